@@ -6,8 +6,7 @@
 #include <iosfwd>
 #include <cstdint>
 
-#include "ReadUintBe.hpp"
-#include "WriteUintBe.hpp"
+#include "FieldLayout.hpp"
 #include "EthernetAddress.hpp"
 #include "EthernetHeader.hpp"
 #include "Ip4Address.hpp"
@@ -22,6 +21,29 @@ enum struct ArpOperation : std::uint16_t
     Reply = 2,
 };
 
+namespace layout {
+
+// ARP for IPv4 over Ethernet (RFC 826)
+struct ArpIp4
+{
+    static constexpr std::size_t size = 28;
+    using HardwareType = FieldBe<0, std::uint16_t>;
+    using ProtocolType = FieldBe<2, EtherType>;
+    using HardwareAddressLength = FieldBe<4, std::uint8_t>;
+    using ProtocolAddressLength = FieldBe<5, std::uint8_t>;
+    using Operation = FieldBe<6, ArpOperation>;
+    using SenderHardwareAddress = AddressField<8, EthernetAddress>;
+    using SenderProtocolAddress = AddressField<14, Ip4Address>;
+    using TargetHardwareAddress = AddressField<18, EthernetAddress>;
+    using TargetProtocolAddress = AddressField<24, Ip4Address>;
+};
+static_assert(FieldsFitLayout<ArpIp4, ArpIp4::HardwareType, ArpIp4::ProtocolType, ArpIp4::HardwareAddressLength,
+                              ArpIp4::ProtocolAddressLength, ArpIp4::Operation, ArpIp4::SenderHardwareAddress,
+                              ArpIp4::SenderProtocolAddress, ArpIp4::TargetHardwareAddress,
+                              ArpIp4::TargetProtocolAddress>);
+
+} // namespace layout
+
 struct ArpIp4Packet
 {
     ArpOperation operation;
@@ -33,31 +55,17 @@ struct ArpIp4Packet
 
 inline auto ParseArpIp4Packet(asio::const_buffer data) -> ArpIp4Packet
 {
-    const auto htype = ReadUintBe<std::uint16_t>(data + 0);
-    if (htype != 1)
-    {
-        throw adapters::InvalidArpPacketError{};
-    }
+    using Arp = layout::ArpIp4;
+    CheckLayoutSize<Arp>(data);
+    const auto bytes = static_cast<const std::uint8_t*>(data.data());
 
-    const auto ptype = ReadUintBe<std::uint16_t>(data + 2);
-    if (ptype != 0x0800)
+    if (Arp::HardwareType::Load(bytes) != 1 || Arp::ProtocolType::Load(bytes) != EtherType::Ip4
+        || Arp::HardwareAddressLength::Load(bytes) != 6 || Arp::ProtocolAddressLength::Load(bytes) != 4)
     {
         throw adapters::InvalidArpPacketError{};
     }
 
-    const auto hlen = ReadUintBe<std::uint8_t>(data + 4);
-    if (hlen != 6)
-    {
-        throw adapters::InvalidArpPacketError{};
-    }
-
-    const auto plen = ReadUintBe<std::uint8_t>(data + 5);
-    if (plen != 4)
-    {
-        throw adapters::InvalidArpPacketError{};
-    }
-
-    const auto operation = ReadUintBe<ArpOperation>(data + 6);
+    const auto operation = Arp::Operation::Load(bytes);
     switch (operation)
     {
     case ArpOperation::Request:
@@ -67,31 +75,32 @@ inline auto ParseArpIp4Packet(asio::const_buffer data) -> ArpIp4Packet
         throw adapters::InvalidArpPacketError{};
     }
 
-    const auto sha = ReadEthernetAddress(data + 8);
-    const auto spa = ReadIp4Address(data + 14);
-    const auto tha = ReadEthernetAddress(data + 18);
-    const auto tpa = ReadIp4Address(data + 24);
-
     return {
-        operation, sha, spa, tha, tpa,
+        operation,
+        Arp::SenderHardwareAddress::Load(bytes),
+        Arp::SenderProtocolAddress::Load(bytes),
+        Arp::TargetHardwareAddress::Load(bytes),
+        Arp::TargetProtocolAddress::Load(bytes),
     };
 }
 
 inline auto WriteArpIp4Packet(const asio::mutable_buffer target, const ArpIp4Packet& arpIp4Packet) -> std::size_t
 {
-    asio::mutable_buffer dst = target;
-
-    dst += WriteUintBe<std::uint16_t>(dst, 1);
-    dst += WriteUintBe(dst, EtherType::Ip4);
-    dst += WriteUintBe<std::uint8_t>(dst, 6);
-    dst += WriteUintBe<std::uint8_t>(dst, 4);
-    dst += WriteUintBe(dst, arpIp4Packet.operation);
-    dst += WriteEthernetAddress(dst, arpIp4Packet.senderHardwareAddress);
-    dst += WriteIp4Address(dst, arpIp4Packet.senderProtocolAddress);
-    dst += WriteEthernetAddress(dst, arpIp4Packet.targetHardwareAddress);
-    dst += WriteIp4Address(dst, arpIp4Packet.targetProtocolAddress);
-
-    return target.size() - dst.size();
+    using Arp = layout::ArpIp4;
+    CheckLayoutSize<Arp>(target);
+    const auto bytes = static_cast<std::uint8_t*>(target.data());
+
+    Arp::HardwareType::Store(bytes, 1);
+    Arp::ProtocolType::Store(bytes, EtherType::Ip4);
+    Arp::HardwareAddressLength::Store(bytes, 6);
+    Arp::ProtocolAddressLength::Store(bytes, 4);
+    Arp::Operation::Store(bytes, arpIp4Packet.operation);
+    Arp::SenderHardwareAddress::Store(bytes, arpIp4Packet.senderHardwareAddress);
+    Arp::SenderProtocolAddress::Store(bytes, arpIp4Packet.senderProtocolAddress);
+    Arp::TargetHardwareAddress::Store(bytes, arpIp4Packet.targetHardwareAddress);
+    Arp::TargetProtocolAddress::Store(bytes, arpIp4Packet.targetProtocolAddress);
+
+    return Arp::size;
 }
 
 std::ostream& operator<<(std::ostream& ostream, const ArpOperation& arpOperation);
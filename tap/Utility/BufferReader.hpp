@@ -8,7 +8,7 @@
 #include <cstdint>
 #include <cstddef>
 
-#include "InternetChecksum.hpp"
+#include "FieldLayout.hpp"
 
 #include "common/Exceptions.hpp"
 
@@ -29,11 +29,6 @@ public:
         return _offset;
     }
 
-    [[nodiscard]] auto GetChecksum() const -> std::uint16_t
-    {
-        return _checksum.GetChecksum();
-    }
-
     auto Skip(const std::size_t byteCount) -> std::size_t
     {
         const auto skipOffset = _offset;
@@ -46,7 +41,6 @@ public:
     {
         const std::size_t getOffset = _offset;
         const std::size_t byteCount = Get(getOffset, mutableBufferSequence);
-        _checksum.AddBuffer(asio::buffer(_buffer + getOffset, byteCount));
         _offset += byteCount;
         return getOffset;
     }
@@ -56,7 +50,6 @@ public:
     {
         const std::size_t getOffset = _offset;
         const std::size_t byteCount = GetBe(getOffset, value);
-        _checksum.AddBuffer(asio::buffer(_buffer + getOffset, byteCount));
         _offset += byteCount;
         return getOffset;
     }
@@ -81,13 +74,7 @@ public:
     {
         CheckGetAt(offset, sizeof(T));
 
-        const auto bytes = static_cast<const std::uint8_t*>((_buffer + offset).data());
-        value = 0;
-        for (unsigned byte_index = 0; byte_index < sizeof(T); ++byte_index)
-        {
-            value |= static_cast<T>(bytes[sizeof(T) - 1 - byte_index]) << (byte_index * 8u);
-        }
-
+        value = LoadBe<T>((_buffer + offset).data());
         return sizeof(T);
     }
 
@@ -112,8 +99,6 @@ private:
 private:
     asio::const_buffer _buffer;
     std::size_t _offset = 0;
-
-    InternetChecksum _checksum;
 };
 
 } // namespace demo
@@ -8,7 +8,7 @@
 #include <cstdint>
 #include <cstddef>
 
-#include "InternetChecksum.hpp"
+#include "FieldLayout.hpp"
 
 #include "common/Exceptions.hpp"
 
@@ -29,11 +29,6 @@ public:
         return _offset;
     }
 
-    [[nodiscard]] auto GetChecksum() const -> std::uint16_t
-    {
-        return _checksum.GetChecksum();
-    }
-
     auto Skip(const std::size_t byteCount) -> std::size_t
     {
         const auto skipOffset = _offset;
@@ -46,7 +41,6 @@ public:
     {
         const std::size_t putOffset = _offset;
         const std::size_t byteCount = Put(putOffset, constBufferSequence);
-        _checksum.AddBuffer(asio::buffer(_buffer + putOffset, byteCount));
         _offset += byteCount;
         return putOffset;
     }
@@ -56,7 +50,6 @@ public:
     {
         const std::size_t putOffset = _offset;
         const std::size_t byteCount = PutBe(putOffset, value);
-        _checksum.AddBuffer(asio::buffer(_buffer + putOffset, byteCount));
         _offset += byteCount;
         return putOffset;
     }
@@ -73,12 +66,7 @@ public:
     {
         CheckPutAt(offset, sizeof(T));
 
-        const auto bytes = static_cast<std::uint8_t*>((_buffer + offset).data());
-        for (unsigned byte_index = 0; byte_index < sizeof(T); ++byte_index)
-        {
-            bytes[sizeof(T) - 1 - byte_index] = (value >> (byte_index * 8u)) & 0xFF;
-        }
-
+        StoreBe<T>((_buffer + offset).data(), value);
         return sizeof(T);
     }
 
@@ -100,8 +88,6 @@ private:
 private:
     asio::mutable_buffer _buffer;
     std::size_t _offset = 0;
-
-    InternetChecksum _checksum;
 };
 
 } // namespace demo
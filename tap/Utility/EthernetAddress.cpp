@@ -3,12 +3,34 @@
 
 #include "EthernetAddress.hpp"
 
+#include <cctype>
 #include <ostream>
+#include <stdexcept>
 
 #include "FormattedBuffer.hpp"
 
 namespace demo {
 
+auto ParseEthernetAddress(const std::string& text) -> EthernetAddress
+{
+    const auto isHexDigit = [](char c) { return std::isxdigit(static_cast<unsigned char>(c)) != 0; };
+
+    EthernetAddress address{};
+    bool isWellFormed = text.size() == 17;
+    for (std::size_t index = 0; isWellFormed && index < 6; ++index)
+    {
+        const auto digits = text.substr(index * 3, 2);
+        const bool hasSeparator = index == 5 || text[index * 3 + 2] == ':' || text[index * 3 + 2] == '-';
+        isWellFormed = isHexDigit(digits[0]) && isHexDigit(digits[1]) && hasSeparator;
+        address.data[index] = isWellFormed ? static_cast<std::uint8_t>(std::stoul(digits, nullptr, 16)) : 0;
+    }
+    if (!isWellFormed)
+    {
+        throw std::invalid_argument{"'" + text + "' is not an Ethernet address"};
+    }
+    return address;
+}
+
 std::ostream& operator<<(std::ostream& ostream, const EthernetAddress& ethernetAddress)
 {
     return ostream << "EthernetAddress(" << FormattedBuffer{asio::buffer(ethernetAddress.data)} << ")";
@@ -6,6 +6,7 @@
 #include <array>
 #include <iosfwd>
 #include <cstdint>
+#include <string>
 #include <asio/ts/buffer.hpp>
 
 #include "common/Exceptions.hpp"
@@ -42,6 +43,12 @@ inline auto WriteEthernetAddress(asio::mutable_buffer target, const EthernetAddr
     return 6;
 }
 
+/// <summary>
+/// Parses six pairs of hex digits separated by ':' or '-', e.g. "52:54:56:53:4B:55".
+/// </summary>
+/// <exception cref="std::invalid_argument">Thrown if the text is malformed.</exception>
+auto ParseEthernetAddress(const std::string& text) -> EthernetAddress;
+
 std::ostream& operator<<(std::ostream& ostream, const EthernetAddress& ethernetAddress);
 
 } // namespace demo
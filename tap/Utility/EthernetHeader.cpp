@@ -15,6 +15,8 @@ std::ostream& operator<<(std::ostream& ostream, const EtherType& etherType)
         return ostream << "EtherType::Ip4";
     case demo::EtherType::Arp:
         return ostream << "EtherType::Arp";
+    case demo::EtherType::Ip6:
+        return ostream << "EtherType::Ip6";
     case demo::EtherType::Vlan_802_1q:
         return ostream << "EtherType::Vlan_802_1q";
     case demo::EtherType::Vlan_802_1ad:
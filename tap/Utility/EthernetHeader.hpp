@@ -9,10 +9,12 @@
 #include <vector>
 
 #include "Enums.hpp"
+#include "FieldLayout.hpp"
 #include "ReadUintBe.hpp"
 #include "WriteUintBe.hpp"
 #include "ParseResult.hpp"
 #include "EthernetAddress.hpp"
+#include "FrameBuilder.hpp"
 
 #include "asio/ts/buffer.hpp"
 
@@ -22,11 +24,36 @@ enum struct EtherType : std::uint16_t
 {
     Ip4 = 0x0800,
     Arp = 0x0806,
+    Ip6 = 0x86DD,
 
     Vlan_802_1q = 0x8100,
     Vlan_802_1ad = 0x88A8,
 };
 
+namespace layout {
+
+struct Ethernet
+{
+    static constexpr std::size_t size = 14;
+    using Destination = AddressField<0, EthernetAddress>;
+    using Source = AddressField<6, EthernetAddress>;
+    // each VLAN tag moves the EtherType back by VlanTag::size
+    using EtherType = FieldBe<12, demo::EtherType>;
+};
+static_assert(FieldsFitLayout<Ethernet, Ethernet::Destination, Ethernet::Source, Ethernet::EtherType>);
+
+// An 802.1ad or 802.1Q tag, in place of the EtherType
+struct VlanTag
+{
+    static constexpr std::size_t size = 4;
+    using Tpid = FieldBe<0, demo::EtherType>;
+    using Tci = FieldBe<2, std::uint16_t>;
+    using VlanId = BitFieldBe<2, std::uint16_t, 0, 12>;
+};
+static_assert(FieldsFitLayout<VlanTag, VlanTag::Tpid, VlanTag::Tci, VlanTag::VlanId>);
+
+} // namespace layout
+
 struct EthernetVlanTag
 {
     EtherType tpid;
@@ -35,9 +62,11 @@ struct EthernetVlanTag
 
 inline auto WriteEthernetVlanTag(asio::mutable_buffer target, const EthernetVlanTag& ethernetVlanTag) -> std::size_t
 {
-    target += WriteUintBe(target, ethernetVlanTag.tpid);
-    target += WriteUintBe(target, ethernetVlanTag.data);
-    return 4;
+    CheckLayoutSize<layout::VlanTag>(target);
+    const auto bytes = static_cast<std::uint8_t*>(target.data());
+    layout::VlanTag::Tpid::Store(bytes, ethernetVlanTag.tpid);
+    layout::VlanTag::Tci::Store(bytes, ethernetVlanTag.data);
+    return layout::VlanTag::size;
 }
 
 static_assert(sizeof(EthernetVlanTag) == 4 && std::is_trivial<EthernetVlanTag>::value);
@@ -53,54 +82,67 @@ struct EthernetHeader
 
 inline auto ParseEthernetHeader(asio::const_buffer data) -> ParseResult<EthernetHeader>
 {
-    asio::const_buffer remaining = asio::buffer(data);
+    CheckLayoutSize<layout::Ethernet>(data);
+    const auto bytes = static_cast<const std::uint8_t*>(data.data());
 
     EthernetHeader ethernetHeader = {};
-
-    ethernetHeader.destination = ReadEthernetAddress(remaining);
-    remaining += 6;
-
-    ethernetHeader.source = ReadEthernetAddress(remaining);
-    remaining += 6;
-
-    if (const auto tpid = ReadUintBe<EtherType>(remaining); tpid == EtherType::Vlan_802_1ad)
+    ethernetHeader.destination = layout::Ethernet::Destination::Load(bytes);
+    ethernetHeader.source = layout::Ethernet::Source::Load(bytes);
+
+    // the tags are read at the position of the EtherType, the header grows by one tag for each of them
+    std::size_t tagsSize = 0;
+    const auto readVlanTag = [&]() -> EthernetVlanTag {
+        if (data.size() < layout::Ethernet::size + tagsSize + layout::VlanTag::size)
+        {
+            throw adapters::InvalidBufferSize{};
+        }
+        const auto tag = bytes + layout::Ethernet::EtherType::offset + tagsSize;
+        tagsSize += layout::VlanTag::size;
+        return EthernetVlanTag{layout::VlanTag::Tpid::Load(tag), layout::VlanTag::Tci::Load(tag)};
+    };
+
+    if (layout::Ethernet::EtherType::Load(bytes) == EtherType::Vlan_802_1ad)
     {
-        ethernetHeader.vlanTag8021ad = EthernetVlanTag{tpid, ReadUintBe<std::uint16_t>(remaining + 2)};
-        remaining += 4;
+        ethernetHeader.vlanTag8021ad = readVlanTag();
     }
 
-    if (const auto tpid = ReadUintBe<EtherType>(remaining); tpid == EtherType::Vlan_802_1q)
+    if (layout::Ethernet::EtherType::Load(bytes + tagsSize) == EtherType::Vlan_802_1q)
     {
-        ethernetHeader.vlanTag8021q = EthernetVlanTag{tpid, ReadUintBe<std::uint16_t>(remaining + 2)};
-        remaining += 4;
+        ethernetHeader.vlanTag8021q = readVlanTag();
     }
 
-    ethernetHeader.etherType = ReadUintBe<EtherType>(remaining);
-    remaining += 2;
+    ethernetHeader.etherType = layout::Ethernet::EtherType::Load(bytes + tagsSize);
 
-    return {ethernetHeader, remaining};
+    return {ethernetHeader, data + (layout::Ethernet::size + tagsSize)};
 }
 
 inline auto WriteEthernetHeader(const asio::mutable_buffer target, EthernetHeader ethernetHeader) -> std::size_t
 {
-    asio::mutable_buffer dst = target;
-
-    dst += WriteEthernetAddress(dst, ethernetHeader.destination);
-    dst += WriteEthernetAddress(dst, ethernetHeader.source);
-
-    if (ethernetHeader.vlanTag8021ad)
+    const std::size_t tagsSize = (ethernetHeader.vlanTag8021ad ? layout::VlanTag::size : 0)
+                                 + (ethernetHeader.vlanTag8021q ? layout::VlanTag::size : 0);
+    if (target.size() < layout::Ethernet::size + tagsSize)
     {
-        dst += WriteEthernetVlanTag(dst, ethernetHeader.vlanTag8021ad.value());
+        throw adapters::InvalidBufferSize{};
     }
+    const auto bytes = static_cast<std::uint8_t*>(target.data());
 
-    if (ethernetHeader.vlanTag8021q)
+    layout::Ethernet::Destination::Store(bytes, ethernetHeader.destination);
+    layout::Ethernet::Source::Store(bytes, ethernetHeader.source);
+
+    auto tag = bytes + layout::Ethernet::EtherType::offset;
+    for (const auto& vlanTag : {ethernetHeader.vlanTag8021ad, ethernetHeader.vlanTag8021q})
     {
-        dst += WriteEthernetVlanTag(dst, ethernetHeader.vlanTag8021q.value());
+        if (vlanTag)
+        {
+            layout::VlanTag::Tpid::Store(tag, vlanTag->tpid);
+            layout::VlanTag::Tci::Store(tag, vlanTag->data);
+            tag += layout::VlanTag::size;
+        }
     }
 
-    dst += WriteUintBe(dst, ethernetHeader.etherType);
+    layout::Ethernet::EtherType::Store(bytes + tagsSize, ethernetHeader.etherType);
 
-    return target.size() - dst.size();
+    return layout::Ethernet::size + tagsSize;
 }
 
 std::ostream& operator<<(std::ostream& ostream, const EtherType& etherType);
@@ -162,5 +204,29 @@ inline auto RemoveVlanTag(const Container& frame) -> std::vector<std::uint8_t>
     return stripped;
 }
 
+// Appends the frame with an 802.1Q VLAN tag like InjectVlanTag, the tag is the only copied part.
+inline void AppendWithVlanTag(demo::FrameBuilder& builder, asio::const_buffer frame, std::uint16_t vid)
+{
+    if (frame.size() < 14)
+    {
+        builder.AppendReference(frame);
+        return;
+    }
+
+    const std::uint8_t vlanBytes[4] = {0x81, 0x00, static_cast<std::uint8_t>(vid >> 8),
+                                       static_cast<std::uint8_t>(vid & 0xFF)};
+    builder.AppendReference(asio::buffer(frame, 12));
+    builder.AppendCopy(asio::buffer(vlanBytes));
+    builder.AppendReference(frame + 12);
+}
+
+// Appends the frame without its 802.1Q VLAN tag like RemoveVlanTag, nothing is copied.
+// The caller must ensure a VLAN tag is present.
+inline void AppendWithoutVlanTag(demo::FrameBuilder& builder, asio::const_buffer frame)
+{
+    builder.AppendReference(asio::buffer(frame, 12));
+    builder.AppendReference(frame + 16);
+}
+
 } // namespace vlan
 } // namespace adapters
@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "common/Exceptions.hpp"
+
+#include "asio/ts/buffer.hpp"
+
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+// Compile-time descriptions of protocol headers, from which the parse and write code is generated.
+//
+//   A layout is a struct in demo::layout with the size of the fixed part of a header and one alias per field:
+//
+//       struct Udp
+//       {
+//           static constexpr std::size_t size = 8;
+//           using SourcePort = FieldBe<0, std::uint16_t>;
+//           ...
+//       };
+//
+//   A field knows its offset, width and byte order at compile time, its Load and Store are a single load or
+//   store at a fixed offset, byte-swapped with an intrinsic. The size of a buffer is checked once for the whole
+//   layout (FitsLayout, CheckLayoutSize), the fields do not check it again. FieldsFitLayout verifies at compile
+//   time that the fields of a layout do not reach past its size.
+
+namespace demo {
+
+namespace detail {
+
+template <typename T>
+inline auto ByteSwap(T value) -> T
+{
+    static_assert(std::is_unsigned<T>::value && sizeof(T) <= 8, "only unsigned integers are swapped");
+    if constexpr (sizeof(T) == 1)
+    {
+        return value;
+    }
+#if defined(_MSC_VER)
+    else if constexpr (sizeof(T) == 2)
+    {
+        return static_cast<T>(_byteswap_ushort(static_cast<unsigned short>(value)));
+    }
+    else if constexpr (sizeof(T) == 4)
+    {
+        return static_cast<T>(_byteswap_ulong(static_cast<unsigned long>(value)));
+    }
+    else
+    {
+        return static_cast<T>(_byteswap_uint64(static_cast<unsigned __int64>(value)));
+    }
+#else
+    else if constexpr (sizeof(T) == 2)
+    {
+        return static_cast<T>(__builtin_bswap16(static_cast<std::uint16_t>(value)));
+    }
+    else if constexpr (sizeof(T) == 4)
+    {
+        return static_cast<T>(__builtin_bswap32(static_cast<std::uint32_t>(value)));
+    }
+    else
+    {
+        return static_cast<T>(__builtin_bswap64(static_cast<std::uint64_t>(value)));
+    }
+#endif
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool hostIsBigEndian = true;
+#else
+constexpr bool hostIsBigEndian = false;
+#endif
+
+template <typename T>
+using StorageOf = typename std::conditional_t<std::is_enum<T>::value, std::underlying_type<T>,
+                                              std::remove_cv<T>>::type;
+
+} // namespace detail
+
+// Loads an unsigned integer stored in network byte order, data needs no alignment.
+template <typename T>
+inline auto LoadBe(const void* data) -> std::enable_if_t<std::is_unsigned<T>::value, T>
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return detail::hostIsBigEndian ? value : detail::ByteSwap(value);
+}
+
+// Stores an unsigned integer in network byte order, data needs no alignment.
+template <typename T>
+inline auto StoreBe(void* data, T value) -> std::enable_if_t<std::is_unsigned<T>::value>
+{
+    const T stored = detail::hostIsBigEndian ? value : detail::ByteSwap(value);
+    std::memcpy(data, &stored, sizeof(T));
+}
+
+// An unsigned integer or enum in network byte order
+template <std::size_t Offset, typename Value>
+struct FieldBe
+{
+    using Storage = detail::StorageOf<Value>;
+    static_assert(std::is_unsigned<Storage>::value, "fields are unsigned integers or enums of them");
+
+    static constexpr std::size_t offset = Offset;
+    static constexpr std::size_t size = sizeof(Storage);
+
+    static auto Load(const std::uint8_t* header) -> Value
+    {
+        return static_cast<Value>(LoadBe<Storage>(header + Offset));
+    }
+
+    static void Store(std::uint8_t* header, Value value)
+    {
+        StoreBe<Storage>(header + Offset, static_cast<Storage>(value));
+    }
+};
+
+// The bits [Shift, Shift + Width) of an unsigned integer of type Storage in network byte order. Store keeps the
+// other bits of the integer.
+template <std::size_t Offset, typename Storage, unsigned Shift, unsigned Width, typename Value = Storage>
+struct BitFieldBe
+{
+    static_assert(std::is_unsigned<Storage>::value, "bit fields are parts of unsigned integers");
+    static_assert(Width > 0 && Shift + Width <= std::numeric_limits<Storage>::digits, "bits outside of the integer");
+
+    static constexpr std::size_t offset = Offset;
+    static constexpr std::size_t size = sizeof(Storage);
+    static constexpr Storage mask = static_cast<Storage>(
+        (Width == std::numeric_limits<Storage>::digits ? ~Storage{0} : static_cast<Storage>((Storage{1} << Width) - 1))
+        << Shift);
+
+    static auto Load(const std::uint8_t* header) -> Value
+    {
+        return static_cast<Value>((LoadBe<Storage>(header + Offset) & mask) >> Shift);
+    }
+
+    static void Store(std::uint8_t* header, Value value)
+    {
+        const auto bits = static_cast<Storage>(static_cast<Storage>(static_cast<detail::StorageOf<Value>>(value))
+                                               << Shift);
+        StoreBe<Storage>(header + Offset,
+                         static_cast<Storage>((LoadBe<Storage>(header + Offset) & ~mask) | (bits & mask)));
+    }
+};
+
+// A byte array, such as EthernetAddress or Ip4Address with their std::array member data
+template <std::size_t Offset, typename Address>
+struct AddressField
+{
+    static constexpr std::size_t offset = Offset;
+    static constexpr std::size_t size = sizeof(Address::data);
+
+    static auto Load(const std::uint8_t* header) -> Address
+    {
+        Address address;
+        std::memcpy(address.data.data(), header + Offset, size);
+        return address;
+    }
+
+    static void Store(std::uint8_t* header, const Address& address)
+    {
+        std::memcpy(header + Offset, address.data.data(), size);
+    }
+};
+
+template <typename Layout, typename... Fields>
+constexpr bool FieldsFitLayout = ((Fields::offset + Fields::size <= Layout::size) && ...);
+
+template <typename Layout>
+inline auto FitsLayout(asio::const_buffer buffer) -> bool
+{
+    return buffer.size() >= Layout::size;
+}
+
+// Throws InvalidBufferSize if the buffer is too short for the layout, the common check of the Parse functions
+template <typename Layout>
+inline void CheckLayoutSize(asio::const_buffer buffer)
+{
+    if (buffer.size() < Layout::size)
+    {
+        throw adapters::InvalidBufferSize{};
+    }
+}
+
+} // namespace demo
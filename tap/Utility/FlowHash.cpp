@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "FlowHash.hpp"
+
+#include <cassert>
+
+#include "FieldLayout.hpp"
+
+namespace demo {
+
+const ToeplitzHash::Key ToeplitzHash::defaultKey = {
+    0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2, 0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3,
+    0x8f, 0xb0, 0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4, 0x77, 0xcb, 0x2d, 0xa3,
+    0x80, 0x30, 0xf2, 0x0c, 0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa,
+};
+
+ToeplitzHash::ToeplitzHash(const Key& key)
+    : _tables(maxInputSize)
+{
+    // bit i of the input XORs the 32 key bits starting at bit i into the hash
+    const auto keyWindow = [&key](std::size_t bitIndex) -> std::uint32_t {
+        std::uint32_t window = 0;
+        for (std::size_t windowBit = 0; windowBit < 32; ++windowBit)
+        {
+            const auto keyBit = bitIndex + windowBit;
+            window = (window << 1u) | ((key[keyBit / 8] >> (7 - keyBit % 8)) & 1u);
+        }
+        return window;
+    };
+
+    for (std::size_t byteIndex = 0; byteIndex < maxInputSize; ++byteIndex)
+    {
+        std::array<std::uint32_t, 8> bitWindows;
+        for (std::size_t bit = 0; bit < 8; ++bit)
+        {
+            // the most significant bit of a byte comes first
+            bitWindows[bit] = keyWindow(byteIndex * 8 + 7 - bit);
+        }
+        for (std::size_t value = 0; value < 256; ++value)
+        {
+            std::uint32_t hash = 0;
+            for (std::size_t bit = 0; bit < 8; ++bit)
+            {
+                if ((value >> bit) & 1u)
+                {
+                    hash ^= bitWindows[bit];
+                }
+            }
+            _tables[byteIndex][value] = hash;
+        }
+    }
+}
+
+auto ToeplitzHash::Hash(const std::uint8_t* input, std::size_t size) const -> std::uint32_t
+{
+    assert(size <= maxInputSize);
+
+    std::uint32_t hash = 0;
+    for (std::size_t byteIndex = 0; byteIndex < size; ++byteIndex)
+    {
+        hash ^= _tables[byteIndex][input[byteIndex]];
+    }
+    return hash;
+}
+
+auto ToeplitzHash::Hash(const FlowKey& flowKey, bool includePorts) const -> std::uint32_t
+{
+    const std::size_t addressSize = flowKey.ipVersion == 4 ? 4 : 16;
+
+    std::array<std::uint8_t, maxInputSize> input;
+    std::memcpy(input.data(), flowKey.sourceAddress.data(), addressSize);
+    std::memcpy(input.data() + addressSize, flowKey.destinationAddress.data(), addressSize);
+    std::size_t size = 2 * addressSize;
+    if (includePorts)
+    {
+        StoreBe(input.data() + size, flowKey.sourcePort);
+        StoreBe(input.data() + size + 2, flowKey.destinationPort);
+        size += 4;
+    }
+    return Hash(input.data(), size);
+}
+
+auto FastFlowHash(const FlowKey& flowKey, bool includePorts) -> std::uint32_t
+{
+    std::array<std::uint64_t, 4> addressWords;
+    std::memcpy(addressWords.data(), flowKey.sourceAddress.data(), 16);
+    std::memcpy(addressWords.data() + 2, flowKey.destinationAddress.data(), 16);
+    const std::uint64_t ports = includePorts ? (std::uint64_t{flowKey.sourcePort} << 16u) | flowKey.destinationPort : 0;
+    const std::uint64_t otherWord = (ports << 32u) | (std::uint64_t{flowKey.vlanId} << 16u)
+                                    | (std::uint64_t{flowKey.ipVersion} << 8u) | flowKey.protocol;
+
+    // independent multiplications by different odd constants, so that they run in parallel
+    std::uint64_t hash = addressWords[0] * 0x9E3779B97F4A7C15ull ^ addressWords[1] * 0xC2B2AE3D27D4EB4Full
+                         ^ addressWords[2] * 0x165667B19E3779F9ull ^ addressWords[3] * 0xD6E8FEB86659FD93ull
+                         ^ otherWord * 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 29u;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    return static_cast<std::uint32_t>(hash >> 32u);
+}
+
+} // namespace demo
@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "FlowKey.hpp"
+
+namespace demo {
+
+/// <summary>
+/// The Toeplitz hash of receive side scaling (RSS), as computed by NICs and by the Linux kernel for a given key.
+///
+///   The input is the source and destination address, followed by the source and destination port for TCP and,
+///   if configured so, for UDP. The protocol and the VLAN are not part of it. With the same key (ethtool -x shows
+///   it, ethtool -X hkey sets it) a frame hashes to the same value as on the NIC of a real ECU.
+///
+///   The key is expanded into one table of 256 partial hashes per input byte, so that hashing takes one lookup
+///   and one XOR per byte instead of one branch per bit.
+/// </summary>
+class ToeplitzHash
+{
+public:
+    using Key = std::array<std::uint8_t, 40>;
+
+    // the key of the RSS verification suite of Microsoft, the default of many NIC drivers
+    static const Key defaultKey;
+
+    // IPv6 addresses and ports
+    static constexpr std::size_t maxInputSize = 36;
+
+    explicit ToeplitzHash(const Key& key = defaultKey);
+
+    [[nodiscard]] auto Hash(const std::uint8_t* input, std::size_t size) const -> std::uint32_t;
+
+    [[nodiscard]] auto Hash(const FlowKey& flowKey, bool includePorts) const -> std::uint32_t;
+
+private:
+    std::vector<std::array<std::uint32_t, 256>> _tables;
+};
+
+/// <summary>
+/// A cheaper alternative to the Toeplitz hash for flow tables which do not need to match a NIC: a few multiplications
+/// over the words of the whole key, including protocol and VLAN.
+/// </summary>
+auto FastFlowHash(const FlowKey& flowKey, bool includePorts) -> std::uint32_t;
+
+} // namespace demo
@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "FlowKey.hpp"
+
+#include <ostream>
+
+#include "Enums.hpp"
+#include "Ip6Header.hpp"
+#include "PacketView.hpp"
+
+namespace demo {
+
+namespace {
+
+auto OffsetIn(asio::const_buffer frame, asio::const_buffer part) -> std::uint16_t
+{
+    return static_cast<std::uint16_t>(static_cast<const std::uint8_t*>(part.data())
+                                      - static_cast<const std::uint8_t*>(frame.data()));
+}
+
+// Fills in the ports and the payload of UDP and TCP, the upper-layer data of other protocols is the payload
+auto ExtractTransport(asio::const_buffer frame, asio::const_buffer transport, bool hasTransportHeader, Flow& flow)
+    -> bool
+{
+    flow.transportOffset = OffsetIn(frame, transport);
+    flow.payloadOffset = flow.transportOffset;
+    flow.payloadSize = static_cast<std::uint16_t>(transport.size());
+    if (!hasTransportHeader)
+    {
+        return true;
+    }
+
+    if (flow.key.protocol == ToUnderlying(Ip4Protocol::UDP))
+    {
+        const auto udp = UdpView::Parse(transport);
+        if (!udp)
+        {
+            return false;
+        }
+        flow.key.sourcePort = udp.GetSourcePort();
+        flow.key.destinationPort = udp.GetDestinationPort();
+        flow.payloadOffset = OffsetIn(frame, udp.GetPayload());
+        flow.payloadSize = static_cast<std::uint16_t>(udp.GetPayload().size());
+    }
+    else if (flow.key.protocol == ToUnderlying(Ip4Protocol::TCP))
+    {
+        const auto tcp = TcpView::Parse(transport);
+        if (!tcp)
+        {
+            return false;
+        }
+        flow.key.sourcePort = tcp.GetSourcePort();
+        flow.key.destinationPort = tcp.GetDestinationPort();
+        flow.payloadOffset = OffsetIn(frame, tcp.GetPayload());
+        flow.payloadSize = static_cast<std::uint16_t>(tcp.GetPayload().size());
+    }
+    return true;
+}
+
+auto ExtractIp4(asio::const_buffer frame, asio::const_buffer packet, Flow& flow) -> bool
+{
+    const auto ip4 = Ip4View::Parse(packet);
+    if (!ip4)
+    {
+        return false;
+    }
+
+    flow.key.ipVersion = 4;
+    flow.key.protocol = ToUnderlying(ip4.GetProtocol());
+    std::memcpy(flow.key.sourceAddress.data(), ip4.GetSourceAddress().data.data(), 4);
+    std::memcpy(flow.key.destinationAddress.data(), ip4.GetDestinationAddress().data.data(), 4);
+    flow.isFragment = ip4.IsFragment();
+
+    // only the first fragment carries the transport header
+    return ExtractTransport(frame, ip4.GetPayload(), ip4.GetFragmentOffset() == 0, flow);
+}
+
+auto ExtractIp6(asio::const_buffer frame, asio::const_buffer packet, Flow& flow) -> bool
+{
+    using Ip6 = layout::Ip6;
+    if (!FitsLayout<Ip6>(packet))
+    {
+        return false;
+    }
+    const auto bytes = static_cast<const std::uint8_t*>(packet.data());
+    const std::size_t payloadLength = Ip6::PayloadLength::Load(bytes);
+    if (Ip6::Version::Load(bytes) != 6 || packet.size() < Ip6::size + payloadLength)
+    {
+        return false;
+    }
+
+    flow.key.ipVersion = 6;
+    flow.key.sourceAddress = Ip6::SourceAddress::Load(bytes).data;
+    flow.key.destinationAddress = Ip6::DestinationAddress::Load(bytes).data;
+
+    // the non-throwing counterpart of SkipIp6ExtensionHeaders, which also notes fragments
+    auto nextHeader = Ip6::NextHeader::Load(bytes);
+    auto data = asio::buffer(packet + Ip6::size, payloadLength);
+    bool hasTransportHeader = true;
+    for (bool isExtensionHeader = true; isExtensionHeader;)
+    {
+        const auto header = static_cast<const std::uint8_t*>(data.data());
+        switch (nextHeader)
+        {
+        case Ip6NextHeader::HopByHopOptions:
+        case Ip6NextHeader::Routing:
+        case Ip6NextHeader::DestinationOptions:
+        {
+            if (data.size() < 8 || data.size() < (std::size_t(header[1]) + 1) * 8)
+            {
+                return false;
+            }
+            nextHeader = static_cast<Ip6NextHeader>(header[0]);
+            data += (std::size_t(header[1]) + 1) * 8;
+            break;
+        }
+        case Ip6NextHeader::Fragment:
+        {
+            if (data.size() < 8)
+            {
+                return false;
+            }
+            flow.isFragment = true;
+            // fragment offset in the upper 13 bits, only the first fragment carries the transport header
+            hasTransportHeader = hasTransportHeader && (LoadBe<std::uint16_t>(header + 2) >> 3u) == 0;
+            nextHeader = static_cast<Ip6NextHeader>(header[0]);
+            data += 8;
+            break;
+        }
+        default:
+            isExtensionHeader = false;
+            break;
+        }
+    }
+
+    flow.key.protocol = ToUnderlying(nextHeader);
+    return ExtractTransport(frame, data, hasTransportHeader, flow);
+}
+
+} // namespace
+
+auto ExtractFlow(asio::const_buffer frame) -> std::optional<Flow>
+{
+    const auto ethernet = EthernetView::Parse(frame);
+    if (!ethernet)
+    {
+        return std::nullopt;
+    }
+
+    Flow flow = {};
+    flow.key.vlanId = ethernet.HasVlanTag() ? ethernet.GetVlanId() : FlowKey::noVlanId;
+    flow.networkOffset = static_cast<std::uint16_t>(ethernet.GetHeaderSize());
+
+    switch (ethernet.GetEtherType())
+    {
+    case EtherType::Ip4:
+        return ExtractIp4(frame, ethernet.GetPayload(), flow) ? std::make_optional(flow) : std::nullopt;
+    case EtherType::Ip6:
+        return ExtractIp6(frame, ethernet.GetPayload(), flow) ? std::make_optional(flow) : std::nullopt;
+    default:
+        return std::nullopt;
+    }
+}
+
+std::ostream& operator<<(std::ostream& ostream, const FlowKey& flowKey)
+{
+    ostream << "FlowKey(ipVersion=" << unsigned(flowKey.ipVersion) << ",protocol=" << unsigned(flowKey.protocol)
+            << ",source=";
+    if (flowKey.ipVersion == 4)
+    {
+        Ip4Address sourceAddress, destinationAddress;
+        std::memcpy(sourceAddress.data.data(), flowKey.sourceAddress.data(), 4);
+        std::memcpy(destinationAddress.data.data(), flowKey.destinationAddress.data(), 4);
+        ostream << sourceAddress << ":" << flowKey.sourcePort << ",destination=" << destinationAddress;
+    }
+    else
+    {
+        ostream << Ip6Address{flowKey.sourceAddress} << ":" << flowKey.sourcePort
+                << ",destination=" << Ip6Address{flowKey.destinationAddress};
+    }
+    ostream << ":" << flowKey.destinationPort;
+    if (flowKey.vlanId != FlowKey::noVlanId)
+    {
+        ostream << ",vlanId=" << flowKey.vlanId;
+    }
+    return ostream << ")";
+}
+
+} // namespace demo
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <optional>
+#include <type_traits>
+
+#include "asio/ts/buffer.hpp"
+
+namespace demo {
+
+/// <summary>
+/// The 5-tuple and the VLAN of an IPv4 or IPv6 frame. A plain 40 byte struct without padding, so that it can be
+/// compared and hashed as bytes.
+/// </summary>
+struct FlowKey
+{
+    static constexpr std::uint16_t noVlanId = 0xFFFF;
+
+    // IPv4 addresses take the first 4 bytes, the rest is zero
+    std::array<std::uint8_t, 16> sourceAddress;
+    std::array<std::uint8_t, 16> destinationAddress;
+    // the UDP or TCP ports, 0 for other protocols and for fragments without the transport header
+    std::uint16_t sourcePort;
+    std::uint16_t destinationPort;
+    // the VLAN ID of the 802.1Q tag, noVlanId for untagged frames
+    std::uint16_t vlanId;
+    // 4 or 6
+    std::uint8_t ipVersion;
+    // the IPv4 protocol or the IPv6 upper-layer next header, after the extension headers
+    std::uint8_t protocol;
+
+    [[nodiscard]] auto HasPorts() const -> bool
+    {
+        return sourcePort != 0 || destinationPort != 0;
+    }
+};
+
+static_assert(sizeof(FlowKey) == 40 && std::is_trivial<FlowKey>::value, "flow keys are compared as bytes");
+
+inline bool operator==(const FlowKey& lhs, const FlowKey& rhs)
+{
+    return std::memcmp(&lhs, &rhs, sizeof(FlowKey)) == 0;
+}
+
+inline bool operator!=(const FlowKey& lhs, const FlowKey& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/// <summary>
+/// A classified frame: its flow key and where its headers are, so that later stages do not parse it again.
+/// The offsets are relative to the start of the frame.
+/// </summary>
+struct Flow
+{
+    FlowKey key;
+    // of the IPv4 or IPv6 header
+    std::uint16_t networkOffset;
+    // of the UDP or TCP header, or of the upper-layer data of other protocols
+    std::uint16_t transportOffset;
+    // of the UDP or TCP payload, equal to transportOffset for other protocols and for later fragments
+    std::uint16_t payloadOffset;
+    // up to the UDP length or the IP total or payload length, padding of short frames excluded
+    std::uint16_t payloadSize;
+    // any fragment of a datagram, including the first one with the transport header. Hashes leave the ports of
+    // fragments out, so that all fragments of a datagram hash alike.
+    bool isFragment;
+
+    [[nodiscard]] auto GetPayload(asio::const_buffer frame) const -> asio::const_buffer
+    {
+        return asio::buffer(frame + payloadOffset, payloadSize);
+    }
+};
+
+/// <summary>
+/// Extracts the flow of an Ethernet frame with IPv4 or IPv6, after an optional 802.1ad and 802.1Q tag. IPv6
+/// extension headers are skipped. Never throws, returns nothing for other EtherTypes and for truncated or
+/// malformed headers.
+/// </summary>
+auto ExtractFlow(asio::const_buffer frame) -> std::optional<Flow>;
+
+std::ostream& operator<<(std::ostream& ostream, const FlowKey& flowKey);
+
+} // namespace demo
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "FrameBuilder.hpp"
+
+#include <cstring>
+
+namespace demo {
+
+auto FrameBuilder::AppendHeader(std::size_t size) -> asio::mutable_buffer
+{
+    if (size > headerCapacity - _headerSize)
+    {
+        throw adapters::InvalidBufferSize{};
+    }
+    auto* header = _headers.data() + _headerSize;
+    AppendSegment(asio::const_buffer{header, size});
+    _headerSize += size;
+    return asio::mutable_buffer{header, size};
+}
+
+auto FrameBuilder::AppendCopy(asio::const_buffer bytes) -> asio::mutable_buffer
+{
+    const auto header = AppendHeader(bytes.size());
+    std::memcpy(header.data(), bytes.data(), bytes.size());
+    return header;
+}
+
+void FrameBuilder::AppendReference(asio::const_buffer bytes)
+{
+    AppendSegment(bytes);
+}
+
+void FrameBuilder::PadTo(std::size_t frameSize)
+{
+    if (_size < frameSize)
+    {
+        const auto padding = AppendHeader(frameSize - _size);
+        std::memset(padding.data(), 0, padding.size());
+    }
+}
+
+void FrameBuilder::FlattenTo(std::vector<std::uint8_t>& frame) const
+{
+    frame.resize(_size);
+    asio::buffer_copy(asio::buffer(frame), *this);
+}
+
+void FrameBuilder::AppendSegment(asio::const_buffer segment)
+{
+    if (segment.size() == 0)
+    {
+        return;
+    }
+    if (_segmentCount > 0)
+    {
+        // adjacent headers and adjacent parts of a referenced buffer are one segment
+        auto& last = _segments[_segmentCount - 1];
+        if (static_cast<const std::uint8_t*>(last.data()) + last.size() == segment.data())
+        {
+            last = asio::const_buffer{last.data(), last.size() + segment.size()};
+            _size += segment.size();
+            return;
+        }
+    }
+    if (_segmentCount == maxSegments)
+    {
+        throw adapters::InvalidBufferSize{};
+    }
+    _segments[_segmentCount++] = segment;
+    _size += segment.size();
+}
+
+} // namespace demo
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "common/Exceptions.hpp"
+
+#include "asio/ts/buffer.hpp"
+
+namespace demo {
+
+/// <summary>
+/// Composes a frame as a short chain of segments instead of copying it into one buffer: new or rewritten headers
+/// are written into the storage of the builder, the unchanged parts like the payload are referenced where they
+/// are. The builder is a ConstBufferSequence, so the segments can be written as a gather list (writev) or joined
+/// once with FlattenTo for senders which take a contiguous frame.
+///
+///   Referenced buffers must stay valid until the frame is sent. The segments point into the builder, which can
+///   therefore not be copied or moved; clear and reuse it for the next frame.
+/// </summary>
+class FrameBuilder
+{
+public:
+    static constexpr std::size_t maxSegments = 8;
+    // enough for the Ethernet, VLAN, IPv6 and transport headers of one frame
+    static constexpr std::size_t headerCapacity = 128;
+
+    FrameBuilder() = default;
+    FrameBuilder(const FrameBuilder&) = delete;
+    auto operator=(const FrameBuilder&) -> FrameBuilder& = delete;
+
+    void Clear()
+    {
+        _segmentCount = 0;
+        _headerSize = 0;
+        _size = 0;
+    }
+
+    /// <summary>
+    /// Returns size bytes of the header storage, appended to the frame, to be written by the caller.
+    /// </summary>
+    /// <exception cref="adapters::InvalidBufferSize">Thrown if the header storage or segments are used up.</exception>
+    auto AppendHeader(std::size_t size) -> asio::mutable_buffer;
+
+    /// <summary>
+    /// Appends a copy of bytes in the header storage and returns it, e.g. to rewrite fields of a received header.
+    /// </summary>
+    /// <exception cref="adapters::InvalidBufferSize">Thrown if the header storage or segments are used up.</exception>
+    auto AppendCopy(asio::const_buffer bytes) -> asio::mutable_buffer;
+
+    /// <summary>
+    /// Appends a reference to bytes owned by the caller, nothing is copied.
+    /// </summary>
+    /// <exception cref="adapters::InvalidBufferSize">Thrown if the segments are used up.</exception>
+    void AppendReference(asio::const_buffer bytes);
+
+    /// <summary>
+    /// Appends zeros up to the given frame size, e.g. the 60 bytes of the shortest Ethernet frame.
+    /// </summary>
+    void PadTo(std::size_t frameSize);
+
+    /// <summary>
+    /// Replaces the content of frame with the joined segments. Reusing frame avoids the allocation.
+    /// </summary>
+    void FlattenTo(std::vector<std::uint8_t>& frame) const;
+
+    auto GetSize() const -> std::size_t
+    {
+        return _size;
+    }
+
+    auto GetSegmentCount() const -> std::size_t
+    {
+        return _segmentCount;
+    }
+
+    // ConstBufferSequence
+    auto begin() const -> const asio::const_buffer*
+    {
+        return _segments.data();
+    }
+
+    auto end() const -> const asio::const_buffer*
+    {
+        return _segments.data() + _segmentCount;
+    }
+
+private:
+    void AppendSegment(asio::const_buffer segment);
+
+    std::array<asio::const_buffer, maxSegments> _segments;
+    std::size_t _segmentCount{0};
+    std::array<std::uint8_t, headerCapacity> _headers;
+    std::size_t _headerSize{0};
+    std::size_t _size{0};
+};
+
+} // namespace demo
@@ -13,6 +13,8 @@ std::ostream& operator<<(std::ostream& ostream, const Icmp4Type& icmp4Type)
     {
     case demo::Icmp4Type::EchoReply:
         return ostream << "Icmp4Type::EchoReply";
+    case demo::Icmp4Type::DestinationUnreachable:
+        return ostream << "Icmp4Type::DestinationUnreachable";
     case demo::Icmp4Type::EchoRequest:
         return ostream << "Icmp4Type::EchoRequest";
     }
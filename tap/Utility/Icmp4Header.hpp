@@ -6,8 +6,7 @@
 #include <iosfwd>
 #include <cstdint>
 
-#include "ReadUintBe.hpp"
-#include "WriteUintBe.hpp"
+#include "FieldLayout.hpp"
 #include "ParseResult.hpp"
 #include "Ip4Address.hpp"
 #include "Ip4Header.hpp"
@@ -17,9 +16,47 @@ namespace demo {
 enum struct Icmp4Type : std::uint8_t
 {
     EchoReply = 0,
+    DestinationUnreachable = 3,
     EchoRequest = 8,
 };
 
+// The code of a destination unreachable message sent for a packet which exceeds the MTU but must not be fragmented
+constexpr std::uint8_t icmp4FragmentationNeeded = 4;
+
+namespace layout {
+
+// The common part of the ICMP header (RFC 792), the rest of the header depends on the type
+struct Icmp4
+{
+    static constexpr std::size_t size = 4;
+    using Type = FieldBe<0, Icmp4Type>;
+    using Code = FieldBe<1, std::uint8_t>;
+    using Checksum = FieldBe<2, std::uint16_t>;
+};
+static_assert(FieldsFitLayout<Icmp4, Icmp4::Type, Icmp4::Code, Icmp4::Checksum>);
+
+// The header of echo requests and replies
+struct Icmp4Echo : Icmp4
+{
+    static constexpr std::size_t size = 8;
+    using Identifier = FieldBe<4, std::uint16_t>;
+    using SequenceNumber = FieldBe<6, std::uint16_t>;
+};
+static_assert(FieldsFitLayout<Icmp4Echo, Icmp4Echo::Identifier, Icmp4Echo::SequenceNumber>);
+
+// The header of destination unreachable messages, followed by the start of the offending packet. The next-hop MTU
+// is only set for fragmentation needed (RFC 1191).
+struct Icmp4DestinationUnreachable : Icmp4
+{
+    static constexpr std::size_t size = 8;
+    using Unused = FieldBe<4, std::uint16_t>;
+    using NextHopMtu = FieldBe<6, std::uint16_t>;
+};
+static_assert(FieldsFitLayout<Icmp4DestinationUnreachable, Icmp4DestinationUnreachable::Unused,
+                              Icmp4DestinationUnreachable::NextHopMtu>);
+
+} // namespace layout
+
 struct Icmp4Header
 {
     Icmp4Type type;
@@ -29,29 +66,31 @@ struct Icmp4Header
 
 inline auto ParseIcmp4Header(asio::const_buffer data) -> ParseResult<Icmp4Header>
 {
-    const auto type = ReadUintBe<Icmp4Type>(data + 0);
-    const auto code = ReadUintBe<std::uint8_t>(data + 1);
-    const auto checksum = ReadUintBe<std::uint16_t>(data + 2);
+    using Icmp4 = layout::Icmp4;
+    CheckLayoutSize<Icmp4>(data);
+    const auto bytes = static_cast<const std::uint8_t*>(data.data());
 
     return {
         Icmp4Header{
-            type,
-            code,
-            checksum,
+            Icmp4::Type::Load(bytes),
+            Icmp4::Code::Load(bytes),
+            Icmp4::Checksum::Load(bytes),
         },
-        data + 4,
+        data + Icmp4::size,
     };
 }
 
 inline auto WriteIcmp4Header(const asio::mutable_buffer target, const Icmp4Header& icmp4Header) -> std::size_t
 {
-    BufferWriter writer{target};
+    using Icmp4 = layout::Icmp4;
+    CheckLayoutSize<Icmp4>(target);
+    const auto bytes = static_cast<std::uint8_t*>(target.data());
 
-    writer.WriteBe(icmp4Header.type);
-    writer.WriteBe(icmp4Header.code);
-    writer.WriteBe(std::uint16_t(0));
+    Icmp4::Type::Store(bytes, icmp4Header.type);
+    Icmp4::Code::Store(bytes, icmp4Header.code);
+    Icmp4::Checksum::Store(bytes, 0);
 
-    return writer.GetOffset();
+    return Icmp4::size;
 }
 
 std::ostream& operator<<(std::ostream& ostream, const Icmp4Type& icmp4Type);
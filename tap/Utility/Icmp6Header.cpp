@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "Icmp6Header.hpp"
+
+#include <ostream>
+
+#include "Enums.hpp"
+
+namespace demo {
+
+std::ostream& operator<<(std::ostream& ostream, const Icmp6Type& icmp6Type)
+{
+    switch (icmp6Type)
+    {
+    case demo::Icmp6Type::PacketTooBig:
+        return ostream << "Icmp6Type::PacketTooBig";
+    case demo::Icmp6Type::MulticastListenerQuery:
+        return ostream << "Icmp6Type::MulticastListenerQuery";
+    case demo::Icmp6Type::MulticastListenerReport:
+        return ostream << "Icmp6Type::MulticastListenerReport";
+    case demo::Icmp6Type::MulticastListenerDone:
+        return ostream << "Icmp6Type::MulticastListenerDone";
+    case demo::Icmp6Type::NeighborSolicitation:
+        return ostream << "Icmp6Type::NeighborSolicitation";
+    case demo::Icmp6Type::NeighborAdvertisement:
+        return ostream << "Icmp6Type::NeighborAdvertisement";
+    case demo::Icmp6Type::Version2MulticastListenerReport:
+        return ostream << "Icmp6Type::Version2MulticastListenerReport";
+    }
+    return ostream << "Icmp6Type(" << unsigned(ToUnderlying(icmp6Type)) << ")";
+}
+
+std::ostream& operator<<(std::ostream& ostream, const Icmp6Header& icmp6Header)
+{
+    return ostream << "Icmp6Header(type=" << icmp6Header.type << ",code=" << static_cast<int>(icmp6Header.code)
+                   << ",checksum=" << icmp6Header.checksum << ")";
+}
+
+} // namespace demo
@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <iosfwd>
+#include <cstdint>
+
+#include "FieldLayout.hpp"
+#include "ReadUintBe.hpp"
+#include "ParseResult.hpp"
+#include "EthernetAddress.hpp"
+#include "Ip6Address.hpp"
+
+namespace demo {
+
+enum struct Icmp6Type : std::uint8_t
+{
+    PacketTooBig = 2,
+    MulticastListenerQuery = 130,
+    MulticastListenerReport = 131,
+    MulticastListenerDone = 132,
+    NeighborSolicitation = 135,
+    NeighborAdvertisement = 136,
+    Version2MulticastListenerReport = 143,
+};
+
+namespace layout {
+
+// The header of packet too big messages (RFC 4443), followed by as much of the offending packet as fits into the
+// minimum IPv6 MTU
+struct Icmp6PacketTooBig
+{
+    static constexpr std::size_t size = 8;
+    using Type = FieldBe<0, Icmp6Type>;
+    using Code = FieldBe<1, std::uint8_t>;
+    using Checksum = FieldBe<2, std::uint16_t>;
+    using Mtu = FieldBe<4, std::uint32_t>;
+};
+static_assert(FieldsFitLayout<Icmp6PacketTooBig, Icmp6PacketTooBig::Type, Icmp6PacketTooBig::Code,
+                              Icmp6PacketTooBig::Checksum, Icmp6PacketTooBig::Mtu>);
+
+// Neighbor solicitation (RFC 4861, 4.3), followed by options
+struct Icmp6NeighborSolicitation
+{
+    static constexpr std::size_t size = 24;
+    using Type = FieldBe<0, Icmp6Type>;
+    using Code = FieldBe<1, std::uint8_t>;
+    using Checksum = FieldBe<2, std::uint16_t>;
+    using TargetAddress = AddressField<8, Ip6Address>;
+};
+static_assert(FieldsFitLayout<Icmp6NeighborSolicitation, Icmp6NeighborSolicitation::Type,
+                              Icmp6NeighborSolicitation::Code, Icmp6NeighborSolicitation::Checksum,
+                              Icmp6NeighborSolicitation::TargetAddress>);
+
+// Neighbor advertisement (RFC 4861, 4.4), followed by options
+struct Icmp6NeighborAdvertisement
+{
+    static constexpr std::size_t size = 24;
+    using Type = FieldBe<0, Icmp6Type>;
+    using Code = FieldBe<1, std::uint8_t>;
+    using Checksum = FieldBe<2, std::uint16_t>;
+    using Flags = FieldBe<4, std::uint32_t>;
+    using Router = BitFieldBe<4, std::uint8_t, 7, 1, bool>;
+    using Solicited = BitFieldBe<4, std::uint8_t, 6, 1, bool>;
+    using Override = BitFieldBe<4, std::uint8_t, 5, 1, bool>;
+    using TargetAddress = AddressField<8, Ip6Address>;
+};
+static_assert(FieldsFitLayout<Icmp6NeighborAdvertisement, Icmp6NeighborAdvertisement::Type,
+                              Icmp6NeighborAdvertisement::Code, Icmp6NeighborAdvertisement::Checksum,
+                              Icmp6NeighborAdvertisement::Flags, Icmp6NeighborAdvertisement::Router,
+                              Icmp6NeighborAdvertisement::Solicited, Icmp6NeighborAdvertisement::Override,
+                              Icmp6NeighborAdvertisement::TargetAddress>);
+
+// The source or target link-layer address option of neighbor discovery messages on Ethernet (RFC 4861, 4.6.1)
+struct NdpLinkLayerAddressOption
+{
+    static constexpr std::size_t size = 8;
+    using Type = FieldBe<0, std::uint8_t>;
+    using Length = FieldBe<1, std::uint8_t>; // in units of 8 bytes
+    using Address = AddressField<2, EthernetAddress>;
+};
+static_assert(FieldsFitLayout<NdpLinkLayerAddressOption, NdpLinkLayerAddressOption::Type,
+                              NdpLinkLayerAddressOption::Length, NdpLinkLayerAddressOption::Address>);
+
+} // namespace layout
+
+enum struct NdpOptionType : std::uint8_t
+{
+    SourceLinkLayerAddress = 1,
+    TargetLinkLayerAddress = 2,
+};
+
+struct Icmp6Header
+{
+    Icmp6Type type;
+    std::uint8_t code;
+    std::uint16_t checksum;
+};
+
+inline auto ParseIcmp6Header(asio::const_buffer data) -> ParseResult<Icmp6Header>
+{
+    const auto type = ReadUintBe<Icmp6Type>(data + 0);
+    const auto code = ReadUintBe<std::uint8_t>(data + 1);
+    const auto checksum = ReadUintBe<std::uint16_t>(data + 2);
+
+    return {
+        Icmp6Header{
+            type,
+            code,
+            checksum,
+        },
+        data + 4,
+    };
+}
+
+std::ostream& operator<<(std::ostream& ostream, const Icmp6Type& icmp6Type);
+std::ostream& operator<<(std::ostream& ostream, const Icmp6Header& icmp6Header);
+
+} // namespace demo
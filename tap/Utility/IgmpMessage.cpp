@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "IgmpMessage.hpp"
+
+#include <ostream>
+
+#include "Enums.hpp"
+
+namespace demo {
+
+std::ostream& operator<<(std::ostream& ostream, const IgmpType& igmpType)
+{
+    switch (igmpType)
+    {
+    case demo::IgmpType::MembershipQuery:
+        return ostream << "IgmpType::MembershipQuery";
+    case demo::IgmpType::V1MembershipReport:
+        return ostream << "IgmpType::V1MembershipReport";
+    case demo::IgmpType::V2MembershipReport:
+        return ostream << "IgmpType::V2MembershipReport";
+    case demo::IgmpType::V2LeaveGroup:
+        return ostream << "IgmpType::V2LeaveGroup";
+    case demo::IgmpType::V3MembershipReport:
+        return ostream << "IgmpType::V3MembershipReport";
+    }
+    return ostream << "IgmpType(" << unsigned(ToUnderlying(igmpType)) << ")";
+}
+
+std::ostream& operator<<(std::ostream& ostream, const MulticastRecordType& recordType)
+{
+    switch (recordType)
+    {
+    case demo::MulticastRecordType::ModeIsInclude:
+        return ostream << "MulticastRecordType::ModeIsInclude";
+    case demo::MulticastRecordType::ModeIsExclude:
+        return ostream << "MulticastRecordType::ModeIsExclude";
+    case demo::MulticastRecordType::ChangeToIncludeMode:
+        return ostream << "MulticastRecordType::ChangeToIncludeMode";
+    case demo::MulticastRecordType::ChangeToExcludeMode:
+        return ostream << "MulticastRecordType::ChangeToExcludeMode";
+    case demo::MulticastRecordType::AllowNewSources:
+        return ostream << "MulticastRecordType::AllowNewSources";
+    case demo::MulticastRecordType::BlockOldSources:
+        return ostream << "MulticastRecordType::BlockOldSources";
+    }
+    return ostream << "MulticastRecordType(" << unsigned(ToUnderlying(recordType)) << ")";
+}
+
+std::ostream& operator<<(std::ostream& ostream, const IgmpHeader& igmpHeader)
+{
+    ostream << "IgmpHeader(type=" << igmpHeader.type << ",maxResponseCode=" << unsigned(igmpHeader.maxResponseCode)
+            << ",checksum=" << igmpHeader.checksum;
+    if (igmpHeader.type == IgmpType::V3MembershipReport)
+    {
+        ostream << ",numberOfGroupRecords=" << igmpHeader.numberOfGroupRecords;
+    }
+    else
+    {
+        ostream << ",groupAddress=" << igmpHeader.groupAddress;
+    }
+    return ostream << ")";
+}
+
+std::ostream& operator<<(std::ostream& ostream, const Igmp3GroupRecord& groupRecord)
+{
+    return ostream << "Igmp3GroupRecord(recordType=" << groupRecord.recordType
+                   << ",numberOfSources=" << groupRecord.numberOfSources
+                   << ",multicastAddress=" << groupRecord.multicastAddress << ")";
+}
+
+} // namespace demo
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <iosfwd>
+#include <cstdint>
+
+#include "ReadUintBe.hpp"
+#include "ParseResult.hpp"
+#include "Ip4Address.hpp"
+
+#include "common/Exceptions.hpp"
+
+namespace demo {
+
+enum struct IgmpType : std::uint8_t
+{
+    MembershipQuery = 0x11,
+    V1MembershipReport = 0x12,
+    V2MembershipReport = 0x16,
+    V2LeaveGroup = 0x17,
+    V3MembershipReport = 0x22,
+};
+
+// Group record types of IGMPv3 (RFC 3376, 4.2.12), reused by MLDv2 (RFC 3810, 5.2.12)
+enum struct MulticastRecordType : std::uint8_t
+{
+    ModeIsInclude = 1,
+    ModeIsExclude = 2,
+    ChangeToIncludeMode = 3,
+    ChangeToExcludeMode = 4,
+    AllowNewSources = 5,
+    BlockOldSources = 6,
+};
+
+struct IgmpHeader
+{
+    IgmpType type;
+    std::uint8_t maxResponseCode;
+    std::uint16_t checksum;
+    // unset for IGMPv3 membership reports, which carry group records instead
+    Ip4Address groupAddress;
+    // only set for IGMPv3 membership reports
+    std::uint16_t numberOfGroupRecords;
+};
+
+struct Igmp3GroupRecord
+{
+    MulticastRecordType recordType;
+    std::uint16_t numberOfSources;
+    Ip4Address multicastAddress;
+};
+
+inline auto ParseIgmpHeader(asio::const_buffer data) -> ParseResult<IgmpHeader>
+{
+    IgmpHeader igmpHeader = {};
+
+    igmpHeader.type = ReadUintBe<IgmpType>(data + 0);
+    igmpHeader.maxResponseCode = ReadUintBe<std::uint8_t>(data + 1);
+    igmpHeader.checksum = ReadUintBe<std::uint16_t>(data + 2);
+
+    if (igmpHeader.type == IgmpType::V3MembershipReport)
+    {
+        igmpHeader.numberOfGroupRecords = ReadUintBe<std::uint16_t>(data + 6);
+    }
+    else
+    {
+        igmpHeader.groupAddress = ReadIp4Address(data + 4);
+    }
+
+    return {igmpHeader, data + 8};
+}
+
+// Parses one IGMPv3 group record, the remaining buffer starts at the next record.
+inline auto ParseIgmp3GroupRecord(asio::const_buffer data) -> ParseResult<Igmp3GroupRecord>
+{
+    const auto recordType = ReadUintBe<MulticastRecordType>(data + 0);
+    const auto auxDataLength = std::size_t(ReadUintBe<std::uint8_t>(data + 1)) * 4;
+    const auto numberOfSources = ReadUintBe<std::uint16_t>(data + 2);
+    const auto multicastAddress = ReadIp4Address(data + 4);
+
+    const auto recordLength = 8 + std::size_t(numberOfSources) * 4 + auxDataLength;
+    if (data.size() < recordLength)
+    {
+        throw adapters::InvalidBufferSize{};
+    }
+
+    return {
+        Igmp3GroupRecord{
+            recordType,
+            numberOfSources,
+            multicastAddress,
+        },
+        data + recordLength,
+    };
+}
+
+std::ostream& operator<<(std::ostream& ostream, const IgmpType& igmpType);
+std::ostream& operator<<(std::ostream& ostream, const MulticastRecordType& recordType);
+std::ostream& operator<<(std::ostream& ostream, const IgmpHeader& igmpHeader);
+std::ostream& operator<<(std::ostream& ostream, const Igmp3GroupRecord& groupRecord);
+
+} // namespace demo
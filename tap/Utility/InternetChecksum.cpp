@@ -2,3 +2,192 @@
 // SPDX-License-Identifier: MIT
 
 #include "InternetChecksum.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if DEMO_INTERNET_CHECKSUM_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DEMO_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DEMO_TARGET_AVX2
+#endif
+
+namespace demo {
+namespace detail {
+
+namespace {
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool hostIsLittleEndian = false;
+#else
+constexpr bool hostIsLittleEndian = true;
+#endif
+
+auto Fold(std::uint64_t sum) -> std::uint16_t
+{
+    while ((sum >> 16u) != 0)
+    {
+        sum = (sum & 0xFFFFu) + (sum >> 16u);
+    }
+    return static_cast<std::uint16_t>(sum);
+}
+
+} // namespace
+
+auto SumWordsScalar(const std::uint8_t* data, std::size_t size) -> std::uint64_t
+{
+    // 32-bit halves of 64-bit words: 2^32 additions of at most 2^32 - 1 do not overflow the accumulator, and
+    // 2^16 * high + low is congruent to high + low modulo 0xFFFF
+    std::uint64_t sum = 0;
+    for (; size >= 8; data += 8, size -= 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        sum += (word & 0xFFFFFFFFu) + (word >> 32u);
+    }
+    for (; size >= 2; data += 2, size -= 2)
+    {
+        std::uint16_t word;
+        std::memcpy(&word, data, sizeof(word));
+        sum += word;
+    }
+    return sum;
+}
+
+#if DEMO_INTERNET_CHECKSUM_X86
+
+namespace {
+
+// 32-bit lanes take at most one word per vector, they are moved into the 64-bit accumulator before they can
+// overflow
+constexpr std::size_t vectorsPerFlush = 65536;
+
+} // namespace
+
+auto SumWordsSse2(const std::uint8_t* data, std::size_t size) -> std::uint64_t
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum64 = _mm_setzero_si128();
+
+    while (size >= 16)
+    {
+        const std::size_t vectorCount = std::min(size / 16, vectorsPerFlush);
+        // two accumulators, so that the additions of consecutive vectors do not wait for each other
+        __m128i sumLow = _mm_setzero_si128();
+        __m128i sumHigh = _mm_setzero_si128();
+        for (std::size_t vectorIndex = 0; vectorIndex < vectorCount; ++vectorIndex)
+        {
+            const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + vectorIndex * 16));
+            sumLow = _mm_add_epi32(sumLow, _mm_unpacklo_epi16(words, zero));
+            sumHigh = _mm_add_epi32(sumHigh, _mm_unpackhi_epi16(words, zero));
+        }
+        data += vectorCount * 16;
+        size -= vectorCount * 16;
+
+        sum64 = _mm_add_epi64(sum64, _mm_unpacklo_epi32(sumLow, zero));
+        sum64 = _mm_add_epi64(sum64, _mm_unpackhi_epi32(sumLow, zero));
+        sum64 = _mm_add_epi64(sum64, _mm_unpacklo_epi32(sumHigh, zero));
+        sum64 = _mm_add_epi64(sum64, _mm_unpackhi_epi32(sumHigh, zero));
+    }
+
+    std::uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sum64);
+    return lanes[0] + lanes[1] + SumWordsScalar(data, size);
+}
+
+DEMO_TARGET_AVX2 auto SumWordsAvx2(const std::uint8_t* data, std::size_t size) -> std::uint64_t
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i sum64 = _mm256_setzero_si256();
+
+    while (size >= 32)
+    {
+        const std::size_t vectorCount = std::min(size / 32, vectorsPerFlush);
+        __m256i sumLow = _mm256_setzero_si256();
+        __m256i sumHigh = _mm256_setzero_si256();
+        for (std::size_t vectorIndex = 0; vectorIndex < vectorCount; ++vectorIndex)
+        {
+            const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + vectorIndex * 32));
+            sumLow = _mm256_add_epi32(sumLow, _mm256_unpacklo_epi16(words, zero));
+            sumHigh = _mm256_add_epi32(sumHigh, _mm256_unpackhi_epi16(words, zero));
+        }
+        data += vectorCount * 32;
+        size -= vectorCount * 32;
+
+        sum64 = _mm256_add_epi64(sum64, _mm256_unpacklo_epi32(sumLow, zero));
+        sum64 = _mm256_add_epi64(sum64, _mm256_unpackhi_epi32(sumLow, zero));
+        sum64 = _mm256_add_epi64(sum64, _mm256_unpacklo_epi32(sumHigh, zero));
+        sum64 = _mm256_add_epi64(sum64, _mm256_unpackhi_epi32(sumHigh, zero));
+    }
+
+    std::uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), sum64);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + SumWordsSse2(data, size);
+}
+
+auto IsAvx2Supported() -> bool
+{
+#if defined(_MSC_VER)
+    int registers[4];
+    __cpuid(registers, 0);
+    if (registers[0] < 7)
+    {
+        return false;
+    }
+    // AVX (ECX bit 28) and OSXSAVE (ECX bit 27), and the OS saves the XMM and YMM registers, before AVX2 (EBX
+    // bit 5 of leaf 7) counts
+    __cpuid(registers, 1);
+    const bool avxSupported = (registers[2] & (1 << 28)) != 0;
+    const bool osSavesAvxState = (registers[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(registers, 7, 0);
+    return avxSupported && osSavesAvxState && (registers[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // DEMO_INTERNET_CHECKSUM_X86
+
+auto GetSumWords() -> SumWordsFunction
+{
+#if DEMO_INTERNET_CHECKSUM_X86
+    // SSE2 is part of x86-64
+    static const SumWordsFunction sumWords = IsAvx2Supported() ? &SumWordsAvx2 : &SumWordsSse2;
+#else
+    static const SumWordsFunction sumWords = &SumWordsScalar;
+#endif
+    return sumWords;
+}
+
+auto GetSumWordsName() -> const char*
+{
+#if DEMO_INTERNET_CHECKSUM_X86
+    return GetSumWords() == &SumWordsAvx2 ? "avx2" : "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+auto SumBytePairs(const std::uint8_t* data, std::size_t size) -> std::uint16_t
+{
+    assert(size % 2 == 0);
+
+    // The ones' complement sum is independent of the byte order (RFC 1071), the sum of the words in host byte
+    // order only needs to be swapped once
+    const auto sum = Fold(GetSumWords()(data, size));
+    if (hostIsLittleEndian)
+    {
+        return static_cast<std::uint16_t>((sum << 8u) | (sum >> 8u));
+    }
+    return sum;
+}
+
+} // namespace detail
+} // namespace demo
@@ -3,16 +3,42 @@
 
 #pragma once
 
-#include <optional>
 #include <cstdint>
 #include <cassert>
+#include <initializer_list>
 
 #include "ReadUintBe.hpp"
 
 #include "asio/ts/buffer.hpp"
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define DEMO_INTERNET_CHECKSUM_X86 1
+#endif
+
 namespace demo {
 
+namespace detail {
+
+// Sums the 16-bit words of data in host byte order, size must be even. The result is not folded, it is congruent
+// to the ones' complement sum of the words modulo 0xFFFF.
+using SumWordsFunction = auto (*)(const std::uint8_t* data, std::size_t size) -> std::uint64_t;
+
+auto SumWordsScalar(const std::uint8_t* data, std::size_t size) -> std::uint64_t;
+#if DEMO_INTERNET_CHECKSUM_X86
+auto SumWordsSse2(const std::uint8_t* data, std::size_t size) -> std::uint64_t;
+auto SumWordsAvx2(const std::uint8_t* data, std::size_t size) -> std::uint64_t;
+auto IsAvx2Supported() -> bool;
+#endif
+
+// The implementation for this CPU, selected at the first call
+auto GetSumWords() -> SumWordsFunction;
+auto GetSumWordsName() -> const char*;
+
+// The ones' complement sum of the big-endian 16-bit words of data, size must be even
+auto SumBytePairs(const std::uint8_t* data, std::size_t size) -> std::uint16_t;
+
+} // namespace detail
+
 class InternetChecksum
 {
 public:
@@ -23,17 +49,25 @@ public:
             return;
         }
 
-        if (_partial)
+        if (_hasPartialByte)
         {
             AddByte(*static_cast<const std::uint8_t *>(buffer.data()));
             buffer += 1;
         }
 
         const std::size_t bytePairCount = buffer.size() / std::size_t(2);
-        for (std::size_t bytePairIndex = 0; bytePairIndex < bytePairCount; ++bytePairIndex)
+        const auto bytes = static_cast<const std::uint8_t *>(buffer.data());
+        if (bytePairCount >= vectorizedBytePairCount)
         {
-            const auto bytes = static_cast<const std::uint8_t *>(buffer.data());
-            AddPair(bytes[bytePairIndex * 2 + 0], bytes[bytePairIndex * 2 + 1]);
+            _accumulator += detail::SumBytePairs(bytes, bytePairCount * 2);
+        }
+        else
+        {
+            // short headers and fields, not worth a call
+            for (std::size_t bytePairIndex = 0; bytePairIndex < bytePairCount; ++bytePairIndex)
+            {
+                AddPair(bytes[bytePairIndex * 2 + 0], bytes[bytePairIndex * 2 + 1]);
+            }
         }
         buffer += bytePairCount * 2;
 
@@ -48,21 +82,59 @@ public:
 
     [[nodiscard]] std::uint16_t GetChecksum() const
     {
-        const std::uint64_t accumulator = _accumulator + (_partial.value_or(0) << 8u);
-        return ~(std::uint16_t(accumulator >> 16u) + std::uint16_t(accumulator));
+        std::uint64_t accumulator = _accumulator + (std::uint64_t{_partialByte} << 8u);
+        while ((accumulator >> 16u) != 0)
+        {
+            accumulator = (accumulator & 0xFFFFu) + (accumulator >> 16u);
+        }
+        return static_cast<std::uint16_t>(~accumulator);
+    }
+
+    /// <summary>
+    /// Validates a checksum in one pass: the buffers include the transmitted checksum field (and the pseudo
+    /// header, if any), which makes the checksum over all of them zero if they are intact.
+    /// </summary>
+    [[nodiscard]] static auto Verify(std::initializer_list<asio::const_buffer> buffers) -> bool
+    {
+        InternetChecksum checksum;
+        for (const auto& buffer : buffers)
+        {
+            checksum.AddBuffer(buffer);
+        }
+        return checksum.GetChecksum() == 0;
+    }
+
+    /// <summary>
+    /// Updates a checksum for a changed 16-bit word of the data it covers, without summing the data again
+    /// (RFC 1624, equation 3). Words are in host byte order, as loaded by LoadBe.
+    /// </summary>
+    [[nodiscard]] static auto Update(std::uint16_t checksum, std::uint16_t oldWord, std::uint16_t newWord)
+        -> std::uint16_t
+    {
+        std::uint32_t sum = static_cast<std::uint16_t>(~checksum);
+        sum += static_cast<std::uint16_t>(~oldWord);
+        sum += newWord;
+        sum = (sum & 0xFFFFu) + (sum >> 16u);
+        sum = (sum & 0xFFFFu) + (sum >> 16u);
+        return static_cast<std::uint16_t>(~sum);
     }
 
 private:
+    // buffers with at least this many byte pairs are summed by the vectorized implementation
+    static constexpr std::size_t vectorizedBytePairCount = 16;
+
     void AddByte(const std::uint8_t x)
     {
-        if (_partial)
+        if (_hasPartialByte)
         {
-            AddPair(*_partial, x);
-            _partial.reset();
+            AddPair(_partialByte, x);
+            _partialByte = 0;
+            _hasPartialByte = false;
         }
         else
         {
-            _partial = x;
+            _partialByte = x;
+            _hasPartialByte = true;
         }
     }
 
@@ -73,7 +145,10 @@ private:
 
 private:
     std::uint64_t _accumulator = 0;
-    std::optional<std::uint8_t> _partial;
+    // the odd last byte of the previous buffer, 0 without one, as a std::optional trips -Wmaybe-uninitialized
+    // of GCC once AddBuffer is inlined into a loop
+    std::uint8_t _partialByte = 0;
+    bool _hasPartialByte = false;
 };
 
-} // namespace demo
\ No newline at end of file
+} // namespace demo
@@ -13,6 +13,8 @@ std::ostream& operator<<(std::ostream& ostream, const Ip4Protocol& protocol)
     {
     case demo::Ip4Protocol::ICMP:
         return ostream << "Ip4Protocol::ICMP";
+    case demo::Ip4Protocol::IGMP:
+        return ostream << "Ip4Protocol::IGMP";
     case demo::Ip4Protocol::TCP:
         return ostream << "Ip4Protocol::TCP";
     case demo::Ip4Protocol::UDP:
@@ -6,10 +6,9 @@
 #include <iosfwd>
 #include <cstdint>
 
-#include "BufferWriter.hpp"
-#include "BufferReader.hpp"
+#include "FieldLayout.hpp"
+#include "InternetChecksum.hpp"
 #include "ReadUintBe.hpp"
-#include "WriteUintBe.hpp"
 #include "ParseResult.hpp"
 #include "EthernetAddress.hpp"
 #include "EthernetHeader.hpp"
@@ -22,10 +21,39 @@ namespace demo {
 enum struct Ip4Protocol : std::uint8_t
 {
     ICMP = 1,
+    IGMP = 2,
     TCP = 6,
     UDP = 17,
 };
 
+namespace layout {
+
+// The IPv4 header without options (RFC 791)
+struct Ip4
+{
+    static constexpr std::size_t size = 20;
+    using Version = BitFieldBe<0, std::uint8_t, 4, 4>;
+    using HeaderLength = BitFieldBe<0, std::uint8_t, 0, 4>; // in 32-bit words
+    using TypeOfService = FieldBe<1, std::uint8_t>;
+    using TotalLength = FieldBe<2, std::uint16_t>;
+    using Identification = FieldBe<4, std::uint16_t>;
+    using FlagsAndFragmentOffset = FieldBe<6, std::uint16_t>;
+    using DontFragment = BitFieldBe<6, std::uint16_t, 14, 1, bool>;
+    using MoreFragments = BitFieldBe<6, std::uint16_t, 13, 1, bool>;
+    using FragmentOffset = BitFieldBe<6, std::uint16_t, 0, 13>;
+    using TimeToLive = FieldBe<8, std::uint8_t>;
+    using Protocol = FieldBe<9, Ip4Protocol>;
+    using Checksum = FieldBe<10, std::uint16_t>;
+    using SourceAddress = AddressField<12, Ip4Address>;
+    using DestinationAddress = AddressField<16, Ip4Address>;
+};
+static_assert(FieldsFitLayout<Ip4, Ip4::Version, Ip4::HeaderLength, Ip4::TypeOfService, Ip4::TotalLength,
+                              Ip4::Identification, Ip4::FlagsAndFragmentOffset, Ip4::DontFragment, Ip4::MoreFragments,
+                              Ip4::FragmentOffset, Ip4::TimeToLive, Ip4::Protocol, Ip4::Checksum, Ip4::SourceAddress,
+                              Ip4::DestinationAddress>);
+
+} // namespace layout
+
 struct Ip4Header
 {
     std::uint16_t totalLength;
@@ -42,63 +70,49 @@ struct Ip4Header
 
 inline auto ParseIp4Header(asio::const_buffer data) -> ParseResult<Ip4Header>
 {
-    auto reader = BufferReader{data};
-
-    const auto byte0 = reader.ReadBe<std::uint8_t>();
-    const std::uint8_t ipVersion = (byte0 & 0xF0) >> 4u;
-    const std::uint32_t internetHeaderLength = (byte0 & 0x0F) * 4u;
+    using Ip4 = layout::Ip4;
+    if (data.size() == 0)
+    {
+        throw adapters::InvalidBufferSize{};
+    }
+    const auto bytes = static_cast<const std::uint8_t*>(data.data());
 
-    if (ipVersion != 4)
+    if (Ip4::Version::Load(bytes) != 4)
     {
         throw adapters::InvalidIp4PacketError{};
     }
 
-    if (internetHeaderLength < 20 || internetHeaderLength > 60 || data.size() < internetHeaderLength)
+    const std::size_t internetHeaderLength = Ip4::HeaderLength::Load(bytes) * 4u;
+    if (internetHeaderLength < Ip4::size || internetHeaderLength > 60 || data.size() < internetHeaderLength)
     {
         throw adapters::InvalidIp4PacketError{};
     }
 
-    // NOTE: We ignore byte1 (typeOfService)
-    (void)reader.ReadBe<std::uint8_t>();
+    // NOTE: We ignore the type of service
 
-    const auto totalLength = reader.ReadBe<std::uint16_t>();
+    const auto totalLength = Ip4::TotalLength::Load(bytes);
     if (internetHeaderLength <= totalLength && data.size() < totalLength)
     {
         throw adapters::InvalidIp4PacketError{};
     }
 
-    const auto identification = reader.ReadBe<std::uint16_t>();
-
-    const auto flagsAndFragmentOffset = reader.ReadBe<std::uint16_t>();
-    if ((flagsAndFragmentOffset & 0b001) != 0)
+    if ((Ip4::FlagsAndFragmentOffset::Load(bytes) & 0b001) != 0)
     {
         throw adapters::InvalidIp4PacketError{};
     }
 
-    const bool dontFragment = (flagsAndFragmentOffset & 0b0100'0000'0000'0000) != 0;
-    const bool moreFragments = (flagsAndFragmentOffset & 0b0010'0000'0000'0000) != 0;
-
-    const std::uint16_t fragmentOffset = flagsAndFragmentOffset & 0b0001'1111'1111'1111;
-
-    const auto timeToLive = reader.ReadBe<std::uint8_t>();
-    const auto protocol = reader.ReadBe<Ip4Protocol>();
-    const auto checksum = reader.ReadBe<std::uint16_t>();
-    Ip4Address sourceAddress, destinationAddress;
-    reader.ReadInto(asio::buffer(sourceAddress.data));
-    reader.ReadInto(asio::buffer(destinationAddress.data));
-
     return {
         Ip4Header{
             totalLength,
-            identification,
-            dontFragment,
-            moreFragments,
-            fragmentOffset,
-            timeToLive,
-            protocol,
-            checksum,
-            sourceAddress,
-            destinationAddress,
+            Ip4::Identification::Load(bytes),
+            Ip4::DontFragment::Load(bytes),
+            Ip4::MoreFragments::Load(bytes),
+            Ip4::FragmentOffset::Load(bytes),
+            Ip4::TimeToLive::Load(bytes),
+            Ip4::Protocol::Load(bytes),
+            Ip4::Checksum::Load(bytes),
+            Ip4::SourceAddress::Load(bytes),
+            Ip4::DestinationAddress::Load(bytes),
         },
         data + internetHeaderLength,
     };
@@ -106,23 +120,96 @@ inline auto ParseIp4Header(asio::const_buffer data) -> ParseResult<Ip4Header>
 
 inline auto WriteIp4Header(const asio::mutable_buffer target, const Ip4Header &ip4Header) -> std::size_t
 {
-    BufferWriter writer{target};
-
-    writer.WriteBe(std::uint8_t((4u << 4u) | (20u / 4u)));
-    writer.WriteBe(std::uint8_t(0)); // Type of Service / DSCP+ECN
-    writer.WriteBe(ip4Header.totalLength);
-    writer.WriteBe(ip4Header.identification);
-    writer.WriteBe(
-        std::uint16_t((ip4Header.dontFragment << 14u) | (ip4Header.moreFragments << 13u) | ip4Header.fragmentOffset));
-    writer.WriteBe(ip4Header.timeToLive);
-    writer.WriteBe(ip4Header.protocol);
-    const auto checksumOffset = writer.WriteBe(std::uint16_t(0)); // checksum
-    writer.Write(asio::buffer(ip4Header.sourceAddress.data));
-    writer.Write(asio::buffer(ip4Header.destinationAddress.data));
-
-    writer.PutBe(checksumOffset, writer.GetChecksum());
-
-    return writer.GetOffset();
+    using Ip4 = layout::Ip4;
+    CheckLayoutSize<Ip4>(target);
+    const auto bytes = static_cast<std::uint8_t *>(target.data());
+
+    Ip4::FlagsAndFragmentOffset::Store(bytes, 0);
+    Ip4::Version::Store(bytes, 4);
+    Ip4::HeaderLength::Store(bytes, Ip4::size / 4u);
+    Ip4::TypeOfService::Store(bytes, 0); // DSCP+ECN
+    Ip4::TotalLength::Store(bytes, ip4Header.totalLength);
+    Ip4::Identification::Store(bytes, ip4Header.identification);
+    Ip4::DontFragment::Store(bytes, ip4Header.dontFragment);
+    Ip4::MoreFragments::Store(bytes, ip4Header.moreFragments);
+    Ip4::FragmentOffset::Store(bytes, ip4Header.fragmentOffset);
+    Ip4::TimeToLive::Store(bytes, ip4Header.timeToLive);
+    Ip4::Protocol::Store(bytes, ip4Header.protocol);
+    Ip4::Checksum::Store(bytes, 0);
+    Ip4::SourceAddress::Store(bytes, ip4Header.sourceAddress);
+    Ip4::DestinationAddress::Store(bytes, ip4Header.destinationAddress);
+
+    InternetChecksum checksum;
+    checksum.AddBuffer(asio::buffer(bytes, Ip4::size));
+    Ip4::Checksum::Store(bytes, checksum.GetChecksum());
+
+    return Ip4::size;
+}
+
+// Validates the header checksum of the IPv4 packet in data. Returns false for a truncated header.
+inline auto VerifyIp4HeaderChecksum(asio::const_buffer data) -> bool
+{
+    if (!FitsLayout<layout::Ip4>(data))
+    {
+        return false;
+    }
+    const std::size_t internetHeaderLength =
+        layout::Ip4::HeaderLength::Load(static_cast<const std::uint8_t *>(data.data())) * 4u;
+    if (internetHeaderLength < layout::Ip4::size || data.size() < internetHeaderLength)
+    {
+        return false;
+    }
+    return InternetChecksum::Verify({asio::buffer(data, internetHeaderLength)});
+}
+
+// Validates the checksum of the ICMP, UDP or TCP payload of the IPv4 packet in data, including the pseudo header
+// for UDP and TCP. Padding after the total length (of minimum size Ethernet frames) is ignored. Returns true for
+// other protocols, for fragments (the checksum covers the reassembled datagram) and for UDP without checksum.
+inline auto VerifyIp4PayloadChecksum(asio::const_buffer data) -> bool
+{
+    if (!FitsLayout<layout::Ip4>(data))
+    {
+        return false;
+    }
+    const auto bytes = static_cast<const std::uint8_t *>(data.data());
+    const std::size_t internetHeaderLength = layout::Ip4::HeaderLength::Load(bytes) * 4u;
+    const std::size_t totalLength = layout::Ip4::TotalLength::Load(bytes);
+    if (internetHeaderLength < layout::Ip4::size || totalLength < internetHeaderLength || data.size() < totalLength)
+    {
+        return false;
+    }
+    if (layout::Ip4::MoreFragments::Load(bytes) || layout::Ip4::FragmentOffset::Load(bytes) != 0)
+    {
+        return true;
+    }
+
+    const auto payload = asio::buffer(data + internetHeaderLength, totalLength - internetHeaderLength);
+    const auto protocol = layout::Ip4::Protocol::Load(bytes);
+    switch (protocol)
+    {
+    case Ip4Protocol::ICMP:
+        return InternetChecksum::Verify({payload});
+    case Ip4Protocol::UDP:
+    case Ip4Protocol::TCP:
+    {
+        const std::size_t checksumOffset = protocol == Ip4Protocol::UDP ? 6 : 16;
+        if (payload.size() < checksumOffset + 2)
+        {
+            return false;
+        }
+        if (protocol == Ip4Protocol::UDP && ReadUintBe<std::uint16_t>(payload + checksumOffset) == 0)
+        {
+            return true;
+        }
+        // source and destination address, zero, protocol, segment length
+        const std::uint8_t pseudoHeaderTail[4] = {0, bytes[9], static_cast<std::uint8_t>(payload.size() >> 8u),
+                                                  static_cast<std::uint8_t>(payload.size())};
+        return InternetChecksum::Verify({asio::buffer(data + layout::Ip4::SourceAddress::offset, 8),
+                                         asio::buffer(pseudoHeaderTail), payload});
+    }
+    default:
+        return true;
+    }
 }
 
 std::ostream &operator<<(std::ostream &ostream, const Ip4Protocol &protocol);
@@ -0,0 +1,17 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "Ip6Address.hpp"
+
+#include <ostream>
+
+#include "asio/ts/net.hpp"
+
+namespace demo {
+
+std::ostream& operator<<(std::ostream& ostream, const Ip6Address& ip6Address)
+{
+    return ostream << asio::ip::address_v6{ip6Address.data};
+}
+
+} // namespace demo
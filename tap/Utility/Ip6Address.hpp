@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <iosfwd>
+#include <cstdint>
+
+#include "common/Exceptions.hpp"
+
+#include "asio/ts/buffer.hpp"
+
+namespace demo {
+
+struct Ip6Address
+{
+    std::array<std::uint8_t, 16> data;
+};
+
+inline bool operator==(const Ip6Address& lhs, const Ip6Address& rhs)
+{
+    return lhs.data == rhs.data;
+}
+
+inline auto ReadIp6Address(asio::const_buffer buffer) -> Ip6Address
+{
+    Ip6Address address = {};
+    if (asio::buffer_copy(asio::buffer(address.data), buffer) != 16)
+    {
+        throw adapters::InvalidBufferSize{};
+    }
+    return address;
+}
+
+inline auto WriteIp6Address(asio::mutable_buffer target, const Ip6Address& ip6Address) -> std::size_t
+{
+    if (asio::buffer_copy(target, asio::buffer(ip6Address.data)) != 16)
+    {
+        throw adapters::InvalidBufferSize{};
+    }
+    return 16;
+}
+
+std::ostream& operator<<(std::ostream& ostream, const Ip6Address& ip6Address);
+
+} // namespace demo
@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "Ip6Header.hpp"
+
+#include <ostream>
+
+#include "Enums.hpp"
+
+namespace demo {
+
+std::ostream& operator<<(std::ostream& ostream, const Ip6NextHeader& nextHeader)
+{
+    switch (nextHeader)
+    {
+    case demo::Ip6NextHeader::HopByHopOptions:
+        return ostream << "Ip6NextHeader::HopByHopOptions";
+    case demo::Ip6NextHeader::TCP:
+        return ostream << "Ip6NextHeader::TCP";
+    case demo::Ip6NextHeader::UDP:
+        return ostream << "Ip6NextHeader::UDP";
+    case demo::Ip6NextHeader::Routing:
+        return ostream << "Ip6NextHeader::Routing";
+    case demo::Ip6NextHeader::Fragment:
+        return ostream << "Ip6NextHeader::Fragment";
+    case demo::Ip6NextHeader::ICMPv6:
+        return ostream << "Ip6NextHeader::ICMPv6";
+    case demo::Ip6NextHeader::NoNextHeader:
+        return ostream << "Ip6NextHeader::NoNextHeader";
+    case demo::Ip6NextHeader::DestinationOptions:
+        return ostream << "Ip6NextHeader::DestinationOptions";
+    }
+    return ostream << "Ip6NextHeader(" << unsigned(ToUnderlying(nextHeader)) << ")";
+}
+
+std::ostream& operator<<(std::ostream& ostream, const Ip6Header& ip6Header)
+{
+    return ostream << "Ip6Header(payloadLength=" << ip6Header.payloadLength << ",nextHeader=" << ip6Header.nextHeader
+                   << ",hopLimit=" << unsigned(ip6Header.hopLimit) << ",sourceAddress=" << ip6Header.sourceAddress
+                   << ",destinationAddress=" << ip6Header.destinationAddress << ")";
+}
+
+} // namespace demo
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <iosfwd>
+#include <cstdint>
+
+#include "FieldLayout.hpp"
+#include "InternetChecksum.hpp"
+#include "ReadUintBe.hpp"
+#include "ParseResult.hpp"
+#include "Ip6Address.hpp"
+
+#include "common/Exceptions.hpp"
+
+namespace demo {
+
+enum struct Ip6NextHeader : std::uint8_t
+{
+    HopByHopOptions = 0,
+    TCP = 6,
+    UDP = 17,
+    Routing = 43,
+    Fragment = 44,
+    ICMPv6 = 58,
+    NoNextHeader = 59,
+    DestinationOptions = 60,
+};
+
+namespace layout {
+
+// The fixed IPv6 header (RFC 8200)
+struct Ip6
+{
+    static constexpr std::size_t size = 40;
+    using Version = BitFieldBe<0, std::uint32_t, 28, 4>;
+    using PayloadLength = FieldBe<4, std::uint16_t>;
+    using NextHeader = FieldBe<6, Ip6NextHeader>;
+    using HopLimit = FieldBe<7, std::uint8_t>;
+    using SourceAddress = AddressField<8, Ip6Address>;
+    using DestinationAddress = AddressField<24, Ip6Address>;
+};
+static_assert(FieldsFitLayout<Ip6, Ip6::Version, Ip6::PayloadLength, Ip6::NextHeader, Ip6::HopLimit,
+                              Ip6::SourceAddress, Ip6::DestinationAddress>);
+
+} // namespace layout
+
+struct Ip6Header
+{
+    std::uint16_t payloadLength;
+    Ip6NextHeader nextHeader;
+    std::uint8_t hopLimit;
+    Ip6Address sourceAddress;
+    Ip6Address destinationAddress;
+};
+
+inline auto ParseIp6Header(asio::const_buffer data) -> ParseResult<Ip6Header>
+{
+    using Ip6 = layout::Ip6;
+    CheckLayoutSize<Ip6>(data);
+    const auto bytes = static_cast<const std::uint8_t*>(data.data());
+
+    if (Ip6::Version::Load(bytes) != 6)
+    {
+        throw adapters::InvalidBufferSize{};
+    }
+
+    const auto payloadLength = Ip6::PayloadLength::Load(bytes);
+    const auto payload = data + Ip6::size;
+    if (payload.size() < payloadLength)
+    {
+        throw adapters::InvalidBufferSize{};
+    }
+
+    return {
+        Ip6Header{
+            payloadLength,
+            Ip6::NextHeader::Load(bytes),
+            Ip6::HopLimit::Load(bytes),
+            Ip6::SourceAddress::Load(bytes),
+            Ip6::DestinationAddress::Load(bytes),
+        },
+        asio::buffer(payload, payloadLength),
+    };
+}
+
+// Walks the extension header chain starting at nextHeader and returns the upper-layer protocol
+// together with its payload.
+inline auto SkipIp6ExtensionHeaders(Ip6NextHeader nextHeader, asio::const_buffer data) -> ParseResult<Ip6NextHeader>
+{
+    for (;;)
+    {
+        switch (nextHeader)
+        {
+        case Ip6NextHeader::HopByHopOptions:
+        case Ip6NextHeader::Routing:
+        case Ip6NextHeader::DestinationOptions:
+        {
+            const auto headerLength = (std::size_t(ReadUintBe<std::uint8_t>(data + 1)) + 1) * 8;
+            if (data.size() < headerLength)
+            {
+                throw adapters::InvalidBufferSize{};
+            }
+            nextHeader = ReadUintBe<Ip6NextHeader>(data);
+            data += headerLength;
+            break;
+        }
+        case Ip6NextHeader::Fragment:
+        {
+            if (data.size() < 8)
+            {
+                throw adapters::InvalidBufferSize{};
+            }
+            nextHeader = ReadUintBe<Ip6NextHeader>(data);
+            data += 8;
+            break;
+        }
+        default:
+            return {nextHeader, data};
+        }
+    }
+}
+
+// Computes the checksum of the ICMPv6, UDP or TCP packet following the IPv6 header, including the pseudo header
+// (RFC 8200, 8.1). Over a received packet with its checksum field, the result is 0 if the checksum is valid.
+inline auto ComputeIp6UpperLayerChecksum(const std::uint8_t* ip6Header, asio::const_buffer upperLayerPacket,
+                                         Ip6NextHeader nextHeader) -> std::uint16_t
+{
+    // source and destination address, upper-layer packet length, zero, next header
+    const auto length = static_cast<std::uint32_t>(upperLayerPacket.size());
+    const std::uint8_t pseudoHeaderTail[8] = {static_cast<std::uint8_t>(length >> 24u),
+                                              static_cast<std::uint8_t>(length >> 16u),
+                                              static_cast<std::uint8_t>(length >> 8u),
+                                              static_cast<std::uint8_t>(length),
+                                              0,
+                                              0,
+                                              0,
+                                              static_cast<std::uint8_t>(nextHeader)};
+    InternetChecksum checksum;
+    checksum.AddBuffer(asio::buffer(ip6Header + layout::Ip6::SourceAddress::offset, 32));
+    checksum.AddBuffer(asio::buffer(pseudoHeaderTail));
+    checksum.AddBuffer(upperLayerPacket);
+    return checksum.GetChecksum();
+}
+
+std::ostream& operator<<(std::ostream& ostream, const Ip6NextHeader& nextHeader);
+std::ostream& operator<<(std::ostream& ostream, const Ip6Header& ip6Header);
+
+} // namespace demo
@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "MldMessage.hpp"
+
+#include <ostream>
+
+namespace demo {
+
+std::ostream& operator<<(std::ostream& ostream, const Mld1Message& mld1Message)
+{
+    return ostream << "Mld1Message(maximumResponseDelay=" << mld1Message.maximumResponseDelay
+                   << ",multicastAddress=" << mld1Message.multicastAddress << ")";
+}
+
+std::ostream& operator<<(std::ostream& ostream, const Mld2GroupRecord& groupRecord)
+{
+    return ostream << "Mld2GroupRecord(recordType=" << groupRecord.recordType
+                   << ",numberOfSources=" << groupRecord.numberOfSources
+                   << ",multicastAddress=" << groupRecord.multicastAddress << ")";
+}
+
+} // namespace demo
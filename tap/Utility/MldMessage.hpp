@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <iosfwd>
+#include <cstdint>
+
+#include "ReadUintBe.hpp"
+#include "ParseResult.hpp"
+#include "Ip6Address.hpp"
+#include "IgmpMessage.hpp"
+
+#include "common/Exceptions.hpp"
+
+namespace demo {
+
+// Body of MLDv1 queries, reports and done messages following the ICMPv6 header (RFC 2710, 3)
+struct Mld1Message
+{
+    std::uint16_t maximumResponseDelay;
+    Ip6Address multicastAddress;
+};
+
+struct Mld2GroupRecord
+{
+    MulticastRecordType recordType;
+    std::uint16_t numberOfSources;
+    Ip6Address multicastAddress;
+};
+
+inline auto ParseMld1Message(asio::const_buffer data) -> ParseResult<Mld1Message>
+{
+    const auto maximumResponseDelay = ReadUintBe<std::uint16_t>(data + 0);
+    const auto multicastAddress = ReadIp6Address(data + 4);
+
+    return {
+        Mld1Message{
+            maximumResponseDelay,
+            multicastAddress,
+        },
+        data + 20,
+    };
+}
+
+// Returns the number of group records of an MLDv2 report, the remaining buffer starts at the first record.
+inline auto ParseMld2ReportHeader(asio::const_buffer data) -> ParseResult<std::uint16_t>
+{
+    return {ReadUintBe<std::uint16_t>(data + 2), data + 4};
+}
+
+// Parses one MLDv2 group record, the remaining buffer starts at the next record.
+inline auto ParseMld2GroupRecord(asio::const_buffer data) -> ParseResult<Mld2GroupRecord>
+{
+    const auto recordType = ReadUintBe<MulticastRecordType>(data + 0);
+    const auto auxDataLength = std::size_t(ReadUintBe<std::uint8_t>(data + 1)) * 4;
+    const auto numberOfSources = ReadUintBe<std::uint16_t>(data + 2);
+    const auto multicastAddress = ReadIp6Address(data + 4);
+
+    const auto recordLength = 20 + std::size_t(numberOfSources) * 16 + auxDataLength;
+    if (data.size() < recordLength)
+    {
+        throw adapters::InvalidBufferSize{};
+    }
+
+    return {
+        Mld2GroupRecord{
+            recordType,
+            numberOfSources,
+            multicastAddress,
+        },
+        data + recordLength,
+    };
+}
+
+std::ostream& operator<<(std::ostream& ostream, const Mld1Message& mld1Message);
+std::ostream& operator<<(std::ostream& ostream, const Mld2GroupRecord& groupRecord);
+
+} // namespace demo
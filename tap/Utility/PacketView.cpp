@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "PacketView.hpp"
+
+#include <ostream>
+
+namespace demo {
+
+std::ostream& operator<<(std::ostream& ostream, const ParseStatus& parseStatus)
+{
+    switch (parseStatus)
+    {
+    case demo::ParseStatus::Ok:
+        return ostream << "ParseStatus::Ok";
+    case demo::ParseStatus::Truncated:
+        return ostream << "ParseStatus::Truncated";
+    case demo::ParseStatus::InvalidVersion:
+        return ostream << "ParseStatus::InvalidVersion";
+    case demo::ParseStatus::InvalidHeaderLength:
+        return ostream << "ParseStatus::InvalidHeaderLength";
+    case demo::ParseStatus::InvalidLength:
+        return ostream << "ParseStatus::InvalidLength";
+    case demo::ParseStatus::Unsupported:
+        return ostream << "ParseStatus::Unsupported";
+    }
+    return ostream << "ParseStatus(" << unsigned(ToUnderlying(parseStatus)) << ")";
+}
+
+} // namespace demo
@@ -0,0 +1,739 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+
+#include "ArpIp4Packet.hpp"
+#include "EthernetAddress.hpp"
+#include "EthernetHeader.hpp"
+#include "Icmp4Header.hpp"
+#include "InternetChecksum.hpp"
+#include "Ip4Address.hpp"
+#include "Ip4Header.hpp"
+#include "SomeIpHeader.hpp"
+#include "TcpHeader.hpp"
+#include "UdpHeader.hpp"
+
+#include "asio/ts/buffer.hpp"
+
+// Views over the headers of a frame, the non-throwing counterpart of the Parse* functions for the hot path.
+//
+//   Parse validates the lengths of a header once and never throws, the view converts to false if the header is
+//   invalid and GetStatus tells why. The accessors of a valid view read their field from the original buffer on
+//   each call, nothing is copied or decoded up front. The accessors must not be called on an invalid view, and the
+//   buffer must outlive the view.
+
+namespace demo {
+
+enum struct ParseStatus : std::uint8_t
+{
+    Ok,
+    // the buffer is shorter than the header, or than the length the header announces
+    Truncated,
+    InvalidVersion,
+    InvalidHeaderLength,
+    InvalidLength,
+    // a valid header of a variant the view does not decode, e.g. ARP for other protocols than IPv4
+    Unsupported,
+};
+
+std::ostream& operator<<(std::ostream& ostream, const ParseStatus& parseStatus);
+
+// Ethernet II header, with an optional 802.1ad and an optional 802.1Q tag
+class EthernetView
+{
+public:
+    [[nodiscard]] static auto Parse(asio::const_buffer frame) -> EthernetView
+    {
+        using Ethernet = layout::Ethernet;
+        const auto data = static_cast<const std::uint8_t*>(frame.data());
+        if (!FitsLayout<Ethernet>(frame))
+        {
+            return EthernetView{ParseStatus::Truncated};
+        }
+
+        // each tag takes the place of the EtherType and moves it back by the size of a tag
+        std::uint8_t headerSize = Ethernet::size;
+        std::uint8_t vlanTag8021adOffset = 0;
+        std::uint8_t vlanTag8021qOffset = 0;
+        const auto skipVlanTag = [&](EtherType tpid, std::uint8_t& tagOffset) {
+            if (Ethernet::EtherType::Load(data + (headerSize - Ethernet::size)) != tpid)
+            {
+                return true;
+            }
+            tagOffset = static_cast<std::uint8_t>(headerSize - sizeof(EtherType));
+            headerSize += layout::VlanTag::size;
+            return frame.size() >= headerSize;
+        };
+        if (!skipVlanTag(EtherType::Vlan_802_1ad, vlanTag8021adOffset)
+            || !skipVlanTag(EtherType::Vlan_802_1q, vlanTag8021qOffset))
+        {
+            return EthernetView{ParseStatus::Truncated};
+        }
+        return EthernetView{frame, headerSize, vlanTag8021adOffset, vlanTag8021qOffset};
+    }
+
+    explicit operator bool() const
+    {
+        return _status == ParseStatus::Ok;
+    }
+
+    [[nodiscard]] auto GetStatus() const -> ParseStatus
+    {
+        return _status;
+    }
+
+    [[nodiscard]] auto GetDestination() const -> EthernetAddress
+    {
+        return layout::Ethernet::Destination::Load(Data());
+    }
+
+    [[nodiscard]] auto GetSource() const -> EthernetAddress
+    {
+        return layout::Ethernet::Source::Load(Data());
+    }
+
+    [[nodiscard]] auto HasVlanTag() const -> bool
+    {
+        return _vlanTag8021qOffset != 0;
+    }
+
+    // VLAN ID of the 802.1Q tag, requires HasVlanTag()
+    [[nodiscard]] auto GetVlanId() const -> std::uint16_t
+    {
+        return layout::VlanTag::VlanId::Load(Data() + _vlanTag8021qOffset);
+    }
+
+    [[nodiscard]] auto HasServiceVlanTag() const -> bool
+    {
+        return _vlanTag8021adOffset != 0;
+    }
+
+    // VLAN ID of the 802.1ad tag, requires HasServiceVlanTag()
+    [[nodiscard]] auto GetServiceVlanId() const -> std::uint16_t
+    {
+        return layout::VlanTag::VlanId::Load(Data() + _vlanTag8021adOffset);
+    }
+
+    [[nodiscard]] auto GetEtherType() const -> EtherType
+    {
+        return layout::Ethernet::EtherType::Load(Data() + (_headerSize - layout::Ethernet::size));
+    }
+
+    [[nodiscard]] auto GetHeaderSize() const -> std::size_t
+    {
+        return _headerSize;
+    }
+
+    [[nodiscard]] auto GetPayload() const -> asio::const_buffer
+    {
+        return _buffer + _headerSize;
+    }
+
+private:
+    explicit EthernetView(ParseStatus status)
+        : _status{status}
+    {
+    }
+
+    EthernetView(asio::const_buffer buffer, std::uint8_t headerSize, std::uint8_t vlanTag8021adOffset,
+                 std::uint8_t vlanTag8021qOffset)
+        : _buffer{buffer}
+        , _headerSize{headerSize}
+        , _vlanTag8021adOffset{vlanTag8021adOffset}
+        , _vlanTag8021qOffset{vlanTag8021qOffset}
+    {
+    }
+
+    auto Data() const -> const std::uint8_t*
+    {
+        return static_cast<const std::uint8_t*>(_buffer.data());
+    }
+
+    asio::const_buffer _buffer;
+    std::uint8_t _headerSize{0};
+    // 0 if the tag is absent, a tag never starts at offset 0
+    std::uint8_t _vlanTag8021adOffset{0};
+    std::uint8_t _vlanTag8021qOffset{0};
+    ParseStatus _status{ParseStatus::Ok};
+};
+
+// ARP packet for IPv4 over Ethernet
+class ArpView
+{
+public:
+    static constexpr std::size_t size = layout::ArpIp4::size;
+
+    [[nodiscard]] static auto Parse(asio::const_buffer packet) -> ArpView
+    {
+        const auto data = static_cast<const std::uint8_t*>(packet.data());
+        if (packet.size() < size)
+        {
+            return ArpView{ParseStatus::Truncated};
+        }
+        using Arp = layout::ArpIp4;
+        if (Arp::HardwareType::Load(data) != 1 || Arp::ProtocolType::Load(data) != EtherType::Ip4)
+        {
+            return ArpView{ParseStatus::Unsupported};
+        }
+        if (Arp::HardwareAddressLength::Load(data) != 6 || Arp::ProtocolAddressLength::Load(data) != 4)
+        {
+            return ArpView{ParseStatus::InvalidLength};
+        }
+        return ArpView{packet};
+    }
+
+    explicit operator bool() const
+    {
+        return _status == ParseStatus::Ok;
+    }
+
+    [[nodiscard]] auto GetStatus() const -> ParseStatus
+    {
+        return _status;
+    }
+
+    // not validated, other operations than request and reply are passed through
+    [[nodiscard]] auto GetOperation() const -> ArpOperation
+    {
+        return layout::ArpIp4::Operation::Load(Data());
+    }
+
+    [[nodiscard]] auto GetSenderHardwareAddress() const -> EthernetAddress
+    {
+        return layout::ArpIp4::SenderHardwareAddress::Load(Data());
+    }
+
+    [[nodiscard]] auto GetSenderProtocolAddress() const -> Ip4Address
+    {
+        return layout::ArpIp4::SenderProtocolAddress::Load(Data());
+    }
+
+    [[nodiscard]] auto GetTargetHardwareAddress() const -> EthernetAddress
+    {
+        return layout::ArpIp4::TargetHardwareAddress::Load(Data());
+    }
+
+    [[nodiscard]] auto GetTargetProtocolAddress() const -> Ip4Address
+    {
+        return layout::ArpIp4::TargetProtocolAddress::Load(Data());
+    }
+
+private:
+    explicit ArpView(ParseStatus status)
+        : _status{status}
+    {
+    }
+
+    explicit ArpView(asio::const_buffer buffer)
+        : _buffer{buffer}
+    {
+    }
+
+    auto Data() const -> const std::uint8_t*
+    {
+        return static_cast<const std::uint8_t*>(_buffer.data());
+    }
+
+    asio::const_buffer _buffer;
+    ParseStatus _status{ParseStatus::Ok};
+};
+
+// IPv4 header. The payload ends at the total length, Ethernet padding of short frames is not part of it.
+class Ip4View
+{
+public:
+    [[nodiscard]] static auto Parse(asio::const_buffer packet) -> Ip4View
+    {
+        const auto data = static_cast<const std::uint8_t*>(packet.data());
+        if (!FitsLayout<layout::Ip4>(packet))
+        {
+            return Ip4View{ParseStatus::Truncated};
+        }
+        if (layout::Ip4::Version::Load(data) != 4)
+        {
+            return Ip4View{ParseStatus::InvalidVersion};
+        }
+        const std::size_t headerLength = layout::Ip4::HeaderLength::Load(data) * 4u;
+        if (headerLength < layout::Ip4::size)
+        {
+            return Ip4View{ParseStatus::InvalidHeaderLength};
+        }
+        const std::size_t totalLength = layout::Ip4::TotalLength::Load(data);
+        if (totalLength < headerLength)
+        {
+            return Ip4View{ParseStatus::InvalidLength};
+        }
+        if (packet.size() < totalLength)
+        {
+            return Ip4View{ParseStatus::Truncated};
+        }
+        return Ip4View{asio::buffer(packet, totalLength)};
+    }
+
+    explicit operator bool() const
+    {
+        return _status == ParseStatus::Ok;
+    }
+
+    [[nodiscard]] auto GetStatus() const -> ParseStatus
+    {
+        return _status;
+    }
+
+    [[nodiscard]] auto GetHeaderLength() const -> std::size_t
+    {
+        return layout::Ip4::HeaderLength::Load(Data()) * 4u;
+    }
+
+    [[nodiscard]] auto GetTotalLength() const -> std::uint16_t
+    {
+        return static_cast<std::uint16_t>(_buffer.size());
+    }
+
+    [[nodiscard]] auto GetIdentification() const -> std::uint16_t
+    {
+        return layout::Ip4::Identification::Load(Data());
+    }
+
+    [[nodiscard]] auto GetDontFragment() const -> bool
+    {
+        return layout::Ip4::DontFragment::Load(Data());
+    }
+
+    [[nodiscard]] auto GetMoreFragments() const -> bool
+    {
+        return layout::Ip4::MoreFragments::Load(Data());
+    }
+
+    // in units of 8 bytes
+    [[nodiscard]] auto GetFragmentOffset() const -> std::uint16_t
+    {
+        return layout::Ip4::FragmentOffset::Load(Data());
+    }
+
+    // true for all fragments of a fragmented datagram, only the first one carries the transport header
+    [[nodiscard]] auto IsFragment() const -> bool
+    {
+        return GetMoreFragments() || GetFragmentOffset() != 0;
+    }
+
+    [[nodiscard]] auto GetTimeToLive() const -> std::uint8_t
+    {
+        return layout::Ip4::TimeToLive::Load(Data());
+    }
+
+    [[nodiscard]] auto GetProtocol() const -> Ip4Protocol
+    {
+        return layout::Ip4::Protocol::Load(Data());
+    }
+
+    [[nodiscard]] auto GetChecksum() const -> std::uint16_t
+    {
+        return layout::Ip4::Checksum::Load(Data());
+    }
+
+    [[nodiscard]] auto GetSourceAddress() const -> Ip4Address
+    {
+        return layout::Ip4::SourceAddress::Load(Data());
+    }
+
+    [[nodiscard]] auto GetDestinationAddress() const -> Ip4Address
+    {
+        return layout::Ip4::DestinationAddress::Load(Data());
+    }
+
+    [[nodiscard]] auto GetHeader() const -> asio::const_buffer
+    {
+        return asio::buffer(_buffer, GetHeaderLength());
+    }
+
+    [[nodiscard]] auto GetPayload() const -> asio::const_buffer
+    {
+        return _buffer + GetHeaderLength();
+    }
+
+    [[nodiscard]] auto VerifyChecksum() const -> bool
+    {
+        return InternetChecksum::Verify({GetHeader()});
+    }
+
+private:
+    explicit Ip4View(ParseStatus status)
+        : _status{status}
+    {
+    }
+
+    explicit Ip4View(asio::const_buffer buffer)
+        : _buffer{buffer}
+    {
+    }
+
+    auto Data() const -> const std::uint8_t*
+    {
+        return static_cast<const std::uint8_t*>(_buffer.data());
+    }
+
+    // the packet up to its total length
+    asio::const_buffer _buffer;
+    ParseStatus _status{ParseStatus::Ok};
+};
+
+// ICMPv4 message with its 8 byte header
+class Icmp4View
+{
+public:
+    [[nodiscard]] static auto Parse(asio::const_buffer message) -> Icmp4View
+    {
+        if (!FitsLayout<layout::Icmp4Echo>(message))
+        {
+            return Icmp4View{ParseStatus::Truncated};
+        }
+        return Icmp4View{message};
+    }
+
+    explicit operator bool() const
+    {
+        return _status == ParseStatus::Ok;
+    }
+
+    [[nodiscard]] auto GetStatus() const -> ParseStatus
+    {
+        return _status;
+    }
+
+    // not validated, other types than echo request and reply are passed through
+    [[nodiscard]] auto GetType() const -> Icmp4Type
+    {
+        return layout::Icmp4::Type::Load(Data());
+    }
+
+    [[nodiscard]] auto GetCode() const -> std::uint8_t
+    {
+        return layout::Icmp4::Code::Load(Data());
+    }
+
+    [[nodiscard]] auto GetChecksum() const -> std::uint16_t
+    {
+        return layout::Icmp4::Checksum::Load(Data());
+    }
+
+    // identifier of echo requests and replies
+    [[nodiscard]] auto GetIdentifier() const -> std::uint16_t
+    {
+        return layout::Icmp4Echo::Identifier::Load(Data());
+    }
+
+    // sequence number of echo requests and replies
+    [[nodiscard]] auto GetSequenceNumber() const -> std::uint16_t
+    {
+        return layout::Icmp4Echo::SequenceNumber::Load(Data());
+    }
+
+    // the data after the 8 byte header
+    [[nodiscard]] auto GetPayload() const -> asio::const_buffer
+    {
+        return _buffer + layout::Icmp4Echo::size;
+    }
+
+    [[nodiscard]] auto VerifyChecksum() const -> bool
+    {
+        return InternetChecksum::Verify({_buffer});
+    }
+
+private:
+    explicit Icmp4View(ParseStatus status)
+        : _status{status}
+    {
+    }
+
+    explicit Icmp4View(asio::const_buffer buffer)
+        : _buffer{buffer}
+    {
+    }
+
+    auto Data() const -> const std::uint8_t*
+    {
+        return static_cast<const std::uint8_t*>(_buffer.data());
+    }
+
+    asio::const_buffer _buffer;
+    ParseStatus _status{ParseStatus::Ok};
+};
+
+// UDP header, the payload ends at the UDP length
+class UdpView
+{
+public:
+    [[nodiscard]] static auto Parse(asio::const_buffer datagram) -> UdpView
+    {
+        if (!FitsLayout<layout::Udp>(datagram))
+        {
+            return UdpView{ParseStatus::Truncated};
+        }
+        const std::size_t length = layout::Udp::Length::Load(static_cast<const std::uint8_t*>(datagram.data()));
+        if (length < layout::Udp::size)
+        {
+            return UdpView{ParseStatus::InvalidLength};
+        }
+        if (datagram.size() < length)
+        {
+            return UdpView{ParseStatus::Truncated};
+        }
+        return UdpView{asio::buffer(datagram, length)};
+    }
+
+    explicit operator bool() const
+    {
+        return _status == ParseStatus::Ok;
+    }
+
+    [[nodiscard]] auto GetStatus() const -> ParseStatus
+    {
+        return _status;
+    }
+
+    [[nodiscard]] auto GetSourcePort() const -> std::uint16_t
+    {
+        return layout::Udp::SourcePort::Load(Data());
+    }
+
+    [[nodiscard]] auto GetDestinationPort() const -> std::uint16_t
+    {
+        return layout::Udp::DestinationPort::Load(Data());
+    }
+
+    [[nodiscard]] auto GetLength() const -> std::uint16_t
+    {
+        return static_cast<std::uint16_t>(_buffer.size());
+    }
+
+    [[nodiscard]] auto GetChecksum() const -> std::uint16_t
+    {
+        return layout::Udp::Checksum::Load(Data());
+    }
+
+    [[nodiscard]] auto GetPayload() const -> asio::const_buffer
+    {
+        return _buffer + layout::Udp::size;
+    }
+
+private:
+    explicit UdpView(ParseStatus status)
+        : _status{status}
+    {
+    }
+
+    explicit UdpView(asio::const_buffer buffer)
+        : _buffer{buffer}
+    {
+    }
+
+    auto Data() const -> const std::uint8_t*
+    {
+        return static_cast<const std::uint8_t*>(_buffer.data());
+    }
+
+    asio::const_buffer _buffer;
+    ParseStatus _status{ParseStatus::Ok};
+};
+
+// TCP header including its options
+class TcpView
+{
+public:
+    [[nodiscard]] static auto Parse(asio::const_buffer segment) -> TcpView
+    {
+        if (!FitsLayout<layout::Tcp>(segment))
+        {
+            return TcpView{ParseStatus::Truncated};
+        }
+        const auto data = static_cast<const std::uint8_t*>(segment.data());
+        const std::size_t dataOffset = layout::Tcp::DataOffset::Load(data) * 4u;
+        if (dataOffset < layout::Tcp::size)
+        {
+            return TcpView{ParseStatus::InvalidHeaderLength};
+        }
+        if (segment.size() < dataOffset)
+        {
+            return TcpView{ParseStatus::Truncated};
+        }
+        return TcpView{segment};
+    }
+
+    explicit operator bool() const
+    {
+        return _status == ParseStatus::Ok;
+    }
+
+    [[nodiscard]] auto GetStatus() const -> ParseStatus
+    {
+        return _status;
+    }
+
+    [[nodiscard]] auto GetSourcePort() const -> std::uint16_t
+    {
+        return layout::Tcp::SourcePort::Load(Data());
+    }
+
+    [[nodiscard]] auto GetDestinationPort() const -> std::uint16_t
+    {
+        return layout::Tcp::DestinationPort::Load(Data());
+    }
+
+    [[nodiscard]] auto GetSequenceNumber() const -> std::uint32_t
+    {
+        return layout::Tcp::SequenceNumber::Load(Data());
+    }
+
+    [[nodiscard]] auto GetAcknowledgmentNumber() const -> std::uint32_t
+    {
+        return layout::Tcp::AcknowledgmentNumber::Load(Data());
+    }
+
+    [[nodiscard]] auto GetDataOffset() const -> std::size_t
+    {
+        return layout::Tcp::DataOffset::Load(Data()) * 4u;
+    }
+
+    [[nodiscard]] auto GetFlags() const -> std::uint8_t
+    {
+        return layout::Tcp::Flags::Load(Data());
+    }
+
+    [[nodiscard]] auto GetPayload() const -> asio::const_buffer
+    {
+        return _buffer + GetDataOffset();
+    }
+
+private:
+    explicit TcpView(ParseStatus status)
+        : _status{status}
+    {
+    }
+
+    explicit TcpView(asio::const_buffer buffer)
+        : _buffer{buffer}
+    {
+    }
+
+    auto Data() const -> const std::uint8_t*
+    {
+        return static_cast<const std::uint8_t*>(_buffer.data());
+    }
+
+    asio::const_buffer _buffer;
+    ParseStatus _status{ParseStatus::Ok};
+};
+
+// SOME/IP header of protocol version 1. The payload may be truncated, e.g. if the message is segmented over
+// several TCP segments.
+class SomeIpView
+{
+public:
+    [[nodiscard]] static auto Parse(asio::const_buffer message) -> SomeIpView
+    {
+        using SomeIp = layout::SomeIp;
+        if (!FitsLayout<SomeIp>(message))
+        {
+            return SomeIpView{ParseStatus::Truncated};
+        }
+        const auto data = static_cast<const std::uint8_t*>(message.data());
+        if (SomeIp::Length::Load(data) < 8)
+        {
+            return SomeIpView{ParseStatus::InvalidLength};
+        }
+        if (SomeIp::ProtocolVersion::Load(data) != 1)
+        {
+            return SomeIpView{ParseStatus::InvalidVersion};
+        }
+        return SomeIpView{message};
+    }
+
+    explicit operator bool() const
+    {
+        return _status == ParseStatus::Ok;
+    }
+
+    [[nodiscard]] auto GetStatus() const -> ParseStatus
+    {
+        return _status;
+    }
+
+    [[nodiscard]] auto GetServiceId() const -> std::uint16_t
+    {
+        return layout::SomeIp::ServiceId::Load(Data());
+    }
+
+    [[nodiscard]] auto GetMethodId() const -> std::uint16_t
+    {
+        return layout::SomeIp::MethodId::Load(Data());
+    }
+
+    // number of bytes following the length field, i.e. 8 + payload size
+    [[nodiscard]] auto GetLength() const -> std::uint32_t
+    {
+        return layout::SomeIp::Length::Load(Data());
+    }
+
+    [[nodiscard]] auto GetClientId() const -> std::uint16_t
+    {
+        return layout::SomeIp::ClientId::Load(Data());
+    }
+
+    [[nodiscard]] auto GetSessionId() const -> std::uint16_t
+    {
+        return layout::SomeIp::SessionId::Load(Data());
+    }
+
+    [[nodiscard]] auto GetInterfaceVersion() const -> std::uint8_t
+    {
+        return layout::SomeIp::InterfaceVersion::Load(Data());
+    }
+
+    [[nodiscard]] auto GetMessageType() const -> SomeIpMessageType
+    {
+        return layout::SomeIp::MessageType::Load(Data());
+    }
+
+    [[nodiscard]] auto GetReturnCode() const -> std::uint8_t
+    {
+        return layout::SomeIp::ReturnCode::Load(Data());
+    }
+
+    // the size of the whole message, which may be larger than the buffer
+    [[nodiscard]] auto GetMessageSize() const -> std::size_t
+    {
+        return std::size_t(8) + GetLength();
+    }
+
+    // the payload within the buffer
+    [[nodiscard]] auto GetPayload() const -> asio::const_buffer
+    {
+        return asio::buffer(_buffer + layout::SomeIp::size, GetLength() - 8);
+    }
+
+private:
+    explicit SomeIpView(ParseStatus status)
+        : _status{status}
+    {
+    }
+
+    explicit SomeIpView(asio::const_buffer buffer)
+        : _buffer{buffer}
+    {
+    }
+
+    auto Data() const -> const std::uint8_t*
+    {
+        return static_cast<const std::uint8_t*>(_buffer.data());
+    }
+
+    asio::const_buffer _buffer;
+    ParseStatus _status{ParseStatus::Ok};
+};
+
+} // namespace demo
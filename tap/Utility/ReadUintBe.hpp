@@ -5,6 +5,8 @@
 
 #include <type_traits>
 
+#include "FieldLayout.hpp"
+
 #include "common/Exceptions.hpp"
 
 #include "asio/ts/buffer.hpp"
@@ -19,15 +21,7 @@ auto ReadUintBe(asio::const_buffer buffer) -> std::enable_if_t<std::is_unsigned<
         throw adapters::InvalidBufferSize{};
     }
 
-    const auto bytes = static_cast<const unsigned char*>(buffer.data());
-
-    T result = 0;
-    for (unsigned byte_index = 0; byte_index < sizeof(T); ++byte_index)
-    {
-        result |= static_cast<T>(bytes[sizeof(T) - 1 - byte_index]) << (byte_index * 8u);
-    }
-
-    return result;
+    return LoadBe<T>(buffer.data());
 }
 
 template <typename T>
@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "SomeIpHeader.hpp"
+
+#include <ostream>
+
+#include "Enums.hpp"
+
+namespace demo {
+
+std::ostream& operator<<(std::ostream& ostream, const SomeIpMessageType& messageType)
+{
+    switch (messageType)
+    {
+    case demo::SomeIpMessageType::Request:
+        return ostream << "SomeIpMessageType::Request";
+    case demo::SomeIpMessageType::RequestNoReturn:
+        return ostream << "SomeIpMessageType::RequestNoReturn";
+    case demo::SomeIpMessageType::Notification:
+        return ostream << "SomeIpMessageType::Notification";
+    case demo::SomeIpMessageType::Response:
+        return ostream << "SomeIpMessageType::Response";
+    case demo::SomeIpMessageType::Error:
+        return ostream << "SomeIpMessageType::Error";
+    case demo::SomeIpMessageType::TpRequest:
+        return ostream << "SomeIpMessageType::TpRequest";
+    case demo::SomeIpMessageType::TpRequestNoReturn:
+        return ostream << "SomeIpMessageType::TpRequestNoReturn";
+    case demo::SomeIpMessageType::TpNotification:
+        return ostream << "SomeIpMessageType::TpNotification";
+    case demo::SomeIpMessageType::TpResponse:
+        return ostream << "SomeIpMessageType::TpResponse";
+    case demo::SomeIpMessageType::TpError:
+        return ostream << "SomeIpMessageType::TpError";
+    }
+    return ostream << "SomeIpMessageType(" << unsigned(ToUnderlying(messageType)) << ")";
+}
+
+std::ostream& operator<<(std::ostream& ostream, const SomeIpHeader& someIpHeader)
+{
+    return ostream << "SomeIpHeader(serviceId=" << someIpHeader.serviceId << ",methodId=" << someIpHeader.methodId
+                   << ",length=" << someIpHeader.length << ",clientId=" << someIpHeader.clientId
+                   << ",sessionId=" << someIpHeader.sessionId
+                   << ",protocolVersion=" << unsigned(someIpHeader.protocolVersion)
+                   << ",interfaceVersion=" << unsigned(someIpHeader.interfaceVersion)
+                   << ",messageType=" << someIpHeader.messageType
+                   << ",returnCode=" << unsigned(someIpHeader.returnCode) << ")";
+}
+
+} // namespace demo
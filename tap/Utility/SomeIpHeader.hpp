@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <iosfwd>
+#include <cstdint>
+
+#include "FieldLayout.hpp"
+#include "ParseResult.hpp"
+
+#include "common/Exceptions.hpp"
+
+namespace demo {
+
+enum struct SomeIpMessageType : std::uint8_t
+{
+    Request = 0x00,
+    RequestNoReturn = 0x01,
+    Notification = 0x02,
+    Response = 0x80,
+    Error = 0x81,
+    TpRequest = 0x20,
+    TpRequestNoReturn = 0x21,
+    TpNotification = 0x22,
+    TpResponse = 0xA0,
+    TpError = 0xA1,
+};
+
+namespace layout {
+
+struct SomeIp
+{
+    static constexpr std::size_t size = 16;
+    using ServiceId = FieldBe<0, std::uint16_t>;
+    using MethodId = FieldBe<2, std::uint16_t>;
+    using Length = FieldBe<4, std::uint32_t>;
+    using ClientId = FieldBe<8, std::uint16_t>;
+    using SessionId = FieldBe<10, std::uint16_t>;
+    using ProtocolVersion = FieldBe<12, std::uint8_t>;
+    using InterfaceVersion = FieldBe<13, std::uint8_t>;
+    using MessageType = FieldBe<14, SomeIpMessageType>;
+    using ReturnCode = FieldBe<15, std::uint8_t>;
+};
+static_assert(FieldsFitLayout<SomeIp, SomeIp::ServiceId, SomeIp::MethodId, SomeIp::Length, SomeIp::ClientId,
+                              SomeIp::SessionId, SomeIp::ProtocolVersion, SomeIp::InterfaceVersion,
+                              SomeIp::MessageType, SomeIp::ReturnCode>);
+
+} // namespace layout
+
+struct SomeIpHeader
+{
+    std::uint16_t serviceId;
+    std::uint16_t methodId;
+    // number of bytes following the length field, i.e. 8 + payload size
+    std::uint32_t length;
+    std::uint16_t clientId;
+    std::uint16_t sessionId;
+    std::uint8_t protocolVersion;
+    std::uint8_t interfaceVersion;
+    SomeIpMessageType messageType;
+    std::uint8_t returnCode;
+
+    [[nodiscard]] auto GetMessageSize() const -> std::size_t
+    {
+        return std::size_t(8) + length;
+    }
+};
+
+// The remaining buffer is the message payload, it may be truncated if the message is
+// segmented over several TCP segments.
+inline auto ParseSomeIpHeader(asio::const_buffer data) -> ParseResult<SomeIpHeader>
+{
+    using SomeIp = layout::SomeIp;
+    CheckLayoutSize<SomeIp>(data);
+    const auto bytes = static_cast<const std::uint8_t*>(data.data());
+
+    const auto length = SomeIp::Length::Load(bytes);
+    const auto protocolVersion = SomeIp::ProtocolVersion::Load(bytes);
+    if (length < 8 || protocolVersion != 1)
+    {
+        throw adapters::InvalidBufferSize{};
+    }
+
+    const auto payload = data + SomeIp::size;
+    return {
+        SomeIpHeader{
+            SomeIp::ServiceId::Load(bytes),
+            SomeIp::MethodId::Load(bytes),
+            length,
+            SomeIp::ClientId::Load(bytes),
+            SomeIp::SessionId::Load(bytes),
+            protocolVersion,
+            SomeIp::InterfaceVersion::Load(bytes),
+            SomeIp::MessageType::Load(bytes),
+            SomeIp::ReturnCode::Load(bytes),
+        },
+        asio::buffer(payload, length - 8),
+    };
+}
+
+std::ostream& operator<<(std::ostream& ostream, const SomeIpMessageType& messageType);
+std::ostream& operator<<(std::ostream& ostream, const SomeIpHeader& someIpHeader);
+
+} // namespace demo
@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "Split.hpp"
+
+namespace demo {
+
+auto Split(const std::string& text, char separator) -> std::vector<std::string>
+{
+    std::vector<std::string> parts;
+    std::size_t begin = 0;
+    for (;;)
+    {
+        const auto end = text.find(separator, begin);
+        parts.push_back(text.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+        if (end == std::string::npos)
+        {
+            return parts;
+        }
+        begin = end + 1;
+    }
+}
+
+} // namespace demo
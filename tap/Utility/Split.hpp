@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace demo {
+
+// Splits text at each separator, e.g. the terms of a CLI list. Empty terms are kept, so that the parsers can
+// reject them, and an empty text is a single empty term.
+auto Split(const std::string& text, char separator) -> std::vector<std::string>;
+
+} // namespace demo
@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "TcpHeader.hpp"
+
+#include <ostream>
+
+namespace demo {
+
+std::ostream& operator<<(std::ostream& ostream, const TcpHeader& tcpHeader)
+{
+    return ostream << "TcpHeader(sourcePort=" << tcpHeader.sourcePort
+                   << ",destinationPort=" << tcpHeader.destinationPort
+                   << ",sequenceNumber=" << tcpHeader.sequenceNumber
+                   << ",acknowledgmentNumber=" << tcpHeader.acknowledgmentNumber
+                   << ",dataOffset=" << unsigned(tcpHeader.dataOffset) << ",flags=" << unsigned(tcpHeader.flags)
+                   << ",windowSize=" << tcpHeader.windowSize << ",checksum=" << tcpHeader.checksum << ")";
+}
+
+} // namespace demo
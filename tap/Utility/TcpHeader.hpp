@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <iosfwd>
+#include <cstdint>
+
+#include "FieldLayout.hpp"
+#include "ParseResult.hpp"
+
+#include "common/Exceptions.hpp"
+
+namespace demo {
+
+enum struct TcpFlags : std::uint8_t
+{
+    Fin = 0x01,
+    Syn = 0x02,
+    Rst = 0x04,
+    Psh = 0x08,
+    Ack = 0x10,
+    Urg = 0x20,
+};
+
+enum struct TcpOptionKind : std::uint8_t
+{
+    EndOfOptionList = 0,
+    NoOperation = 1,
+    MaximumSegmentSize = 2,
+};
+
+namespace layout {
+
+// The TCP header without options (RFC 9293)
+struct Tcp
+{
+    static constexpr std::size_t size = 20;
+    using SourcePort = FieldBe<0, std::uint16_t>;
+    using DestinationPort = FieldBe<2, std::uint16_t>;
+    using SequenceNumber = FieldBe<4, std::uint32_t>;
+    using AcknowledgmentNumber = FieldBe<8, std::uint32_t>;
+    using DataOffset = BitFieldBe<12, std::uint8_t, 4, 4>; // in 32-bit words
+    using Flags = FieldBe<13, std::uint8_t>;
+    using WindowSize = FieldBe<14, std::uint16_t>;
+    using Checksum = FieldBe<16, std::uint16_t>;
+    using UrgentPointer = FieldBe<18, std::uint16_t>;
+};
+static_assert(FieldsFitLayout<Tcp, Tcp::SourcePort, Tcp::DestinationPort, Tcp::SequenceNumber,
+                              Tcp::AcknowledgmentNumber, Tcp::DataOffset, Tcp::Flags, Tcp::WindowSize, Tcp::Checksum,
+                              Tcp::UrgentPointer>);
+
+// The maximum segment size option, only valid in SYN segments
+struct TcpMaximumSegmentSizeOption
+{
+    static constexpr std::size_t size = 4;
+    using Kind = FieldBe<0, TcpOptionKind>;
+    using Length = FieldBe<1, std::uint8_t>;
+    using MaximumSegmentSize = FieldBe<2, std::uint16_t>;
+};
+static_assert(FieldsFitLayout<TcpMaximumSegmentSizeOption, TcpMaximumSegmentSizeOption::Kind,
+                              TcpMaximumSegmentSizeOption::Length, TcpMaximumSegmentSizeOption::MaximumSegmentSize>);
+
+} // namespace layout
+
+struct TcpHeader
+{
+    std::uint16_t sourcePort;
+    std::uint16_t destinationPort;
+    std::uint32_t sequenceNumber;
+    std::uint32_t acknowledgmentNumber;
+    std::uint8_t dataOffset; // header length in bytes, including options
+    std::uint8_t flags;
+    std::uint16_t windowSize;
+    std::uint16_t checksum;
+    std::uint16_t urgentPointer;
+
+    [[nodiscard]] bool HasFlag(TcpFlags flag) const
+    {
+        return (flags & static_cast<std::uint8_t>(flag)) != 0;
+    }
+};
+
+inline auto ParseTcpHeader(asio::const_buffer data) -> ParseResult<TcpHeader>
+{
+    using Tcp = layout::Tcp;
+    CheckLayoutSize<Tcp>(data);
+    const auto bytes = static_cast<const std::uint8_t*>(data.data());
+
+    const auto dataOffset = static_cast<std::uint8_t>(Tcp::DataOffset::Load(bytes) * 4u);
+    if (dataOffset < Tcp::size || data.size() < dataOffset)
+    {
+        throw adapters::InvalidBufferSize{};
+    }
+
+    return {
+        TcpHeader{
+            Tcp::SourcePort::Load(bytes),
+            Tcp::DestinationPort::Load(bytes),
+            Tcp::SequenceNumber::Load(bytes),
+            Tcp::AcknowledgmentNumber::Load(bytes),
+            dataOffset,
+            Tcp::Flags::Load(bytes),
+            Tcp::WindowSize::Load(bytes),
+            Tcp::Checksum::Load(bytes),
+            Tcp::UrgentPointer::Load(bytes),
+        },
+        data + dataOffset,
+    };
+}
+
+std::ostream& operator<<(std::ostream& ostream, const TcpHeader& tcpHeader);
+
+} // namespace demo
@@ -0,0 +1,17 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "UdpHeader.hpp"
+
+#include <ostream>
+
+namespace demo {
+
+std::ostream& operator<<(std::ostream& ostream, const UdpHeader& udpHeader)
+{
+    return ostream << "UdpHeader(sourcePort=" << udpHeader.sourcePort
+                   << ",destinationPort=" << udpHeader.destinationPort << ",length=" << udpHeader.length
+                   << ",checksum=" << udpHeader.checksum << ")";
+}
+
+} // namespace demo
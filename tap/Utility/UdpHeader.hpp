@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <iosfwd>
+#include <cstdint>
+
+#include "FieldLayout.hpp"
+#include "ParseResult.hpp"
+
+#include "common/Exceptions.hpp"
+
+namespace demo {
+
+namespace layout {
+
+struct Udp
+{
+    static constexpr std::size_t size = 8;
+    using SourcePort = FieldBe<0, std::uint16_t>;
+    using DestinationPort = FieldBe<2, std::uint16_t>;
+    using Length = FieldBe<4, std::uint16_t>; // including the header
+    using Checksum = FieldBe<6, std::uint16_t>;
+};
+static_assert(FieldsFitLayout<Udp, Udp::SourcePort, Udp::DestinationPort, Udp::Length, Udp::Checksum>);
+
+} // namespace layout
+
+struct UdpHeader
+{
+    std::uint16_t sourcePort;
+    std::uint16_t destinationPort;
+    std::uint16_t length;
+    std::uint16_t checksum;
+};
+
+inline auto ParseUdpHeader(asio::const_buffer data) -> ParseResult<UdpHeader>
+{
+    using Udp = layout::Udp;
+    CheckLayoutSize<Udp>(data);
+    const auto bytes = static_cast<const std::uint8_t*>(data.data());
+
+    const auto length = Udp::Length::Load(bytes);
+    if (length < Udp::size || data.size() < length)
+    {
+        throw adapters::InvalidBufferSize{};
+    }
+
+    return {
+        UdpHeader{
+            Udp::SourcePort::Load(bytes),
+            Udp::DestinationPort::Load(bytes),
+            length,
+            Udp::Checksum::Load(bytes),
+        },
+        asio::buffer(data + Udp::size, length - Udp::size),
+    };
+}
+
+std::ostream& operator<<(std::ostream& ostream, const UdpHeader& udpHeader);
+
+} // namespace demo
@@ -5,6 +5,8 @@
 
 #include <type_traits>
 
+#include "FieldLayout.hpp"
+
 #include "common/Exceptions.hpp"
 
 #include "asio/ts/buffer.hpp"
@@ -20,13 +22,7 @@ auto WriteUintBe(asio::mutable_buffer buffer,
         throw adapters::InvalidBufferSize{};
     }
 
-    const auto bytes = static_cast<unsigned char*>(buffer.data());
-
-    for (unsigned byte_index = 0; byte_index < sizeof(T); ++byte_index)
-    {
-        bytes[sizeof(T) - 1 - byte_index] = (value >> (byte_index * 8u)) & 0xFF;
-    }
-
+    StoreBe<T>(buffer.data(), value);
     return sizeof(T);
 }
 
@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace adapters {
+
+/// <summary>
+/// Forwarding direction of a frame through the adapter.
+/// </summary>
+enum struct Direction : std::uint8_t
+{
+    TapToSilKit = 0,
+    SilKitToTap = 1,
+};
+
+constexpr std::size_t directionCount = 2;
+
+inline auto ToIndex(Direction direction) -> std::size_t
+{
+    return static_cast<std::size_t>(direction);
+}
+
+inline auto ToString(Direction direction) -> const char*
+{
+    return direction == Direction::TapToSilKit ? "tap_to_silkit" : "silkit_to_tap";
+}
+
+} // namespace adapters
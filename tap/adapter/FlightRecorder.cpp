@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "FlightRecorder.hpp"
+#include "Pcapng.hpp"
+
+#include <csignal>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+using namespace adapters;
+
+namespace {
+
+auto GetReasonName(FlightRecorder::DumpReason reason) -> const char*
+{
+    switch (reason)
+    {
+    case FlightRecorder::DumpReason::Signal:
+        return "signal";
+    case FlightRecorder::DumpReason::TapReadError:
+        return "tap-read-error";
+    case FlightRecorder::DumpReason::NackBurst:
+        return "nack-burst";
+    case FlightRecorder::DumpReason::Command:
+        return "command";
+    }
+    return "unknown";
+}
+
+auto SteadyNowNs() -> std::uint64_t
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+}
+
+struct SnapshotEntry
+{
+    std::uint64_t timestampNs;
+    std::uint32_t originalSize;
+    std::uint32_t capturedSize;
+    Direction direction;
+    std::size_t dataOffset;
+};
+
+} // namespace
+
+constexpr std::size_t FlightRecorder::maxSlotCount;
+constexpr std::uint32_t FlightRecorder::maxSnapLength;
+constexpr std::size_t FlightRecorder::maxSlotDataSize;
+
+FlightRecorder::FlightRecorder(asio::io_context& ioContext, SilKit::Services::Logging::ILogger* logger,
+                               Options options)
+    : _logger{logger}
+    , _options{std::move(options)}
+    , _slots{std::make_unique<Slot[]>(_options.slotCount)}
+    , _slotData{std::make_unique<std::uint8_t[]>(_options.slotCount * _options.snapLength)}
+#if !WIN32
+    , _signals{ioContext, SIGUSR1}
+#endif
+{
+#if !WIN32
+    WaitForSignal();
+#else
+    (void)ioContext;
+#endif
+    _thread = std::thread{[this] { Run(); }};
+}
+
+FlightRecorder::~FlightRecorder()
+{
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopRequested = true;
+    }
+    _dumpRequested.notify_one();
+    _thread.join();
+}
+
+void FlightRecorder::CountNack()
+{
+    if (_options.nackBurstThreshold == 0)
+    {
+        return;
+    }
+
+    const auto nowNs = SteadyNowNs();
+    const auto windowNs = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(_options.nackBurstWindow).count());
+    auto windowStartNs = _nackWindowStartNs.load(std::memory_order_relaxed);
+    if (nowNs - windowStartNs > windowNs
+        && _nackWindowStartNs.compare_exchange_strong(windowStartNs, nowNs, std::memory_order_relaxed))
+    {
+        _nacksInWindow.store(0, std::memory_order_relaxed);
+    }
+
+    if (_nacksInWindow.fetch_add(1, std::memory_order_relaxed) + 1 != _options.nackBurstThreshold)
+    {
+        return;
+    }
+
+    const auto minIntervalNs = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(_options.minNackBurstDumpInterval).count());
+    auto lastDumpNs = _lastNackBurstDumpNs.load(std::memory_order_relaxed);
+    if ((lastDumpNs == 0 || nowNs - lastDumpNs >= minIntervalNs)
+        && _lastNackBurstDumpNs.compare_exchange_strong(lastDumpNs, nowNs, std::memory_order_relaxed))
+    {
+        RequestDump(DumpReason::NackBurst);
+    }
+}
+
+void FlightRecorder::RequestDump(DumpReason reason)
+{
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        if (_pendingReason)
+        {
+            return; // the pending dump will contain the same frames
+        }
+        _pendingReason = reason;
+    }
+    _dumpRequested.notify_one();
+}
+
+#if !WIN32
+void FlightRecorder::WaitForSignal()
+{
+    _signals.async_wait([this](const std::error_code& ec, int /*signalNumber*/) {
+        if (ec)
+        {
+            return;
+        }
+        RequestDump(DumpReason::Signal);
+        WaitForSignal();
+    });
+}
+#endif
+
+void FlightRecorder::Run()
+{
+    std::unique_lock<std::mutex> lock{_mutex};
+    for (;;)
+    {
+        _dumpRequested.wait(lock, [this] { return _stopRequested || _pendingReason.has_value(); });
+        if (_stopRequested)
+        {
+            return;
+        }
+
+        const auto reason = *_pendingReason;
+        lock.unlock();
+        Dump(reason);
+        lock.lock();
+        _pendingReason.reset();
+    }
+}
+
+void FlightRecorder::Dump(DumpReason reason)
+{
+    // Copy the slots first, so that forwarding overwrites as few of them as possible while the file is
+    // written. Slots which are written during the copy are left out.
+    std::vector<SnapshotEntry> entries;
+    std::vector<std::uint8_t> data(_options.slotCount * _options.snapLength);
+    entries.reserve(_options.slotCount);
+    for (std::size_t slotIndex = 0; slotIndex < _options.slotCount; ++slotIndex)
+    {
+        auto& slot = _slots[slotIndex];
+        const auto sequenceBefore = slot.sequence.load(std::memory_order_acquire);
+        if (sequenceBefore == 0 || (sequenceBefore & 1u) != 0)
+        {
+            continue;
+        }
+
+        SnapshotEntry entry{slot.timestampNs, slot.originalSize, slot.capturedSize, slot.direction,
+                            entries.size() * _options.snapLength};
+        entry.capturedSize = std::min(entry.capturedSize, _options.snapLength);
+        std::memcpy(&data[entry.dataOffset], &_slotData[slotIndex * _options.snapLength], entry.capturedSize);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequenceBefore)
+        {
+            continue;
+        }
+        entries.push_back(entry);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const SnapshotEntry& lhs, const SnapshotEntry& rhs) {
+        return lhs.timestampNs < rhs.timestampNs;
+    });
+
+    std::vector<std::uint8_t> buffer;
+    buffer.reserve(entries.size() * pcapng::EnhancedPacketBlockSize(_options.snapLength) + 512);
+    pcapng::AppendSectionStart(buffer, _options.snapLength);
+    for (const auto& entry : entries)
+    {
+        pcapng::AppendEnhancedPacket(buffer, entry.direction, entry.timestampNs, &data[entry.dataOffset],
+                                     entry.capturedSize, entry.originalSize);
+    }
+
+    std::ostringstream path;
+    path << _options.pathPrefix << "-" << std::setw(5) << std::setfill('0') << _dumpIndex++ << "-"
+         << GetReasonName(reason) << ".pcapng";
+
+    std::ofstream file{path.str(), std::ios::binary | std::ios::trunc};
+    file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    file.close();
+    if (!file)
+    {
+        _logger->Error("Flight recorder: cannot write " + path.str());
+        return;
+    }
+
+    std::ostringstream SILKitInfoMessage;
+    SILKitInfoMessage << "Flight recorder: dumped the last " << entries.size() << " frames to " << path.str()
+                      << " (" << GetReasonName(reason) << ")";
+    _logger->Info(SILKitInfoMessage.str());
+}
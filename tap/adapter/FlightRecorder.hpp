@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "Direction.hpp"
+
+#include "asio/ts/io_context.hpp"
+#if !WIN32
+#include "asio/signal_set.hpp"
+#endif
+
+#include "silkit/services/logging/all.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// In-memory record of the most recent frames of both directions, written to a pcapng file on demand.
+///
+///   Frames are copied into a fixed number of preallocated slots which are overwritten round-robin,
+///   each slot holds the leading bytes of a frame (its headers plus a payload prefix). The recorder is
+///   dumped on SIGUSR1, on a fatal TAP read error, on a burst of NACKs from SIL Kit and on request.
+///   Dumps are written by a thread of the recorder, never by the forwarding threads.
+/// </summary>
+class FlightRecorder
+{
+public:
+    enum struct DumpReason : std::uint8_t
+    {
+        Signal,
+        TapReadError,
+        NackBurst,
+        Command,
+    };
+
+    // bounds of slotCount and snapLength, the slots are allocated up front and once more by each dump
+    static constexpr std::size_t maxSlotCount = 1024 * 1024;
+    static constexpr std::uint32_t maxSnapLength = 65535;
+    static constexpr std::size_t maxSlotDataSize = 256 * 1024 * 1024;
+
+    struct Options
+    {
+        // dumps are named <pathPrefix>-00000-<reason>.pcapng, <pathPrefix>-00001-<reason>.pcapng, ...
+        std::string pathPrefix;
+        std::size_t slotCount = 8192;
+        // leading bytes of a frame kept per slot
+        std::uint32_t snapLength = 128;
+        // NACKs within nackBurstWindow triggering a dump, 0 disables the trigger
+        std::uint32_t nackBurstThreshold = 16;
+        std::chrono::milliseconds nackBurstWindow{1000};
+        // NACK bursts do not trigger dumps more often than this
+        std::chrono::seconds minNackBurstDumpInterval{10};
+    };
+
+    FlightRecorder(asio::io_context& ioContext, SilKit::Services::Logging::ILogger* logger, Options options);
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    /// <summary>
+    /// Records a frame forwarded in the given direction, overwriting the oldest slot.
+    /// </summary>
+    void Record(Direction direction, const std::uint8_t* frame, std::size_t frameSize)
+    {
+        const auto slotIndex = _nextSlot.fetch_add(1, std::memory_order_relaxed) % _options.slotCount;
+        auto& slot = _slots[slotIndex];
+
+        // seqlock: an odd sequence marks a slot which is being written
+        const auto sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.timestampNs = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                          std::chrono::system_clock::now().time_since_epoch())
+                                                          .count());
+        slot.originalSize = static_cast<std::uint32_t>(frameSize);
+        slot.capturedSize = static_cast<std::uint32_t>(std::min<std::size_t>(frameSize, _options.snapLength));
+        slot.direction = direction;
+        std::memcpy(&_slotData[slotIndex * _options.snapLength], frame, slot.capturedSize);
+
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /// <summary>
+    /// Counts a NACK of SIL Kit and requests a dump if the NACKs within the burst window reach the threshold.
+    /// </summary>
+    void CountNack();
+
+    /// <summary>
+    /// Requests a dump, which is written asynchronously. May be called from any thread.
+    /// </summary>
+    void RequestDump(DumpReason reason);
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence{0};
+        std::uint64_t timestampNs{0};
+        std::uint32_t originalSize{0};
+        std::uint32_t capturedSize{0};
+        Direction direction{Direction::TapToSilKit};
+    };
+
+    void Run();
+    void Dump(DumpReason reason);
+    void WaitForSignal();
+
+    SilKit::Services::Logging::ILogger* _logger;
+    Options _options;
+
+    std::unique_ptr<Slot[]> _slots;
+    std::unique_ptr<std::uint8_t[]> _slotData;
+    std::atomic<std::uint64_t> _nextSlot{0};
+
+    std::atomic<std::uint64_t> _nackWindowStartNs{0};
+    std::atomic<std::uint32_t> _nacksInWindow{0};
+    std::atomic<std::uint64_t> _lastNackBurstDumpNs{0};
+
+#if !WIN32
+    asio::signal_set _signals;
+#endif
+
+    std::mutex _mutex;
+    std::condition_variable _dumpRequested;
+    std::optional<DumpReason> _pendingReason;
+    bool _stopRequested{false};
+    std::uint64_t _dumpIndex{0};
+    std::thread _thread;
+};
+
+} // namespace adapters
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "FlowClassifier.hpp"
+
+#include "Enums.hpp"
+#include "Ip4Header.hpp"
+
+using namespace adapters;
+
+FlowClassifier::FlowClassifier(Options options)
+    : _options{options}
+    , _toeplitzHash{options.toeplitzKey}
+{
+}
+
+auto FlowClassifier::ParseHashFunction(const std::string& name) -> std::optional<HashFunction>
+{
+    if (name == "toeplitz")
+    {
+        return HashFunction::Toeplitz;
+    }
+    if (name == "fast")
+    {
+        return HashFunction::Fast;
+    }
+    return std::nullopt;
+}
+
+void FlowClassifier::Classify(asio::const_buffer frame, FrameMetadata& metadata,
+                              std::optional<std::uint16_t> egressVlanId) const
+{
+    metadata.flow = demo::ExtractFlow(frame);
+    if (!metadata.flow)
+    {
+        metadata.flowHash = 0;
+        return;
+    }
+    if (egressVlanId)
+    {
+        metadata.flow->key.vlanId = *egressVlanId;
+    }
+
+    const auto& flow = *metadata.flow;
+    if (_options.hashFunction == HashFunction::Fast)
+    {
+        metadata.flowHash = demo::FastFlowHash(flow.key, !flow.isFragment);
+        return;
+    }
+
+    // RSS hashes the ports of TCP and, if enabled, of UDP, but never of fragments
+    const bool isTcp = flow.key.protocol == demo::ToUnderlying(demo::Ip4Protocol::TCP);
+    const bool isUdp = flow.key.protocol == demo::ToUnderlying(demo::Ip4Protocol::UDP);
+    const bool hashPorts = !flow.isFragment && (isTcp || (_options.hashUdpPorts && isUdp));
+    metadata.flowHash = _toeplitzHash.Hash(flow.key, hashPorts);
+}
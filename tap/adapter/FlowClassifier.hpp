@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "FrameMetadata.hpp"
+#include "FlowHash.hpp"
+
+#include "asio/ts/buffer.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// First stage of the forwarding pipeline: extracts the flow key of IPv4 and IPv6 frames and hashes it, so that
+/// the per-flow stages (statistics, tracing) neither parse nor hash the frame again.
+/// </summary>
+class FlowClassifier
+{
+public:
+    enum struct HashFunction : std::uint8_t
+    {
+        // RSS compatible, see demo::ToeplitzHash
+        Toeplitz,
+        // cheaper, see demo::FastFlowHash
+        Fast,
+    };
+
+    struct Options
+    {
+        HashFunction hashFunction = HashFunction::Toeplitz;
+        demo::ToeplitzHash::Key toeplitzKey = demo::ToeplitzHash::defaultKey;
+        // hash the ports of UDP as well as of TCP, like "ethtool -N <dev> rx-flow-hash udp4 sdfn"
+        bool hashUdpPorts = true;
+    };
+
+    explicit FlowClassifier(Options options);
+
+    /// <summary>
+    /// Parses the hash function of the command line, "toeplitz" or "fast".
+    /// </summary>
+    static auto ParseHashFunction(const std::string& name) -> std::optional<HashFunction>;
+
+    /// <summary>
+    /// Fills in the flow and its hash, leaves them empty for other frames. Never throws.
+    /// </summary>
+    /// <param name="egressVlanId">The VLAN the pipeline tags the frame with later on, it replaces the VLAN of the
+    /// key, so that both directions of a flow get the same key.</param>
+    void Classify(asio::const_buffer frame, FrameMetadata& metadata,
+                  std::optional<std::uint16_t> egressVlanId = std::nullopt) const;
+
+private:
+    Options _options;
+    demo::ToeplitzHash _toeplitzHash;
+};
+
+} // namespace adapters
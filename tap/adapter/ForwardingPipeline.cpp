@@ -0,0 +1,352 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "ForwardingPipeline.hpp"
+#include "MulticastSnooping.hpp"
+#include "SomeIpStatistics.hpp"
+#include "Metrics.hpp"
+#include "LatencyHistogram.hpp"
+#include "Tracepoints.hpp"
+#include "FrameTrace.hpp"
+#include "PcapngCapture.hpp"
+#include "FlightRecorder.hpp"
+#include "FlowClassifier.hpp"
+#include "MtuAdaptation.hpp"
+#include "NeighborProxy.hpp"
+#include "LoopSuppression.hpp"
+#include "EthernetHeader.hpp"
+
+using namespace adapters;
+using namespace SilKit::Services::Ethernet;
+
+ForwardingPipeline::ForwardingPipeline(Features features, FrameEndpoint& endpoint, SilKitSender sendToSilKit)
+    : _features{features}
+    , _endpoint{endpoint}
+    , _sendToSilKit{std::move(sendToSilKit)}
+{
+}
+
+void ForwardingPipeline::ForwardToSilKit(std::vector<std::uint8_t> data)
+{
+    const auto& vlanId = _features.vlanId;
+    auto* pipelineLatency = _features.pipelineLatency;
+
+    const auto ingressNs = pipelineLatency ? PipelineLatency::Now() : 0;
+    auto stageStartNs = ingressNs;
+
+    if (_features.loopSuppression
+        && _features.loopSuppression->IsLoopedBack(Direction::TapToSilKit, asio::buffer(data)))
+    {
+        metrics::Increment(metrics::Counter::DropsTapToSilKitLoop);
+        TAP_ADAPTER_PROBE2(frame_dropped, ToIndex(Direction::TapToSilKit),
+                           static_cast<std::size_t>(metrics::Counter::DropsTapToSilKitLoop));
+        return;
+    }
+
+    if (_features.neighborProxy && _features.neighborProxy->AnswerTapFrame(asio::buffer(data), _neighborProxyReply))
+    {
+        // resolved from the cache, the request does not go to SIL Kit
+        SendToEndpoint(_neighborProxyReply);
+        metrics::Increment(metrics::Counter::NeighborProxyReplies);
+        return;
+    }
+
+    FrameMetadata metadata;
+    if (_features.flowClassifier)
+    {
+        _features.flowClassifier->Classify(asio::buffer(data), metadata, vlanId);
+    }
+
+    if (_features.multicastSnooping)
+    {
+        _features.multicastSnooping->SnoopTapFrame(asio::buffer(data));
+    }
+
+    if (_features.someIpStatistics)
+    {
+        CountSomeIpMessages(Direction::TapToSilKit, asio::buffer(data), metadata);
+    }
+
+    if (pipelineLatency)
+    {
+        stageStartNs = pipelineLatency->Record(PipelineLatency::Stage::TapToSilKitParse, stageStartNs);
+    }
+
+    if (_features.mtuAdaptation)
+    {
+        switch (_features.mtuAdaptation->AdaptToSilKit(data, metadata, _adaptedFramesToSilKit))
+        {
+        case MtuAdaptation::Verdict::Forward:
+            break;
+        case MtuAdaptation::Verdict::Fragmented:
+            for (auto& fragment : _adaptedFramesToSilKit)
+            {
+                SendToSilKit(std::move(fragment), metadata, ingressNs, stageStartNs);
+            }
+            return;
+        case MtuAdaptation::Verdict::TooBig:
+            for (const auto& reply : _adaptedFramesToSilKit)
+            {
+                SendToEndpoint(reply);
+            }
+            metrics::Increment(metrics::Counter::DropsTapToSilKitPacketTooBig);
+            TAP_ADAPTER_PROBE2(frame_dropped, ToIndex(Direction::TapToSilKit),
+                               static_cast<std::size_t>(metrics::Counter::DropsTapToSilKitPacketTooBig));
+            return;
+        }
+    }
+
+    SendToSilKit(std::move(data), metadata, ingressNs, stageStartNs);
+}
+
+void ForwardingPipeline::SendToSilKit(std::vector<std::uint8_t> data, const FrameMetadata& metadata,
+                                      std::uint64_t ingressNs, std::uint64_t stageStartNs)
+{
+    const auto& vlanId = _features.vlanId;
+    auto* pipelineLatency = _features.pipelineLatency;
+
+    const std::vector<std::uint8_t>* frame = &data;
+    if (vlanId.has_value())
+    {
+        // the tag is inserted while the frame is joined into the reused buffer, instead of moving the payload
+        _frameToSilKit.Clear();
+        vlan::AppendWithVlanTag(_frameToSilKit, asio::buffer(data), *vlanId);
+        _frameToSilKit.PadTo(60);
+        _frameToSilKit.FlattenTo(_taggedFrameToSilKit);
+        frame = &_taggedFrameToSilKit;
+    }
+    else if (data.size() < 60)
+    {
+        data.resize(60, 0);
+    }
+    const auto frameSize = frame->size();
+    const auto transmitId = ++_transmitId;
+
+    if (pipelineLatency)
+    {
+        stageStartNs = pipelineLatency->Record(PipelineLatency::Stage::TapToSilKitVlan, stageStartNs);
+        pipelineLatency->TrackTransmit(transmitId, ingressNs);
+    }
+
+    if (_features.frameTracer)
+    {
+        _features.frameTracer->TraceFrame(Direction::TapToSilKit, frame->data(), frameSize, transmitId, vlanId,
+                                          GetFlowHash(metadata));
+    }
+
+    if (_features.capture)
+    {
+        _features.capture->Capture(Direction::TapToSilKit, frame->data(), frameSize);
+    }
+
+    if (_features.flightRecorder)
+    {
+        _features.flightRecorder->Record(Direction::TapToSilKit, frame->data(), frameSize);
+    }
+
+    if (_features.loopSuppression)
+    {
+        _features.loopSuppression->RememberSent(Direction::TapToSilKit, asio::buffer(*frame));
+    }
+
+    TAP_ADAPTER_PROBE2(send_frame, transmitId, frameSize);
+    _sendToSilKit(*frame, transmitId);
+
+    if (pipelineLatency)
+    {
+        pipelineLatency->Record(PipelineLatency::Stage::TapToSilKitSend, stageStartNs);
+        pipelineLatency->Record(PipelineLatency::Stage::TapToSilKitTotal, ingressNs);
+    }
+    metrics::Increment(metrics::Counter::FramesTapToSilKit);
+    metrics::Increment(metrics::Counter::BytesTapToSilKit, frameSize);
+}
+
+void ForwardingPipeline::ForwardToEndpoint(SilKit::Util::Span<const std::uint8_t> rawFrame)
+{
+    const auto& vlanId = _features.vlanId;
+    auto* pipelineLatency = _features.pipelineLatency;
+
+    const auto ingressNs = pipelineLatency ? PipelineLatency::Now() : 0;
+    auto stageStartNs = ingressNs;
+
+    TAP_ADAPTER_PROBE1(silkit_frame, rawFrame.size());
+
+    if (_features.loopSuppression
+        && _features.loopSuppression->IsLoopedBack(Direction::SilKitToTap,
+                                                   asio::buffer(rawFrame.data(), rawFrame.size())))
+    {
+        metrics::Increment(metrics::Counter::DropsSilKitToTapLoop);
+        TAP_ADAPTER_PROBE2(frame_dropped, ToIndex(Direction::SilKitToTap),
+                           static_cast<std::size_t>(metrics::Counter::DropsSilKitToTapLoop));
+        return;
+    }
+
+    if (_features.capture)
+    {
+        _features.capture->Capture(Direction::SilKitToTap, rawFrame.data(), rawFrame.size());
+    }
+
+    if (_features.flightRecorder)
+    {
+        _features.flightRecorder->Record(Direction::SilKitToTap, rawFrame.data(), rawFrame.size());
+    }
+
+    if (_features.multicastSnooping
+        && !_features.multicastSnooping->ShouldForwardToTap(asio::buffer(rawFrame.data(), rawFrame.size())))
+    {
+        // No host on the TAP device side joined the multicast group, drop frame
+        metrics::Increment(metrics::Counter::DropsSilKitToTapMulticastNotJoined);
+        TAP_ADAPTER_PROBE2(frame_dropped, ToIndex(Direction::SilKitToTap),
+                           static_cast<std::size_t>(metrics::Counter::DropsSilKitToTapMulticastNotJoined));
+        return;
+    }
+
+    std::optional<std::uint16_t> vid;
+    if (vlanId.has_value())
+    {
+        vid = vlan::ExtractVlanId(rawFrame);
+        if (!vid.has_value() || *vid != *vlanId)
+        {
+            // No 802.1Q tag or VLAN ID mismatch, drop frame
+            metrics::Increment(metrics::Counter::DropsSilKitToTapVlanMismatch);
+            TAP_ADAPTER_PROBE2(frame_dropped, ToIndex(Direction::SilKitToTap),
+                               static_cast<std::size_t>(metrics::Counter::DropsSilKitToTapVlanMismatch));
+            return;
+        }
+    }
+
+    if (_features.neighborProxy)
+    {
+        _features.neighborProxy->LearnFromSilKitFrame(asio::buffer(rawFrame.data(), rawFrame.size()));
+    }
+
+    const std::uint8_t* frame = rawFrame.data();
+    std::size_t frameSize = rawFrame.size();
+    if (_features.mtuAdaptation)
+    {
+        const auto adaptedFrame =
+            _features.mtuAdaptation->AdaptToEndpoint(asio::buffer(frame, frameSize), _adaptedFrameToEndpoint);
+        if (!adaptedFrame)
+        {
+            // a fragment, kept until its datagram is complete
+            return;
+        }
+        frame = static_cast<const std::uint8_t*>(adaptedFrame->data());
+        frameSize = adaptedFrame->size();
+    }
+
+    // frames dropped above are not classified, reassembled datagrams are classified as a whole
+    FrameMetadata metadata;
+    if (_features.flowClassifier)
+    {
+        _features.flowClassifier->Classify(asio::buffer(frame, frameSize), metadata);
+    }
+
+    if (_features.someIpStatistics)
+    {
+        CountSomeIpMessages(Direction::SilKitToTap, asio::buffer(frame, frameSize), metadata);
+    }
+
+    if (pipelineLatency)
+    {
+        stageStartNs = pipelineLatency->Record(PipelineLatency::Stage::SilKitToTapParse, stageStartNs);
+    }
+
+    const auto receivedFrame = SilKit::Util::Span<const std::uint8_t>{frame, frameSize};
+    if (vlanId.has_value())
+    {
+        // written around the tag as a gather list, the frame is not copied
+        _frameToEndpoint.Clear();
+        vlan::AppendWithoutVlanTag(_frameToEndpoint, asio::buffer(frame, frameSize));
+        frameSize = _frameToEndpoint.GetSize();
+        if (pipelineLatency)
+        {
+            stageStartNs = pipelineLatency->Record(PipelineLatency::Stage::SilKitToTapVlan, stageStartNs);
+        }
+    }
+
+    // remembered before the write, the frame may be read back from the TAP device before the write returns
+    if (_features.loopSuppression)
+    {
+        if (vlanId.has_value())
+        {
+            _features.loopSuppression->RememberSent(Direction::SilKitToTap, _frameToEndpoint);
+        }
+        else
+        {
+            _features.loopSuppression->RememberSent(Direction::SilKitToTap, asio::buffer(frame, frameSize));
+        }
+    }
+
+    TAP_ADAPTER_PROBE1(tap_write, frameSize);
+    if (vlanId.has_value())
+    {
+        _endpoint.SendSegments(_frameToEndpoint);
+    }
+    else
+    {
+        _endpoint.Send(frame, frameSize);
+    }
+    if (pipelineLatency)
+    {
+        pipelineLatency->Record(PipelineLatency::Stage::SilKitToTapWrite, stageStartNs);
+        pipelineLatency->Record(PipelineLatency::Stage::SilKitToTapTotal, ingressNs);
+    }
+    metrics::Increment(metrics::Counter::FramesSilKitToTap);
+    metrics::Increment(metrics::Counter::BytesSilKitToTap, frameSize);
+
+    if (_features.frameTracer)
+    {
+        _features.frameTracer->TraceFrame(Direction::SilKitToTap, receivedFrame.data(), receivedFrame.size(), 0, vid,
+                                          GetFlowHash(metadata));
+    }
+}
+
+void ForwardingPipeline::SendToEndpoint(const std::vector<std::uint8_t>& frame)
+{
+    if (_features.loopSuppression)
+    {
+        _features.loopSuppression->RememberSent(Direction::SilKitToTap, asio::buffer(frame));
+    }
+    _endpoint.Send(frame.data(), frame.size());
+}
+
+void ForwardingPipeline::CountSomeIpMessages(Direction direction, asio::const_buffer frame,
+                                             const FrameMetadata& metadata)
+{
+    if (metadata.flow)
+    {
+        _features.someIpStatistics->CountFrame(direction, frame, *metadata.flow);
+    }
+    else if (!_features.flowClassifier)
+    {
+        _features.someIpStatistics->CountFrame(direction, frame);
+    }
+    // else neither IPv4 nor IPv6, no SOME/IP
+}
+
+auto ForwardingPipeline::GetFlowHash(const FrameMetadata& metadata) -> std::optional<std::uint32_t>
+{
+    return metadata.flow ? std::make_optional(metadata.flowHash) : std::nullopt;
+}
+
+void ForwardingPipeline::OnTransmitAck(std::intptr_t transmitId, EthernetTransmitStatus status)
+{
+    TAP_ADAPTER_PROBE2(transmit_ack, transmitId, static_cast<int>(status));
+    if (_features.pipelineLatency)
+    {
+        _features.pipelineLatency->RecordTransmitAck(transmitId);
+    }
+
+    metrics::Increment(status == EthernetTransmitStatus::Transmitted ? metrics::Counter::TransmitAcks
+                                                                     : metrics::Counter::TransmitNacks);
+    if (_features.frameTracer)
+    {
+        _features.frameTracer->TraceTransmitStatus(transmitId, status);
+    }
+
+    if (_features.flightRecorder && status != EthernetTransmitStatus::Transmitted)
+    {
+        _features.flightRecorder->CountNack();
+    }
+}
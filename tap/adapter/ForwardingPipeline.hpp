@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "Direction.hpp"
+#include "FrameEndpoint.hpp"
+#include "FrameMetadata.hpp"
+
+#include "asio/ts/buffer.hpp"
+
+#include "silkit/services/ethernet/all.hpp"
+
+namespace adapters {
+
+class MulticastSnooping;
+class SomeIpStatistics;
+class PipelineLatency;
+class FrameTracer;
+class PcapngCapture;
+class FlightRecorder;
+class FlowClassifier;
+class MtuAdaptation;
+class NeighborProxy;
+class LoopSuppression;
+
+/// <summary>
+/// Forwarding of frames between a frame endpoint (the TAP device) and SIL Kit, with VLAN tagging and the
+/// optional observation features. Independent of the SIL Kit participant, so that it can be driven by a
+/// loopback endpoint and a stub sender in benchmarks.
+/// </summary>
+class ForwardingPipeline
+{
+public:
+    /// <summary>
+    /// Optional features, null if disabled. They are not owned by the pipeline.
+    /// </summary>
+    struct Features
+    {
+        std::optional<std::uint16_t> vlanId;
+        FlowClassifier* flowClassifier = nullptr;
+        MtuAdaptation* mtuAdaptation = nullptr;
+        NeighborProxy* neighborProxy = nullptr;
+        LoopSuppression* loopSuppression = nullptr;
+        MulticastSnooping* multicastSnooping = nullptr;
+        SomeIpStatistics* someIpStatistics = nullptr;
+        PipelineLatency* pipelineLatency = nullptr;
+        FrameTracer* frameTracer = nullptr;
+        PcapngCapture* capture = nullptr;
+        FlightRecorder* flightRecorder = nullptr;
+    };
+
+    // sends a frame to SIL Kit, the transmit id comes back with its acknowledgment
+    using SilKitSender = std::function<void(const std::vector<std::uint8_t>& frame, std::intptr_t transmitId)>;
+
+    ForwardingPipeline(Features features, FrameEndpoint& endpoint, SilKitSender sendToSilKit);
+
+    /// <summary>
+    /// Forwards a frame received from the endpoint to SIL Kit. Called on the io_context.
+    /// </summary>
+    void ForwardToSilKit(std::vector<std::uint8_t> frame);
+
+    /// <summary>
+    /// Forwards a frame received from SIL Kit to the endpoint, unless it is filtered.
+    /// </summary>
+    void ForwardToEndpoint(SilKit::Util::Span<const std::uint8_t> rawFrame);
+
+    /// <summary>
+    /// Handles the transmit acknowledgment of SIL Kit for a frame sent by ForwardToSilKit.
+    /// </summary>
+    void OnTransmitAck(std::intptr_t transmitId, SilKit::Services::Ethernet::EthernetTransmitStatus status);
+
+private:
+    void SendToSilKit(std::vector<std::uint8_t> data, const FrameMetadata& metadata, std::uint64_t ingressNs,
+                      std::uint64_t stageStartNs);
+    // the frames the pipeline generates itself for the endpoint, the replies of the neighbor proxy and MTU adaptation
+    void SendToEndpoint(const std::vector<std::uint8_t>& frame);
+    void CountSomeIpMessages(Direction direction, asio::const_buffer frame, const FrameMetadata& metadata);
+    static auto GetFlowHash(const FrameMetadata& metadata) -> std::optional<std::uint32_t>;
+
+    Features _features;
+    FrameEndpoint& _endpoint;
+    SilKitSender _sendToSilKit;
+    std::intptr_t _transmitId{0};
+    // reused by the MTU adaptation, the first one on the io_context, the second one on the SIL Kit thread
+    std::vector<std::vector<std::uint8_t>> _adaptedFramesToSilKit;
+    std::vector<std::uint8_t> _adaptedFrameToEndpoint;
+    // reused for the replies of the neighbor proxy, on the io_context
+    std::vector<std::uint8_t> _neighborProxyReply;
+    // reused for the VLAN tagging, on the io_context, and the untagging, on the SIL Kit thread
+    demo::FrameBuilder _frameToSilKit;
+    std::vector<std::uint8_t> _taggedFrameToSilKit;
+    demo::FrameBuilder _frameToEndpoint;
+};
+
+} // namespace adapters
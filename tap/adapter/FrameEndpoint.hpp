@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "FrameBuilder.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// Local side of the adapter: the source of the frames forwarded to SIL Kit and the sink of the frames
+/// received from it. Implemented by the TAP device connection and by an in-memory loopback.
+/// </summary>
+class FrameEndpoint
+{
+public:
+    using FrameHandler = std::function<void(std::vector<std::uint8_t>)>;
+
+    struct Statistics
+    {
+        std::uint64_t receivedFrames;
+        std::uint64_t receivedBytes;
+        // number of wakeups which delivered frames, receivedFrames / receiveBursts is the average burst size
+        std::uint64_t receiveBursts;
+        std::uint64_t sentFrames;
+        std::uint64_t sentBytes;
+    };
+
+    virtual ~FrameEndpoint() = default;
+
+    /// <summary>
+    /// Starts the reception, the handler is called on the io_context for every received frame.
+    /// Frames which are ready at the same time are delivered as a burst of consecutive calls.
+    /// </summary>
+    virtual void StartReceiving(FrameHandler onFrameHandler) = 0;
+
+    /// <summary>
+    /// Sets a handler which is called on the io_context when the reception failed for good.
+    /// </summary>
+    virtual void SetFatalReadErrorHandler(std::function<void()> handler) = 0;
+
+    /// <summary>
+    /// Sends a frame, throws if it cannot be sent completely. May be called from any thread.
+    /// </summary>
+    virtual void Send(const std::uint8_t* frame, std::size_t frameSize) = 0;
+
+    /// <summary>
+    /// Sends a frame composed of segments, as a gather list where the endpoint can write one, so that the
+    /// segments are not joined first. Throws like Send. May be called from any thread.
+    /// </summary>
+    virtual void SendSegments(const demo::FrameBuilder& frame) = 0;
+
+    virtual auto GetStatistics() const -> Statistics = 0;
+};
+
+} // namespace adapters
@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "FlowKey.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// What the stages of the forwarding pipeline learned about a frame, handed to the later stages along with it.
+/// The offsets of the flow refer to the frame as the pipeline received it, before VLAN tags are added or removed.
+/// </summary>
+struct FrameMetadata
+{
+    // empty if flow classification is disabled or the frame is neither IPv4 nor IPv6
+    std::optional<demo::Flow> flow;
+    std::uint32_t flowHash{0};
+};
+
+} // namespace adapters
@@ -0,0 +1,371 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "FrameTrace.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+#include "EthernetHeader.hpp"
+#include "ArpIp4Packet.hpp"
+#include "Ip4Header.hpp"
+#include "Icmp4Header.hpp"
+#include "IgmpMessage.hpp"
+#include "Ip6Header.hpp"
+#include "Icmp6Header.hpp"
+#include "UdpHeader.hpp"
+#include "TcpHeader.hpp"
+
+#include "silkit/services/ethernet/string_utils.hpp"
+
+using namespace adapters;
+
+namespace {
+
+constexpr std::size_t maxBatchSize = 1024;
+constexpr std::size_t maxTrackedFlows = 65536;
+constexpr auto idleInterval = std::chrono::milliseconds{5};
+constexpr std::uint64_t reportIntervalNs = 1'000'000'000;
+
+std::atomic<std::uint64_t> nextTracerId{1};
+
+class FlowHash
+{
+public:
+    void Add(const std::uint8_t* data, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            _hash = (_hash ^ data[i]) * 0x100000001B3ull;
+        }
+    }
+
+    auto Get() const -> std::uint64_t
+    {
+        return _hash;
+    }
+
+private:
+    std::uint64_t _hash{0xCBF29CE484222325ull};
+};
+
+// Identifies the flow of a frame from the captured bytes: IP addresses, protocol and ports for IP,
+// Ethernet addresses and EtherType for everything else.
+auto GetFlowKey(const TraceRecord& record) -> std::uint64_t
+{
+    const auto* data = record.captured.data();
+    const std::size_t size = record.capturedSize;
+
+    FlowHash hash;
+    hash.Add(reinterpret_cast<const std::uint8_t*>(&record.direction), 1);
+
+    std::size_t offset = 12;
+    while (offset + 2 <= size && (demo::ReadUintBe<std::uint16_t>(asio::buffer(data + offset, 2)) == 0x8100
+                                  || demo::ReadUintBe<std::uint16_t>(asio::buffer(data + offset, 2)) == 0x88A8))
+    {
+        hash.Add(data + offset + 2, 2); // VLAN ID is part of the flow
+        offset += 4;
+    }
+    if (offset + 2 > size)
+    {
+        hash.Add(data, size);
+        return hash.Get();
+    }
+
+    const auto etherType = demo::ReadUintBe<std::uint16_t>(asio::buffer(data + offset, 2));
+    const auto l3 = offset + 2;
+    if (etherType == demo::ToUnderlying(demo::EtherType::Ip4) && l3 + 20 <= size)
+    {
+        const std::size_t headerLength = (data[l3] & 0x0Fu) * 4u;
+        hash.Add(data + l3 + 9, 1); // protocol
+        hash.Add(data + l3 + 12, 8); // addresses
+        if (l3 + headerLength + 4 <= size)
+        {
+            hash.Add(data + l3 + headerLength, 4); // ports
+        }
+    }
+    else if (etherType == demo::ToUnderlying(demo::EtherType::Ip6) && l3 + 40 <= size)
+    {
+        hash.Add(data + l3 + 6, 1); // next header
+        hash.Add(data + l3 + 8, 32); // addresses
+        if (l3 + 44 <= size)
+        {
+            hash.Add(data + l3 + 40, 4); // ports
+        }
+    }
+    else
+    {
+        hash.Add(data, std::min<std::size_t>(size, 14));
+    }
+    return hash.Get();
+}
+
+// Prints the headers of all layers the adapter knows, stops at the first one which does not parse.
+void WriteHeaders(std::ostream& out, asio::const_buffer frame)
+{
+    try
+    {
+        const auto [ethernetHeader, ethernetPayload] = demo::ParseEthernetHeader(frame);
+        out << " " << ethernetHeader;
+
+        asio::const_buffer transportPayload;
+        std::uint8_t protocol = 0;
+
+        switch (ethernetHeader.etherType)
+        {
+        case demo::EtherType::Arp:
+            out << " " << demo::ParseArpIp4Packet(ethernetPayload);
+            return;
+        case demo::EtherType::Ip4:
+        {
+            const auto [ip4Header, ip4Payload] = demo::ParseIp4Header(ethernetPayload);
+            out << " " << ip4Header;
+            if (ip4Header.fragmentOffset != 0)
+            {
+                return;
+            }
+            transportPayload = ip4Payload;
+            protocol = demo::ToUnderlying(ip4Header.protocol);
+            break;
+        }
+        case demo::EtherType::Ip6:
+        {
+            const auto [ip6Header, ip6Payload] = demo::ParseIp6Header(ethernetPayload);
+            out << " " << ip6Header;
+            const auto [upperLayerProtocol, upperLayerPayload] =
+                demo::SkipIp6ExtensionHeaders(ip6Header.nextHeader, ip6Payload);
+            transportPayload = upperLayerPayload;
+            protocol = demo::ToUnderlying(upperLayerProtocol);
+            break;
+        }
+        default:
+            return;
+        }
+
+        if (protocol == demo::ToUnderlying(demo::Ip4Protocol::ICMP))
+        {
+            const auto [icmp4Header, icmp4Payload] = demo::ParseIcmp4Header(transportPayload);
+            out << " " << icmp4Header << " + " << icmp4Payload.size() << " bytes payload";
+        }
+        else if (protocol == demo::ToUnderlying(demo::Ip4Protocol::IGMP))
+        {
+            out << " " << demo::ParseIgmpHeader(transportPayload).header;
+        }
+        else if (protocol == demo::ToUnderlying(demo::Ip6NextHeader::ICMPv6))
+        {
+            out << " " << demo::ParseIcmp6Header(transportPayload).header;
+        }
+        else if (protocol == demo::ToUnderlying(demo::Ip4Protocol::UDP))
+        {
+            const auto [udpHeader, udpPayload] = demo::ParseUdpHeader(transportPayload);
+            out << " " << udpHeader << " + " << udpPayload.size() << " bytes payload";
+        }
+        else if (protocol == demo::ToUnderlying(demo::Ip4Protocol::TCP))
+        {
+            const auto [tcpHeader, tcpPayload] = demo::ParseTcpHeader(transportPayload);
+            out << " " << tcpHeader << " + " << tcpPayload.size() << " bytes payload";
+        }
+    }
+    catch (const std::exception&)
+    {
+        out << " (truncated)";
+    }
+}
+
+} // namespace
+
+FrameTracer::FrameTracer(SilKit::Services::Logging::ILogger* logger, std::string localSideName, Options options)
+    : _id{nextTracerId++}
+    , _logger{logger}
+    , _localSideName{std::move(localSideName)}
+    , _options{options}
+    , _startNs{Now()}
+{
+    _batch.reserve(maxBatchSize);
+    _lineTokens = _options.maxLinesPerSecond;
+    _lastRefillNs = _startNs;
+    _lastReportNs = _startNs;
+    _thread = std::thread{[this] { Run(); }};
+}
+
+FrameTracer::~FrameTracer()
+{
+    _stopRequested = true;
+    _thread.join();
+}
+
+auto FrameTracer::RegisterRing() -> Ring*
+{
+    std::lock_guard<std::mutex> lock{_ringsMutex};
+    _rings.push_back(std::make_unique<Ring>(_options.ringCapacity));
+    return _rings.back().get();
+}
+
+void FrameTracer::Run()
+{
+    while (!_stopRequested)
+    {
+        if (!Drain())
+        {
+            std::this_thread::sleep_for(idleInterval);
+        }
+    }
+
+    // log what the forwarding threads traced before the adapter stopped
+    while (Drain())
+    {
+    }
+    ReportSuppressed(Now() + reportIntervalNs);
+}
+
+auto FrameTracer::Drain() -> bool
+{
+    _batch.clear();
+    std::uint64_t overruns = 0;
+    {
+        std::lock_guard<std::mutex> lock{_ringsMutex};
+        for (auto& ring : _rings)
+        {
+            const auto tail = ring->tail.load(std::memory_order_relaxed);
+            const auto head = ring->head.load(std::memory_order_acquire);
+            const auto count = std::min<std::uint64_t>(head - tail, maxBatchSize / _rings.size() + 1);
+            for (std::uint64_t index = tail; index < tail + count; ++index)
+            {
+                _batch.push_back(ring->records[index & ring->mask]);
+            }
+            ring->tail.store(tail + count, std::memory_order_release);
+            overruns += ring->overruns.load(std::memory_order_relaxed);
+        }
+    }
+
+    // records of different threads are logged in the order they were taken
+    std::stable_sort(_batch.begin(), _batch.end(), [](const TraceRecord& lhs, const TraceRecord& rhs) {
+        return lhs.timestampNs < rhs.timestampNs;
+    });
+
+    const auto nowNs = Now();
+    for (const auto& record : _batch)
+    {
+        if (!IsSampled(record))
+        {
+            ++_sampledOut;
+        }
+        else if (!IsWithinRateLimit(nowNs))
+        {
+            ++_rateLimited;
+        }
+        else
+        {
+            Log(record);
+        }
+    }
+
+    _overruns = overruns;
+    ReportSuppressed(nowNs);
+    return !_batch.empty();
+}
+
+auto FrameTracer::IsSampled(const TraceRecord& record) -> bool
+{
+    if (record.event != TraceEvent::Frame || _options.flowSampleRate <= 1)
+    {
+        return true;
+    }
+
+    if (_flowRecordCounts.size() >= maxTrackedFlows)
+    {
+        _flowRecordCounts.clear();
+    }
+
+    // the direction is part of the flow, as in GetFlowKey
+    const auto flowKey = record.flowHash != 0
+                             ? (std::uint64_t{record.flowHash} << 32u) | ToIndex(record.direction)
+                             : GetFlowKey(record);
+    const auto recordIndex = _flowRecordCounts[flowKey]++;
+    return recordIndex < _options.flowBurst || (recordIndex - _options.flowBurst) % _options.flowSampleRate == 0;
+}
+
+auto FrameTracer::IsWithinRateLimit(std::uint64_t nowNs) -> bool
+{
+    if (_options.maxLinesPerSecond == 0)
+    {
+        return true;
+    }
+
+    // token bucket holding at most one second worth of lines
+    const auto elapsedSeconds = static_cast<double>(nowNs - _lastRefillNs) / 1e9;
+    _lastRefillNs = nowNs;
+    _lineTokens = std::min<double>(_options.maxLinesPerSecond,
+                                   _lineTokens + elapsedSeconds * _options.maxLinesPerSecond);
+    if (_lineTokens < 1.0)
+    {
+        return false;
+    }
+    _lineTokens -= 1.0;
+    return true;
+}
+
+void FrameTracer::ReportSuppressed(std::uint64_t nowNs)
+{
+    if (nowNs - _lastReportNs < reportIntervalNs
+        || (_sampledOut == 0 && _rateLimited == 0 && _overruns == _loggedOverruns))
+    {
+        return;
+    }
+    _lastReportNs = nowNs;
+
+    std::ostringstream SILKitDebugMessage;
+    SILKitDebugMessage << "Frame trace: " << _sampledOut << " records sampled out, " << _rateLimited
+                       << " records over the rate limit, " << _overruns - _loggedOverruns
+                       << " records lost (trace ring full)";
+    _logger->Debug(SILKitDebugMessage.str());
+
+    _sampledOut = 0;
+    _rateLimited = 0;
+    _loggedOverruns = _overruns;
+}
+
+void FrameTracer::Log(const TraceRecord& record)
+{
+    std::ostringstream SILKitDebugMessage;
+    SILKitDebugMessage << "[+" << std::fixed << std::setprecision(6)
+                       << static_cast<double>(record.timestampNs - _startNs) / 1e9 << "s] ";
+
+    const auto* source = record.direction == Direction::TapToSilKit ? _localSideName.c_str() : "SIL Kit";
+    const auto* destination = record.direction == Direction::TapToSilKit ? "SIL Kit" : _localSideName.c_str();
+
+    if (record.event == TraceEvent::TransmitStatus)
+    {
+        const auto status = static_cast<SilKit::Services::Ethernet::EthernetTransmitStatus>(record.transmitStatus);
+        SILKitDebugMessage << destination << " >> " << source << ": ";
+        if (status == SilKit::Services::Ethernet::EthernetTransmitStatus::Transmitted)
+        {
+            SILKitDebugMessage << "ACK for ETH Message with transmitId=" << record.transmitId;
+        }
+        else
+        {
+            SILKitDebugMessage << "NACK for ETH Message with transmitId=" << record.transmitId << ": " << status;
+        }
+        _logger->Debug(SILKitDebugMessage.str());
+        return;
+    }
+
+    SILKitDebugMessage << source << " >> " << destination << ": Ethernet frame (" << record.frameSize << " bytes";
+    if (record.transmitId != 0)
+    {
+        SILKitDebugMessage << ", txId=" << record.transmitId;
+    }
+    if (record.vlanId != TraceRecord::noVlanId)
+    {
+        SILKitDebugMessage << ", VLAN ID " << record.vlanId;
+    }
+    SILKitDebugMessage << ")";
+
+    // the parsers check the lengths in the headers against the buffer, so the bytes which were not
+    // captured are replaced by zeros
+    _formatBuffer.assign(record.captured.begin(), record.captured.begin() + record.capturedSize);
+    _formatBuffer.resize(record.frameSize, 0);
+    WriteHeaders(SILKitDebugMessage, asio::buffer(_formatBuffer));
+
+    _logger->Debug(SILKitDebugMessage.str());
+}
@@ -0,0 +1,232 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Direction.hpp"
+
+#include "silkit/services/ethernet/all.hpp"
+#include "silkit/services/logging/all.hpp"
+
+namespace adapters {
+
+enum struct TraceEvent : std::uint8_t
+{
+    Frame,
+    TransmitStatus,
+};
+
+/// <summary>
+/// Fixed-size binary trace record. Only the leading bytes of a frame are kept, they are parsed
+/// and formatted on the trace thread.
+/// </summary>
+struct TraceRecord
+{
+    static constexpr std::size_t maxCapturedSize = 96;
+    static constexpr std::uint16_t noVlanId = 0xFFFF;
+
+    std::uint64_t timestampNs;
+    std::int64_t transmitId;
+    std::uint32_t frameSize;
+    TraceEvent event;
+    Direction direction;
+    std::uint8_t capturedSize;
+    std::uint8_t transmitStatus;
+    std::uint16_t vlanId;
+    std::array<std::uint8_t, maxCapturedSize> captured;
+    // hash of the flow classifier, 0 if the frame was not classified
+    std::uint32_t flowHash;
+};
+
+static_assert(sizeof(TraceRecord) == 128, "trace records should fill exactly two cache lines");
+
+/// <summary>
+/// Asynchronous frame trace for the debug log.
+///
+///   The forwarding threads copy a TraceRecord into a lock-free ring of their own, which costs a
+///   timestamp and a memcpy of at most 128 bytes. A background thread drains the rings, parses the
+///   captured headers and logs one line per record with the SIL Kit logger. The background thread
+///   limits the number of lines per second and, after the first records of each flow, only logs
+///   every n-th record of the flow. Records are lost rather than blocking if a ring runs full.
+/// </summary>
+class FrameTracer
+{
+public:
+    struct Options
+    {
+        // ring size per forwarding thread, must be a power of two
+        std::size_t ringCapacity = 4096;
+        // 0 disables the limit
+        std::uint32_t maxLinesPerSecond = 1000;
+        // records of a flow which are always logged before sampling starts
+        std::uint32_t flowBurst = 8;
+        // log every n-th record of a flow after the burst
+        std::uint32_t flowSampleRate = 1;
+    };
+
+    /// <param name="localSideName">Name of the non-SIL Kit side in the log lines, e.g. "TAP device".</param>
+    FrameTracer(SilKit::Services::Logging::ILogger* logger, std::string localSideName, Options options);
+    ~FrameTracer();
+
+    FrameTracer(const FrameTracer&) = delete;
+    FrameTracer& operator=(const FrameTracer&) = delete;
+
+    /// <summary>
+    /// Traces a frame forwarded in the given direction.
+    /// </summary>
+    /// <param name="transmitId">User context passed to SendFrame, 0 if there is none.</param>
+    /// <param name="flowHash">Hash of the flow classifier, which then identifies the flow instead of the captured
+    /// bytes.</param>
+    void TraceFrame(Direction direction, const std::uint8_t* frame, std::size_t frameSize, std::intptr_t transmitId = 0,
+                    std::optional<std::uint16_t> vlanId = std::nullopt,
+                    std::optional<std::uint32_t> flowHash = std::nullopt)
+    {
+        auto& ring = GetThreadRing();
+        auto* record = BeginRecord(ring);
+        if (record == nullptr)
+        {
+            return;
+        }
+        record->event = TraceEvent::Frame;
+        record->direction = direction;
+        record->transmitId = transmitId;
+        record->frameSize = static_cast<std::uint32_t>(frameSize);
+        record->vlanId = vlanId.value_or(TraceRecord::noVlanId);
+        record->flowHash = flowHash.value_or(0);
+        record->capturedSize = static_cast<std::uint8_t>(std::min(frameSize, TraceRecord::maxCapturedSize));
+        std::memcpy(record->captured.data(), frame, record->capturedSize);
+        CommitRecord(ring);
+    }
+
+    /// <summary>
+    /// Traces the ACK or NACK of SIL Kit for a frame sent to SIL Kit.
+    /// </summary>
+    void TraceTransmitStatus(std::intptr_t transmitId, SilKit::Services::Ethernet::EthernetTransmitStatus status)
+    {
+        auto& ring = GetThreadRing();
+        auto* record = BeginRecord(ring);
+        if (record == nullptr)
+        {
+            return;
+        }
+        record->event = TraceEvent::TransmitStatus;
+        record->direction = Direction::TapToSilKit;
+        record->transmitId = transmitId;
+        record->transmitStatus = static_cast<std::uint8_t>(status);
+        record->frameSize = 0;
+        record->capturedSize = 0;
+        CommitRecord(ring);
+    }
+
+private:
+    // single producer (the owning thread), single consumer (the trace thread)
+    struct Ring
+    {
+        explicit Ring(std::size_t capacity)
+            : records{std::make_unique<TraceRecord[]>(capacity)}
+            , mask{capacity - 1}
+        {
+        }
+
+        std::unique_ptr<TraceRecord[]> records;
+        std::size_t mask;
+        alignas(64) std::atomic<std::uint64_t> head{0};
+        std::uint64_t cachedTail{0};
+        std::atomic<std::uint64_t> overruns{0};
+        alignas(64) std::atomic<std::uint64_t> tail{0};
+    };
+
+    struct ThreadRing
+    {
+        std::uint64_t tracerId;
+        Ring* ring;
+    };
+
+    static auto Now() -> std::uint64_t
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now().time_since_epoch())
+                                              .count());
+    }
+
+    auto GetThreadRing() -> Ring&
+    {
+        // ids instead of addresses, so that a new tracer at the address of a destroyed one gets new rings
+        thread_local ThreadRing threadRing{0, nullptr};
+        if (threadRing.tracerId != _id)
+        {
+            threadRing = ThreadRing{_id, RegisterRing()};
+        }
+        return *threadRing.ring;
+    }
+
+    static auto BeginRecord(Ring& ring) -> TraceRecord*
+    {
+        const auto head = ring.head.load(std::memory_order_relaxed);
+        if (head - ring.cachedTail > ring.mask)
+        {
+            ring.cachedTail = ring.tail.load(std::memory_order_acquire);
+            if (head - ring.cachedTail > ring.mask)
+            {
+                ring.overruns.store(ring.overruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+        }
+        auto* record = &ring.records[head & ring.mask];
+        record->timestampNs = Now();
+        return record;
+    }
+
+    static void CommitRecord(Ring& ring)
+    {
+        ring.head.store(ring.head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    auto RegisterRing() -> Ring*;
+    void Run();
+    auto Drain() -> bool;
+    void Log(const TraceRecord& record);
+    auto IsSampled(const TraceRecord& record) -> bool;
+    auto IsWithinRateLimit(std::uint64_t nowNs) -> bool;
+    void ReportSuppressed(std::uint64_t nowNs);
+
+    std::uint64_t _id;
+    SilKit::Services::Logging::ILogger* _logger;
+    std::string _localSideName;
+    Options _options;
+    std::uint64_t _startNs;
+
+    std::mutex _ringsMutex;
+    std::vector<std::unique_ptr<Ring>> _rings;
+
+    // state of the trace thread
+    std::vector<TraceRecord> _batch;
+    std::vector<std::uint8_t> _formatBuffer;
+    std::unordered_map<std::uint64_t, std::uint64_t> _flowRecordCounts;
+    double _lineTokens{0};
+    std::uint64_t _lastRefillNs{0};
+    std::uint64_t _lastReportNs{0};
+    std::uint64_t _sampledOut{0};
+    std::uint64_t _rateLimited{0};
+    std::uint64_t _overruns{0};
+    std::uint64_t _loggedOverruns{0};
+
+    std::atomic<bool> _stopRequested{false};
+    std::thread _thread;
+};
+
+} // namespace adapters
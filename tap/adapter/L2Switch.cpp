@@ -0,0 +1,336 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "L2Switch.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "EthernetHeader.hpp"
+#include "Metrics.hpp"
+#include "PacketView.hpp"
+#include "Split.hpp"
+
+using namespace adapters;
+
+namespace {
+
+constexpr std::uint16_t maxVlanId = 4094;
+
+auto ToString(const demo::EthernetAddress& address) -> std::string
+{
+    std::ostringstream stream;
+    stream << address;
+    return stream.str();
+}
+
+bool IsGroupAddress(const demo::EthernetAddress& address)
+{
+    return (address.data[0] & 0x01) != 0;
+}
+
+// The Ethernet address in the low 48 bits, the VLAN ID above, so that each VLAN learns its own addresses
+auto ToKey(std::uint16_t vlanId, const demo::EthernetAddress& address) -> std::uint64_t
+{
+    std::uint64_t key = vlanId;
+    for (const auto byte : address.data)
+    {
+        key = (key << 8) | byte;
+    }
+    return key;
+}
+
+auto ParseVlanId(const std::string& text) -> std::uint16_t
+{
+    const auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+    if (text.empty() || text.size() > 4 || !std::all_of(text.begin(), text.end(), isDigit))
+    {
+        throw std::invalid_argument{"'" + text + "' is not a VLAN ID"};
+    }
+    const auto vlanId = std::stoul(text);
+    if (vlanId < 1 || vlanId > maxVlanId)
+    {
+        throw std::invalid_argument{"VLAN ID " + text + " is not in the range 1 to 4094"};
+    }
+    return static_cast<std::uint16_t>(vlanId);
+}
+
+void ParseVlanMembership(const std::string& list, L2Switch::PortOptions& options)
+{
+    options.untaggedVlanId.reset();
+    for (const auto& term : demo::Split(list, '+'))
+    {
+        if (term.empty() || (term[0] != 'u' && term[0] != 't'))
+        {
+            throw std::invalid_argument{"'" + term + "' is not of the form u<vlan> or t<vlan>"};
+        }
+
+        const auto vlanId = ParseVlanId(term.substr(1));
+        auto& tagged = options.taggedVlanIds;
+        if (options.untaggedVlanId == vlanId || std::find(tagged.begin(), tagged.end(), vlanId) != tagged.end())
+        {
+            throw std::invalid_argument{"port " + options.name + " is a member of VLAN " + term.substr(1)
+                                        + " more than once"};
+        }
+        if (term[0] == 't')
+        {
+            tagged.push_back(vlanId);
+        }
+        else if (options.untaggedVlanId.has_value())
+        {
+            throw std::invalid_argument{"port " + options.name + " is untagged in more than one VLAN"};
+        }
+        else
+        {
+            options.untaggedVlanId = vlanId;
+        }
+    }
+}
+
+} // namespace
+
+constexpr std::chrono::seconds L2Switch::defaultMaxAge;
+constexpr std::size_t L2Switch::defaultMaxEntries;
+constexpr std::uint16_t L2Switch::defaultVlanId;
+constexpr std::chrono::seconds L2Switch::purgeInterval;
+
+auto L2Switch::ParsePorts(const std::string& list) -> std::vector<PortDescription>
+{
+    std::vector<PortDescription> ports;
+    for (const auto& term : demo::Split(list, ','))
+    {
+        const auto colon = term.find(':');
+        const auto kind = term.substr(0, colon == std::string::npos ? 0 : colon);
+        if (kind != "tap" && kind != "network")
+        {
+            throw std::invalid_argument{"'" + term + "' is not of the form tap:<name>[@<vlans>] or "
+                                        "network:<name>[@<vlans>]"};
+        }
+
+        const auto at = term.find('@', colon);
+        PortDescription port{kind == "tap" ? PortDescription::Kind::Tap : PortDescription::Kind::Network, {}};
+        port.options.name = term.substr(colon + 1, at == std::string::npos ? std::string::npos : at - colon - 1);
+        if (port.options.name.empty())
+        {
+            throw std::invalid_argument{"'" + term + "' has no " + kind + " name"};
+        }
+        if (at != std::string::npos)
+        {
+            ParseVlanMembership(term.substr(at + 1), port.options);
+        }
+        const auto isSamePort = [&port](const PortDescription& other) {
+            return other.kind == port.kind && other.options.name == port.options.name;
+        };
+        if (std::any_of(ports.begin(), ports.end(), isSamePort))
+        {
+            throw std::invalid_argument{"the " + kind + " " + port.options.name + " is given more than once"};
+        }
+        ports.push_back(std::move(port));
+    }
+    return ports;
+}
+
+bool L2Switch::Port::IsMember(std::uint16_t vlanId) const
+{
+    return options.untaggedVlanId == vlanId || IsTagged(vlanId);
+}
+
+bool L2Switch::Port::IsTagged(std::uint16_t vlanId) const
+{
+    return std::find(options.taggedVlanIds.begin(), options.taggedVlanIds.end(), vlanId)
+           != options.taggedVlanIds.end();
+}
+
+L2Switch::L2Switch(SilKit::Services::Logging::ILogger* logger, std::chrono::seconds maxAge, std::size_t maxEntries)
+    : _logger(logger)
+    , _maxAge(maxAge)
+    , _maxEntries(maxEntries)
+{
+}
+
+auto L2Switch::AddPort(PortOptions options, PortSender sender) -> PortId
+{
+    auto port = std::make_unique<Port>();
+    port->options = std::move(options);
+    port->sender = std::move(sender);
+    _ports.push_back(std::move(port));
+    return _ports.size() - 1;
+}
+
+auto L2Switch::GetPortOptions(PortId port) const -> const PortOptions&
+{
+    return _ports.at(port)->options;
+}
+
+auto L2Switch::GetPortStatistics(PortId port) const -> PortStatistics
+{
+    const auto& p = *_ports.at(port);
+    return PortStatistics{p.receivedFrames.load(std::memory_order_relaxed),
+                          p.sentFrames.load(std::memory_order_relaxed)};
+}
+
+void L2Switch::Receive(PortId ingressPort, asio::const_buffer frame)
+{
+    auto& ingress = *_ports[ingressPort];
+    ingress.receivedFrames.fetch_add(1, std::memory_order_relaxed);
+
+    const auto ethernet = demo::EthernetView::Parse(frame);
+    if (!ethernet)
+    {
+        metrics::Increment(metrics::Counter::SwitchDropsMalformed);
+        return;
+    }
+
+    // an 802.1Q tag right after the addresses, frames with an 802.1ad tag are switched as untagged frames
+    const auto taggedVlanId = ethernet.HasVlanTag() && !ethernet.HasServiceVlanTag()
+                                  ? std::make_optional(ethernet.GetVlanId())
+                                  : std::nullopt;
+
+    // priority tagged frames (VLAN ID 0) belong to the VLAN of untagged frames
+    std::uint16_t vlanId = 0;
+    if (taggedVlanId.value_or(0) != 0 && ingress.IsTagged(*taggedVlanId))
+    {
+        vlanId = *taggedVlanId;
+    }
+    else if (taggedVlanId.value_or(0) == 0 && ingress.options.untaggedVlanId.has_value())
+    {
+        vlanId = *ingress.options.untaggedVlanId;
+    }
+    else
+    {
+        metrics::Increment(metrics::Counter::SwitchDropsVlanNotMember);
+        return;
+    }
+
+    const auto source = ethernet.GetSource();
+    const auto destination = ethernet.GetDestination();
+    const auto egressPort = LearnAndLookUp(IsGroupAddress(source) ? 0 : ToKey(vlanId, source),
+                                           IsGroupAddress(destination) ? 0 : ToKey(vlanId, destination),
+                                           ingressPort, Clock::now());
+    if (egressPort == ingressPort)
+    {
+        // the destination is on the segment of the ingress port, which has already seen the frame
+        metrics::Increment(metrics::Counter::SwitchDropsSamePort);
+        return;
+    }
+    if (egressPort.has_value())
+    {
+        metrics::Increment(metrics::Counter::SwitchFramesUnicast);
+        SendTo(*_ports[*egressPort], frame, taggedVlanId, vlanId);
+        return;
+    }
+
+    // broadcast, multicast and unknown unicast
+    metrics::Increment(metrics::Counter::SwitchFramesFlooded);
+    for (PortId port = 0; port < _ports.size(); ++port)
+    {
+        if (port != ingressPort && _ports[port]->IsMember(vlanId))
+        {
+            SendTo(*_ports[port], frame, taggedVlanId, vlanId);
+        }
+    }
+}
+
+auto L2Switch::LearnAndLookUp(std::uint64_t sourceKey, std::uint64_t destinationKey, PortId ingressPort,
+                              Clock::time_point now) -> std::optional<PortId>
+{
+    // keys of group addresses are 0, they are never learned or looked up
+    bool isNewStation = false;
+    bool isTableFull = false;
+    std::optional<PortId> egressPort;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        if (sourceKey != 0)
+        {
+            auto it = _entries.find(sourceKey);
+            // the sweep visits the whole table, so a burst of new (or spoofed) stations does not repeat it per frame
+            if (it == _entries.end() && _entries.size() >= _maxEntries && now - _lastPurge >= purgeInterval)
+            {
+                _lastPurge = now;
+                for (auto expired = _entries.begin(); expired != _entries.end();)
+                {
+                    expired = now - expired->second.lastSeen > _maxAge ? _entries.erase(expired) : ++expired;
+                }
+                isTableFull = _entries.size() >= _maxEntries && !_tableFullLogged;
+                _tableFullLogged = _tableFullLogged || isTableFull;
+            }
+            if (it != _entries.end())
+            {
+                // a station which moved to another port is learned there with its next frame
+                isNewStation = it->second.port != ingressPort;
+                it->second = Entry{ingressPort, now};
+            }
+            else if (_entries.size() < _maxEntries)
+            {
+                _entries.emplace(sourceKey, Entry{ingressPort, now});
+                isNewStation = true;
+            }
+        }
+
+        const auto it = destinationKey != 0 ? _entries.find(destinationKey) : _entries.end();
+        if (it != _entries.end() && now - it->second.lastSeen > _maxAge)
+        {
+            _entries.erase(it);
+        }
+        else if (it != _entries.end())
+        {
+            egressPort = it->second.port;
+        }
+    }
+
+    if (isNewStation && _logger->GetLogLevel() <= SilKit::Services::Logging::Level::Debug)
+    {
+        const auto address = demo::EthernetAddress{{
+            static_cast<std::uint8_t>(sourceKey >> 40), static_cast<std::uint8_t>(sourceKey >> 32),
+            static_cast<std::uint8_t>(sourceKey >> 24), static_cast<std::uint8_t>(sourceKey >> 16),
+            static_cast<std::uint8_t>(sourceKey >> 8), static_cast<std::uint8_t>(sourceKey)}};
+        _logger->Debug("Switch: learned " + ToString(address) + " in VLAN " + std::to_string(sourceKey >> 48)
+                       + " on port " + _ports[ingressPort]->options.name);
+    }
+    if (isTableFull)
+    {
+        _logger->Warn("Switch: the address table is full with " + std::to_string(_maxEntries)
+                      + " entries, frames to new stations are flooded until entries expire");
+    }
+    return egressPort;
+}
+
+void L2Switch::SendTo(Port& port, asio::const_buffer frame, std::optional<std::uint16_t> taggedVlanId,
+                      std::uint16_t vlanId)
+{
+    // the tag is added, removed or rewritten around the referenced frame
+    demo::FrameBuilder egressFrame;
+    const bool isEgressTagged = port.IsTagged(vlanId);
+    if (isEgressTagged && !taggedVlanId.has_value())
+    {
+        vlan::AppendWithVlanTag(egressFrame, frame, vlanId);
+    }
+    else if (!isEgressTagged && taggedVlanId.has_value())
+    {
+        vlan::AppendWithoutVlanTag(egressFrame, frame);
+    }
+    else if (isEgressTagged && *taggedVlanId != vlanId)
+    {
+        // priority tagged, the priority is kept
+        egressFrame.AppendReference(asio::buffer(frame, 12));
+        const auto tag = egressFrame.AppendCopy(asio::buffer(frame + 12, demo::layout::VlanTag::size));
+        demo::layout::VlanTag::VlanId::Store(static_cast<std::uint8_t*>(tag.data()), vlanId);
+        egressFrame.AppendReference(frame + 12 + demo::layout::VlanTag::size);
+    }
+    else
+    {
+        egressFrame.AppendReference(frame);
+    }
+
+    try
+    {
+        port.sender(egressFrame);
+        port.sentFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+    catch (const std::exception&)
+    {
+        // counted instead of logged, a port which is down fails every frame; the other ports still get theirs
+        metrics::Increment(metrics::Counter::SwitchDropsSendError);
+    }
+}
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FrameBuilder.hpp"
+
+#include "asio/ts/buffer.hpp"
+
+#include "silkit/services/logging/all.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// A learning Ethernet switch between local ports: TAP devices, SIL Kit Ethernet controllers or any other frame
+/// endpoint. Frames between two local ports are forwarded in the process instead of through SIL Kit.
+///
+///   Each port is a member of VLANs, untagged in at most one and 802.1Q tagged in any number of them. Frames are
+///   only accepted in and sent to the VLANs of a port. The source addresses are learned per VLAN; frames to a
+///   learned address go to its port, unknown unicast, broadcast and multicast are flooded to the other member
+///   ports of the VLAN. Learned addresses expire after maxAge without frames from them.
+///
+///   The frame handed to a port references the received frame and is only valid during the call; VLAN tags are
+///   added or removed around it, nothing is copied. Receive may be called from different threads.
+/// </summary>
+class L2Switch
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using PortId = std::size_t;
+
+    // the default ageing time of IEEE 802.1D
+    static constexpr std::chrono::seconds defaultMaxAge{300};
+    static constexpr std::size_t defaultMaxEntries = 8192;
+    static constexpr std::uint16_t defaultVlanId = 1;
+    // a full table is swept for expired entries at most this often, new stations wait for the next sweep
+    static constexpr std::chrono::seconds purgeInterval{1};
+
+    // sends a frame out of a port, may throw if it cannot be sent
+    using PortSender = std::function<void(const demo::FrameBuilder& frame)>;
+
+    struct PortOptions
+    {
+        std::string name;
+        // the VLAN of untagged frames, which leave the port untagged; none drops untagged frames
+        std::optional<std::uint16_t> untaggedVlanId = defaultVlanId;
+        // the VLANs whose frames pass the port with an 802.1Q tag
+        std::vector<std::uint16_t> taggedVlanIds;
+    };
+
+    struct PortDescription
+    {
+        enum struct Kind
+        {
+            Tap,
+            Network,
+        };
+
+        Kind kind;
+        // the name is the TAP device or SIL Kit network
+        PortOptions options;
+    };
+
+    struct PortStatistics
+    {
+        std::uint64_t receivedFrames;
+        std::uint64_t sentFrames;
+    };
+
+    /// <summary>
+    /// Parses a comma separated list of ports of the form tap:name[@vlans] or network:name[@vlans], where vlans
+    /// are joined by '+', u for untagged and t for tagged, e.g. "tap:sut1,tap:sut2@u10,network:Ethernet1@u10+t20".
+    /// Without vlans a port is an untagged member of VLAN 1.
+    /// </summary>
+    /// <exception cref="std::invalid_argument">Thrown if the list is malformed.</exception>
+    static auto ParsePorts(const std::string& list) -> std::vector<PortDescription>;
+
+    L2Switch(SilKit::Services::Logging::ILogger* logger, std::chrono::seconds maxAge = defaultMaxAge,
+             std::size_t maxEntries = defaultMaxEntries);
+
+    /// <summary>
+    /// Adds a port, all ports must be added before the first frame is received.
+    /// </summary>
+    auto AddPort(PortOptions options, PortSender sender) -> PortId;
+
+    /// <summary>
+    /// Switches a frame received on a port.
+    /// </summary>
+    void Receive(PortId ingressPort, asio::const_buffer frame);
+
+    auto GetPortOptions(PortId port) const -> const PortOptions&;
+    auto GetPortStatistics(PortId port) const -> PortStatistics;
+    auto GetPortCount() const -> std::size_t
+    {
+        return _ports.size();
+    }
+
+private:
+    struct Port
+    {
+        PortOptions options;
+        PortSender sender;
+        std::atomic<std::uint64_t> receivedFrames{0};
+        std::atomic<std::uint64_t> sentFrames{0};
+
+        bool IsMember(std::uint16_t vlanId) const;
+        bool IsTagged(std::uint16_t vlanId) const;
+    };
+
+    struct Entry
+    {
+        PortId port;
+        Clock::time_point lastSeen;
+    };
+
+    // learns the source and returns the port of the destination, if it is a learned unicast address
+    auto LearnAndLookUp(std::uint64_t sourceKey, std::uint64_t destinationKey, PortId ingressPort,
+                        Clock::time_point now) -> std::optional<PortId>;
+    // taggedVlanId is the VLAN ID of the 802.1Q tag of the frame, vlanId the VLAN it is switched in
+    void SendTo(Port& port, asio::const_buffer frame, std::optional<std::uint16_t> taggedVlanId,
+                std::uint16_t vlanId);
+
+    SilKit::Services::Logging::ILogger* _logger;
+    const Clock::duration _maxAge;
+    const std::size_t _maxEntries;
+
+    std::vector<std::unique_ptr<Port>> _ports;
+
+    std::mutex _mutex;
+    // keyed by VLAN ID and Ethernet address
+    std::unordered_map<std::uint64_t, Entry> _entries;
+    // expired entries are only removed from a full table, at most once per purgeInterval
+    Clock::time_point _lastPurge{};
+    bool _tableFullLogged{false};
+};
+
+} // namespace adapters
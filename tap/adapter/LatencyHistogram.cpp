@@ -0,0 +1,218 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+using namespace adapters;
+
+namespace {
+
+struct StageDescriptor
+{
+    Direction direction;
+    const char* name;
+};
+
+constexpr StageDescriptor stageDescriptors[] = {
+    {Direction::TapToSilKit, "parse"},
+    {Direction::TapToSilKit, "vlan"},
+    {Direction::TapToSilKit, "send"},
+    {Direction::TapToSilKit, "total"},
+    {Direction::TapToSilKit, "ack"},
+    {Direction::SilKitToTap, "parse"},
+    {Direction::SilKitToTap, "vlan"},
+    {Direction::SilKitToTap, "tap_write"},
+    {Direction::SilKitToTap, "total"},
+};
+
+static_assert(sizeof(stageDescriptors) / sizeof(stageDescriptors[0]) == PipelineLatency::stageCount,
+              "every stage needs a descriptor");
+
+auto FloorLog2(std::uint64_t value) -> unsigned
+{
+    unsigned magnitude = 0;
+    while (value >>= 1u)
+    {
+        ++magnitude;
+    }
+    return magnitude;
+}
+
+auto ToSeconds(std::uint64_t valueNs) -> double
+{
+    return static_cast<double>(valueNs) / 1e9;
+}
+
+auto ToMicroseconds(std::uint64_t valueNs) -> double
+{
+    return static_cast<double>(valueNs) / 1e3;
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram()
+    : _buckets{std::make_unique<std::atomic<std::uint64_t>[]>(bucketCount)}
+{
+}
+
+auto LatencyHistogram::BucketIndex(std::uint64_t valueNs) -> std::size_t
+{
+    if (valueNs < subBucketCount)
+    {
+        return static_cast<std::size_t>(valueNs);
+    }
+
+    const auto magnitude = std::min(FloorLog2(valueNs), maxMagnitude);
+    const auto shift = magnitude - (subBucketBits - 1);
+    const auto subBucket = std::min(valueNs >> shift, subBucketCount - 1); // clamped values land in the last one
+    return static_cast<std::size_t>(subBucketCount + (magnitude - subBucketBits) * (subBucketCount / 2)
+                                    + (subBucket - subBucketCount / 2));
+}
+
+auto LatencyHistogram::BucketUpperBound(std::size_t bucketIndex) -> std::uint64_t
+{
+    if (bucketIndex < subBucketCount)
+    {
+        return bucketIndex;
+    }
+
+    const auto linearIndex = bucketIndex - subBucketCount;
+    const auto magnitude = static_cast<unsigned>(linearIndex / (subBucketCount / 2)) + subBucketBits;
+    const auto subBucket = linearIndex % (subBucketCount / 2) + subBucketCount / 2;
+    const auto shift = magnitude - (subBucketBits - 1);
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(std::uint64_t valueNs)
+{
+    _buckets[BucketIndex(valueNs)].fetch_add(1, std::memory_order_relaxed);
+    _sumNs.fetch_add(valueNs, std::memory_order_relaxed);
+
+    auto maxNs = _maxNs.load(std::memory_order_relaxed);
+    while (valueNs > maxNs && !_maxNs.compare_exchange_weak(maxNs, valueNs, std::memory_order_relaxed))
+    {
+    }
+}
+
+auto LatencyHistogram::Summarize() const -> Summary
+{
+    Summary summary{};
+    summary.sumNs = _sumNs.load(std::memory_order_relaxed);
+    summary.maxNs = _maxNs.load(std::memory_order_relaxed);
+
+    // the count is summed from the buckets, so that the percentiles are consistent with it
+    std::vector<std::uint64_t> buckets(bucketCount);
+    for (std::size_t bucketIndex = 0; bucketIndex < bucketCount; ++bucketIndex)
+    {
+        buckets[bucketIndex] = _buckets[bucketIndex].load(std::memory_order_relaxed);
+        summary.count += buckets[bucketIndex];
+    }
+
+    const auto percentile = [&buckets, &summary](double quantile) -> std::uint64_t {
+        const auto rank = static_cast<std::uint64_t>(quantile * static_cast<double>(summary.count) + 0.5);
+        std::uint64_t cumulative = 0;
+        for (std::size_t bucketIndex = 0; bucketIndex < bucketCount; ++bucketIndex)
+        {
+            cumulative += buckets[bucketIndex];
+            if (cumulative >= std::max<std::uint64_t>(rank, 1))
+            {
+                return std::min(BucketUpperBound(bucketIndex), summary.maxNs);
+            }
+        }
+        return summary.maxNs;
+    };
+
+    if (summary.count > 0)
+    {
+        summary.p50Ns = percentile(0.5);
+        summary.p90Ns = percentile(0.9);
+        summary.p99Ns = percentile(0.99);
+        summary.p999Ns = percentile(0.999);
+    }
+    return summary;
+}
+
+PipelineLatency::PipelineLatency()
+    : _pendingTransmits{std::make_unique<PendingTransmit[]>(pendingTransmitCount)}
+{
+}
+
+void PipelineLatency::TrackTransmit(std::intptr_t transmitId, std::uint64_t ingressNs)
+{
+    // invalidate the slot while it is rewritten, so that an ACK never pairs with a foreign timestamp
+    auto& pendingTransmit = _pendingTransmits[static_cast<std::size_t>(transmitId) & (pendingTransmitCount - 1)];
+    pendingTransmit.transmitId.store(0);
+    pendingTransmit.ingressNs.store(ingressNs);
+    pendingTransmit.transmitId.store(transmitId);
+}
+
+void PipelineLatency::RecordTransmitAck(std::intptr_t transmitId)
+{
+    auto& pendingTransmit = _pendingTransmits[static_cast<std::size_t>(transmitId) & (pendingTransmitCount - 1)];
+    if (pendingTransmit.transmitId.load() != transmitId)
+    {
+        return;
+    }
+    const auto ingressNs = pendingTransmit.ingressNs.load();
+    if (pendingTransmit.transmitId.load() != transmitId)
+    {
+        return;
+    }
+    Record(Stage::TapToSilKitAck, ingressNs);
+}
+
+void PipelineLatency::WriteMetrics(metrics::OpenMetricsWriter& writer) const
+{
+    std::array<LatencyHistogram::Summary, stageCount> summaries;
+    for (std::size_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+    {
+        summaries[stageIndex] = _histograms[stageIndex].Summarize();
+    }
+
+    const auto stageLabels = [](std::size_t stageIndex) {
+        return std::string{"direction=\""} + ToString(stageDescriptors[stageIndex].direction) + "\",stage=\""
+               + stageDescriptors[stageIndex].name + "\"";
+    };
+
+    writer.Family("stage_latency_seconds", "summary", "Time spent by frames in a stage of the adapter.");
+    for (std::size_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+    {
+        const auto& summary = summaries[stageIndex];
+        const auto labels = stageLabels(stageIndex);
+        writer.Sample("", labels + ",quantile=\"0.5\"", ToSeconds(summary.p50Ns));
+        writer.Sample("", labels + ",quantile=\"0.99\"", ToSeconds(summary.p99Ns));
+        writer.Sample("", labels + ",quantile=\"0.999\"", ToSeconds(summary.p999Ns));
+        writer.Sample("_sum", labels, ToSeconds(summary.sumNs));
+        writer.Sample("_count", labels, summary.count);
+    }
+
+    writer.Family("stage_latency_max_seconds", "gauge", "Longest time a frame spent in a stage of the adapter.");
+    for (std::size_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+    {
+        writer.Sample("", stageLabels(stageIndex), ToSeconds(summaries[stageIndex].maxNs));
+    }
+}
+
+void PipelineLatency::LogSummary(SilKit::Services::Logging::ILogger* logger) const
+{
+    for (std::size_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+    {
+        const auto summary = _histograms[stageIndex].Summarize();
+        if (summary.count == 0)
+        {
+            continue;
+        }
+
+        const auto& descriptor = stageDescriptors[stageIndex];
+        std::ostringstream SILKitInfoMessage;
+        SILKitInfoMessage << std::fixed << std::setprecision(1) << "Latency " << ToString(descriptor.direction) << "/"
+                          << descriptor.name << ": p50=" << ToMicroseconds(summary.p50Ns) << "us p99="
+                          << ToMicroseconds(summary.p99Ns) << "us p99.9=" << ToMicroseconds(summary.p999Ns) << "us max="
+                          << ToMicroseconds(summary.maxNs) << "us (" << summary.count << " frames)";
+        logger->Info(SILKitInfoMessage.str());
+    }
+}
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Direction.hpp"
+#include "Metrics.hpp"
+
+#include "silkit/services/logging/all.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// Log-linear latency histogram in the style of HdrHistogram.
+///
+///   Values below 64 ns get a bucket each, every following power of two is split into 32 linear
+///   sub-buckets, which bounds the relative error of a reported value to about 3%. Values above
+///   2^40 ns (about 18 minutes) are clamped. Recording is lock-free and may happen from any thread.
+/// </summary>
+class LatencyHistogram
+{
+public:
+    struct Summary
+    {
+        std::uint64_t count;
+        std::uint64_t sumNs;
+        std::uint64_t p50Ns;
+        std::uint64_t p90Ns;
+        std::uint64_t p99Ns;
+        std::uint64_t p999Ns;
+        std::uint64_t maxNs;
+    };
+
+    LatencyHistogram();
+
+    void Record(std::uint64_t valueNs);
+
+    auto Summarize() const -> Summary;
+
+private:
+    static constexpr unsigned subBucketBits = 6;
+    static constexpr std::uint64_t subBucketCount = std::uint64_t(1) << subBucketBits;
+    static constexpr unsigned maxMagnitude = 40;
+    static constexpr std::size_t bucketCount =
+        subBucketCount + (maxMagnitude - subBucketBits + 1) * (subBucketCount / 2);
+
+    static auto BucketIndex(std::uint64_t valueNs) -> std::size_t;
+    static auto BucketUpperBound(std::size_t bucketIndex) -> std::uint64_t;
+
+    std::unique_ptr<std::atomic<std::uint64_t>[]> _buckets;
+    std::atomic<std::uint64_t> _sumNs{0};
+    std::atomic<std::uint64_t> _maxNs{0};
+};
+
+/// <summary>
+/// Latency histograms of the stages a frame passes through the adapter, plus the time until
+/// SIL Kit acknowledges a frame sent from the TAP device (matched by its transmit id).
+/// </summary>
+class PipelineLatency
+{
+public:
+    enum struct Stage : std::size_t
+    {
+        TapToSilKitParse, // multicast snooping and SOME/IP statistics
+        TapToSilKitVlan, // VLAN tag injection and padding
+        TapToSilKitSend, // IEthernetController::SendFrame
+        TapToSilKitTotal, // TAP read completed until SendFrame returned
+        TapToSilKitAck, // TAP read completed until the transmit ACK/NACK of SIL Kit
+
+        SilKitToTapParse, // multicast filter, VLAN check and SOME/IP statistics
+        SilKitToTapVlan, // VLAN tag removal
+        SilKitToTapWrite, // write to the TAP device
+        SilKitToTapTotal, // EthernetFrameEvent received until the TAP write returned
+
+        Count // keep last
+    };
+
+    static constexpr std::size_t stageCount = static_cast<std::size_t>(Stage::Count);
+
+    PipelineLatency();
+
+    /// <summary>
+    /// Monotonic timestamp in nanoseconds.
+    /// </summary>
+    static auto Now() -> std::uint64_t
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now().time_since_epoch())
+                                              .count());
+    }
+
+    /// <summary>
+    /// Records the time since startNs for the stage and returns the current timestamp, so that it can
+    /// be used as the start of the next stage.
+    /// </summary>
+    auto Record(Stage stage, std::uint64_t startNs) -> std::uint64_t
+    {
+        const auto nowNs = Now();
+        _histograms[static_cast<std::size_t>(stage)].Record(nowNs - startNs);
+        return nowNs;
+    }
+
+    /// <summary>
+    /// Remembers the ingress timestamp of a frame handed to SIL Kit. Must be called before SendFrame,
+    /// as SIL Kit may acknowledge the frame before SendFrame returns.
+    /// </summary>
+    void TrackTransmit(std::intptr_t transmitId, std::uint64_t ingressNs);
+
+    /// <summary>
+    /// Records the TapToSilKitAck stage for the acknowledged frame. Frames whose timestamp was already
+    /// overwritten by later transmits (more than 4096 frames pending) are not recorded.
+    /// </summary>
+    void RecordTransmitAck(std::intptr_t transmitId);
+
+    /// <summary>
+    /// Writes p50/p99/p99.9 summaries and the maximum of all stages as OpenMetrics families.
+    /// </summary>
+    void WriteMetrics(metrics::OpenMetricsWriter& writer) const;
+
+    /// <summary>
+    /// Logs p50/p99/p99.9/max of all stages which recorded frames.
+    /// </summary>
+    void LogSummary(SilKit::Services::Logging::ILogger* logger) const;
+
+private:
+    struct PendingTransmit
+    {
+        std::atomic<std::intptr_t> transmitId{0};
+        std::atomic<std::uint64_t> ingressNs{0};
+    };
+
+    // must be a power of two
+    static constexpr std::size_t pendingTransmitCount = 4096;
+
+    std::array<LatencyHistogram, stageCount> _histograms;
+    std::unique_ptr<PendingTransmit[]> _pendingTransmits;
+};
+
+} // namespace adapters
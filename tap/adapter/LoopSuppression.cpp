@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "LoopSuppression.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+using namespace adapters;
+
+namespace {
+
+// an entry is the fingerprint of the hash above the time it was sent, in milliseconds modulo 2^24 (4.6 hours)
+constexpr unsigned timeBits = 24;
+constexpr std::uint64_t timeMask = (std::uint64_t{1} << timeBits) - 1;
+
+auto Fingerprint(std::uint64_t hash) -> std::uint64_t
+{
+    // never 0, which is an empty entry
+    return (hash >> timeBits) | 1;
+}
+
+auto Opposite(Direction direction) -> Direction
+{
+    return direction == Direction::TapToSilKit ? Direction::SilKitToTap : Direction::TapToSilKit;
+}
+
+} // namespace
+
+constexpr std::chrono::milliseconds LoopSuppression::defaultWindow;
+constexpr std::chrono::milliseconds LoopSuppression::maxWindow;
+constexpr std::size_t LoopSuppression::hashedBytes;
+constexpr std::size_t LoopSuppression::entryCount;
+
+LoopSuppression::LoopSuppression(SilKit::Services::Logging::ILogger* logger, std::chrono::milliseconds window)
+    : _logger{logger}
+    , _windowMs{static_cast<std::uint64_t>(std::min(window, maxWindow).count())}
+    , _start{Clock::now()}
+{
+}
+
+void LoopSuppression::RememberSent(Direction direction, asio::const_buffer frame)
+{
+    const auto* data = static_cast<const std::uint8_t*>(frame.data());
+    Remember(direction, HashFrame(data, std::min(frame.size(), hashedBytes), frame.size()));
+}
+
+void LoopSuppression::RememberSent(Direction direction, const demo::FrameBuilder& frame)
+{
+    // the leading bytes of the segments, as HashFrame of the joined frame would read them
+    std::array<std::uint8_t, hashedBytes> prefix;
+    const auto hashedSize = asio::buffer_copy(asio::buffer(prefix), frame);
+    Remember(direction, HashFrame(prefix.data(), hashedSize, frame.GetSize()));
+}
+
+auto LoopSuppression::IsLoopedBack(Direction direction, asio::const_buffer frame) -> bool
+{
+    const auto* data = static_cast<const std::uint8_t*>(frame.data());
+    const auto hash = HashFrame(data, std::min(frame.size(), hashedBytes), frame.size());
+    auto& recentFrames = _recentFrames[ToIndex(Opposite(direction))];
+    const auto& bucket = recentFrames.buckets[hash & (bucketCount - 1)];
+    const auto fingerprint = Fingerprint(hash);
+    const auto now = Now();
+
+    for (const auto& way : bucket)
+    {
+        const auto entry = way.load(std::memory_order_relaxed);
+        if ((entry >> timeBits) == fingerprint && ((now - entry) & timeMask) <= _windowMs)
+        {
+            if (_logger && !recentFrames.loopWarned.exchange(true, std::memory_order_relaxed))
+            {
+                const std::string source = direction == Direction::TapToSilKit ? "the TAP device" : "SIL Kit";
+                const std::string destination = direction == Direction::TapToSilKit ? "SIL Kit" : "the TAP device";
+                _logger->Warn("Loop suppression: dropped a frame from " + source
+                              + " which the adapter sent to it within the last " + std::to_string(_windowMs)
+                              + " ms, " + source + " probably reaches " + destination
+                              + " through another path as well. Further looped frames are only counted.");
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+auto LoopSuppression::HashFrame(const std::uint8_t* data, std::size_t hashedSize, std::size_t frameSize)
+    -> std::uint64_t
+{
+    constexpr std::uint64_t multiplier = 0xFF51AFD7ED558CCDull;
+    std::uint64_t hash = 0x9E3779B97F4A7C15ull ^ frameSize;
+
+    std::size_t offset = 0;
+    for (; offset + sizeof(std::uint64_t) <= hashedSize; offset += sizeof(std::uint64_t))
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data + offset, sizeof(word));
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 32;
+    }
+    if (offset < hashedSize)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data + offset, hashedSize - offset);
+        hash = (hash ^ word ^ (hashedSize - offset)) * multiplier;
+        hash ^= hash >> 32;
+    }
+
+    // the finalizer of MurmurHash3, so that the bucket and the fingerprint depend on all bits
+    hash ^= hash >> 33;
+    hash *= multiplier;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+auto LoopSuppression::Now() const -> std::uint64_t
+{
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - _start).count());
+}
+
+void LoopSuppression::Remember(Direction direction, std::uint64_t hash)
+{
+    auto& bucket = _recentFrames[ToIndex(direction)].buckets[hash & (bucketCount - 1)];
+    const auto fingerprint = Fingerprint(hash);
+    const auto now = Now();
+
+    // the entry of the same frame, otherwise an empty or the oldest one
+    std::size_t victim = 0;
+    std::uint64_t victimAge = 0;
+    for (std::size_t way = 0; way < waysPerBucket; ++way)
+    {
+        const auto entry = bucket[way].load(std::memory_order_relaxed);
+        if ((entry >> timeBits) == fingerprint)
+        {
+            victim = way;
+            break;
+        }
+        const auto age = entry == 0 ? timeMask + 1 : (now - entry) & timeMask;
+        if (age > victimAge)
+        {
+            victim = way;
+            victimAge = age;
+        }
+    }
+    bucket[victim].store((fingerprint << timeBits) | (now & timeMask), std::memory_order_relaxed);
+}
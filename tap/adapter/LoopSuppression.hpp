@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "Direction.hpp"
+#include "FrameBuilder.hpp"
+
+#include "asio/ts/buffer.hpp"
+
+#include "silkit/services/logging/all.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// Suppresses forwarding loops: a frame which comes back from the side the adapter recently sent it to is
+/// dropped. This happens when the TAP device is part of a Linux bridge which also reaches SIL Kit through another
+/// path, the frames would bounce between the TAP device and SIL Kit forever.
+///
+///   For each direction the hashes of the recently sent frames are kept in a small set-associative table: a
+///   bucket per hash of four entries, each an atomic word of a fingerprint of the hash and the time it was sent.
+///   Entries older than the window do not match any more and are replaced first, otherwise the oldest entry of
+///   the bucket is. Frames are hashed over their size and their first hashedBytes, which include the headers and
+///   checksums, so that identical frames match; frames of other stations differ in their addresses anyway.
+///
+///   Frames are remembered and checked from the io_context and the SIL Kit thread without locks. Two threads
+///   remembering into the same bucket at once may lose one of the entries, which lets a looped frame pass once.
+/// </summary>
+class LoopSuppression
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::milliseconds defaultWindow{100};
+    // longer windows do not fit into the time of an entry
+    static constexpr std::chrono::milliseconds maxWindow{10000};
+    static constexpr std::size_t hashedBytes = 128;
+    // entries per direction, a power of two
+    static constexpr std::size_t entryCount = 4096;
+
+    explicit LoopSuppression(SilKit::Services::Logging::ILogger* logger,
+                             std::chrono::milliseconds window = defaultWindow);
+
+    /// <summary>
+    /// Remembers a frame the adapter sends in direction, to the TAP device or to SIL Kit.
+    /// </summary>
+    void RememberSent(Direction direction, asio::const_buffer frame);
+    void RememberSent(Direction direction, const demo::FrameBuilder& frame);
+
+    /// <summary>
+    /// Returns true if a frame received in direction was sent the opposite way within the window, and warns
+    /// the first time this happens per direction.
+    /// </summary>
+    auto IsLoopedBack(Direction direction, asio::const_buffer frame) -> bool;
+
+private:
+    static constexpr std::size_t waysPerBucket = 4;
+    static constexpr std::size_t bucketCount = entryCount / waysPerBucket;
+
+    using Bucket = std::array<std::atomic<std::uint64_t>, waysPerBucket>;
+
+    struct RecentFrames
+    {
+        std::unique_ptr<Bucket[]> buckets{std::make_unique<Bucket[]>(bucketCount)};
+        std::atomic<bool> loopWarned{false};
+    };
+
+    static auto HashFrame(const std::uint8_t* data, std::size_t hashedSize, std::size_t frameSize) -> std::uint64_t;
+    auto Now() const -> std::uint64_t;
+    void Remember(Direction direction, std::uint64_t hash);
+
+    SilKit::Services::Logging::ILogger* _logger;
+    const std::uint64_t _windowMs;
+    const Clock::time_point _start;
+    // indexed by the direction in which the frames were sent
+    std::array<RecentFrames, directionCount> _recentFrames;
+};
+
+} // namespace adapters
@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "LoopbackEndpoint.hpp"
+#include "Metrics.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+
+#include "asio/post.hpp"
+
+using namespace adapters;
+
+LoopbackEndpoint::LoopbackEndpoint(asio::io_context& ioContext, Options options)
+    : _ioContext{ioContext}
+    , _options{options}
+{
+    _options.maxBurst = std::max<std::size_t>(_options.maxBurst, 1);
+    _burst.reserve(_options.maxBurst);
+}
+
+void LoopbackEndpoint::StartReceiving(FrameHandler onFrameHandler)
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+    _onFrameHandler = std::move(onFrameHandler);
+    if (!_pendingFrames.empty() && !_deliveryScheduled)
+    {
+        _deliveryScheduled = true;
+        asio::post(_ioContext, [this] { DeliverBurst(); });
+    }
+}
+
+void LoopbackEndpoint::Send(const std::uint8_t* frame, std::size_t frameSize)
+{
+    _sentFrames.fetch_add(1, std::memory_order_relaxed);
+    _sentBytes.fetch_add(frameSize, std::memory_order_relaxed);
+
+    if (_onSentFrameHandler)
+    {
+        _onSentFrameHandler(frame, frameSize);
+    }
+    if (_options.reflect)
+    {
+        Inject(std::vector<std::uint8_t>(frame, frame + frameSize));
+    }
+}
+
+void LoopbackEndpoint::SendSegments(const demo::FrameBuilder& frame)
+{
+    thread_local std::vector<std::uint8_t> flattenedFrame;
+    frame.FlattenTo(flattenedFrame);
+    Send(flattenedFrame.data(), flattenedFrame.size());
+}
+
+auto LoopbackEndpoint::GetStatistics() const -> Statistics
+{
+    return Statistics{
+        _receivedFrames.load(std::memory_order_relaxed), _receivedBytes.load(std::memory_order_relaxed),
+        _receiveBursts.load(std::memory_order_relaxed),  _sentFrames.load(std::memory_order_relaxed),
+        _sentBytes.load(std::memory_order_relaxed),
+    };
+}
+
+void LoopbackEndpoint::Inject(std::vector<std::uint8_t> frame)
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+    _pendingFrames.push_back(std::move(frame));
+    if (_onFrameHandler && !_deliveryScheduled)
+    {
+        _deliveryScheduled = true;
+        asio::post(_ioContext, [this] { DeliverBurst(); });
+    }
+}
+
+void LoopbackEndpoint::DeliverBurst()
+{
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        const auto burstSize = std::min(_pendingFrames.size(), _options.maxBurst);
+        std::move(_pendingFrames.begin(), _pendingFrames.begin() + burstSize, std::back_inserter(_burst));
+        _pendingFrames.erase(_pendingFrames.begin(), _pendingFrames.begin() + burstSize);
+
+        // frames left over are delivered by the next invocation, so that other handlers get their turn
+        _deliveryScheduled = !_pendingFrames.empty();
+        if (_deliveryScheduled)
+        {
+            asio::post(_ioContext, [this] { DeliverBurst(); });
+        }
+    }
+
+    if (!_burst.empty())
+    {
+        _receiveBursts.fetch_add(1, std::memory_order_relaxed);
+    }
+    for (auto& frame : _burst)
+    {
+        _receivedFrames.fetch_add(1, std::memory_order_relaxed);
+        _receivedBytes.fetch_add(frame.size(), std::memory_order_relaxed);
+        try
+        {
+            _onFrameHandler(std::move(frame));
+        }
+        catch (const std::exception&)
+        {
+            metrics::Increment(metrics::Counter::DropsTapToSilKitProcessingError);
+        }
+    }
+    _burst.clear();
+}
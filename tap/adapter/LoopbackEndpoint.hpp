@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "FrameEndpoint.hpp"
+
+#include "asio/ts/io_context.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// In-memory frame endpoint, to run the forwarding pipeline without a TAP device and without privileges.
+///
+///   Injected frames are delivered to the receive handler on the io_context, in bursts of up to maxBurst
+///   frames per handler invocation of the io_context. Sent frames are passed to the sent frame handler, or
+///   injected again in reflect mode, which makes the endpoint answer every frame from SIL Kit with itself.
+/// </summary>
+class LoopbackEndpoint : public FrameEndpoint
+{
+public:
+    struct Options
+    {
+        std::size_t maxBurst = 32;
+        bool reflect = false;
+    };
+
+    using SentFrameHandler = std::function<void(const std::uint8_t* frame, std::size_t frameSize)>;
+
+    LoopbackEndpoint(asio::io_context& ioContext, Options options);
+
+    void StartReceiving(FrameHandler onFrameHandler) override;
+
+    /// <summary>
+    /// The loopback does not fail, the handler is never called.
+    /// </summary>
+    void SetFatalReadErrorHandler(std::function<void()> /*handler*/) override
+    {
+    }
+
+    void Send(const std::uint8_t* frame, std::size_t frameSize) override;
+
+    // joins the segments in a buffer of the calling thread and sends them like Send
+    void SendSegments(const demo::FrameBuilder& frame) override;
+
+    auto GetStatistics() const -> Statistics override;
+
+    /// <summary>
+    /// Sets a handler which is called for every sent frame, on the thread of the sender.
+    /// </summary>
+    void SetSentFrameHandler(SentFrameHandler handler)
+    {
+        _onSentFrameHandler = std::move(handler);
+    }
+
+    /// <summary>
+    /// Queues a frame as if it was received, may be called from any thread.
+    /// </summary>
+    void Inject(std::vector<std::uint8_t> frame);
+
+private:
+    void DeliverBurst();
+
+    asio::io_context& _ioContext;
+    Options _options;
+    FrameHandler _onFrameHandler;
+    SentFrameHandler _onSentFrameHandler;
+
+    std::mutex _mutex;
+    std::deque<std::vector<std::uint8_t>> _pendingFrames;
+    bool _deliveryScheduled{false};
+    std::vector<std::vector<std::uint8_t>> _burst;
+
+    std::atomic<std::uint64_t> _receivedFrames{0};
+    std::atomic<std::uint64_t> _receivedBytes{0};
+    std::atomic<std::uint64_t> _receiveBursts{0};
+    std::atomic<std::uint64_t> _sentFrames{0};
+    std::atomic<std::uint64_t> _sentBytes{0};
+};
+
+} // namespace adapters
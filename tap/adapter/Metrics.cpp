@@ -0,0 +1,283 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "Metrics.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+using namespace adapters;
+using namespace adapters::metrics;
+
+namespace {
+
+struct alignas(64) CounterBlock
+{
+    std::array<std::atomic<std::uint64_t>, counterCount> values{};
+};
+
+struct CounterRegistry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<CounterBlock>> blocks;
+};
+
+// never destroyed, threads of SIL Kit may still count while static objects are torn down
+auto GetRegistry() -> CounterRegistry&
+{
+    static auto* registry = new CounterRegistry{};
+    return *registry;
+}
+
+// blocks are kept after their thread exits, so that its counts remain part of the totals
+auto RegisterBlock() -> CounterBlock*
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    registry.blocks.push_back(std::make_unique<CounterBlock>());
+    return registry.blocks.back().get();
+}
+
+auto GetThreadBlock() -> CounterBlock&
+{
+    thread_local CounterBlock* block = RegisterBlock();
+    return *block;
+}
+
+struct CounterDescriptor
+{
+    Counter counter;
+    const char* family;
+    const char* labels;
+};
+
+constexpr CounterDescriptor counterDescriptors[] = {
+    {Counter::FramesTapToSilKit, "frames", R"(direction="tap_to_silkit")"},
+    {Counter::FramesSilKitToTap, "frames", R"(direction="silkit_to_tap")"},
+    {Counter::BytesTapToSilKit, "bytes", R"(direction="tap_to_silkit")"},
+    {Counter::BytesSilKitToTap, "bytes", R"(direction="silkit_to_tap")"},
+    {Counter::DropsTapToSilKitProcessingError, "drops", R"(direction="tap_to_silkit",reason="processing_error")"},
+    {Counter::DropsTapToSilKitPacketTooBig, "drops", R"(direction="tap_to_silkit",reason="packet_too_big")"},
+    {Counter::DropsTapToSilKitStartupQueueFull, "drops",
+     R"(direction="tap_to_silkit",reason="startup_queue_full")"},
+    {Counter::DropsTapToSilKitStartupQueueExpired, "drops",
+     R"(direction="tap_to_silkit",reason="startup_queue_expired")"},
+    {Counter::DropsTapToSilKitLoop, "drops", R"(direction="tap_to_silkit",reason="loop")"},
+    {Counter::DropsSilKitToTapVlanMismatch, "drops", R"(direction="silkit_to_tap",reason="vlan_mismatch")"},
+    {Counter::DropsSilKitToTapMulticastNotJoined, "drops",
+     R"(direction="silkit_to_tap",reason="multicast_not_joined")"},
+    {Counter::DropsSilKitToTapTapWriteError, "drops", R"(direction="silkit_to_tap",reason="tap_write_error")"},
+    {Counter::DropsSilKitToTapReassemblyFailed, "drops",
+     R"(direction="silkit_to_tap",reason="reassembly_failed")"},
+    {Counter::DropsSilKitToTapLoop, "drops", R"(direction="silkit_to_tap",reason="loop")"},
+    {Counter::TapReadErrors, "tap_read_errors", ""},
+    {Counter::TapWriteErrors, "tap_write_errors", ""},
+    {Counter::TransmitAcks, "transmit_acks", ""},
+    {Counter::TransmitNacks, "transmit_nacks", ""},
+    {Counter::CaptureFrames, "capture_frames", ""},
+    {Counter::CaptureLostFrames, "capture_lost_frames", ""},
+    {Counter::MtuFragmentedPackets, "mtu_fragmented_packets", ""},
+    {Counter::MtuReassembledPackets, "mtu_reassembled_packets", ""},
+    {Counter::MtuClampedMss, "mtu_clamped_mss", ""},
+    {Counter::NeighborProxyReplies, "neighbor_proxy_replies", ""},
+    {Counter::StartupQueuedFrames, "startup_queued_frames", ""},
+    {Counter::SwitchFramesUnicast, "switch_frames", R"(delivery="unicast")"},
+    {Counter::SwitchFramesFlooded, "switch_frames", R"(delivery="flooded")"},
+    {Counter::SwitchDropsVlanNotMember, "switch_drops", R"(reason="vlan_not_member")"},
+    {Counter::SwitchDropsSamePort, "switch_drops", R"(reason="same_port")"},
+    {Counter::SwitchDropsMalformed, "switch_drops", R"(reason="malformed")"},
+    {Counter::SwitchDropsSendError, "switch_drops", R"(reason="send_error")"},
+};
+
+static_assert(sizeof(counterDescriptors) / sizeof(counterDescriptors[0]) == counterCount,
+              "every counter needs a descriptor");
+
+auto GetHelp(const std::string& family) -> const char*
+{
+    if (family == "frames")
+        return "Ethernet frames forwarded by the adapter.";
+    if (family == "bytes")
+        return "Bytes of the Ethernet frames forwarded by the adapter.";
+    if (family == "drops")
+        return "Ethernet frames dropped by the adapter.";
+    if (family == "tap_read_errors")
+        return "Failed reads from the TAP device.";
+    if (family == "tap_write_errors")
+        return "Failed writes to the TAP device.";
+    if (family == "transmit_acks")
+        return "Frames acknowledged by SIL Kit.";
+    if (family == "transmit_nacks")
+        return "Frames not acknowledged by SIL Kit.";
+    if (family == "capture_frames")
+        return "Frames written to the pcapng capture.";
+    if (family == "capture_lost_frames")
+        return "Frames missing in the pcapng capture because the capture ring was full.";
+    if (family == "mtu_fragmented_packets")
+        return "IPv4 packets from the TAP device fragmented to the MTU of SIL Kit.";
+    if (family == "mtu_reassembled_packets")
+        return "IPv4 packets from SIL Kit reassembled from their fragments.";
+    if (family == "mtu_clamped_mss")
+        return "TCP SYN segments whose maximum segment size was clamped to the MTU of SIL Kit.";
+    if (family == "neighbor_proxy_replies")
+        return "ARP requests and neighbor solicitations from the TAP device answered by the neighbor proxy.";
+    if (family == "startup_queued_frames")
+        return "Frames from the TAP device queued until the Ethernet controller of SIL Kit was active.";
+    if (family == "switch_frames")
+        return "Ethernet frames switched between the local ports, to the learned port or flooded to the VLAN.";
+    if (family == "switch_drops")
+        return "Ethernet frames dropped by the switch between the local ports.";
+    return "";
+}
+
+constexpr const char* metricPrefix = "sil_kit_adapter_tap_";
+
+auto Value(const CounterValues& values, Counter counter) -> std::uint64_t
+{
+    return values[static_cast<std::size_t>(counter)];
+}
+
+auto TransmitPending(const CounterValues& values) -> std::uint64_t
+{
+    const auto sent = Value(values, Counter::FramesTapToSilKit);
+    const auto answered = Value(values, Counter::TransmitAcks) + Value(values, Counter::TransmitNacks);
+    return sent > answered ? sent - answered : 0;
+}
+
+} // namespace
+
+void metrics::Increment(Counter counter, std::uint64_t value)
+{
+    auto& counterValue = GetThreadBlock().values[static_cast<std::size_t>(counter)];
+    // only this thread writes the block, so no read-modify-write is needed
+    counterValue.store(counterValue.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+auto metrics::Aggregate() -> CounterValues
+{
+    CounterValues sums{};
+
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    for (const auto& block : registry.blocks)
+    {
+        for (std::size_t counterIndex = 0; counterIndex < counterCount; ++counterIndex)
+        {
+            sums[counterIndex] += block->values[counterIndex].load(std::memory_order_relaxed);
+        }
+    }
+    return sums;
+}
+
+void OpenMetricsWriter::Family(const std::string& name, const char* type, const char* help)
+{
+    _family = metricPrefix + name;
+    _text += "# TYPE " + _family + " " + type + "\n";
+    _text += "# HELP " + _family + " " + help + "\n";
+}
+
+void OpenMetricsWriter::Sample(const char* suffix, const std::string& labels, std::uint64_t value)
+{
+    _text += _family + suffix;
+    if (!labels.empty())
+    {
+        _text += "{" + labels + "}";
+    }
+    _text += " " + std::to_string(value) + "\n";
+}
+
+void OpenMetricsWriter::Sample(const char* suffix, const std::string& labels, double value)
+{
+    std::ostringstream valueStream;
+    valueStream << value;
+
+    _text += _family + suffix;
+    if (!labels.empty())
+    {
+        _text += "{" + labels + "}";
+    }
+    _text += " " + valueStream.str() + "\n";
+}
+
+auto OpenMetricsWriter::Finish() -> std::string
+{
+    _text += "# EOF\n";
+    return std::move(_text);
+}
+
+void metrics::WriteCounters(OpenMetricsWriter& writer, const CounterValues& values)
+{
+    const char* currentFamily = nullptr;
+    for (const auto& descriptor : counterDescriptors)
+    {
+        if (currentFamily == nullptr || std::string{currentFamily} != descriptor.family)
+        {
+            currentFamily = descriptor.family;
+            writer.Family(currentFamily, "counter", GetHelp(currentFamily));
+        }
+        writer.Sample("_total", descriptor.labels, Value(values, descriptor.counter));
+    }
+
+    writer.Family("transmit_pending", "gauge", "Frames handed to SIL Kit which are not acknowledged yet.");
+    writer.Sample("", "", TransmitPending(values));
+}
+
+SummaryLogger::SummaryLogger(asio::io_context& ioContext, std::chrono::seconds interval,
+                             SilKit::Services::Logging::ILogger* logger)
+    : _timer{ioContext}
+    , _interval{interval}
+    , _logger{logger}
+{
+    ScheduleNextSummary();
+}
+
+void SummaryLogger::ScheduleNextSummary()
+{
+    _timer.expires_after(_interval);
+    _timer.async_wait([this](const std::error_code ec) {
+        if (ec)
+        {
+            return;
+        }
+        LogSummary();
+        ScheduleNextSummary();
+    });
+}
+
+void SummaryLogger::LogSummary()
+{
+    const auto values = Aggregate();
+
+    CounterValues deltas{};
+    for (std::size_t counterIndex = 0; counterIndex < counterCount; ++counterIndex)
+    {
+        deltas[counterIndex] = values[counterIndex] - _previousValues[counterIndex];
+    }
+    _previousValues = values;
+
+    const auto perSecond = [this, &deltas](Counter counter) {
+        return static_cast<double>(Value(deltas, counter)) / static_cast<double>(_interval.count());
+    };
+
+    std::uint64_t drops = 0;
+    for (const auto& descriptor : counterDescriptors)
+    {
+        if (std::string{descriptor.family} == "drops")
+        {
+            drops += Value(deltas, descriptor.counter);
+        }
+    }
+    const auto tapErrors = Value(deltas, Counter::TapReadErrors) + Value(deltas, Counter::TapWriteErrors);
+
+    std::ostringstream SILKitInfoMessage;
+    SILKitInfoMessage.precision(1);
+    SILKitInfoMessage << std::fixed << "TAP device >> SIL Kit: " << perSecond(Counter::FramesTapToSilKit)
+                      << " frames/s, " << perSecond(Counter::BytesTapToSilKit) / 1000.0
+                      << " kB/s | SIL Kit >> TAP device: " << perSecond(Counter::FramesSilKitToTap) << " frames/s, "
+                      << perSecond(Counter::BytesSilKitToTap) / 1000.0 << " kB/s | drops: " << drops
+                      << ", NACKs: " << Value(deltas, Counter::TransmitNacks) << ", TAP errors: " << tapErrors
+                      << ", pending transmits: " << TransmitPending(values);
+    _logger->Info(SILKitInfoMessage.str());
+}
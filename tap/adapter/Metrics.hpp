@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "asio/ts/io_context.hpp"
+#include "asio/steady_timer.hpp"
+
+#include "silkit/services/logging/all.hpp"
+
+namespace adapters {
+namespace metrics {
+
+/// <summary>
+/// Adapter counters. Every thread increments its own copy of the counters without any
+/// synchronization, the copies are only summed up when the counters are read.
+/// </summary>
+enum struct Counter : std::size_t
+{
+    FramesTapToSilKit,
+    BytesTapToSilKit,
+    FramesSilKitToTap,
+    BytesSilKitToTap,
+
+    DropsTapToSilKitProcessingError,
+    DropsTapToSilKitPacketTooBig,
+    DropsTapToSilKitStartupQueueFull,
+    DropsTapToSilKitStartupQueueExpired,
+    DropsTapToSilKitLoop,
+    DropsSilKitToTapVlanMismatch,
+    DropsSilKitToTapMulticastNotJoined,
+    DropsSilKitToTapTapWriteError,
+    DropsSilKitToTapReassemblyFailed,
+    DropsSilKitToTapLoop,
+
+    TapReadErrors,
+    TapWriteErrors,
+
+    TransmitAcks,
+    TransmitNacks,
+
+    CaptureFrames,
+    CaptureLostFrames,
+
+    MtuFragmentedPackets,
+    MtuReassembledPackets,
+    MtuClampedMss,
+
+    NeighborProxyReplies,
+
+    StartupQueuedFrames,
+
+    SwitchFramesUnicast,
+    SwitchFramesFlooded,
+    SwitchDropsVlanNotMember,
+    SwitchDropsSamePort,
+    SwitchDropsMalformed,
+    SwitchDropsSendError,
+
+    Count // keep last
+};
+
+constexpr std::size_t counterCount = static_cast<std::size_t>(Counter::Count);
+
+using CounterValues = std::array<std::uint64_t, counterCount>;
+
+/// <summary>
+/// Adds value to the calling thread's copy of the counter.
+/// </summary>
+void Increment(Counter counter, std::uint64_t value = 1);
+
+/// <summary>
+/// Sums up the counters of all threads.
+/// </summary>
+auto Aggregate() -> CounterValues;
+
+/// <summary>
+/// Builds a text exposition in the OpenMetrics format (https://openmetrics.io).
+/// </summary>
+class OpenMetricsWriter
+{
+public:
+    /// <summary>
+    /// Starts a metric family, all following samples belong to it.
+    /// </summary>
+    /// <param name="type">OpenMetrics type, e.g. "counter" or "gauge".</param>
+    void Family(const std::string& name, const char* type, const char* help);
+
+    /// <summary>
+    /// Adds a sample of the current family.
+    /// </summary>
+    /// <param name="suffix">Appended to the family name, e.g. "_total" for counters.</param>
+    /// <param name="labels">Comma separated label pairs without braces, may be empty.</param>
+    void Sample(const char* suffix, const std::string& labels, std::uint64_t value);
+    void Sample(const char* suffix, const std::string& labels, double value);
+
+    /// <summary>
+    /// Terminates the exposition and returns it.
+    /// </summary>
+    auto Finish() -> std::string;
+
+private:
+    std::string _text;
+    std::string _family;
+};
+
+/// <summary>
+/// Writes all adapter counters and the derived gauges.
+/// </summary>
+void WriteCounters(OpenMetricsWriter& writer, const CounterValues& values);
+
+/// <summary>
+/// Periodically logs a one-line summary of the adapter counters.
+/// </summary>
+class SummaryLogger
+{
+public:
+    SummaryLogger(asio::io_context& ioContext, std::chrono::seconds interval,
+                  SilKit::Services::Logging::ILogger* logger);
+
+private:
+    void ScheduleNextSummary();
+    void LogSummary();
+
+    asio::steady_timer _timer;
+    std::chrono::seconds _interval;
+    SilKit::Services::Logging::ILogger* _logger;
+    CounterValues _previousValues{};
+};
+
+} // namespace metrics
+} // namespace adapters
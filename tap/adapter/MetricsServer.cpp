@@ -0,0 +1,219 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "MetricsServer.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <istream>
+#include <stdexcept>
+
+#include "asio/error.hpp"
+#include "asio/read_until.hpp"
+#include "asio/streambuf.hpp"
+#include "asio/write.hpp"
+
+using namespace adapters;
+
+namespace {
+
+constexpr const char* localEndpointPrefix = "unix:";
+
+// requests are a single GET line plus a few headers, anything bigger is not a scrape
+constexpr std::size_t maxRequestSize = 8192;
+// a scrape is answered in milliseconds, clients slower than this only hold a file descriptor
+constexpr std::chrono::seconds sessionTimeout{5};
+// scrapers and the control commands of a test need a few connections at most
+constexpr std::size_t maxOpenSessions = 16;
+constexpr std::chrono::seconds acceptRetryDelay{1};
+
+template <typename Socket>
+struct Session
+{
+    Session(Socket socket, std::shared_ptr<std::size_t> openSessions)
+        : socket{std::move(socket)}
+        , request{maxRequestSize}
+        , deadline{this->socket.get_executor()}
+        , openSessions{std::move(openSessions)}
+    {
+        ++*this->openSessions;
+    }
+
+    ~Session()
+    {
+        --*openSessions;
+    }
+
+    Socket socket;
+    asio::streambuf request;
+    std::string response;
+    asio::steady_timer deadline;
+    std::shared_ptr<std::size_t> openSessions;
+};
+
+auto MakeResponse(const char* status, const char* contentType, const std::string& body) -> std::string
+{
+    return std::string{"HTTP/1.1 "} + status + "\r\nContent-Type: " + contentType
+           + "\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+}
+
+} // namespace
+
+MetricsServer::MetricsServer(asio::io_context& ioContext, const std::string& endpoint, RenderMetrics renderMetrics,
+                             SilKit::Services::Logging::ILogger* logger)
+    : _renderMetrics{std::move(renderMetrics)}
+    , _logger{logger}
+    , _acceptRetryTimer{ioContext}
+{
+    if (endpoint.rfind(localEndpointPrefix, 0) == 0)
+    {
+#if !WIN32
+        _localSocketPath = endpoint.substr(std::string{localEndpointPrefix}.size());
+        std::remove(_localSocketPath.c_str()); // stale socket of a previous run
+        _localAcceptor.emplace(ioContext, asio::local::stream_protocol::endpoint{_localSocketPath});
+        _logger->Info("Serving metrics on unix socket " + _localSocketPath);
+        Accept(*_localAcceptor);
+#else
+        throw std::invalid_argument{"unix sockets are not supported for the metrics endpoint on Windows"};
+#endif
+    }
+    else
+    {
+        const auto port = static_cast<unsigned short>(std::stoul(endpoint));
+        _tcpAcceptor.emplace(ioContext, asio::ip::tcp::endpoint{asio::ip::address_v4::loopback(), port});
+        _logger->Info("Serving metrics on http://127.0.0.1:" + std::to_string(port) + "/metrics");
+        Accept(*_tcpAcceptor);
+    }
+}
+
+MetricsServer::~MetricsServer()
+{
+#if !WIN32
+    if (_localAcceptor)
+    {
+        _localAcceptor->close();
+        std::remove(_localSocketPath.c_str());
+    }
+#endif
+}
+
+void MetricsServer::AddCommand(const std::string& path, Command command)
+{
+    _commands[path] = std::move(command);
+}
+
+template <typename Acceptor>
+void MetricsServer::Accept(Acceptor& acceptor)
+{
+    acceptor.async_accept([this, &acceptor](const std::error_code ec, typename Acceptor::protocol_type::socket socket) {
+        if (ec == asio::error::operation_aborted)
+        {
+            return;
+        }
+
+        if (ec)
+        {
+            // e.g. out of file descriptors, accepting again right away would fail the same way
+            if (!_acceptFailing)
+            {
+                _logger->Warn("Metrics endpoint: failed to accept connection (" + ec.message() + "), retrying every "
+                              + std::to_string(acceptRetryDelay.count()) + " s");
+                _acceptFailing = true;
+            }
+            AcceptLater(acceptor);
+            return;
+        }
+
+        _acceptFailing = false;
+        if (*_openSessions < maxOpenSessions)
+        {
+            Serve(std::move(socket));
+        }
+        // otherwise the socket is closed when it goes out of scope
+
+        Accept(acceptor);
+    });
+}
+
+template <typename Acceptor>
+void MetricsServer::AcceptLater(Acceptor& acceptor)
+{
+    _acceptRetryTimer.expires_after(acceptRetryDelay);
+    _acceptRetryTimer.async_wait([this, &acceptor](const std::error_code ec) {
+        if (!ec)
+        {
+            Accept(acceptor);
+        }
+    });
+}
+
+template <typename Socket>
+void MetricsServer::Serve(Socket socket)
+{
+    auto session = std::make_shared<Session<Socket>>(std::move(socket), _openSessions);
+
+    // the deadline covers reading the request and writing the response
+    session->deadline.expires_after(sessionTimeout);
+    session->deadline.async_wait([weakSession = std::weak_ptr<Session<Socket>>{session}](const std::error_code ec) {
+        const auto session = weakSession.lock();
+        if (!ec && session)
+        {
+            std::error_code ignored;
+            session->socket.close(ignored);
+        }
+    });
+
+    asio::async_read_until(session->socket, session->request, "\r\n\r\n",
+                           [this, session](const std::error_code ec, std::size_t /*bytesTransferred*/) {
+        if (ec)
+        {
+            return; // client went away or sent an oversized request
+        }
+
+        std::istream requestStream{&session->request};
+        std::string requestLine;
+        std::getline(requestStream, requestLine);
+
+        session->response = Respond(requestLine);
+        asio::async_write(session->socket, asio::buffer(session->response),
+                          [session](const std::error_code /*ec*/, std::size_t /*bytesTransferred*/) {
+            std::error_code ignored;
+            session->socket.shutdown(asio::socket_base::shutdown_both, ignored);
+        });
+    });
+}
+
+auto MetricsServer::Respond(const std::string& requestLine) -> std::string
+{
+    // e.g. "GET /metrics HTTP/1.1\r"
+    const auto methodEnd = requestLine.find(' ');
+    const auto pathEnd = requestLine.find(' ', methodEnd + 1);
+    if (methodEnd == std::string::npos || pathEnd == std::string::npos)
+    {
+        return MakeResponse("400 Bad Request", "text/plain", "Bad Request\n");
+    }
+
+    const auto method = requestLine.substr(0, methodEnd);
+    const auto path = requestLine.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+
+    if (path == "/metrics" || path == "/")
+    {
+        if (method != "GET")
+        {
+            return MakeResponse("405 Method Not Allowed", "text/plain", "Method Not Allowed\n");
+        }
+        return MakeResponse("200 OK", "application/openmetrics-text; version=1.0.0; charset=utf-8",
+                            _renderMetrics());
+    }
+
+    if (const auto command = _commands.find(path); command != _commands.end())
+    {
+        if (method != "POST")
+        {
+            return MakeResponse("405 Method Not Allowed", "text/plain", "Method Not Allowed\n");
+        }
+        return MakeResponse("200 OK", "text/plain", command->second());
+    }
+
+    return MakeResponse("404 Not Found", "text/plain", "Not Found\n");
+}
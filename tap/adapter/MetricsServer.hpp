@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "asio/ts/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/steady_timer.hpp"
+#if !WIN32
+#include "asio/local/stream_protocol.hpp"
+#endif
+
+#include "silkit/services/logging/all.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// Minimal HTTP server exposing the adapter metrics in the OpenMetrics text format under /metrics.
+///
+///   The server only listens on the loopback interface or on a Unix domain socket. Requests are
+///   handled on the given io_context, the metrics are rendered on demand for every request.
+///   Control commands of the adapter are triggered by POST requests to their paths.
+///
+///   Since the io_context also forwards the frames of the TAP device, clients cannot hold on to it: a
+///   connection is closed if it is not answered within a few seconds, connections beyond a small limit
+///   are closed right away, and accepting pauses for a moment after a failure, e.g. when the process
+///   runs out of file descriptors.
+/// </summary>
+class MetricsServer
+{
+public:
+    using RenderMetrics = std::function<std::string()>;
+    using Command = std::function<std::string()>;
+
+    /// <param name="endpoint">TCP port on 127.0.0.1, or "unix:" followed by a socket path.</param>
+    MetricsServer(asio::io_context& ioContext, const std::string& endpoint, RenderMetrics renderMetrics,
+                  SilKit::Services::Logging::ILogger* logger);
+    ~MetricsServer();
+
+    /// <summary>
+    /// Registers a command which is run on the io_context for POST requests to path. The returned text
+    /// is the response body.
+    /// </summary>
+    void AddCommand(const std::string& path, Command command);
+
+private:
+    template <typename Acceptor>
+    void Accept(Acceptor& acceptor);
+
+    template <typename Acceptor>
+    void AcceptLater(Acceptor& acceptor);
+
+    template <typename Socket>
+    void Serve(Socket socket);
+
+    auto Respond(const std::string& requestLine) -> std::string;
+
+    RenderMetrics _renderMetrics;
+    std::map<std::string, Command> _commands;
+    SilKit::Services::Logging::ILogger* _logger;
+
+    // shared with the sessions, which may outlive the server in the handlers of the io_context
+    std::shared_ptr<std::size_t> _openSessions{std::make_shared<std::size_t>(0)};
+    asio::steady_timer _acceptRetryTimer;
+    bool _acceptFailing{false};
+
+    std::optional<asio::ip::tcp::acceptor> _tcpAcceptor;
+#if !WIN32
+    std::optional<asio::local::stream_protocol::acceptor> _localAcceptor;
+    std::string _localSocketPath;
+#endif
+};
+
+} // namespace adapters
@@ -0,0 +1,509 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "MtuAdaptation.hpp"
+#include "Metrics.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "Enums.hpp"
+#include "PacketView.hpp"
+#include "Ip6Header.hpp"
+#include "Icmp6Header.hpp"
+
+using namespace adapters;
+
+namespace {
+
+using Ip4 = demo::layout::Ip4;
+using Ip6 = demo::layout::Ip6;
+using Tcp = demo::layout::Tcp;
+using MssOption = demo::layout::TcpMaximumSegmentSizeOption;
+
+constexpr std::size_t maxDatagramSize = 65535;
+// RFC 1812, 4.3.2.3: ICMP errors quote as much of the offending datagram as fits into 576 bytes
+constexpr std::size_t maxIcmp4ErrorSize = 576;
+constexpr std::uint8_t replyTimeToLive = 64;
+
+// Copies the Ethernet header of a frame with swapped addresses, for a reply to it
+void WriteReplyEthernetHeader(std::uint8_t* reply, const std::uint8_t* frame, std::size_t ethernetHeaderSize)
+{
+    std::memcpy(reply, frame + 6, 6);
+    std::memcpy(reply + 6, frame, 6);
+    std::memcpy(reply + 12, frame + 12, ethernetHeaderSize - 12);
+}
+
+// ICMP errors are neither sent for multicast and broadcast packets nor to unspecified sources (RFC 1812, 4.3.2.7)
+bool MayReplyTo(const demo::Ip4View& ip4)
+{
+    return ip4.GetDestinationAddress().data[0] < 224 && !(ip4.GetSourceAddress() == demo::Ip4Address{});
+}
+
+// RFC 4443, 2.4: the reply would have to come from a multicast address, and not to the unspecified address
+bool MayReplyTo(const demo::Ip6Address& source, const demo::Ip6Address& destination)
+{
+    return destination.data[0] != 0xff && !(source == demo::Ip6Address{});
+}
+
+// The adapter has no address of its own, the error claims to come from the destination of the packet. Hosts
+// match it to their connection by the quoted headers.
+void WriteFragmentationNeeded(const std::uint8_t* frame, std::size_t ethernetHeaderSize, const demo::Ip4View& ip4,
+                              std::uint16_t mtu, MtuAdaptation::Frames& output)
+{
+    using Icmp = demo::layout::Icmp4DestinationUnreachable;
+    const std::size_t quotedSize =
+        std::min<std::size_t>(ip4.GetTotalLength(), maxIcmp4ErrorSize - Ip4::size - Icmp::size);
+    auto& reply = output.emplace_back(ethernetHeaderSize + Ip4::size + Icmp::size + quotedSize);
+    WriteReplyEthernetHeader(reply.data(), frame, ethernetHeaderSize);
+
+    auto* ip4Reply = reply.data() + ethernetHeaderSize;
+    demo::WriteIp4Header(asio::buffer(ip4Reply, Ip4::size),
+                         demo::Ip4Header{static_cast<std::uint16_t>(Ip4::size + Icmp::size + quotedSize), 0, false,
+                                         false, 0, replyTimeToLive, demo::Ip4Protocol::ICMP, 0,
+                                         ip4.GetDestinationAddress(), ip4.GetSourceAddress()});
+
+    auto* icmp = ip4Reply + Ip4::size;
+    Icmp::Type::Store(icmp, demo::Icmp4Type::DestinationUnreachable);
+    Icmp::Code::Store(icmp, demo::icmp4FragmentationNeeded);
+    Icmp::NextHopMtu::Store(icmp, mtu);
+    std::memcpy(icmp + Icmp::size, ip4.GetHeader().data(), quotedSize);
+
+    demo::InternetChecksum checksum;
+    checksum.AddBuffer(asio::buffer(icmp, Icmp::size + quotedSize));
+    Icmp::Checksum::Store(icmp, checksum.GetChecksum());
+}
+
+void WritePacketTooBig(const std::uint8_t* frame, std::size_t ethernetHeaderSize, asio::const_buffer packet,
+                       std::uint16_t mtu, MtuAdaptation::Frames& output)
+{
+    using Icmp = demo::layout::Icmp6PacketTooBig;
+    const auto* offending = static_cast<const std::uint8_t*>(packet.data());
+    const std::size_t quotedSize =
+        std::min<std::size_t>(packet.size(), MtuAdaptation::minMtu - Ip6::size - Icmp::size);
+    const std::size_t icmpSize = Icmp::size + quotedSize;
+    auto& reply = output.emplace_back(ethernetHeaderSize + Ip6::size + icmpSize);
+    WriteReplyEthernetHeader(reply.data(), frame, ethernetHeaderSize);
+
+    auto* ip6Reply = reply.data() + ethernetHeaderSize;
+    Ip6::Version::Store(ip6Reply, 6);
+    Ip6::PayloadLength::Store(ip6Reply, static_cast<std::uint16_t>(icmpSize));
+    Ip6::NextHeader::Store(ip6Reply, demo::Ip6NextHeader::ICMPv6);
+    Ip6::HopLimit::Store(ip6Reply, replyTimeToLive);
+    Ip6::SourceAddress::Store(ip6Reply, Ip6::DestinationAddress::Load(offending));
+    Ip6::DestinationAddress::Store(ip6Reply, Ip6::SourceAddress::Load(offending));
+
+    auto* icmp = ip6Reply + Ip6::size;
+    Icmp::Type::Store(icmp, demo::Icmp6Type::PacketTooBig);
+    Icmp::Mtu::Store(icmp, mtu);
+    std::memcpy(icmp + Icmp::size, offending, quotedSize);
+
+    Icmp::Checksum::Store(icmp, demo::ComputeIp6UpperLayerChecksum(ip6Reply, asio::buffer(icmp, icmpSize),
+                                                                   demo::Ip6NextHeader::ICMPv6));
+}
+
+// The options of the fragments after the first one: only those with the copied flag (RFC 791), padded to 32 bits
+auto CopyOptionsForFragments(const std::uint8_t* options, std::size_t size, std::uint8_t* target) -> std::size_t
+{
+    std::size_t targetSize = 0;
+    for (std::size_t index = 0; index < size;)
+    {
+        const auto type = options[index];
+        if (type == 0) // end of option list
+        {
+            break;
+        }
+        if (type == 1) // no operation
+        {
+            ++index;
+            continue;
+        }
+        if (index + 1 >= size || options[index + 1] < 2 || index + options[index + 1] > size)
+        {
+            break;
+        }
+        const std::size_t length = options[index + 1];
+        if ((type & 0x80u) != 0)
+        {
+            std::memcpy(target + targetSize, options + index, length);
+            targetSize += length;
+        }
+        index += length;
+    }
+    for (; targetSize % 4 != 0; ++targetSize)
+    {
+        target[targetSize] = 0;
+    }
+    return targetSize;
+}
+
+void Fragment(const std::uint8_t* frame, std::size_t ethernetHeaderSize, const demo::Ip4View& ip4,
+              std::uint16_t mtu, MtuAdaptation::Frames& output)
+{
+    const auto* header = static_cast<const std::uint8_t*>(ip4.GetHeader().data());
+    const std::size_t headerLength = ip4.GetHeaderLength();
+    const auto payload = ip4.GetPayload();
+    const auto* payloadBytes = static_cast<const std::uint8_t*>(payload.data());
+
+    std::array<std::uint8_t, 40> laterOptions;
+    const std::size_t laterHeaderLength =
+        Ip4::size + CopyOptionsForFragments(header + Ip4::size, headerLength - Ip4::size, laterOptions.data());
+
+    // the packet may be a fragment itself, its fragments take its place in the datagram
+    const std::size_t offsetBase = ip4.GetFragmentOffset() * 8u;
+    for (std::size_t offset = 0; offset < payload.size();)
+    {
+        const bool isFirst = offset == 0;
+        const std::size_t fragmentHeaderLength = isFirst ? headerLength : laterHeaderLength;
+        // all fragments but the last one carry a multiple of 8 bytes
+        const std::size_t dataSize = std::min((mtu - fragmentHeaderLength) & ~std::size_t{7}, payload.size() - offset);
+
+        auto& fragment = output.emplace_back(ethernetHeaderSize + fragmentHeaderLength + dataSize);
+        auto* fragmentHeader = fragment.data() + ethernetHeaderSize;
+        std::memcpy(fragment.data(), frame, ethernetHeaderSize);
+        std::memcpy(fragmentHeader, header, Ip4::size);
+        std::memcpy(fragmentHeader + Ip4::size, isFirst ? header + Ip4::size : laterOptions.data(),
+                    fragmentHeaderLength - Ip4::size);
+        std::memcpy(fragmentHeader + fragmentHeaderLength, payloadBytes + offset, dataSize);
+
+        Ip4::HeaderLength::Store(fragmentHeader, static_cast<std::uint8_t>(fragmentHeaderLength / 4u));
+        Ip4::TotalLength::Store(fragmentHeader, static_cast<std::uint16_t>(fragmentHeaderLength + dataSize));
+        Ip4::MoreFragments::Store(fragmentHeader, offset + dataSize < payload.size() || ip4.GetMoreFragments());
+        Ip4::FragmentOffset::Store(fragmentHeader, static_cast<std::uint16_t>((offsetBase + offset) / 8u));
+        Ip4::Checksum::Store(fragmentHeader, 0);
+        demo::InternetChecksum checksum;
+        checksum.AddBuffer(asio::buffer(fragmentHeader, fragmentHeaderLength));
+        Ip4::Checksum::Store(fragmentHeader, checksum.GetChecksum());
+
+        offset += dataSize;
+    }
+}
+
+// The MSS excludes the IP and TCP header without options (RFC 9293, 3.7.1)
+auto GetMaxSegmentSize(std::uint16_t mtu, const demo::Flow& flow) -> std::uint16_t
+{
+    return static_cast<std::uint16_t>(mtu - (flow.key.ipVersion == 4 ? Ip4::size : Ip6::size) - Tcp::size);
+}
+
+// Adds [begin, end) to the sorted ranges and merges it with the ranges it overlaps or touches
+void AddRange(std::vector<std::pair<std::uint32_t, std::uint32_t>>& ranges, std::uint32_t begin, std::uint32_t end)
+{
+    auto first =
+        std::find_if(ranges.begin(), ranges.end(), [begin](const auto& range) { return range.second >= begin; });
+    auto last = first;
+    for (; last != ranges.end() && last->first <= end; ++last)
+    {
+        begin = std::min(begin, last->first);
+        end = std::max(end, last->second);
+    }
+    ranges.insert(ranges.erase(first, last), {begin, end});
+}
+
+} // namespace
+
+MtuAdaptation::MtuAdaptation(Options options)
+    : _options{options}
+    , _reassemblies(std::max<std::size_t>(options.maxReassemblies, 1))
+{
+}
+
+auto MtuAdaptation::AdaptToSilKit(std::vector<std::uint8_t>& frame, const FrameMetadata& metadata,
+                                  Frames& output) const -> Verdict
+{
+    output.clear();
+    const auto ethernet = demo::EthernetView::Parse(asio::buffer(frame));
+    if (!ethernet)
+    {
+        return Verdict::Forward;
+    }
+
+    // the payload includes the padding of short frames, it only exceeds the MTU for large packets
+    if (ethernet.GetPayload().size() > _options.mtu)
+    {
+        const auto ethernetHeaderSize = ethernet.GetHeaderSize();
+        if (ethernet.GetEtherType() == demo::EtherType::Ip4)
+        {
+            const auto ip4 = demo::Ip4View::Parse(ethernet.GetPayload());
+            if (ip4 && ip4.GetTotalLength() > _options.mtu)
+            {
+                if (ip4.GetDontFragment())
+                {
+                    if (MayReplyTo(ip4))
+                    {
+                        WriteFragmentationNeeded(frame.data(), ethernetHeaderSize, ip4, _options.mtu, output);
+                    }
+                    return Verdict::TooBig;
+                }
+                Fragment(frame.data(), ethernetHeaderSize, ip4, _options.mtu, output);
+                metrics::Increment(metrics::Counter::MtuFragmentedPackets);
+                return Verdict::Fragmented;
+            }
+        }
+        else if (ethernet.GetEtherType() == demo::EtherType::Ip6)
+        {
+            // routers never fragment IPv6, only the sender can
+            const auto packet = ethernet.GetPayload();
+            const auto* bytes = static_cast<const std::uint8_t*>(packet.data());
+            const std::size_t packetSize =
+                demo::FitsLayout<Ip6>(packet) ? Ip6::size + Ip6::PayloadLength::Load(bytes) : 0;
+            if (packetSize > _options.mtu && packetSize <= packet.size() && Ip6::Version::Load(bytes) == 6)
+            {
+                const auto source = Ip6::SourceAddress::Load(bytes);
+                const auto destination = Ip6::DestinationAddress::Load(bytes);
+                if (MayReplyTo(source, destination))
+                {
+                    WritePacketTooBig(frame.data(), ethernetHeaderSize, asio::buffer(packet, packetSize),
+                                      _options.mtu, output);
+                }
+                return Verdict::TooBig;
+            }
+        }
+        // other protocols cannot be adapted, the frame is forwarded as before
+    }
+
+    if (_options.clampMss)
+    {
+        const auto flow = metadata.flow ? metadata.flow : demo::ExtractFlow(asio::buffer(frame));
+        if (const auto valueOffset = FindOversizeMss(asio::buffer(frame), flow))
+        {
+            ClampMss(frame.data(), *flow, *valueOffset);
+        }
+    }
+    return Verdict::Forward;
+}
+
+auto MtuAdaptation::AdaptToEndpoint(asio::const_buffer frame, std::vector<std::uint8_t>& storage)
+    -> std::optional<asio::const_buffer>
+{
+    const auto ethernet = demo::EthernetView::Parse(frame);
+    if (!ethernet)
+    {
+        return frame;
+    }
+
+    if (ethernet.GetEtherType() == demo::EtherType::Ip4)
+    {
+        const auto ip4 = demo::Ip4View::Parse(ethernet.GetPayload());
+        if (ip4 && ip4.IsFragment())
+        {
+            if (!Reassemble(static_cast<const std::uint8_t*>(frame.data()), ethernet.GetHeaderSize(), ip4, storage))
+            {
+                return std::nullopt;
+            }
+            frame = asio::buffer(storage);
+        }
+    }
+
+    if (_options.clampMss)
+    {
+        const auto flow = demo::ExtractFlow(frame);
+        if (const auto valueOffset = FindOversizeMss(frame, flow))
+        {
+            // frames from SIL Kit are read-only
+            if (frame.data() != storage.data())
+            {
+                const auto* bytes = static_cast<const std::uint8_t*>(frame.data());
+                storage.assign(bytes, bytes + frame.size());
+            }
+            ClampMss(storage.data(), *flow, *valueOffset);
+            frame = asio::buffer(storage);
+        }
+    }
+    return frame;
+}
+
+auto MtuAdaptation::FindOversizeMss(asio::const_buffer frame, const std::optional<demo::Flow>& flow) const
+    -> std::optional<std::size_t>
+{
+    if (!flow || flow->key.protocol != demo::ToUnderlying(demo::Ip4Protocol::TCP) || flow->isFragment)
+    {
+        return std::nullopt;
+    }
+    const auto tcp = demo::TcpView::Parse(frame + flow->transportOffset);
+    if (!tcp || (tcp.GetFlags() & demo::ToUnderlying(demo::TcpFlags::Syn)) == 0)
+    {
+        return std::nullopt;
+    }
+
+    const auto* segment = static_cast<const std::uint8_t*>(frame.data()) + flow->transportOffset;
+    const std::size_t dataOffset = tcp.GetDataOffset();
+    for (std::size_t offset = Tcp::size; offset < dataOffset;)
+    {
+        const auto kind = static_cast<demo::TcpOptionKind>(segment[offset]);
+        if (kind == demo::TcpOptionKind::EndOfOptionList)
+        {
+            break;
+        }
+        if (kind == demo::TcpOptionKind::NoOperation)
+        {
+            ++offset;
+            continue;
+        }
+        if (offset + 1 >= dataOffset || segment[offset + 1] < 2 || offset + segment[offset + 1] > dataOffset)
+        {
+            break;
+        }
+        if (kind == demo::TcpOptionKind::MaximumSegmentSize && segment[offset + 1] == MssOption::size)
+        {
+            if (MssOption::MaximumSegmentSize::Load(segment + offset) <= GetMaxSegmentSize(_options.mtu, *flow))
+            {
+                return std::nullopt;
+            }
+            return flow->transportOffset + offset + MssOption::MaximumSegmentSize::offset;
+        }
+        offset += segment[offset + 1];
+    }
+    return std::nullopt;
+}
+
+void MtuAdaptation::ClampMss(std::uint8_t* frame, const demo::Flow& flow, std::size_t valueOffset) const
+{
+    const auto maxSegmentSize = GetMaxSegmentSize(_options.mtu, flow);
+
+    // Options are not aligned to 16-bit words, an unaligned value changes the two words holding its bytes. The
+    // header length is a multiple of 32 bits, so the second word is still part of it.
+    auto* segment = frame + flow.transportOffset;
+    const std::size_t firstWordOffset = (valueOffset - flow.transportOffset) & ~std::size_t{1};
+    const std::size_t wordCount = (valueOffset - flow.transportOffset) % 2 == 0 ? 1 : 2;
+    std::uint16_t oldWords[2] = {};
+    for (std::size_t wordIndex = 0; wordIndex < wordCount; ++wordIndex)
+    {
+        oldWords[wordIndex] = demo::LoadBe<std::uint16_t>(segment + firstWordOffset + wordIndex * 2);
+    }
+
+    demo::StoreBe<std::uint16_t>(frame + valueOffset, maxSegmentSize);
+
+    auto checksum = Tcp::Checksum::Load(segment);
+    for (std::size_t wordIndex = 0; wordIndex < wordCount; ++wordIndex)
+    {
+        const auto newWord = demo::LoadBe<std::uint16_t>(segment + firstWordOffset + wordIndex * 2);
+        checksum = demo::InternetChecksum::Update(checksum, oldWords[wordIndex], newWord);
+    }
+    Tcp::Checksum::Store(segment, checksum);
+    metrics::Increment(metrics::Counter::MtuClampedMss);
+}
+
+auto MtuAdaptation::Reassemble(const std::uint8_t* frame, std::size_t ethernetHeaderSize, const demo::Ip4View& ip4,
+                               std::vector<std::uint8_t>& storage) -> bool
+{
+    const auto* header = static_cast<const std::uint8_t*>(ip4.GetHeader().data());
+    // source and destination address are adjacent
+    const auto addresses = demo::LoadBe<std::uint64_t>(header + Ip4::SourceAddress::offset);
+    const auto protocolAndIdentification =
+        (std::uint32_t{demo::ToUnderlying(ip4.GetProtocol())} << 16u) | ip4.GetIdentification();
+    auto& reassembly = FindReassembly(addresses, protocolAndIdentification, Clock::now());
+    ++reassembly.fragmentCount;
+
+    const auto payload = ip4.GetPayload();
+    const std::uint32_t begin = ip4.GetFragmentOffset() * 8u;
+    const auto end = static_cast<std::uint32_t>(begin + payload.size());
+    const bool isLast = !ip4.GetMoreFragments();
+    // all fragments but the last one carry a multiple of 8 bytes, and none may reach past the last one
+    if (end > maxDatagramSize - Ip4::size || (!isLast && payload.size() % 8 != 0)
+        || (reassembly.dataSize && (end > *reassembly.dataSize || (isLast && end != *reassembly.dataSize)))
+        || (isLast && !reassembly.ranges.empty() && reassembly.ranges.back().second > end))
+    {
+        Drop(reassembly);
+        return false;
+    }
+
+    if (isLast)
+    {
+        reassembly.dataSize = end;
+    }
+    if (begin == 0)
+    {
+        reassembly.ethernetHeaderSize = ethernetHeaderSize;
+        reassembly.header.assign(frame, header + ip4.GetHeaderLength());
+    }
+    if (reassembly.data.size() < end)
+    {
+        reassembly.data.resize(end);
+    }
+    std::memcpy(reassembly.data.data() + begin, payload.data(), payload.size());
+    AddRange(reassembly.ranges, begin, end);
+
+    const bool isComplete = !reassembly.header.empty() && reassembly.dataSize && reassembly.ranges.size() == 1
+                            && reassembly.ranges.front().first == 0;
+    if (!isComplete)
+    {
+        return false;
+    }
+
+    const std::size_t headerLength = reassembly.header.size() - reassembly.ethernetHeaderSize;
+    const std::size_t totalLength = headerLength + *reassembly.dataSize;
+    if (totalLength > maxDatagramSize)
+    {
+        Drop(reassembly);
+        return false;
+    }
+
+    storage.resize(reassembly.header.size() + *reassembly.dataSize);
+    std::memcpy(storage.data(), reassembly.header.data(), reassembly.header.size());
+    std::memcpy(storage.data() + reassembly.header.size(), reassembly.data.data(), *reassembly.dataSize);
+    reassembly.active = false;
+
+    auto* datagramHeader = storage.data() + reassembly.ethernetHeaderSize;
+    Ip4::TotalLength::Store(datagramHeader, static_cast<std::uint16_t>(totalLength));
+    Ip4::MoreFragments::Store(datagramHeader, false);
+    Ip4::FragmentOffset::Store(datagramHeader, 0);
+    Ip4::Checksum::Store(datagramHeader, 0);
+    demo::InternetChecksum checksum;
+    checksum.AddBuffer(asio::buffer(datagramHeader, headerLength));
+    Ip4::Checksum::Store(datagramHeader, checksum.GetChecksum());
+
+    metrics::Increment(metrics::Counter::MtuReassembledPackets);
+    return true;
+}
+
+auto MtuAdaptation::FindReassembly(std::uint64_t addresses, std::uint32_t protocolAndIdentification,
+                                   Clock::time_point now) -> Reassembly&
+{
+    // the table is small, a linear search also expires the datagrams which timed out
+    Reassembly* freeSlot = nullptr;
+    Reassembly* oldest = nullptr;
+    for (auto& reassembly : _reassemblies)
+    {
+        if (reassembly.active && now - reassembly.started > _options.reassemblyTimeout)
+        {
+            Drop(reassembly);
+        }
+        if (!reassembly.active)
+        {
+            freeSlot = freeSlot ? freeSlot : &reassembly;
+            continue;
+        }
+        if (reassembly.addresses == addresses && reassembly.protocolAndIdentification == protocolAndIdentification)
+        {
+            return reassembly;
+        }
+        if (!oldest || reassembly.started < oldest->started)
+        {
+            oldest = &reassembly;
+        }
+    }
+
+    auto& reassembly = freeSlot ? *freeSlot : *oldest;
+    if (reassembly.active)
+    {
+        Drop(reassembly);
+    }
+    reassembly.active = true;
+    reassembly.addresses = addresses;
+    reassembly.protocolAndIdentification = protocolAndIdentification;
+    reassembly.started = now;
+    reassembly.fragmentCount = 0;
+    reassembly.ethernetHeaderSize = 0;
+    reassembly.header.clear();
+    reassembly.data.clear();
+    reassembly.ranges.clear();
+    reassembly.dataSize.reset();
+    return reassembly;
+}
+
+void MtuAdaptation::Drop(Reassembly& reassembly)
+{
+    metrics::Increment(metrics::Counter::DropsSilKitToTapReassemblyFailed, reassembly.fragmentCount);
+    reassembly.active = false;
+}
@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "FrameMetadata.hpp"
+
+#include "asio/ts/buffer.hpp"
+
+namespace demo {
+class Ip4View;
+} // namespace demo
+
+namespace adapters {
+
+/// <summary>
+/// Adapts the frames exchanged between the TAP device and SIL Kit to a smaller MTU on the SIL Kit side.
+///
+///   IPv4 packets from the TAP device which exceed the MTU are fragmented. If they must not be fragmented, and
+///   for oversize IPv6 packets, the TAP device gets an ICMP fragmentation needed or ICMPv6 packet too big message
+///   instead, so that path MTU discovery of its hosts adapts. IPv4 fragments from SIL Kit are reassembled before
+///   they are written to the TAP device. Optionally, the maximum segment size of TCP SYN segments in both
+///   directions is clamped, so that TCP does not send oversize segments in the first place.
+///
+///   AdaptToSilKit does not change the state and may be called from any thread. AdaptToEndpoint owns the
+///   reassembly table and must only be called from the thread which receives the frames of SIL Kit.
+/// </summary>
+class MtuAdaptation
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Frames = std::vector<std::vector<std::uint8_t>>;
+
+    // the minimum link MTU of IPv6 (RFC 8200)
+    static constexpr std::uint16_t minMtu = 1280;
+
+    struct Options
+    {
+        // the largest IPv4 or IPv6 packet in a frame on the SIL Kit side, without Ethernet header and VLAN tag
+        std::uint16_t mtu = 1500;
+        bool clampMss = false;
+        // datagrams reassembled at the same time, the oldest one is dropped for a new one
+        std::size_t maxReassemblies = 64;
+        // like ipfrag_time of Linux
+        Clock::duration reassemblyTimeout = std::chrono::seconds{30};
+    };
+
+    enum struct Verdict : std::uint8_t
+    {
+        // forward the frame, its MSS may have been clamped in place
+        Forward,
+        // forward the fragments of the output instead of the frame
+        Fragmented,
+        // drop the frame, the output holds the ICMP error for the TAP device if one may be sent
+        TooBig,
+    };
+
+    explicit MtuAdaptation(Options options);
+
+    /// <summary>
+    /// Adapts a frame received from the TAP device. Other than IPv4 and IPv6 frames are forwarded unchanged.
+    /// </summary>
+    /// <param name="metadata">The flow of the frame is reused to find TCP SYN segments, if it was classified.</param>
+    /// <param name="output">Cleared and filled with the fragments or the ICMP error, see Verdict.</param>
+    auto AdaptToSilKit(std::vector<std::uint8_t>& frame, const FrameMetadata& metadata, Frames& output) const
+        -> Verdict;
+
+    /// <summary>
+    /// Adapts a frame received from SIL Kit. Returns the frame to write to the TAP device: the frame itself, or a
+    /// reassembled or clamped copy in storage. Returns nothing for a fragment of an incomplete datagram.
+    /// </summary>
+    auto AdaptToEndpoint(asio::const_buffer frame, std::vector<std::uint8_t>& storage)
+        -> std::optional<asio::const_buffer>;
+
+private:
+    // A datagram being reassembled. The slots are reused, so that their buffers keep their capacity.
+    struct Reassembly
+    {
+        bool active{false};
+        // the datagram is identified by source, destination, protocol and identification (RFC 791)
+        std::uint64_t addresses{0};
+        std::uint32_t protocolAndIdentification{0};
+        Clock::time_point started{};
+        std::uint32_t fragmentCount{0};
+        // the Ethernet and IPv4 header of the first fragment, empty until it arrived
+        std::size_t ethernetHeaderSize{0};
+        std::vector<std::uint8_t> header;
+        std::vector<std::uint8_t> data;
+        // the received ranges of data, sorted and merged
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> ranges;
+        // known once the last fragment arrived
+        std::optional<std::uint32_t> dataSize;
+    };
+
+    // Returns the offset of the MSS option value in the frame, if the frame is a TCP SYN segment with an MSS larger
+    // than the MTU allows
+    auto FindOversizeMss(asio::const_buffer frame, const std::optional<demo::Flow>& flow) const
+        -> std::optional<std::size_t>;
+    void ClampMss(std::uint8_t* frame, const demo::Flow& flow, std::size_t valueOffset) const;
+
+    auto Reassemble(const std::uint8_t* frame, std::size_t ethernetHeaderSize, const demo::Ip4View& ip4,
+                    std::vector<std::uint8_t>& storage) -> bool;
+    auto FindReassembly(std::uint64_t addresses, std::uint32_t protocolAndIdentification, Clock::time_point now)
+        -> Reassembly&;
+    static void Drop(Reassembly& reassembly);
+
+    Options _options;
+    std::vector<Reassembly> _reassemblies;
+};
+
+} // namespace adapters
@@ -0,0 +1,423 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "MulticastSnooping.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include "PacketView.hpp"
+#include "Ip6Header.hpp"
+#include "IgmpMessage.hpp"
+#include "Icmp6Header.hpp"
+#include "MldMessage.hpp"
+
+using namespace adapters;
+
+namespace {
+
+using GroupAddress = std::array<std::uint8_t, 16>;
+
+auto ToGroupAddress(const demo::Ip4Address& ip4Address) -> GroupAddress
+{
+    GroupAddress group = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+    std::copy(ip4Address.data.begin(), ip4Address.data.end(), group.begin() + 12);
+    return group;
+}
+
+auto ToGroupAddress(const demo::Ip6Address& ip6Address) -> GroupAddress
+{
+    return ip6Address.data;
+}
+
+auto ToString(const GroupAddress& group) -> std::string
+{
+    static constexpr std::uint8_t ip4MappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+
+    std::ostringstream stream;
+    if (std::memcmp(group.data(), ip4MappedPrefix, sizeof(ip4MappedPrefix)) == 0)
+    {
+        stream << demo::Ip4Address{{group[12], group[13], group[14], group[15]}};
+    }
+    else
+    {
+        stream << demo::Ip6Address{group};
+    }
+    return stream.str();
+}
+
+bool IsIp4Multicast(const demo::Ip4Address& address)
+{
+    return (address.data[0] & 0xF0) == 0xE0; // 224.0.0.0/4
+}
+
+// 224.0.0.0/24 carries routing and membership protocols and must never be constrained (RFC 4541, 2.1.2)
+bool IsIp4LocalNetworkControlBlock(const demo::Ip4Address& address)
+{
+    return address.data[0] == 224 && address.data[1] == 0 && address.data[2] == 0;
+}
+
+bool IsIp6AllNodes(const demo::Ip6Address& address)
+{
+    static constexpr demo::Ip6Address allNodes{{0xff, 0x02, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01}};
+    return address == allNodes;
+}
+
+// ff02::1:ffXX:XXXX is used by neighbor discovery, which must not depend on the snooping state
+bool IsIp6SolicitedNode(const demo::Ip6Address& address)
+{
+    static constexpr std::uint8_t solicitedNodePrefix[13] = {0xff, 0x02, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0xff};
+    return std::memcmp(address.data.data(), solicitedNodePrefix, sizeof(solicitedNodePrefix)) == 0;
+}
+
+bool IsLeave(demo::MulticastRecordType recordType, std::uint16_t numberOfSources)
+{
+    // "include nothing" is how IGMPv3 and MLDv2 express leaving a group
+    return numberOfSources == 0
+           && (recordType == demo::MulticastRecordType::ChangeToIncludeMode
+               || recordType == demo::MulticastRecordType::ModeIsInclude);
+}
+
+} // namespace
+
+constexpr std::chrono::seconds MulticastSnooping::defaultMembershipInterval;
+constexpr std::chrono::seconds MulticastSnooping::lastMemberQueryTime;
+constexpr std::size_t MulticastSnooping::maxGroups;
+
+std::size_t MulticastSnooping::GroupAddressHash::operator()(const GroupAddress& address) const
+{
+    std::uint64_t high, low;
+    std::memcpy(&high, address.data(), sizeof(high));
+    std::memcpy(&low, address.data() + sizeof(high), sizeof(low));
+    return static_cast<std::size_t>((high * 0x9E3779B97F4A7C15ull) ^ low);
+}
+
+MulticastSnooping::MulticastSnooping(SilKit::Services::Logging::ILogger* logger,
+                                     std::chrono::seconds membershipInterval)
+    : _logger(logger)
+    , _membershipInterval(membershipInterval)
+{
+}
+
+void MulticastSnooping::SnoopTapFrame(asio::const_buffer frame)
+{
+    const auto bytes = static_cast<const std::uint8_t*>(frame.data());
+    if (frame.size() < 14 || (bytes[0] & 0x01) == 0)
+    {
+        return; // membership reports are always sent to a multicast address
+    }
+
+    try
+    {
+        const auto now = Clock::now();
+        const auto ethernet = demo::EthernetView::Parse(frame);
+        if (!ethernet)
+        {
+            return;
+        }
+
+        switch (ethernet.GetEtherType())
+        {
+        case demo::EtherType::Ip4:
+        {
+            const auto ip4 = demo::Ip4View::Parse(ethernet.GetPayload());
+            if (ip4 && ip4.GetProtocol() == demo::Ip4Protocol::IGMP)
+            {
+                SnoopIgmp(ip4.GetPayload(), now);
+            }
+            break;
+        }
+        case demo::EtherType::Ip6:
+        {
+            const auto [ip6Header, ip6Payload] = demo::ParseIp6Header(ethernet.GetPayload());
+            const auto [upperLayerProtocol, upperLayerPayload] =
+                demo::SkipIp6ExtensionHeaders(ip6Header.nextHeader, ip6Payload);
+            if (upperLayerProtocol == demo::Ip6NextHeader::ICMPv6)
+            {
+                SnoopMld(upperLayerPayload, now);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    catch (const std::exception&)
+    {
+        // malformed frames are forwarded unchanged, they just do not change any membership
+    }
+}
+
+bool MulticastSnooping::ShouldForwardToTap(asio::const_buffer frame)
+{
+    const auto bytes = static_cast<const std::uint8_t*>(frame.data());
+    if (frame.size() < 14 || (bytes[0] & 0x01) == 0)
+    {
+        return true;
+    }
+
+    try
+    {
+        const auto ethernet = demo::EthernetView::Parse(frame);
+        if (!ethernet)
+        {
+            return true;
+        }
+
+        switch (ethernet.GetEtherType())
+        {
+        case demo::EtherType::Ip4:
+        {
+            const auto ip4 = demo::Ip4View::Parse(ethernet.GetPayload());
+            if (!ip4)
+            {
+                return true;
+            }
+            const auto group = ip4.GetDestinationAddress();
+            if (!IsIp4Multicast(group))
+            {
+                return true;
+            }
+
+            const auto now = Clock::now();
+            if (IsIp4LocalNetworkControlBlock(group))
+            {
+                const auto ip4Payload = ip4.GetPayload();
+                if (ip4.GetProtocol() == demo::Ip4Protocol::IGMP && ip4Payload.size() >= 1
+                    && static_cast<const std::uint8_t*>(ip4Payload.data())[0]
+                           == demo::ToUnderlying(demo::IgmpType::MembershipQuery))
+                {
+                    QuerierSeen(now);
+                }
+                return true;
+            }
+            return IsJoined(ToGroupAddress(group), now);
+        }
+        case demo::EtherType::Ip6:
+        {
+            const auto [ip6Header, ip6Payload] = demo::ParseIp6Header(ethernet.GetPayload());
+            const auto& group = ip6Header.destinationAddress;
+            if (group.data[0] != 0xff || IsIp6SolicitedNode(group))
+            {
+                return true;
+            }
+
+            const auto now = Clock::now();
+            if (IsIp6AllNodes(group))
+            {
+                const auto [upperLayerProtocol, upperLayerPayload] =
+                    demo::SkipIp6ExtensionHeaders(ip6Header.nextHeader, ip6Payload);
+                if (upperLayerProtocol == demo::Ip6NextHeader::ICMPv6
+                    && demo::ReadUintBe<demo::Icmp6Type>(upperLayerPayload)
+                           == demo::Icmp6Type::MulticastListenerQuery)
+                {
+                    QuerierSeen(now);
+                }
+                return true;
+            }
+            return IsJoined(ToGroupAddress(group), now);
+        }
+        default:
+            return true;
+        }
+    }
+    catch (const std::exception&)
+    {
+        return true;
+    }
+}
+
+void MulticastSnooping::SnoopIgmp(asio::const_buffer igmpMessage, Clock::time_point now)
+{
+    auto [igmpHeader, groupRecords] = demo::ParseIgmpHeader(igmpMessage);
+
+    switch (igmpHeader.type)
+    {
+    case demo::IgmpType::V1MembershipReport:
+    case demo::IgmpType::V2MembershipReport:
+        Join(ToGroupAddress(igmpHeader.groupAddress), now);
+        break;
+    case demo::IgmpType::V2LeaveGroup:
+        Leave(ToGroupAddress(igmpHeader.groupAddress), now);
+        break;
+    case demo::IgmpType::V3MembershipReport:
+        for (std::uint16_t recordIndex = 0; recordIndex < igmpHeader.numberOfGroupRecords; ++recordIndex)
+        {
+            const auto [groupRecord, nextGroupRecords] = demo::ParseIgmp3GroupRecord(groupRecords);
+            groupRecords = nextGroupRecords;
+
+            if (IsLeave(groupRecord.recordType, groupRecord.numberOfSources))
+            {
+                Leave(ToGroupAddress(groupRecord.multicastAddress), now);
+            }
+            else if (groupRecord.recordType != demo::MulticastRecordType::BlockOldSources)
+            {
+                Join(ToGroupAddress(groupRecord.multicastAddress), now);
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void MulticastSnooping::SnoopMld(asio::const_buffer icmp6Message, Clock::time_point now)
+{
+    const auto [icmp6Header, icmp6Payload] = demo::ParseIcmp6Header(icmp6Message);
+
+    switch (icmp6Header.type)
+    {
+    case demo::Icmp6Type::MulticastListenerReport:
+        Join(ToGroupAddress(demo::ParseMld1Message(icmp6Payload).header.multicastAddress), now);
+        break;
+    case demo::Icmp6Type::MulticastListenerDone:
+        Leave(ToGroupAddress(demo::ParseMld1Message(icmp6Payload).header.multicastAddress), now);
+        break;
+    case demo::Icmp6Type::Version2MulticastListenerReport:
+    {
+        auto [numberOfGroupRecords, groupRecords] = demo::ParseMld2ReportHeader(icmp6Payload);
+        for (std::uint16_t recordIndex = 0; recordIndex < numberOfGroupRecords; ++recordIndex)
+        {
+            const auto [groupRecord, nextGroupRecords] = demo::ParseMld2GroupRecord(groupRecords);
+            groupRecords = nextGroupRecords;
+
+            if (IsLeave(groupRecord.recordType, groupRecord.numberOfSources))
+            {
+                Leave(ToGroupAddress(groupRecord.multicastAddress), now);
+            }
+            else if (groupRecord.recordType != demo::MulticastRecordType::BlockOldSources)
+            {
+                Join(ToGroupAddress(groupRecord.multicastAddress), now);
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void MulticastSnooping::Join(const GroupAddress& group, Clock::time_point now)
+{
+    bool isNewGroup = false;
+    bool isFirstOverflow = false;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        auto it = _groups.find(group);
+        if (it == _groups.end())
+        {
+            if (_groups.size() >= maxGroups)
+            {
+                for (auto expiredIt = _groups.begin(); expiredIt != _groups.end();)
+                {
+                    expiredIt = IsExpired(expiredIt->second, now) ? _groups.erase(expiredIt) : std::next(expiredIt);
+                }
+            }
+            if (_groups.size() >= maxGroups)
+            {
+                isFirstOverflow = !_groupsOverflowed;
+                _groupsOverflowed = true;
+            }
+            else
+            {
+                it = _groups.emplace(group, Membership{}).first;
+                isNewGroup = true;
+            }
+        }
+        if (it != _groups.end())
+        {
+            it->second.lastReport = now;
+            it->second.leaveDeadline = Clock::time_point{};
+        }
+    }
+
+    if (isNewGroup)
+    {
+        _logger->Debug("Multicast snooping: TAP device joined group " + ToString(group));
+    }
+    if (isFirstOverflow)
+    {
+        _logger->Warn("Multicast snooping: more than " + std::to_string(maxGroups)
+                      + " groups joined, frames to unknown groups are forwarded from now on");
+    }
+}
+
+void MulticastSnooping::Leave(const GroupAddress& group, Clock::time_point now)
+{
+    bool isMember = false;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        const auto it = _groups.find(group);
+        if (it != _groups.end() && it->second.leaveDeadline == Clock::time_point{})
+        {
+            // other hosts that still listen keep the group by answering the query that follows the leave
+            it->second.leaveDeadline = now + (IsQuerierActive(now) ? Clock::duration{lastMemberQueryTime}
+                                                                   : _membershipInterval);
+            isMember = true;
+        }
+    }
+
+    if (isMember)
+    {
+        _logger->Debug("Multicast snooping: TAP device left group " + ToString(group));
+    }
+}
+
+void MulticastSnooping::QuerierSeen(Clock::time_point now)
+{
+    bool isNewQuerier = false;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        if (_querierLastSeen == Clock::time_point{} || now - _querierLastSeen > _membershipInterval)
+        {
+            // memberships are only refreshed from now on, give the hosts a full interval to report
+            _querierSince = now;
+            isNewQuerier = true;
+        }
+        _querierLastSeen = now;
+    }
+
+    if (isNewQuerier)
+    {
+        _logger->Debug("Multicast snooping: querier detected on the SIL Kit network, memberships now expire");
+    }
+}
+
+bool MulticastSnooping::IsJoined(const GroupAddress& group, Clock::time_point now)
+{
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        const auto it = _groups.find(group);
+        if (it == _groups.end())
+        {
+            // a host may have joined the group after the table overflowed
+            return _groupsOverflowed;
+        }
+        if (!IsExpired(it->second, now))
+        {
+            return true;
+        }
+
+        _groups.erase(it);
+    }
+
+    _logger->Debug("Multicast snooping: membership of group " + ToString(group) + " expired");
+    return false;
+}
+
+bool MulticastSnooping::IsQuerierActive(Clock::time_point now) const
+{
+    return _querierLastSeen != Clock::time_point{} && now - _querierLastSeen <= _membershipInterval;
+}
+
+bool MulticastSnooping::IsExpired(const Membership& membership, Clock::time_point now) const
+{
+    if (membership.leaveDeadline != Clock::time_point{} && now >= membership.leaveDeadline)
+    {
+        return true;
+    }
+    return IsQuerierActive(now) && now - std::max(membership.lastReport, _querierSince) > _membershipInterval;
+}
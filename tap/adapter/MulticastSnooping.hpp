@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include "asio/ts/buffer.hpp"
+
+#include "silkit/services/logging/all.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// IGMPv1/v2/v3 and MLDv1/v2 snooping for the TAP device port.
+///
+///   Group memberships are learned from the reports the TAP device side sends. IP multicast
+///   frames from SIL Kit are only forwarded to the TAP device if a host on the TAP side joined
+///   their group. Link-local control groups (224.0.0.0/24, ff02::1, solicited-node) and non-IP
+///   multicast are always forwarded.
+///
+///   Memberships expire after the group membership interval, which only applies while a querier
+///   is active on the SIL Kit network. Without a querier the hosts do not refresh their reports,
+///   so memberships are then kept until the group is left.
+///
+///   A leave only ends a membership after the last member query time, in which other hosts that
+///   still listen answer the query of the querier. Without a querier nobody is asked, so a left
+///   group is kept for the full membership interval. The table holds at most maxGroups groups,
+///   once a report did not fit, frames to unknown groups are forwarded instead of dropped.
+/// </summary>
+class MulticastSnooping
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // RFC 3376, 8.4: robustness variable (2) * query interval (125s) + query response interval (10s)
+    static constexpr std::chrono::seconds defaultMembershipInterval{260};
+    // RFC 3376, 8.8 and 8.9: last member query count (2) * last member query interval (1s)
+    static constexpr std::chrono::seconds lastMemberQueryTime{2};
+    static constexpr std::size_t maxGroups = 4096;
+
+    MulticastSnooping(SilKit::Services::Logging::ILogger* logger,
+                      std::chrono::seconds membershipInterval = defaultMembershipInterval);
+
+    /// <summary>
+    /// Inspects a frame received from the TAP device and updates the group memberships it reports.
+    /// </summary>
+    void SnoopTapFrame(asio::const_buffer frame);
+
+    /// <summary>
+    /// Returns false if the frame received from SIL Kit is addressed to a multicast group nobody
+    /// on the TAP device side joined.
+    /// </summary>
+    bool ShouldForwardToTap(asio::const_buffer frame);
+
+private:
+    // IPv4 groups are stored as IPv4-mapped IPv6 addresses
+    using GroupAddress = std::array<std::uint8_t, 16>;
+
+    struct GroupAddressHash
+    {
+        std::size_t operator()(const GroupAddress& address) const;
+    };
+
+    struct Membership
+    {
+        Clock::time_point lastReport;
+        // set by a leave, the membership ends then unless another report arrives before
+        Clock::time_point leaveDeadline{};
+    };
+
+    void Join(const GroupAddress& group, Clock::time_point now);
+    void Leave(const GroupAddress& group, Clock::time_point now);
+    void QuerierSeen(Clock::time_point now);
+    bool IsJoined(const GroupAddress& group, Clock::time_point now);
+
+    // Both require _mutex to be held
+    bool IsQuerierActive(Clock::time_point now) const;
+    bool IsExpired(const Membership& membership, Clock::time_point now) const;
+
+    void SnoopIgmp(asio::const_buffer igmpMessage, Clock::time_point now);
+    void SnoopMld(asio::const_buffer icmp6Message, Clock::time_point now);
+
+    SilKit::Services::Logging::ILogger* _logger;
+    const Clock::duration _membershipInterval;
+
+    std::mutex _mutex;
+    std::unordered_map<GroupAddress, Membership, GroupAddressHash> _groups;
+    bool _groupsOverflowed{false};
+    Clock::time_point _querierSince{};
+    Clock::time_point _querierLastSeen{};
+};
+
+} // namespace adapters
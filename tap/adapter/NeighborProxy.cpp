@@ -0,0 +1,481 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "NeighborProxy.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include "ArpIp4Packet.hpp"
+#include "Enums.hpp"
+#include "Icmp6Header.hpp"
+#include "Ip6Header.hpp"
+#include "PacketView.hpp"
+#include "Split.hpp"
+
+#include "asio/ip/address.hpp"
+
+using namespace adapters;
+
+namespace {
+
+using IpAddress = NeighborProxy::IpAddress;
+using Ip6 = demo::layout::Ip6;
+using NeighborSolicitation = demo::layout::Icmp6NeighborSolicitation;
+using NeighborAdvertisement = demo::layout::Icmp6NeighborAdvertisement;
+using LinkLayerAddressOption = demo::layout::NdpLinkLayerAddressOption;
+
+// RFC 4861, 7.1.1: neighbor discovery messages must come from the link itself
+constexpr std::uint8_t ndpHopLimit = 255;
+
+auto ToIpAddress(const demo::Ip4Address& ip4Address) -> IpAddress
+{
+    IpAddress address = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+    std::copy(ip4Address.data.begin(), ip4Address.data.end(), address.begin() + 12);
+    return address;
+}
+
+auto ToIpAddress(const demo::Ip6Address& ip6Address) -> IpAddress
+{
+    return ip6Address.data;
+}
+
+auto ToString(const IpAddress& address) -> std::string
+{
+    static constexpr std::uint8_t ip4MappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+
+    std::ostringstream stream;
+    if (std::memcmp(address.data(), ip4MappedPrefix, sizeof(ip4MappedPrefix)) == 0)
+    {
+        stream << demo::Ip4Address{{address[12], address[13], address[14], address[15]}};
+    }
+    else
+    {
+        stream << demo::Ip6Address{address};
+    }
+    return stream.str();
+}
+
+auto ToString(const demo::EthernetAddress& address) -> std::string
+{
+    std::ostringstream stream;
+    stream << address;
+    return stream.str();
+}
+
+// Multicast and the all-zero address are never the address of a neighbor
+bool IsUnicast(const demo::EthernetAddress& address)
+{
+    return (address.data[0] & 0x01) == 0 && !(address == demo::EthernetAddress{});
+}
+
+auto ParseUnicastEthernetAddress(const std::string& text) -> demo::EthernetAddress
+{
+    const auto address = demo::ParseEthernetAddress(text);
+    if (!IsUnicast(address))
+    {
+        throw std::invalid_argument{"'" + text + "' is not a unicast Ethernet address"};
+    }
+    return address;
+}
+
+// Returns the Ethernet address of the first link-layer address option of the given type
+auto FindLinkLayerAddress(asio::const_buffer options, demo::NdpOptionType type)
+    -> std::optional<demo::EthernetAddress>
+{
+    while (options.size() >= 2)
+    {
+        const auto bytes = static_cast<const std::uint8_t*>(options.data());
+        const std::size_t optionSize = LinkLayerAddressOption::Length::Load(bytes) * std::size_t{8};
+        if (optionSize == 0 || optionSize > options.size())
+        {
+            return std::nullopt; // RFC 4861, 4.6: the message must be discarded
+        }
+        if (LinkLayerAddressOption::Type::Load(bytes) == demo::ToUnderlying(type)
+            && optionSize >= LinkLayerAddressOption::size)
+        {
+            return LinkLayerAddressOption::Address::Load(bytes);
+        }
+        options += optionSize;
+    }
+    return std::nullopt;
+}
+
+// Writes the Ethernet header of a reply to frame, sent by the owner of the requested address
+void WriteReplyEthernetHeader(std::uint8_t* reply, const std::uint8_t* frame, std::size_t ethernetHeaderSize,
+                              const demo::EthernetAddress& owner)
+{
+    std::memcpy(reply, frame + 6, 6);
+    std::memcpy(reply + 6, owner.data.data(), 6);
+    std::memcpy(reply + 12, frame + 12, ethernetHeaderSize - 12);
+}
+
+} // namespace
+
+constexpr std::chrono::seconds NeighborProxy::defaultMaxAge;
+constexpr std::size_t NeighborProxy::defaultMaxEntries;
+
+auto NeighborProxy::ParseBindings(const std::string& list) -> std::vector<Binding>
+{
+    std::vector<Binding> bindings;
+    for (const auto& term : demo::Split(list, ','))
+    {
+        const auto equalSign = term.find('=');
+        if (equalSign == std::string::npos)
+        {
+            throw std::invalid_argument{"'" + term + "' is not of the form <ip>=<mac>"};
+        }
+
+        const auto ipText = term.substr(0, equalSign);
+        std::error_code errorCode;
+        const auto ipAddress = asio::ip::make_address(ipText, errorCode);
+        if (errorCode || ipAddress.is_multicast() || ipAddress.is_unspecified())
+        {
+            throw std::invalid_argument{"'" + ipText + "' is not a unicast IPv4 or IPv6 address"};
+        }
+
+        Binding binding{};
+        if (ipAddress.is_v4())
+        {
+            const auto bytes = ipAddress.to_v4().to_bytes();
+            binding.ipAddress = ToIpAddress(demo::Ip4Address{{bytes[0], bytes[1], bytes[2], bytes[3]}});
+        }
+        else
+        {
+            const auto bytes = ipAddress.to_v6().to_bytes();
+            std::copy(bytes.begin(), bytes.end(), binding.ipAddress.begin());
+        }
+        binding.ethernetAddress = ParseUnicastEthernetAddress(term.substr(equalSign + 1));
+        bindings.push_back(binding);
+    }
+    return bindings;
+}
+
+std::size_t NeighborProxy::IpAddressHash::operator()(const IpAddress& address) const
+{
+    std::uint64_t high, low;
+    std::memcpy(&high, address.data(), sizeof(high));
+    std::memcpy(&low, address.data() + sizeof(high), sizeof(low));
+    return static_cast<std::size_t>((high * 0x9E3779B97F4A7C15ull) ^ low);
+}
+
+NeighborProxy::NeighborProxy(SilKit::Services::Logging::ILogger* logger, std::chrono::seconds maxAge,
+                             std::size_t maxEntries)
+    : _logger(logger)
+    , _maxAge(maxAge)
+    , _maxEntries(maxEntries)
+{
+}
+
+void NeighborProxy::AddStaticBinding(const Binding& binding)
+{
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _entries[binding.ipAddress] = Entry{binding.ethernetAddress, Clock::time_point{}, false, true};
+    }
+
+    _logger->Debug("Neighbor proxy: static binding " + ToString(binding.ipAddress) + " is at "
+                   + ToString(binding.ethernetAddress));
+}
+
+void NeighborProxy::LearnFromSilKitFrame(asio::const_buffer frame)
+{
+    const auto ethernet = demo::EthernetView::Parse(frame);
+    if (!ethernet)
+    {
+        return;
+    }
+
+    switch (ethernet.GetEtherType())
+    {
+    case demo::EtherType::Arp:
+        LearnFromArp(ethernet.GetPayload(), Clock::now());
+        break;
+    case demo::EtherType::Ip6:
+        LearnFromNdp(ethernet.GetPayload(), Clock::now());
+        break;
+    default:
+        break;
+    }
+}
+
+bool NeighborProxy::AnswerTapFrame(asio::const_buffer frame, std::vector<std::uint8_t>& reply)
+{
+    const auto ethernet = demo::EthernetView::Parse(frame);
+    if (!ethernet)
+    {
+        return false;
+    }
+
+    switch (ethernet.GetEtherType())
+    {
+    case demo::EtherType::Arp:
+        return AnswerArp(frame, ethernet.GetHeaderSize(), reply, Clock::now());
+    case demo::EtherType::Ip6:
+        return AnswerNeighborSolicitation(frame, ethernet.GetHeaderSize(), reply, Clock::now());
+    default:
+        return false;
+    }
+}
+
+void NeighborProxy::LearnFromArp(asio::const_buffer packet, Clock::time_point now)
+{
+    // requests and replies alike, which includes gratuitous ARP announcing a new or moved address
+    const auto arp = demo::ArpView::Parse(packet);
+    if (!arp
+        || (arp.GetOperation() != demo::ArpOperation::Request && arp.GetOperation() != demo::ArpOperation::Reply))
+    {
+        return;
+    }
+
+    const auto senderAddress = arp.GetSenderProtocolAddress();
+    const auto senderHardwareAddress = arp.GetSenderHardwareAddress();
+    if (senderAddress == demo::Ip4Address{} || !IsUnicast(senderHardwareAddress))
+    {
+        return; // probes (RFC 5227) do not claim the address yet
+    }
+    Learn(ToIpAddress(senderAddress), senderHardwareAddress, std::nullopt, now);
+}
+
+void NeighborProxy::LearnFromNdp(asio::const_buffer packet, Clock::time_point now)
+{
+    if (!demo::FitsLayout<Ip6>(packet))
+    {
+        return;
+    }
+    const auto ip6 = static_cast<const std::uint8_t*>(packet.data());
+    const std::size_t payloadLength = Ip6::PayloadLength::Load(ip6);
+    if (Ip6::Version::Load(ip6) != 6 || Ip6::NextHeader::Load(ip6) != demo::Ip6NextHeader::ICMPv6
+        || Ip6::HopLimit::Load(ip6) != ndpHopLimit || payloadLength < NeighborSolicitation::size
+        || packet.size() < Ip6::size + payloadLength)
+    {
+        return;
+    }
+
+    const auto icmp6 = ip6 + Ip6::size;
+    const auto type = NeighborSolicitation::Type::Load(icmp6);
+    if ((type != demo::Icmp6Type::NeighborSolicitation && type != demo::Icmp6Type::NeighborAdvertisement)
+        || NeighborSolicitation::Code::Load(icmp6) != 0)
+    {
+        return;
+    }
+    const auto message = asio::buffer(icmp6, payloadLength);
+    if (demo::ComputeIp6UpperLayerChecksum(ip6, message, demo::Ip6NextHeader::ICMPv6) != 0)
+    {
+        return;
+    }
+
+    const auto options = message + NeighborSolicitation::size;
+    if (type == demo::Icmp6Type::NeighborSolicitation)
+    {
+        // the source link-layer address option is absent in duplicate address detection from ::
+        const auto source = Ip6::SourceAddress::Load(ip6);
+        const auto address = FindLinkLayerAddress(options, demo::NdpOptionType::SourceLinkLayerAddress);
+        if (!(source == demo::Ip6Address{}) && address && IsUnicast(*address))
+        {
+            Learn(ToIpAddress(source), *address, std::nullopt, now);
+        }
+    }
+    else
+    {
+        const auto address = FindLinkLayerAddress(options, demo::NdpOptionType::TargetLinkLayerAddress);
+        if (address && IsUnicast(*address))
+        {
+            Learn(ToIpAddress(NeighborAdvertisement::TargetAddress::Load(icmp6)), *address,
+                  NeighborAdvertisement::Router::Load(icmp6), now);
+        }
+    }
+}
+
+bool NeighborProxy::AnswerArp(asio::const_buffer frame, std::size_t ethernetHeaderSize,
+                              std::vector<std::uint8_t>& reply, Clock::time_point now)
+{
+    const auto arp = demo::ArpView::Parse(frame + ethernetHeaderSize);
+    if (!arp || arp.GetOperation() != demo::ArpOperation::Request)
+    {
+        return false;
+    }
+
+    // probes and announcements (RFC 5227) are left to the owner of the address
+    const auto senderAddress = arp.GetSenderProtocolAddress();
+    const auto targetAddress = arp.GetTargetProtocolAddress();
+    if (senderAddress == demo::Ip4Address{} || senderAddress == targetAddress)
+    {
+        return false;
+    }
+
+    const auto entry = Lookup(ToIpAddress(targetAddress), now);
+    if (!entry)
+    {
+        return false;
+    }
+
+    reply.assign(ethernetHeaderSize + demo::layout::ArpIp4::size, 0);
+    WriteReplyEthernetHeader(reply.data(), static_cast<const std::uint8_t*>(frame.data()), ethernetHeaderSize,
+                             entry->ethernetAddress);
+    demo::WriteArpIp4Packet(asio::buffer(reply) + ethernetHeaderSize,
+                            demo::ArpIp4Packet{demo::ArpOperation::Reply, entry->ethernetAddress, targetAddress,
+                                               arp.GetSenderHardwareAddress(), senderAddress});
+    return true;
+}
+
+bool NeighborProxy::AnswerNeighborSolicitation(asio::const_buffer frame, std::size_t ethernetHeaderSize,
+                                               std::vector<std::uint8_t>& reply, Clock::time_point now)
+{
+    const auto packet = frame + ethernetHeaderSize;
+    if (!demo::FitsLayout<Ip6>(packet))
+    {
+        return false;
+    }
+    const auto ip6 = static_cast<const std::uint8_t*>(packet.data());
+    const std::size_t payloadLength = Ip6::PayloadLength::Load(ip6);
+    if (Ip6::Version::Load(ip6) != 6 || Ip6::NextHeader::Load(ip6) != demo::Ip6NextHeader::ICMPv6
+        || Ip6::HopLimit::Load(ip6) != ndpHopLimit || payloadLength < NeighborSolicitation::size
+        || packet.size() < Ip6::size + payloadLength)
+    {
+        return false;
+    }
+
+    const auto icmp6 = ip6 + Ip6::size;
+    if (NeighborSolicitation::Type::Load(icmp6) != demo::Icmp6Type::NeighborSolicitation
+        || NeighborSolicitation::Code::Load(icmp6) != 0)
+    {
+        return false;
+    }
+
+    // duplicate address detection (RFC 4862, 5.4) is left to the owner of the address
+    const auto source = Ip6::SourceAddress::Load(ip6);
+    const auto target = NeighborSolicitation::TargetAddress::Load(icmp6);
+    if (source == demo::Ip6Address{} || target.data[0] == 0xff)
+    {
+        return false;
+    }
+
+    const auto entry = Lookup(ToIpAddress(target), now);
+    if (!entry)
+    {
+        return false;
+    }
+
+    const std::size_t icmp6Size = NeighborAdvertisement::size + LinkLayerAddressOption::size;
+    reply.assign(ethernetHeaderSize + Ip6::size + icmp6Size, 0);
+    WriteReplyEthernetHeader(reply.data(), static_cast<const std::uint8_t*>(frame.data()), ethernetHeaderSize,
+                             entry->ethernetAddress);
+
+    auto* ip6Reply = reply.data() + ethernetHeaderSize;
+    Ip6::Version::Store(ip6Reply, 6);
+    Ip6::PayloadLength::Store(ip6Reply, static_cast<std::uint16_t>(icmp6Size));
+    Ip6::NextHeader::Store(ip6Reply, demo::Ip6NextHeader::ICMPv6);
+    Ip6::HopLimit::Store(ip6Reply, ndpHopLimit);
+    Ip6::SourceAddress::Store(ip6Reply, target);
+    Ip6::DestinationAddress::Store(ip6Reply, source);
+
+    // The binding was announced by the owner itself, so the answer overrides a cached address like the answer of
+    // the owner would.
+    auto* advertisement = ip6Reply + Ip6::size;
+    NeighborAdvertisement::Type::Store(advertisement, demo::Icmp6Type::NeighborAdvertisement);
+    NeighborAdvertisement::Router::Store(advertisement, entry->isRouter);
+    NeighborAdvertisement::Solicited::Store(advertisement, true);
+    NeighborAdvertisement::Override::Store(advertisement, true);
+    NeighborAdvertisement::TargetAddress::Store(advertisement, target);
+
+    auto* option = advertisement + NeighborAdvertisement::size;
+    LinkLayerAddressOption::Type::Store(option, demo::ToUnderlying(demo::NdpOptionType::TargetLinkLayerAddress));
+    LinkLayerAddressOption::Length::Store(option, LinkLayerAddressOption::size / 8);
+    LinkLayerAddressOption::Address::Store(option, entry->ethernetAddress);
+
+    NeighborAdvertisement::Checksum::Store(
+        advertisement, demo::ComputeIp6UpperLayerChecksum(ip6Reply, asio::buffer(advertisement, icmp6Size),
+                                                          demo::Ip6NextHeader::ICMPv6));
+    return true;
+}
+
+void NeighborProxy::Learn(const IpAddress& ipAddress, const demo::EthernetAddress& ethernetAddress,
+                          std::optional<bool> isRouter, Clock::time_point now)
+{
+    bool isNewBinding = false;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        auto it = _entries.find(ipAddress);
+        if (it == _entries.end())
+        {
+            while (_entries.size() >= _maxEntries)
+            {
+                if (!EvictOldest(now))
+                {
+                    return; // only static bindings
+                }
+            }
+            it = _entries.emplace(ipAddress, Entry{ethernetAddress, now, false, false}).first;
+            isNewBinding = true;
+        }
+        else if (it->second.isStatic)
+        {
+            return;
+        }
+
+        auto& entry = it->second;
+        isNewBinding = isNewBinding || !(entry.ethernetAddress == ethernetAddress);
+        entry.ethernetAddress = ethernetAddress;
+        entry.lastSeen = now;
+        entry.isRouter = isRouter.value_or(entry.isRouter);
+    }
+
+    if (isNewBinding)
+    {
+        _logger->Debug("Neighbor proxy: learned " + ToString(ipAddress) + " is at " + ToString(ethernetAddress));
+    }
+}
+
+auto NeighborProxy::Lookup(const IpAddress& ipAddress, Clock::time_point now) -> std::optional<Entry>
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+    const auto it = _entries.find(ipAddress);
+    if (it == _entries.end())
+    {
+        return std::nullopt;
+    }
+    if (!it->second.isStatic && now - it->second.lastSeen > _maxAge)
+    {
+        _entries.erase(it);
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+auto NeighborProxy::EvictOldest(Clock::time_point now) -> bool
+{
+    // only called when the table is full, which makes room for more than one binding if some expired
+    const auto size = _entries.size();
+    auto oldest = _entries.end();
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        if (it->second.isStatic)
+        {
+            ++it;
+            continue;
+        }
+        if (now - it->second.lastSeen > _maxAge)
+        {
+            it = _entries.erase(it);
+            continue;
+        }
+        if (oldest == _entries.end() || it->second.lastSeen < oldest->second.lastSeen)
+        {
+            oldest = it;
+        }
+        ++it;
+    }
+    if (_entries.size() < size)
+    {
+        return true;
+    }
+    if (oldest == _entries.end())
+    {
+        return false;
+    }
+    _entries.erase(oldest);
+    return true;
+}
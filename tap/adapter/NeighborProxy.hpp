@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "EthernetAddress.hpp"
+
+#include "asio/ts/buffer.hpp"
+
+#include "silkit/services/logging/all.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// Answers ARP requests and IPv6 neighbor solicitations of the TAP device side from a cache, so that neighbor
+/// resolution does not wait for a round trip through SIL Kit.
+///
+///   Bindings of IP to Ethernet addresses are learned from the ARP packets and the neighbor advertisements and
+///   solicitations with a link-layer address option received from SIL Kit, and can be configured statically.
+///   Requests for addresses without a binding, probes and duplicate address detection are forwarded to SIL Kit
+///   as usual. Learned bindings expire after maxAge without being seen again, static ones never.
+///
+///   LearnFromSilKitFrame and AnswerTapFrame may be called from different threads.
+/// </summary>
+class NeighborProxy
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // like the default stale time of Linux neighbor entries (gc_stale_time)
+    static constexpr std::chrono::seconds defaultMaxAge{60};
+    static constexpr std::size_t defaultMaxEntries = 1024;
+
+    // IPv4 addresses are stored as IPv4-mapped IPv6 addresses
+    using IpAddress = std::array<std::uint8_t, 16>;
+
+    struct Binding
+    {
+        IpAddress ipAddress;
+        demo::EthernetAddress ethernetAddress;
+    };
+
+    /// <summary>
+    /// Parses a comma separated list of static bindings of the form ip=mac, e.g.
+    /// "192.168.7.2=02:00:00:00:00:02,fd00::2=02-00-00-00-00-02".
+    /// </summary>
+    /// <exception cref="std::invalid_argument">Thrown if the list is malformed.</exception>
+    static auto ParseBindings(const std::string& list) -> std::vector<Binding>;
+
+    NeighborProxy(SilKit::Services::Logging::ILogger* logger, std::chrono::seconds maxAge = defaultMaxAge,
+                  std::size_t maxEntries = defaultMaxEntries);
+
+    /// <summary>
+    /// Adds a binding which never expires and is not overwritten by learned ones.
+    /// </summary>
+    void AddStaticBinding(const Binding& binding);
+
+    /// <summary>
+    /// Inspects a frame received from SIL Kit and learns the binding of its sender.
+    /// </summary>
+    void LearnFromSilKitFrame(asio::const_buffer frame);
+
+    /// <summary>
+    /// Returns true and writes the reply for the TAP device to reply if the frame received from the TAP device is
+    /// an ARP request or a neighbor solicitation for an address with a binding. The frame is then not forwarded.
+    /// </summary>
+    bool AnswerTapFrame(asio::const_buffer frame, std::vector<std::uint8_t>& reply);
+
+private:
+    struct IpAddressHash
+    {
+        std::size_t operator()(const IpAddress& address) const;
+    };
+
+    struct Entry
+    {
+        demo::EthernetAddress ethernetAddress;
+        Clock::time_point lastSeen;
+        // from the router flag of neighbor advertisements, answers must not clear it (RFC 4861, 7.2.5)
+        bool isRouter;
+        bool isStatic;
+    };
+
+    void Learn(const IpAddress& ipAddress, const demo::EthernetAddress& ethernetAddress,
+               std::optional<bool> isRouter, Clock::time_point now);
+    auto Lookup(const IpAddress& ipAddress, Clock::time_point now) -> std::optional<Entry>;
+    // with the mutex held, returns false if there are only static bindings
+    auto EvictOldest(Clock::time_point now) -> bool;
+
+    void LearnFromArp(asio::const_buffer packet, Clock::time_point now);
+    void LearnFromNdp(asio::const_buffer packet, Clock::time_point now);
+
+    bool AnswerArp(asio::const_buffer frame, std::size_t ethernetHeaderSize, std::vector<std::uint8_t>& reply,
+                   Clock::time_point now);
+    bool AnswerNeighborSolicitation(asio::const_buffer frame, std::size_t ethernetHeaderSize,
+                                    std::vector<std::uint8_t>& reply, Clock::time_point now);
+
+    SilKit::Services::Logging::ILogger* _logger;
+    const Clock::duration _maxAge;
+    const std::size_t _maxEntries;
+
+    std::mutex _mutex;
+    std::unordered_map<IpAddress, Entry, IpAddressHash> _entries;
+};
+
+} // namespace adapters
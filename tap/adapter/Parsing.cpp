@@ -3,10 +3,43 @@
 
 #include "Parsing.hpp"
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 
 const std::string adapters::tapNameArg = "--tap-name";
 const std::string adapters::networkArg = "--network";
 const std::string adapters::vlanTagArg = "--vlan-tag";
+const std::string adapters::multicastSnoopingArg = "--multicast-snooping";
+const std::string adapters::someIpStatisticsArg = "--someip-statistics";
+const std::string adapters::flowHashArg = "--flow-hash";
+const std::string adapters::mtuArg = "--mtu";
+const std::string adapters::clampMssArg = "--clamp-mss";
+const std::string adapters::neighborProxyArg = "--neighbor-proxy";
+const std::string adapters::neighborProxyStaticArg = "--neighbor-proxy-static";
+const std::string adapters::metricsEndpointArg = "--metrics-endpoint";
+const std::string adapters::metricsLogIntervalArg = "--metrics-log-interval";
+const std::string adapters::latencyHistogramsArg = "--latency-histograms";
+const std::string adapters::traceRateLimitArg = "--trace-rate-limit";
+const std::string adapters::traceFlowSamplingArg = "--trace-flow-sampling";
+const std::string adapters::captureArg = "--capture";
+const std::string adapters::captureSnapLengthArg = "--capture-snaplen";
+const std::string adapters::captureFilterArg = "--capture-filter";
+const std::string adapters::captureRotateSizeArg = "--capture-rotate-size";
+const std::string adapters::captureRotateIntervalArg = "--capture-rotate-interval";
+const std::string adapters::captureMaxFilesArg = "--capture-max-files";
+const std::string adapters::flightRecorderArg = "--flight-recorder";
+const std::string adapters::flightRecorderFramesArg = "--flight-recorder-frames";
+const std::string adapters::flightRecorderSnapLengthArg = "--flight-recorder-snaplen";
+const std::string adapters::flightRecorderNackBurstArg = "--flight-recorder-nack-burst";
+const std::string adapters::switchPortsArg = "--switch-ports";
+const std::string adapters::cpuAffinityArg = "--cpu-affinity";
+const std::string adapters::schedFifoArg = "--sched-fifo";
+const std::string adapters::lockMemoryArg = "--lock-memory";
+const std::string adapters::startupQueueFramesArg = "--startup-queue-frames";
+const std::string adapters::startupQueueAgeArg = "--startup-queue-age";
+const std::string adapters::readyFileArg = "--ready-file";
+const std::string adapters::loopSuppressionArg = "--loop-suppression";
+const std::string adapters::loopSuppressionWindowArg = "--loop-suppression-window";
 
 void adapters::print_help(bool userRequested)
 {
@@ -20,6 +53,37 @@ void adapters::print_help(bool userRequested)
                  "  ["<<tapNameArg<<" <tap device's name{silkit_tap}>]\n"
                  "  ["<<networkArg<<" <SIL Kit ethernet network{Ethernet1}>]\n"
                  "  ["<<vlanTagArg<<" <VLAN ID to inject on frames>]\n"
+                 "  ["<<multicastSnoopingArg<<" (forward multicast from SIL Kit only for groups joined on the TAP device)]\n"
+                 "  ["<<someIpStatisticsArg<<" <comma separated SOME/IP UDP/TCP ports to count traffic on>]\n"
+                 "  ["<<flowHashArg<<" <toeplitz|fast> (classify IPv4/IPv6 flows once per frame, Toeplitz is RSS compatible)]\n"
+                 "  ["<<mtuArg<<" <IP MTU of the SIL Kit network, at least 1280: fragment or reject larger packets, reassemble fragments>]\n"
+                 "  ["<<clampMssArg<<" (clamp the MSS of TCP SYN segments to the "<<mtuArg<<")]\n"
+                 "  ["<<neighborProxyArg<<" (answer ARP requests and neighbor solicitations of the TAP device from bindings learned from SIL Kit)]\n"
+                 "  ["<<neighborProxyStaticArg<<" <static bindings like 192.168.7.2=02:00:00:00:00:02,fd00::2=02:00:00:00:00:02, implies "<<neighborProxyArg<<">]\n"
+                 "  ["<<metricsEndpointArg<<" <port on 127.0.0.1 or unix:<socket path> serving OpenMetrics under /metrics>]\n"
+                 "  ["<<metricsLogIntervalArg<<" <interval in seconds of a one-line metrics summary log>]\n"
+                 "  ["<<latencyHistogramsArg<<" (record per-stage forwarding latencies, logged on exit and served with the metrics)]\n"
+                 "  ["<<traceRateLimitArg<<" <maximum frame trace lines per second at Debug/Trace log level{1000}, 0 for no limit>]\n"
+                 "  ["<<traceFlowSamplingArg<<" <log every n-th traced frame per flow after the first 8{1}>]\n"
+                 "  ["<<captureArg<<" <path prefix of pcapng files capturing the frames exchanged with SIL Kit>]\n"
+                 "  ["<<captureSnapLengthArg<<" <bytes captured per frame{65535}>]\n"
+                 "  ["<<captureFilterArg<<" <filter like proto=udp|icmp,host=192.168.7.2,port=30490,vlan=4>]\n"
+                 "  ["<<captureRotateSizeArg<<" <MiB after which a new capture file is started{64}, 0 for no limit>]\n"
+                 "  ["<<captureRotateIntervalArg<<" <seconds after which a new capture file is started>]\n"
+                 "  ["<<captureMaxFilesArg<<" <number of capture files kept, older ones are removed>]\n"
+                 "  ["<<flightRecorderArg<<" <path prefix of pcapng dumps of the most recent frames, on SIGUSR1, fatal TAP read errors and NACK bursts>]\n"
+                 "  ["<<flightRecorderFramesArg<<" <number of most recent frames kept in memory{8192}>]\n"
+                 "  ["<<flightRecorderSnapLengthArg<<" <bytes kept per frame{128}>]\n"
+                 "  ["<<flightRecorderNackBurstArg<<" <NACKs within one second which trigger a dump{16}, 0 to disable>]\n"
+                 "  ["<<switchPortsArg<<" <switch between ports like tap:sut1,tap:sut2@u10+t20,network:Ethernet1@t10+t20, replaces "<<tapNameArg<<" and "<<networkArg<<">]\n"
+                 "  ["<<cpuAffinityArg<<" <CPUs of the thread roles io, silkit and background like io=2,silkit=3-4+6 (Linux only)>]\n"
+                 "  ["<<schedFifoArg<<" <SCHED_FIFO priorities 1..99 of the thread roles like io=80,silkit=70 (Linux only)>]\n"
+                 "  ["<<lockMemoryArg<<" (lock and prefault the memory of the adapter, report page faults after startup, Linux only)]\n"
+                 "  ["<<startupQueueFramesArg<<" <number of frames from the TAP device queued until SIL Kit is ready{1024}, 0 to drop them>]\n"
+                 "  ["<<startupQueueAgeArg<<" <milliseconds after which a queued frame is dropped{5000}>]\n"
+                 "  ["<<readyFileArg<<" <path of a file written when the adapter forwards frames, removed when it stops>]\n"
+                 "  ["<<loopSuppressionArg<<" (drop frames which come back from the side they were sent to, e.g. through a bridge)]\n"
+                 "  ["<<loopSuppressionWindowArg<<" <milliseconds within which a returning frame is dropped{100}, implies "<<loopSuppressionArg<<">]\n"
                  "\n"
                  "SIL Kit-specific CLI arguments will be overwritten by the config file passed by " << configurationArg << ".\n";
     std::cout << "\n"
@@ -36,6 +100,63 @@ void adapters::print_help(bool userRequested)
     // clang-format on
 };
 
+auto adapters::ParseUnsigned(const std::string& text, std::uint64_t minValue, std::uint64_t maxValue)
+    -> std::uint64_t
+{
+    const auto invalid = [&]() {
+        return std::invalid_argument{"'" + text + "' is not a number in range " + std::to_string(minValue) + ".."
+                                     + std::to_string(maxValue)};
+    };
+
+    if (text.empty())
+    {
+        throw invalid();
+    }
+    std::uint64_t value = 0;
+    for (const char c : text)
+    {
+        if (c < '0' || c > '9')
+        {
+            throw invalid();
+        }
+        const auto digit = static_cast<std::uint64_t>(c - '0');
+        if (digit > maxValue || value > (maxValue - digit) / 10)
+        {
+            throw invalid();
+        }
+        value = value * 10 + digit;
+    }
+    if (value < minValue)
+    {
+        throw invalid();
+    }
+    return value;
+}
+
+auto adapters::ParsePortList(const std::string& portList) -> std::vector<std::uint16_t>
+{
+    std::vector<std::uint16_t> ports;
+
+    std::istringstream portStream{portList};
+    std::string portStr;
+    while (std::getline(portStream, portStr, ','))
+    {
+        std::size_t parsedLength = 0;
+        const unsigned long port = std::stoul(portStr, &parsedLength);
+        if (parsedLength != portStr.size() || port == 0 || port > 65535)
+        {
+            throw std::invalid_argument{"invalid port '" + portStr + "'"};
+        }
+        ports.push_back(static_cast<std::uint16_t>(port));
+    }
+
+    if (ports.empty())
+    {
+        throw std::invalid_argument{"empty port list"};
+    }
+    return ports;
+}
+
 void adapters::print_version()
 {
     std::cout << "SIL Kit Adapter for TAP devices - version: " << SILKIT_ADAPTER_VERSION << std::endl;
@@ -4,6 +4,8 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <cstdint>
 
 #include "common/Parsing.hpp"
 
@@ -37,4 +39,174 @@ extern const std::string networkArg;
 /// </summary>
 extern const std::string vlanTagArg;
 
+/// <summary>
+/// string containing the switch enabling IGMP/MLD snooping on the TAP device.
+/// </summary>
+extern const std::string multicastSnoopingArg;
+
+/// <summary>
+/// string containing the argument preceding the UDP/TCP ports on which SOME/IP traffic is counted.
+/// </summary>
+extern const std::string someIpStatisticsArg;
+
+/// <summary>
+/// string containing the argument preceding the hash function of the flow classification.
+/// </summary>
+extern const std::string flowHashArg;
+
+/// <summary>
+/// string containing the argument preceding the IP MTU of the SIL Kit network.
+/// </summary>
+extern const std::string mtuArg;
+
+/// <summary>
+/// string containing the switch enabling the TCP MSS clamping to the MTU of the SIL Kit network.
+/// </summary>
+extern const std::string clampMssArg;
+
+/// <summary>
+/// string containing the switch enabling the ARP/NDP proxy answering neighbor resolution of the TAP device.
+/// </summary>
+extern const std::string neighborProxyArg;
+
+/// <summary>
+/// string containing the argument preceding the static bindings of the ARP/NDP proxy.
+/// </summary>
+extern const std::string neighborProxyStaticArg;
+
+/// <summary>
+/// string containing the argument preceding the TCP port or Unix socket path on which the metrics are served.
+/// </summary>
+extern const std::string metricsEndpointArg;
+
+/// <summary>
+/// string containing the argument preceding the interval in seconds of the metrics summary log line.
+/// </summary>
+extern const std::string metricsLogIntervalArg;
+
+/// <summary>
+/// string containing the switch enabling the per-stage latency histograms.
+/// </summary>
+extern const std::string latencyHistogramsArg;
+
+/// <summary>
+/// string containing the argument preceding the maximum number of frame trace lines logged per second.
+/// </summary>
+extern const std::string traceRateLimitArg;
+
+/// <summary>
+/// string containing the argument preceding the sampling rate of the frame trace per flow.
+/// </summary>
+extern const std::string traceFlowSamplingArg;
+
+/// <summary>
+/// string containing the argument preceding the path prefix of the pcapng capture files.
+/// </summary>
+extern const std::string captureArg;
+
+/// <summary>
+/// string containing the argument preceding the number of bytes captured per frame.
+/// </summary>
+extern const std::string captureSnapLengthArg;
+
+/// <summary>
+/// string containing the argument preceding the filter selecting the captured frames.
+/// </summary>
+extern const std::string captureFilterArg;
+
+/// <summary>
+/// string containing the argument preceding the size in MiB at which a new capture file is started.
+/// </summary>
+extern const std::string captureRotateSizeArg;
+
+/// <summary>
+/// string containing the argument preceding the age in seconds at which a new capture file is started.
+/// </summary>
+extern const std::string captureRotateIntervalArg;
+
+/// <summary>
+/// string containing the argument preceding the number of capture files which are kept.
+/// </summary>
+extern const std::string captureMaxFilesArg;
+
+/// <summary>
+/// string containing the argument preceding the path prefix of the flight recorder dumps.
+/// </summary>
+extern const std::string flightRecorderArg;
+
+/// <summary>
+/// string containing the argument preceding the number of frames kept by the flight recorder.
+/// </summary>
+extern const std::string flightRecorderFramesArg;
+
+/// <summary>
+/// string containing the argument preceding the number of bytes the flight recorder keeps per frame.
+/// </summary>
+extern const std::string flightRecorderSnapLengthArg;
+
+/// <summary>
+/// string containing the argument preceding the number of NACKs per second which trigger a flight recorder dump.
+/// </summary>
+extern const std::string flightRecorderNackBurstArg;
+
+/// <summary>
+/// string containing the argument preceding the ports of the switch between TAP devices and SIL Kit networks.
+/// </summary>
+extern const std::string switchPortsArg;
+
+/// <summary>
+/// string containing the argument preceding the CPUs of the adapter threads per role.
+/// </summary>
+extern const std::string cpuAffinityArg;
+
+/// <summary>
+/// string containing the argument preceding the SCHED_FIFO priorities of the adapter threads per role.
+/// </summary>
+extern const std::string schedFifoArg;
+
+/// <summary>
+/// string containing the switch to lock and prefault the memory of the adapter.
+/// </summary>
+extern const std::string lockMemoryArg;
+
+/// <summary>
+/// string containing the argument preceding the number of TAP frames queued until SIL Kit is ready.
+/// </summary>
+extern const std::string startupQueueFramesArg;
+
+/// <summary>
+/// string containing the argument preceding the milliseconds after which a queued TAP frame is dropped.
+/// </summary>
+extern const std::string startupQueueAgeArg;
+
+/// <summary>
+/// string containing the argument preceding the path of the file written when the adapter is ready.
+/// </summary>
+extern const std::string readyFileArg;
+
+/// <summary>
+/// string containing the switch to drop frames which loop back to the side the adapter sent them to.
+/// </summary>
+extern const std::string loopSuppressionArg;
+
+/// <summary>
+/// string containing the argument preceding the milliseconds within which a returning frame is a loop.
+/// </summary>
+extern const std::string loopSuppressionWindowArg;
+
+/// <summary>
+/// Parses an unsigned decimal number of a CLI argument. Unlike std::stoul, signs, blanks and trailing characters
+/// are rejected, so that e.g. "-1" does not wrap to ULONG_MAX.
+/// </summary>
+/// <param name="text">Decimal digits like "8192".</param>
+/// <exception cref="std::invalid_argument">Thrown if the text is not a number in range minValue..maxValue.</exception>
+auto ParseUnsigned(const std::string& text, std::uint64_t minValue, std::uint64_t maxValue) -> std::uint64_t;
+
+/// <summary>
+/// Parses a comma separated list of UDP/TCP ports.
+/// </summary>
+/// <param name="portList">List like "30490,30501".</param>
+/// <exception cref="std::invalid_argument">Thrown if an element is not a port number in range 1..65535.</exception>
+auto ParsePortList(const std::string& portList) -> std::vector<std::uint16_t>;
+
 } // namespace adapters
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "Pcapng.hpp"
+
+#include <cstring>
+#include <string>
+
+using namespace adapters;
+
+namespace {
+
+constexpr std::uint32_t sectionHeaderBlock = 0x0A0D0D0A;
+constexpr std::uint32_t interfaceDescriptionBlock = 0x00000001;
+constexpr std::uint32_t enhancedPacketBlock = 0x00000006;
+constexpr std::uint32_t byteOrderMagic = 0x1A2B3C4D;
+constexpr std::uint16_t linkTypeEthernet = 1;
+
+constexpr std::uint16_t optionShbUserApplication = 4;
+constexpr std::uint16_t optionIfName = 2;
+constexpr std::uint16_t optionIfDescription = 3;
+constexpr std::uint16_t optionIfTimestampResolution = 9;
+
+// Appends one block (type, length, body, length) to a buffer.
+class BlockBuilder
+{
+public:
+    BlockBuilder(std::vector<std::uint8_t>& buffer, std::uint32_t blockType)
+        : _buffer{buffer}
+        , _blockStart{buffer.size()}
+    {
+        Put32(blockType);
+        Put32(0); // patched by Finish
+    }
+
+    void Put16(std::uint16_t value)
+    {
+        PutBytes(&value, sizeof(value));
+    }
+
+    void Put32(std::uint32_t value)
+    {
+        PutBytes(&value, sizeof(value));
+    }
+
+    void PutBytes(const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        _buffer.insert(_buffer.end(), bytes, bytes + size);
+    }
+
+    void PutPadding()
+    {
+        _buffer.resize(_blockStart + ((_buffer.size() - _blockStart + 3) & ~std::size_t{3}), 0);
+    }
+
+    void PutOption(std::uint16_t code, const std::string& value)
+    {
+        Put16(code);
+        Put16(static_cast<std::uint16_t>(value.size()));
+        PutBytes(value.data(), value.size());
+        PutPadding();
+    }
+
+    void PutEndOfOptions()
+    {
+        Put32(0);
+    }
+
+    void Finish()
+    {
+        const auto totalLength = static_cast<std::uint32_t>(_buffer.size() - _blockStart + 4);
+        Put32(totalLength);
+        std::memcpy(_buffer.data() + _blockStart + 4, &totalLength, sizeof(totalLength));
+    }
+
+private:
+    std::vector<std::uint8_t>& _buffer;
+    std::size_t _blockStart;
+};
+
+} // namespace
+
+void pcapng::AppendSectionStart(std::vector<std::uint8_t>& buffer, std::uint32_t snapLength)
+{
+    {
+        BlockBuilder block{buffer, sectionHeaderBlock};
+        block.Put32(byteOrderMagic);
+        block.Put16(1); // major version
+        block.Put16(0); // minor version
+        block.Put32(0xFFFFFFFF); // section length not specified
+        block.Put32(0xFFFFFFFF);
+        block.PutOption(optionShbUserApplication, "sil-kit-adapter-tap");
+        block.PutEndOfOptions();
+        block.Finish();
+    }
+
+    for (const auto direction : {Direction::TapToSilKit, Direction::SilKitToTap})
+    {
+        BlockBuilder block{buffer, interfaceDescriptionBlock};
+        block.Put16(linkTypeEthernet);
+        block.Put16(0); // reserved
+        block.Put32(snapLength);
+        block.PutOption(optionIfName, ToString(direction));
+        block.PutOption(optionIfDescription, direction == Direction::TapToSilKit ? "Frames sent to SIL Kit"
+                                                                                 : "Frames received from SIL Kit");
+        block.PutOption(optionIfTimestampResolution, std::string(1, '\x09')); // nanoseconds
+        block.PutEndOfOptions();
+        block.Finish();
+    }
+}
+
+void pcapng::AppendEnhancedPacket(std::vector<std::uint8_t>& buffer, Direction direction, std::uint64_t timestampNs,
+                                  const std::uint8_t* frame, std::uint32_t capturedSize, std::uint32_t originalSize)
+{
+    BlockBuilder block{buffer, enhancedPacketBlock};
+    block.Put32(static_cast<std::uint32_t>(ToIndex(direction)));
+    block.Put32(static_cast<std::uint32_t>(timestampNs >> 32u));
+    block.Put32(static_cast<std::uint32_t>(timestampNs));
+    block.Put32(capturedSize);
+    block.Put32(originalSize);
+    block.PutBytes(frame, capturedSize);
+    block.PutPadding();
+    block.Finish();
+}
@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Direction.hpp"
+
+namespace adapters {
+namespace pcapng {
+
+// Blocks of the pcapng format, in host byte order. A file written by the adapter is a section header,
+// one Ethernet interface per direction (interface id = direction index, nanosecond timestamps) and
+// the enhanced packet blocks of the frames.
+
+/// <summary>
+/// Size of the enhanced packet block of a frame with capturedSize bytes.
+/// </summary>
+constexpr auto EnhancedPacketBlockSize(std::uint32_t capturedSize) -> std::size_t
+{
+    return 28 + ((std::size_t{capturedSize} + 3) & ~std::size_t{3}) + 4;
+}
+
+/// <summary>
+/// Appends a section header block and the interface description blocks of both directions.
+/// </summary>
+void AppendSectionStart(std::vector<std::uint8_t>& buffer, std::uint32_t snapLength);
+
+/// <summary>
+/// Appends an enhanced packet block.
+/// </summary>
+/// <param name="timestampNs">Nanoseconds since the Unix epoch.</param>
+void AppendEnhancedPacket(std::vector<std::uint8_t>& buffer, Direction direction, std::uint64_t timestampNs,
+                          const std::uint8_t* frame, std::uint32_t capturedSize, std::uint32_t originalSize);
+
+} // namespace pcapng
+} // namespace adapters
@@ -0,0 +1,603 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "PcapngCapture.hpp"
+#include "Pcapng.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include "Ip6Header.hpp"
+#include "PacketView.hpp"
+#include "Split.hpp"
+
+#include "asio/ip/address.hpp"
+
+#if !WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace adapters;
+
+namespace {
+
+constexpr std::size_t maxDrainPerRing = 1024 * 1024;
+constexpr auto idleInterval = std::chrono::milliseconds{5};
+
+std::atomic<std::uint64_t> nextCaptureId{1};
+
+// bits of CaptureFilter conditions on the protocol
+constexpr std::uint32_t protocolArp = 1u << 0;
+constexpr std::uint32_t protocolIp4 = 1u << 1;
+constexpr std::uint32_t protocolIp6 = 1u << 2;
+constexpr std::uint32_t protocolIcmp4 = 1u << 3;
+constexpr std::uint32_t protocolIcmp6 = 1u << 4;
+constexpr std::uint32_t protocolIgmp = 1u << 5;
+constexpr std::uint32_t protocolUdp = 1u << 6;
+constexpr std::uint32_t protocolTcp = 1u << 7;
+
+struct ProtocolName
+{
+    const char* name;
+    std::uint32_t bit;
+};
+
+constexpr ProtocolName protocolNames[] = {
+    {"arp", protocolArp},     {"ip", protocolIp4},     {"ip6", protocolIp6}, {"icmp", protocolIcmp4},
+    {"icmp6", protocolIcmp6}, {"igmp", protocolIgmp}, {"udp", protocolUdp}, {"tcp", protocolTcp},
+};
+
+// The fields of a frame which CaptureFilter conditions refer to.
+struct FrameFields
+{
+    std::uint32_t protocols{0};
+    std::optional<std::uint16_t> vlanId;
+    const std::uint8_t* sourceAddress{nullptr};
+    const std::uint8_t* destinationAddress{nullptr};
+    std::size_t addressSize{0};
+    std::optional<std::uint16_t> sourcePort;
+    std::optional<std::uint16_t> destinationPort;
+};
+
+// Fills the fields of all layers which parse, a truncated or malformed frame keeps those of the outer layers.
+auto ExtractFields(const std::uint8_t* frame, std::size_t frameSize) -> FrameFields
+{
+    FrameFields fields;
+    const auto ethernet = demo::EthernetView::Parse(asio::buffer(frame, frameSize));
+    if (!ethernet)
+    {
+        return fields;
+    }
+    if (ethernet.HasVlanTag())
+    {
+        fields.vlanId = ethernet.GetVlanId();
+    }
+
+    asio::const_buffer transportPayload;
+    std::uint8_t protocol = 0;
+    const auto* l3 = frame + ethernet.GetHeaderSize();
+
+    switch (ethernet.GetEtherType())
+    {
+    case demo::EtherType::Arp:
+        fields.protocols |= protocolArp;
+        return fields;
+    case demo::EtherType::Ip4:
+    {
+        fields.protocols |= protocolIp4;
+        const auto ip4 = demo::Ip4View::Parse(ethernet.GetPayload());
+        if (!ip4)
+        {
+            return fields;
+        }
+        fields.sourceAddress = l3 + 12;
+        fields.destinationAddress = l3 + 16;
+        fields.addressSize = 4;
+        if (ip4.GetFragmentOffset() != 0)
+        {
+            return fields; // no transport header in later fragments
+        }
+        protocol = demo::ToUnderlying(ip4.GetProtocol());
+        transportPayload = ip4.GetPayload();
+        break;
+    }
+    case demo::EtherType::Ip6:
+    {
+        fields.protocols |= protocolIp6;
+        try
+        {
+            const auto [ip6Header, ip6Payload] = demo::ParseIp6Header(ethernet.GetPayload());
+            fields.sourceAddress = l3 + 8;
+            fields.destinationAddress = l3 + 24;
+            fields.addressSize = 16;
+            const auto [nextHeader, upperLayerPayload] =
+                demo::SkipIp6ExtensionHeaders(ip6Header.nextHeader, ip6Payload);
+            protocol = demo::ToUnderlying(nextHeader);
+            transportPayload = upperLayerPayload;
+        }
+        catch (const std::exception&)
+        {
+            return fields;
+        }
+        break;
+    }
+    default:
+        return fields;
+    }
+
+    if (protocol == demo::ToUnderlying(demo::Ip4Protocol::ICMP))
+    {
+        fields.protocols |= protocolIcmp4;
+    }
+    else if (protocol == demo::ToUnderlying(demo::Ip4Protocol::IGMP))
+    {
+        fields.protocols |= protocolIgmp;
+    }
+    else if (protocol == demo::ToUnderlying(demo::Ip6NextHeader::ICMPv6))
+    {
+        fields.protocols |= protocolIcmp6;
+    }
+    else if (protocol == demo::ToUnderlying(demo::Ip4Protocol::UDP))
+    {
+        fields.protocols |= protocolUdp;
+        if (const auto udp = demo::UdpView::Parse(transportPayload))
+        {
+            fields.sourcePort = udp.GetSourcePort();
+            fields.destinationPort = udp.GetDestinationPort();
+        }
+    }
+    else if (protocol == demo::ToUnderlying(demo::Ip4Protocol::TCP))
+    {
+        fields.protocols |= protocolTcp;
+        if (const auto tcp = demo::TcpView::Parse(transportPayload))
+        {
+            fields.sourcePort = tcp.GetSourcePort();
+            fields.destinationPort = tcp.GetDestinationPort();
+        }
+    }
+    return fields;
+}
+
+auto ParseNumber(const std::string& text, unsigned long maximum) -> std::uint32_t
+{
+    std::size_t parsedLength = 0;
+    const auto value = std::stoul(text, &parsedLength);
+    if (parsedLength != text.size() || value > maximum)
+    {
+        throw std::invalid_argument{"'" + text + "' is not a number in range 0.." + std::to_string(maximum)};
+    }
+    return static_cast<std::uint32_t>(value);
+}
+
+} // namespace
+
+auto CaptureFilter::Parse(const std::string& expression) -> CaptureFilter
+{
+    CaptureFilter filter;
+    for (const auto& term : demo::Split(expression, ','))
+    {
+        const auto equalSign = term.find('=');
+        if (equalSign == std::string::npos)
+        {
+            throw std::invalid_argument{"'" + term + "' is not of the form <field>=<value>"};
+        }
+        const auto field = term.substr(0, equalSign);
+
+        Condition condition{};
+        for (const auto& value : demo::Split(term.substr(equalSign + 1), '|'))
+        {
+            if (field == "proto")
+            {
+                condition.field = Field::Protocol;
+                const auto* protocolName = std::find_if(std::begin(protocolNames), std::end(protocolNames),
+                                                        [&value](const ProtocolName& p) { return value == p.name; });
+                if (protocolName == std::end(protocolNames))
+                {
+                    throw std::invalid_argument{"unknown protocol '" + value + "'"};
+                }
+                condition.protocols |= protocolName->bit;
+            }
+            else if (field == "host")
+            {
+                condition.field = Field::Host;
+                std::error_code errorCode;
+                const auto address = asio::ip::make_address(value, errorCode);
+                if (errorCode)
+                {
+                    throw std::invalid_argument{"'" + value + "' is not an IPv4 or IPv6 address"};
+                }
+                Address filterAddress{};
+                if (address.is_v4())
+                {
+                    const auto bytes = address.to_v4().to_bytes();
+                    std::copy(bytes.begin(), bytes.end(), filterAddress.bytes.begin());
+                    filterAddress.size = bytes.size();
+                }
+                else
+                {
+                    const auto bytes = address.to_v6().to_bytes();
+                    std::copy(bytes.begin(), bytes.end(), filterAddress.bytes.begin());
+                    filterAddress.size = bytes.size();
+                }
+                condition.addresses.push_back(filterAddress);
+            }
+            else if (field == "port")
+            {
+                condition.field = Field::Port;
+                condition.numbers.push_back(ParseNumber(value, 65535));
+            }
+            else if (field == "vlan")
+            {
+                condition.field = Field::Vlan;
+                condition.numbers.push_back(value == "none" ? untaggedVlan : ParseNumber(value, 4094));
+            }
+            else
+            {
+                throw std::invalid_argument{"unknown field '" + field + "', expected proto, host, port or vlan"};
+            }
+        }
+        filter._conditions.push_back(std::move(condition));
+    }
+    return filter;
+}
+
+auto CaptureFilter::Matches(const std::uint8_t* frame, std::size_t frameSize) const -> bool
+{
+    const auto fields = ExtractFields(frame, frameSize);
+
+    const auto isAny = [](const std::vector<std::uint32_t>& numbers, std::uint32_t number) {
+        return std::find(numbers.begin(), numbers.end(), number) != numbers.end();
+    };
+
+    for (const auto& condition : _conditions)
+    {
+        switch (condition.field)
+        {
+        case Field::Protocol:
+            if ((fields.protocols & condition.protocols) == 0)
+            {
+                return false;
+            }
+            break;
+        case Field::Host:
+            if (std::none_of(condition.addresses.begin(), condition.addresses.end(), [&fields](const Address& a) {
+                    return a.size == fields.addressSize
+                           && (std::memcmp(a.bytes.data(), fields.sourceAddress, a.size) == 0
+                               || std::memcmp(a.bytes.data(), fields.destinationAddress, a.size) == 0);
+                }))
+            {
+                return false;
+            }
+            break;
+        case Field::Port:
+            if (!fields.sourcePort
+                || (!isAny(condition.numbers, *fields.sourcePort)
+                    && !isAny(condition.numbers, *fields.destinationPort)))
+            {
+                return false;
+            }
+            break;
+        case Field::Vlan:
+            if (!isAny(condition.numbers, fields.vlanId.value_or(untaggedVlan)))
+            {
+                return false;
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+/// <summary>
+/// Capture file written through a sliding memory-mapped window, the file grows by one window at a time
+/// and is truncated to the written size when it is closed. The blocks of a window are allocated before it is
+/// mapped, so that a full disk or quota fails the allocation instead of raising SIGBUS on the memcpy.
+/// </summary>
+class PcapngCapture::File
+{
+public:
+    explicit File(const std::string& path)
+    {
+#if !WIN32
+        _fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (_fd < 0)
+        {
+            throw std::runtime_error{"cannot create capture file " + path + ": " + std::strerror(errno)};
+        }
+#else
+        _stream = std::fopen(path.c_str(), "wb");
+        if (_stream == nullptr)
+        {
+            throw std::runtime_error{"cannot create capture file " + path};
+        }
+#endif
+    }
+
+    // without Close(), e.g. while an exception unwinds, the file keeps the zeros after the last block, readers
+    // stop at the first invalid block
+    ~File()
+    {
+#if !WIN32
+        if (_fd >= 0)
+        {
+            Unmap();
+            ::close(_fd);
+        }
+#else
+        if (_stream != nullptr)
+        {
+            std::fclose(_stream);
+        }
+#endif
+    }
+
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+
+    /// <exception cref="std::runtime_error">Thrown if the file cannot be truncated to the written size.</exception>
+    void Close()
+    {
+#if !WIN32
+        Unmap();
+        const bool truncated = (::ftruncate(_fd, static_cast<off_t>(_size)) == 0);
+        const int truncateError = errno;
+        ::close(_fd);
+        _fd = -1;
+        if (!truncated)
+        {
+            throw std::runtime_error{std::string{"cannot truncate capture file to its written size: "}
+                                     + std::strerror(truncateError)};
+        }
+#else
+        const bool flushed = (std::fclose(_stream) == 0);
+        _stream = nullptr;
+        if (!flushed)
+        {
+            throw std::runtime_error{"cannot close capture file"};
+        }
+#endif
+    }
+
+    void Write(const std::uint8_t* data, std::size_t size)
+    {
+#if !WIN32
+        while (size > 0)
+        {
+            if (_window == nullptr || _size == _windowOffset + windowSize)
+            {
+                MapNextWindow();
+            }
+            const auto windowPosition = static_cast<std::size_t>(_size - _windowOffset);
+            const auto chunkSize = std::min(size, windowSize - windowPosition);
+            std::memcpy(_window + windowPosition, data, chunkSize);
+            data += chunkSize;
+            size -= chunkSize;
+            _size += chunkSize;
+        }
+#else
+        if (std::fwrite(data, 1, size, _stream) != size)
+        {
+            throw std::runtime_error{"write to capture file failed"};
+        }
+        _size += size;
+#endif
+    }
+
+    auto Size() const -> std::uint64_t
+    {
+        return _size;
+    }
+
+private:
+#if !WIN32
+    // a multiple of the page size
+    static constexpr std::size_t windowSize = 4 * 1024 * 1024;
+
+    void Unmap()
+    {
+        if (_window != nullptr)
+        {
+            ::munmap(_window, windowSize);
+            _window = nullptr;
+        }
+    }
+
+    void MapNextWindow()
+    {
+        Unmap();
+        _windowOffset = _size;
+        // unlike ftruncate, which leaves a sparse file, this fails with ENOSPC or EDQUOT right here
+        const int allocateError =
+            ::posix_fallocate(_fd, static_cast<off_t>(_windowOffset), static_cast<off_t>(windowSize));
+        if (allocateError != 0)
+        {
+            throw std::runtime_error{std::string{"cannot grow capture file: "} + std::strerror(allocateError)};
+        }
+        void* window = ::mmap(nullptr, windowSize, PROT_READ | PROT_WRITE, MAP_SHARED, _fd,
+                              static_cast<off_t>(_windowOffset));
+        if (window == MAP_FAILED)
+        {
+            throw std::runtime_error{std::string{"cannot map capture file: "} + std::strerror(errno)};
+        }
+        _window = static_cast<std::uint8_t*>(window);
+    }
+
+    int _fd{-1};
+    std::uint8_t* _window{nullptr};
+    std::uint64_t _windowOffset{0};
+#else
+    std::FILE* _stream{nullptr};
+#endif
+    std::uint64_t _size{0};
+};
+
+PcapngCapture::PcapngCapture(SilKit::Services::Logging::ILogger* logger, Options options)
+    : _id{nextCaptureId++}
+    , _logger{logger}
+    , _options{std::move(options)}
+{
+    if ((_options.ringSize & (_options.ringSize - 1)) != 0 || _options.ringSize < 4 * RecordSize(_options.snapLength))
+    {
+        throw std::invalid_argument{"capture ring size must be a power of two of at least four records"};
+    }
+
+    const auto extension = std::string{".pcapng"};
+    if (_options.pathPrefix.size() > extension.size()
+        && _options.pathPrefix.compare(_options.pathPrefix.size() - extension.size(), extension.size(), extension) == 0)
+    {
+        _options.pathPrefix.resize(_options.pathPrefix.size() - extension.size());
+    }
+
+    _block.reserve(pcapng::EnhancedPacketBlockSize(_options.snapLength));
+    OpenNextFile();
+    _thread = std::thread{[this] { Run(); }};
+}
+
+PcapngCapture::~PcapngCapture()
+{
+    _stopRequested = true;
+    _thread.join();
+    CloseFile();
+}
+
+auto PcapngCapture::RegisterRing() -> Ring*
+{
+    std::lock_guard<std::mutex> lock{_ringsMutex};
+    _rings.push_back(std::make_unique<Ring>(_options.ringSize));
+    return _rings.back().get();
+}
+
+void PcapngCapture::Run()
+{
+    while (!_stopRequested)
+    {
+        if (!Drain())
+        {
+            std::this_thread::sleep_for(idleInterval);
+        }
+    }
+
+    // write what the forwarding threads captured before the adapter stopped
+    while (Drain())
+    {
+    }
+}
+
+auto PcapngCapture::Drain() -> bool
+{
+    // rings are only added while the capture runs, so they can be drained without holding the mutex
+    std::vector<Ring*> rings;
+    {
+        std::lock_guard<std::mutex> lock{_ringsMutex};
+        rings.reserve(_rings.size());
+        for (const auto& ring : _rings)
+        {
+            rings.push_back(ring.get());
+        }
+    }
+
+    bool drained = false;
+    for (auto* ring : rings)
+    {
+        const auto tail = ring->tail.load(std::memory_order_relaxed);
+        const auto head = ring->head.load(std::memory_order_acquire);
+        auto position = tail;
+        while (position < head && position - tail < maxDrainPerRing)
+        {
+            const auto untilEnd = ring->size - (position & (ring->size - 1));
+            const auto* header = reinterpret_cast<const RecordHeader*>(ring->At(position));
+            if (untilEnd < sizeof(RecordHeader) || header->capturedSize == skipMarker)
+            {
+                position += untilEnd;
+                continue;
+            }
+            WriteRecord(*header, ring->At(position) + sizeof(RecordHeader));
+            position += RecordSize(header->capturedSize);
+        }
+        ring->tail.store(position, std::memory_order_release);
+        drained = drained || position != tail;
+    }
+    return drained;
+}
+
+void PcapngCapture::WriteRecord(const RecordHeader& header, const std::uint8_t* frame)
+{
+    if (_failed)
+    {
+        return;
+    }
+
+    const auto blockSize = pcapng::EnhancedPacketBlockSize(header.capturedSize);
+    const bool rotateBySize = _options.rotateSize != 0 && _file->Size() + blockSize > _options.rotateSize;
+    const bool rotateByAge = _options.rotateInterval.count() != 0
+                             && std::chrono::steady_clock::now() - _fileOpened >= _options.rotateInterval;
+
+    try
+    {
+        if (_fileRecords > 0 && (rotateBySize || rotateByAge))
+        {
+            OpenNextFile();
+        }
+
+        _block.clear();
+        pcapng::AppendEnhancedPacket(_block, header.direction, header.timestampNs, frame, header.capturedSize,
+                                     header.originalSize);
+        _file->Write(_block.data(), _block.size());
+        ++_fileRecords;
+        metrics::Increment(metrics::Counter::CaptureFrames);
+    }
+    catch (const std::exception& error)
+    {
+        _failed = true;
+        _logger->Error(std::string{"Capture stopped: "} + error.what());
+    }
+}
+
+void PcapngCapture::OpenNextFile()
+{
+    CloseFile();
+
+    std::ostringstream path;
+    path << _options.pathPrefix << "-" << std::setw(5) << std::setfill('0') << _fileIndex++ << ".pcapng";
+    _file = std::make_unique<File>(path.str());
+    _fileRecords = 0;
+    _fileOpened = std::chrono::steady_clock::now();
+
+    // every file is a section of its own, so that it can be read without the previous ones
+    _block.clear();
+    pcapng::AppendSectionStart(_block, _options.snapLength);
+    _file->Write(_block.data(), _block.size());
+
+    _filePaths.push_back(path.str());
+    if (_options.maxFiles != 0 && _filePaths.size() > _options.maxFiles)
+    {
+        std::remove(_filePaths.front().c_str());
+        _filePaths.pop_front();
+    }
+
+    std::ostringstream SILKitDebugMessage;
+    SILKitDebugMessage << "Capturing frames to " << path.str();
+    _logger->Debug(SILKitDebugMessage.str());
+}
+
+void PcapngCapture::CloseFile()
+{
+    if (_file == nullptr)
+    {
+        return;
+    }
+    try
+    {
+        _file->Close();
+    }
+    catch (const std::exception& error)
+    {
+        _logger->Warn(std::string{"Capture: "} + error.what());
+    }
+    _file.reset();
+}
@@ -0,0 +1,252 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Direction.hpp"
+#include "Metrics.hpp"
+
+#include "silkit/services/logging/all.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// Selects the frames written to a capture.
+///
+///   A filter is a comma separated list of conditions which all have to match. Every condition
+///   accepts alternatives separated by '|', e.g. "proto=udp|icmp,port=30490,vlan=4".
+///     proto=arp|ip|ip6|icmp|icmp6|igmp|udp|tcp
+///     host=IPv4 or IPv6 address     source or destination address
+///     port=number                   UDP/TCP source or destination port
+///     vlan=VLAN ID|none             802.1Q VLAN ID, none for untagged frames
+/// </summary>
+class CaptureFilter
+{
+public:
+    /// <exception cref="std::invalid_argument">Thrown if the expression is malformed.</exception>
+    static auto Parse(const std::string& expression) -> CaptureFilter;
+
+    auto Matches(const std::uint8_t* frame, std::size_t frameSize) const -> bool;
+
+private:
+    enum struct Field : std::uint8_t
+    {
+        Protocol,
+        Host,
+        Port,
+        Vlan,
+    };
+
+    struct Address
+    {
+        std::array<std::uint8_t, 16> bytes;
+        std::size_t size;
+    };
+
+    struct Condition
+    {
+        Field field;
+        std::uint32_t protocols; // bitmask of the alternatives for Field::Protocol
+        std::vector<std::uint32_t> numbers; // ports or VLAN IDs, untaggedVlan for vlan=none
+        std::vector<Address> addresses;
+    };
+
+    static constexpr std::uint32_t untaggedVlan = 0x10000;
+
+    std::vector<Condition> _conditions;
+};
+
+/// <summary>
+/// Captures the frames exchanged with SIL Kit into pcapng files.
+///
+///   Every file contains one interface per direction: "tap_to_silkit" holds the frames handed to
+///   SIL Kit (after VLAN tag injection and padding), "silkit_to_tap" the frames received from SIL Kit
+///   (before VLAN and multicast filtering). The forwarding threads copy the frames into a lock-free
+///   ring of their own, a writer thread drains the rings into memory-mapped files which are rotated
+///   by size or age. Frames are lost rather than blocking forwarding if a ring runs full.
+/// </summary>
+class PcapngCapture
+{
+public:
+    struct Options
+    {
+        // files are named <pathPrefix>-00000.pcapng, <pathPrefix>-00001.pcapng, ...
+        std::string pathPrefix;
+        // captured bytes per frame
+        std::uint32_t snapLength = 65535;
+        // 0 disables rotation by size
+        std::uint64_t rotateSize = 64 * 1024 * 1024;
+        // 0 disables rotation by age
+        std::chrono::seconds rotateInterval{0};
+        // oldest files are removed once there are more, 0 keeps all files
+        std::uint32_t maxFiles = 0;
+        // ring size in bytes per forwarding thread, must be a power of two
+        std::size_t ringSize = 8 * 1024 * 1024;
+        std::optional<CaptureFilter> filter;
+    };
+
+    /// <exception cref="std::runtime_error">Thrown if the first capture file cannot be created.</exception>
+    PcapngCapture(SilKit::Services::Logging::ILogger* logger, Options options);
+    ~PcapngCapture();
+
+    PcapngCapture(const PcapngCapture&) = delete;
+    PcapngCapture& operator=(const PcapngCapture&) = delete;
+
+    /// <summary>
+    /// Captures a frame forwarded in the given direction, unless the filter rejects it.
+    /// </summary>
+    void Capture(Direction direction, const std::uint8_t* frame, std::size_t frameSize)
+    {
+        if (_options.filter && !_options.filter->Matches(frame, frameSize))
+        {
+            return;
+        }
+
+        const auto capturedSize = static_cast<std::uint32_t>(std::min<std::size_t>(frameSize, _options.snapLength));
+        auto& ring = GetThreadRing();
+        auto* record = BeginRecord(ring, RecordSize(capturedSize));
+        if (record == nullptr)
+        {
+            metrics::Increment(metrics::Counter::CaptureLostFrames);
+            return;
+        }
+        auto* header = reinterpret_cast<RecordHeader*>(record);
+        header->timestampNs = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                             std::chrono::system_clock::now().time_since_epoch())
+                                                             .count());
+        header->originalSize = static_cast<std::uint32_t>(frameSize);
+        header->capturedSize = capturedSize;
+        header->direction = direction;
+        std::memcpy(record + sizeof(RecordHeader), frame, capturedSize);
+        CommitRecord(ring);
+    }
+
+private:
+    struct RecordHeader
+    {
+        std::uint64_t timestampNs;
+        std::uint32_t originalSize;
+        std::uint32_t capturedSize; // skipMarker: the rest of the ring up to its end is unused
+        Direction direction;
+        std::uint8_t reserved[7];
+    };
+
+    static_assert(sizeof(RecordHeader) == 24, "records are aligned to 8 bytes");
+
+    static constexpr std::uint32_t skipMarker = 0xFFFFFFFF;
+
+    // single producer (the owning thread), single consumer (the writer thread); head and tail count bytes
+    struct Ring
+    {
+        explicit Ring(std::size_t size)
+            : bytes{std::make_unique<std::uint64_t[]>(size / sizeof(std::uint64_t))}
+            , size{size}
+        {
+        }
+
+        auto At(std::uint64_t position) -> std::uint8_t*
+        {
+            return reinterpret_cast<std::uint8_t*>(bytes.get()) + (position & (size - 1));
+        }
+
+        std::unique_ptr<std::uint64_t[]> bytes;
+        std::size_t size;
+        alignas(64) std::atomic<std::uint64_t> head{0};
+        std::uint64_t cachedTail{0};
+        std::uint64_t pendingHead{0};
+        alignas(64) std::atomic<std::uint64_t> tail{0};
+    };
+
+    struct ThreadRing
+    {
+        std::uint64_t captureId;
+        Ring* ring;
+    };
+
+    static constexpr auto RecordSize(std::uint32_t capturedSize) -> std::size_t
+    {
+        return (sizeof(RecordHeader) + capturedSize + 7) & ~std::size_t{7};
+    }
+
+    auto GetThreadRing() -> Ring&
+    {
+        thread_local ThreadRing threadRing{0, nullptr};
+        if (threadRing.captureId != _id)
+        {
+            threadRing = ThreadRing{_id, RegisterRing()};
+        }
+        return *threadRing.ring;
+    }
+
+    // Reserves recordSize contiguous bytes. If they do not fit before the end of the ring, the rest of
+    // the ring is skipped and the record starts at its beginning.
+    static auto BeginRecord(Ring& ring, std::size_t recordSize) -> std::uint8_t*
+    {
+        auto head = ring.head.load(std::memory_order_relaxed);
+        const auto untilEnd = ring.size - (head & (ring.size - 1));
+        const auto skipSize = untilEnd < recordSize ? untilEnd : 0;
+        if (head + skipSize + recordSize - ring.cachedTail > ring.size)
+        {
+            ring.cachedTail = ring.tail.load(std::memory_order_acquire);
+            if (head + skipSize + recordSize - ring.cachedTail > ring.size)
+            {
+                return nullptr;
+            }
+        }
+        if (skipSize >= sizeof(RecordHeader))
+        {
+            reinterpret_cast<RecordHeader*>(ring.At(head))->capturedSize = skipMarker;
+        }
+        head += skipSize;
+        ring.pendingHead = head + recordSize;
+        return ring.At(head);
+    }
+
+    static void CommitRecord(Ring& ring)
+    {
+        ring.head.store(ring.pendingHead, std::memory_order_release);
+    }
+
+    auto RegisterRing() -> Ring*;
+    void Run();
+    auto Drain() -> bool;
+    void WriteRecord(const RecordHeader& header, const std::uint8_t* frame);
+    void OpenNextFile();
+    void CloseFile();
+
+    class File;
+
+    std::uint64_t _id;
+    SilKit::Services::Logging::ILogger* _logger;
+    Options _options;
+
+    std::mutex _ringsMutex;
+    std::vector<std::unique_ptr<Ring>> _rings;
+
+    // state of the writer thread
+    std::unique_ptr<File> _file;
+    std::uint64_t _fileIndex{0};
+    std::uint64_t _fileRecords{0};
+    std::chrono::steady_clock::time_point _fileOpened;
+    std::deque<std::string> _filePaths;
+    std::vector<std::uint8_t> _block;
+    bool _failed{false};
+
+    std::atomic<bool> _stopRequested{false};
+    std::thread _thread;
+};
+
+} // namespace adapters
@@ -0,0 +1,339 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "RealtimeProfile.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+#include "Split.hpp"
+
+#if defined(__linux__)
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+using namespace adapters;
+
+namespace {
+
+using ThreadRole = RealtimeProfile::ThreadRole;
+
+// the CPUs of a cpu_set_t
+constexpr int maxCpuCount = 1024;
+
+auto ToIndex(ThreadRole role) -> std::size_t
+{
+    return static_cast<std::size_t>(role);
+}
+
+auto ToString(ThreadRole role) -> std::string
+{
+    switch (role)
+    {
+    case ThreadRole::Io:
+        return "io";
+    case ThreadRole::SilKit:
+        return "silkit";
+    case ThreadRole::Background:
+        return "background";
+    }
+    return "";
+}
+
+auto ParseThreadRole(const std::string& text) -> ThreadRole
+{
+    for (const auto role : {ThreadRole::Io, ThreadRole::SilKit, ThreadRole::Background})
+    {
+        if (text == ToString(role))
+        {
+            return role;
+        }
+    }
+    throw std::invalid_argument{"'" + text + "' is not a thread role, expected io, silkit or background"};
+}
+
+auto ParseNumber(const std::string& text, int maxValue) -> int
+{
+    const auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+    if (text.empty() || text.size() > 4 || !std::all_of(text.begin(), text.end(), isDigit)
+        || std::stoi(text) > maxValue)
+    {
+        throw std::invalid_argument{"'" + text + "' is not a number in range 0.." + std::to_string(maxValue)};
+    }
+    return std::stoi(text);
+}
+
+// Calls parseValue with the role and value of each term of a list like "io=2,silkit=3"
+template <typename ParseValue>
+void ParseRoleList(const std::string& list, ParseValue parseValue)
+{
+    for (const auto& term : demo::Split(list, ','))
+    {
+        const auto equalSign = term.find('=');
+        if (equalSign == std::string::npos)
+        {
+            throw std::invalid_argument{"'" + term + "' is not of the form <role>=<value>"};
+        }
+        parseValue(ParseThreadRole(term.substr(0, equalSign)), term.substr(equalSign + 1));
+    }
+}
+
+auto ParseCpuList(const std::string& list) -> std::vector<int>
+{
+    std::vector<int> cpus;
+    for (const auto& term : demo::Split(list, '+'))
+    {
+        const auto dash = term.find('-');
+        const auto first = ParseNumber(term.substr(0, dash), maxCpuCount - 1);
+        const auto last = dash == std::string::npos ? first : ParseNumber(term.substr(dash + 1), maxCpuCount - 1);
+        if (last < first)
+        {
+            throw std::invalid_argument{"'" + term + "' is not an ascending range of CPUs"};
+        }
+        for (auto cpu = first; cpu <= last; ++cpu)
+        {
+            if (std::find(cpus.begin(), cpus.end(), cpu) == cpus.end())
+            {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    return cpus;
+}
+
+auto DescribeSettings(const RealtimeProfile::ThreadSettings& settings) -> std::string
+{
+    std::string description;
+    if (!settings.cpus.empty())
+    {
+        description = "CPUs";
+        for (const auto cpu : settings.cpus)
+        {
+            description += " " + std::to_string(cpu);
+        }
+    }
+    if (settings.fifoPriority)
+    {
+        description += (description.empty() ? "" : ", ") + std::string{"SCHED_FIFO priority "}
+                       + std::to_string(*settings.fifoPriority);
+    }
+    return description;
+}
+
+} // namespace
+
+constexpr std::size_t RealtimeProfile::heapReserveSize;
+constexpr std::chrono::seconds RealtimeProfile::pageFaultCheckInterval;
+constexpr std::chrono::seconds RealtimeProfile::pageFaultWarningInterval;
+
+void RealtimeProfile::ParseCpuAffinity(const std::string& list, Options& options)
+{
+    ParseRoleList(list, [&options](ThreadRole role, const std::string& value) {
+        options.threads[ToIndex(role)].cpus = ParseCpuList(value);
+    });
+}
+
+void RealtimeProfile::ParseSchedFifo(const std::string& list, Options& options)
+{
+    ParseRoleList(list, [&options](ThreadRole role, const std::string& value) {
+        const auto priority = ParseNumber(value, 99);
+        if (priority == 0)
+        {
+            throw std::invalid_argument{"the SCHED_FIFO priority of " + ToString(role) + " must be at least 1"};
+        }
+        options.threads[ToIndex(role)].fifoPriority = priority;
+    });
+}
+
+RealtimeProfile::RealtimeProfile(Options options)
+    : _options{std::move(options)}
+{
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+    {
+        for (int cpu = 0; cpu < maxCpuCount; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &cpuSet))
+            {
+                _processCpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+}
+
+RealtimeProfile::~RealtimeProfile() = default;
+
+void RealtimeProfile::ApplyToCurrentThread(ThreadRole role)
+{
+#if defined(__linux__)
+    const auto& settings = _options.threads[ToIndex(role)];
+    const auto& cpus = settings.cpus.empty() ? _processCpus : settings.cpus;
+    if (!cpus.empty())
+    {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (const auto cpu : cpus)
+        {
+            CPU_SET(cpu, &cpuSet);
+        }
+        const auto result = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+        if (result != 0)
+        {
+            throw std::system_error{result, std::generic_category(),
+                                    "Cannot pin the " + ToString(role) + " threads to their CPUs"};
+        }
+    }
+
+    sched_param parameter{};
+    parameter.sched_priority = settings.fifoPriority.value_or(0);
+    const auto policy = settings.fifoPriority ? SCHED_FIFO : SCHED_OTHER;
+    const auto result = pthread_setschedparam(pthread_self(), policy, &parameter);
+    if (result != 0)
+    {
+        // EPERM without CAP_SYS_NICE or an RLIMIT_RTPRIO of at least the priority
+        throw std::system_error{result, std::generic_category(),
+                                "Cannot set the scheduling policy of the " + ToString(role) + " threads"};
+    }
+#else
+    (void)role;
+    throw std::system_error{std::make_error_code(std::errc::function_not_supported),
+                            "The real-time profile is only available on Linux"};
+#endif
+}
+
+void RealtimeProfile::Start(asio::io_context& ioContext, SilKit::Services::Logging::ILogger* logger)
+{
+    _logger = logger;
+    for (const auto role : {ThreadRole::Io, ThreadRole::SilKit, ThreadRole::Background})
+    {
+        const auto& settings = _options.threads[ToIndex(role)];
+        if (!settings.cpus.empty() || settings.fifoPriority)
+        {
+            _logger->Info("Real-time profile: " + ToString(role) + " threads on " + DescribeSettings(settings));
+        }
+    }
+
+    if (_options.lockMemory)
+    {
+        LockMemory();
+    }
+
+    _timer = std::make_unique<asio::steady_timer>(ioContext);
+    ScheduleNextCheck();
+}
+
+void RealtimeProfile::LockMemory()
+{
+#if defined(__linux__)
+    // freed memory stays in the heap instead of going back to the system, large blocks come from the heap
+    // instead of their own mappings, so that the allocations after startup reuse prefaulted pages
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+
+    // locks the pages of all current mappings, faulting in the pools, rings and thread stacks, and populates
+    // every future mapping when it is created
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+        // ENOMEM or EPERM with an RLIMIT_MEMLOCK below the size of the process and without CAP_IPC_LOCK
+        throw std::system_error{errno, std::generic_category(), "Cannot lock the memory of the adapter"};
+    }
+
+    // faults in the heap reserve, which stays in the heap when it is freed
+    auto reserve = std::make_unique<std::uint8_t[]>(heapReserveSize);
+    const auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    for (std::size_t offset = 0; offset < heapReserveSize; offset += pageSize)
+    {
+        static_cast<volatile std::uint8_t*>(reserve.get())[offset] = 0;
+    }
+    reserve.reset();
+
+    _logger->Info("Real-time profile: memory locked with a heap reserve of "
+                  + std::to_string(heapReserveSize / (1024 * 1024)) + " MiB");
+#else
+    throw std::system_error{std::make_error_code(std::errc::function_not_supported),
+                            "The real-time profile is only available on Linux"};
+#endif
+}
+
+auto RealtimeProfile::ReadPageFaults() -> PageFaults
+{
+#if defined(__linux__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return PageFaults{static_cast<std::uint64_t>(usage.ru_minflt), static_cast<std::uint64_t>(usage.ru_majflt)};
+#else
+    return PageFaults{0, 0};
+#endif
+}
+
+void RealtimeProfile::ScheduleNextCheck()
+{
+    _timer->expires_after(_startPageFaults ? pageFaultWarningInterval : pageFaultCheckInterval);
+    _timer->async_wait([this](const std::error_code ec) {
+        if (ec)
+        {
+            return;
+        }
+        CheckPageFaults();
+        if (_options.lockMemory)
+        {
+            ScheduleNextCheck();
+        }
+    });
+}
+
+void RealtimeProfile::CheckPageFaults()
+{
+    const auto pageFaults = ReadPageFaults();
+    if (!_startPageFaults)
+    {
+        _startPageFaults = pageFaults;
+        _lastPageFaults = pageFaults;
+        return;
+    }
+
+    const auto minor = pageFaults.minor - _lastPageFaults.minor;
+    const auto major = pageFaults.major - _lastPageFaults.major;
+    _lastPageFaults = pageFaults;
+    if (minor != 0 || major != 0)
+    {
+        _logger->Warn("Real-time profile: " + std::to_string(minor) + " minor and " + std::to_string(major)
+                      + " major page faults in the last " + std::to_string(pageFaultWarningInterval.count())
+                      + " s despite the locked memory");
+    }
+}
+
+auto RealtimeProfile::GetPageFaultsSinceStart() const -> PageFaults
+{
+    if (!_startPageFaults)
+    {
+        return PageFaults{0, 0};
+    }
+    const auto pageFaults = ReadPageFaults();
+    return PageFaults{pageFaults.minor - _startPageFaults->minor, pageFaults.major - _startPageFaults->major};
+}
+
+void RealtimeProfile::WriteMetrics(metrics::OpenMetricsWriter& writer) const
+{
+    const auto pageFaults = GetPageFaultsSinceStart();
+    writer.Family("page_faults", "counter", "Page faults of the adapter process after startup.");
+    writer.Sample("_total", R"(type="minor")", pageFaults.minor);
+    writer.Sample("_total", R"(type="major")", pageFaults.major);
+}
+
+void RealtimeProfile::LogSummary() const
+{
+    const auto pageFaults = GetPageFaultsSinceStart();
+    _logger->Info("Real-time profile: " + std::to_string(pageFaults.minor) + " minor and "
+                  + std::to_string(pageFaults.major) + " major page faults after startup");
+}
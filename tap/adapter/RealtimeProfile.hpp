@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Metrics.hpp"
+
+#include "asio/ts/io_context.hpp"
+#include "asio/steady_timer.hpp"
+
+#include "silkit/services/logging/all.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// Real-time execution profile of the adapter threads on Linux: CPU affinity and SCHED_FIFO priority per thread
+/// role, locked and prefaulted memory, and a monitor of the page faults after startup.
+///
+///   Threads inherit the affinity and scheduling policy of the thread creating them. The participant is therefore
+///   created on a thread which takes the settings of the SIL Kit threads, the main thread takes those of the
+///   background threads (frame trace, capture, flight recorder) and, while it starts the io thread, those of the
+///   io thread. A role without settings gets the CPUs of the process and the default policy.
+///
+///   LockMemory is called once all pools and rings are allocated: it keeps freed heap memory in the process,
+///   prefaults a heap reserve and locks all current and future mappings, which faults in every page of the
+///   pools, the rings and the thread stacks up front.
+/// </summary>
+class RealtimeProfile
+{
+public:
+    enum struct ThreadRole : std::uint8_t
+    {
+        // the io_context thread, reading from the TAP device
+        Io,
+        // the threads of SIL Kit, delivering the frames from SIL Kit
+        SilKit,
+        // the threads of the observation features and the main thread
+        Background,
+    };
+    static constexpr std::size_t threadRoleCount = 3;
+
+    struct ThreadSettings
+    {
+        // empty for the CPUs of the process
+        std::vector<int> cpus;
+        // SCHED_FIFO priority 1..99, the default policy if none
+        std::optional<int> fifoPriority;
+    };
+
+    struct Options
+    {
+        std::array<ThreadSettings, threadRoleCount> threads;
+        bool lockMemory = false;
+    };
+
+    // heap prefaulted by LockMemory for the allocations after startup
+    static constexpr std::size_t heapReserveSize = 32 * 1024 * 1024;
+    // the page faults are counted from the first check on, which leaves out the startup of the io thread
+    static constexpr std::chrono::seconds pageFaultCheckInterval{1};
+    // with locked memory, new page faults are checked for and warned about at most this often
+    static constexpr std::chrono::seconds pageFaultWarningInterval{30};
+
+    /// <summary>
+    /// Parses the CPUs of the thread roles like "io=2,silkit=3-5+7,background=0-1" into options.
+    /// </summary>
+    /// <exception cref="std::invalid_argument">Thrown if the list is malformed.</exception>
+    static void ParseCpuAffinity(const std::string& list, Options& options);
+
+    /// <summary>
+    /// Parses the SCHED_FIFO priorities of the thread roles like "io=80,silkit=70" into options.
+    /// </summary>
+    /// <exception cref="std::invalid_argument">Thrown if the list is malformed.</exception>
+    static void ParseSchedFifo(const std::string& list, Options& options);
+
+    explicit RealtimeProfile(Options options);
+    ~RealtimeProfile();
+
+    RealtimeProfile(const RealtimeProfile&) = delete;
+    RealtimeProfile& operator=(const RealtimeProfile&) = delete;
+
+    /// <summary>
+    /// Applies the settings of the role to the calling thread, and to the threads it creates afterwards. Called
+    /// before the participant exists, so nothing is logged until Start.
+    /// </summary>
+    /// <exception cref="std::system_error">Thrown if the settings are not permitted or invalid.</exception>
+    void ApplyToCurrentThread(ThreadRole role);
+
+    /// <summary>
+    /// Logs the settings, locks and prefaults the memory if enabled, and checks the page faults on the io_context.
+    /// They are counted from the first check on, which leaves out the startup of the io thread. With locked
+    /// memory, every warning interval with new ones logs a warning, without it page faults are normal.
+    /// </summary>
+    /// <exception cref="std::system_error">Thrown if the memory cannot be locked.</exception>
+    void Start(asio::io_context& ioContext, SilKit::Services::Logging::ILogger* logger);
+
+    /// <summary>
+    /// Writes the page faults since the first check. Called on the io_context.
+    /// </summary>
+    void WriteMetrics(metrics::OpenMetricsWriter& writer) const;
+
+    /// <summary>
+    /// Logs the page faults since the first check, once the io_context is stopped.
+    /// </summary>
+    void LogSummary() const;
+
+private:
+    struct PageFaults
+    {
+        std::uint64_t minor;
+        std::uint64_t major;
+    };
+
+    static auto ReadPageFaults() -> PageFaults;
+    void LockMemory();
+    void ScheduleNextCheck();
+    void CheckPageFaults();
+    auto GetPageFaultsSinceStart() const -> PageFaults;
+
+    SilKit::Services::Logging::ILogger* _logger{nullptr};
+    Options _options;
+    // the CPUs of the process when the profile was created
+    std::vector<int> _processCpus;
+    // on the io_context, none until the first check
+    std::optional<PageFaults> _startPageFaults;
+    PageFaults _lastPageFaults{};
+    std::unique_ptr<asio::steady_timer> _timer;
+};
+
+} // namespace adapters
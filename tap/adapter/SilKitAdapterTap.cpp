@@ -3,20 +3,40 @@
 
 #include "Parsing.hpp"
 #include "TapConnection.hpp"
-#include "EthernetHeader.hpp"
-
+#include "ForwardingPipeline.hpp"
+#include "FlowClassifier.hpp"
+#include "MtuAdaptation.hpp"
+#include "NeighborProxy.hpp"
+#include "LoopSuppression.hpp"
+#include "L2Switch.hpp"
+#include "MulticastSnooping.hpp"
+#include "SomeIpStatistics.hpp"
+#include "Metrics.hpp"
+#include "MetricsServer.hpp"
+#include "LatencyHistogram.hpp"
+#include "FrameTrace.hpp"
+#include "PcapngCapture.hpp"
+#include "FlightRecorder.hpp"
+#include "RealtimeProfile.hpp"
+#include "Startup.hpp"
+
+#include <future>
 #include <iostream>
 #include <string>
 #include <thread>
 #include <vector>
 #include <cstdint>
+#include <limits>
+#include <memory>
 #include <optional>
+#include <sstream>
 
 #include "common/Parsing.hpp"
 #include "common/Cli.hpp"
 #include "common/ParticipantCreation.hpp"
 #include "common/Exceptions.hpp"
 
+#include "asio/post.hpp"
 #include "asio/ts/buffer.hpp"
 #include "asio/ts/io_context.hpp"
 
@@ -32,6 +52,164 @@ using namespace std::chrono_literals;
 using namespace util;
 using namespace adapters;
 
+namespace {
+
+// Stops and joins the io thread if the startup fails after it was started, Stop joins it otherwise
+class IoThreadGuard
+{
+public:
+    IoThreadGuard(asio::io_context& ioContext, std::thread& thread)
+        : _ioContext{ioContext}
+        , _thread{thread}
+    {
+    }
+
+    ~IoThreadGuard()
+    {
+        if (_thread.joinable())
+        {
+            _ioContext.stop();
+            _thread.join();
+        }
+    }
+
+    IoThreadGuard(const IoThreadGuard&) = delete;
+    IoThreadGuard& operator=(const IoThreadGuard&) = delete;
+
+private:
+    asio::io_context& _ioContext;
+    std::thread& _thread;
+};
+
+auto DescribeVlanMembership(const L2Switch::PortOptions& options) -> std::string
+{
+    std::string description;
+    if (options.untaggedVlanId.has_value())
+    {
+        description = "untagged in VLAN " + std::to_string(*options.untaggedVlanId);
+    }
+    for (std::size_t index = 0; index < options.taggedVlanIds.size(); ++index)
+    {
+        description += (index == 0 ? (description.empty() ? "tagged in VLAN " : ", tagged in VLAN ") : ", ")
+                       + std::to_string(options.taggedVlanIds[index]);
+    }
+    return description;
+}
+
+// Switch mode: the TAP devices and SIL Kit networks of the ports are connected by the switch instead of one
+// forwarding pipeline, frames between local ports do not go through SIL Kit
+void RunSwitch(SilKit::IParticipant* participant, SilKit::Services::Logging::ILogger* logger,
+               ILifecycleService* lifecycleService, std::promise<void>* runningStatePromise,
+               asio::io_context& ioContext, const std::vector<L2Switch::PortDescription>& ports,
+               const std::string& metricsEndpoint, RealtimeProfile* realtimeProfile, const std::string& readyFilePath)
+{
+    L2Switch l2Switch{logger};
+    std::vector<std::unique_ptr<TapConnection>> tapConnections;
+    std::vector<IEthernetController*> ethControllers;
+
+    for (const auto& port : ports)
+    {
+        const auto& name = port.options.name;
+        if (port.kind == L2Switch::PortDescription::Kind::Tap)
+        {
+            logger->Info("Creating switch port for TAP device [" + name + "], "
+                         + DescribeVlanMembership(port.options));
+            tapConnections.push_back(std::make_unique<TapConnection>(ioContext, name, logger));
+            auto* tapConnection = tapConnections.back().get();
+            const auto portId = l2Switch.AddPort(
+                port.options, [tapConnection](const demo::FrameBuilder& frame) { tapConnection->SendSegments(frame); });
+            tapConnection->StartReceiving([&l2Switch, portId](std::vector<std::uint8_t> frame) {
+                l2Switch.Receive(portId, asio::buffer(frame));
+            });
+        }
+        else
+        {
+            const auto controllerName = "SilKit_ETH_CTRL_" + std::to_string(ethControllers.size() + 1);
+            logger->Info("Creating switch port for SIL Kit network [" + name + "] with ethernet controller '"
+                         + controllerName + "', " + DescribeVlanMembership(port.options));
+            auto* ethController = participant->CreateEthernetController(controllerName, name);
+            ethControllers.push_back(ethController);
+            const auto portId = l2Switch.AddPort(port.options, [ethController](const demo::FrameBuilder& frame) {
+                // SIL Kit takes a contiguous frame, joined into a buffer reused by the calling thread
+                thread_local std::vector<std::uint8_t> joinedFrame;
+                frame.FlattenTo(joinedFrame);
+                if (joinedFrame.size() < 60)
+                {
+                    joinedFrame.resize(60, 0);
+                }
+                ethController->SendFrame(EthernetFrame{joinedFrame});
+            });
+            ethController->AddFrameHandler(
+                [&l2Switch, portId](IEthernetController* /*controller*/, const EthernetFrameEvent& msg) {
+                l2Switch.Receive(portId, asio::buffer(msg.frame.raw.data(), msg.frame.raw.size()));
+            });
+        }
+    }
+
+    std::unique_ptr<MetricsServer> metricsServer;
+    if (!metricsEndpoint.empty())
+    {
+        const auto renderMetrics = [realtimeProfile]() {
+            metrics::OpenMetricsWriter writer;
+            metrics::WriteCounters(writer, metrics::Aggregate());
+            if (realtimeProfile)
+            {
+                realtimeProfile->WriteMetrics(writer);
+            }
+            return writer.Finish();
+        };
+        metricsServer = std::make_unique<MetricsServer>(ioContext, metricsEndpoint, renderMetrics, logger);
+    }
+
+    ReadinessNotifier readinessNotifier{readyFilePath, logger};
+
+    // Called during startup
+    lifecycleService->SetCommunicationReadyHandler([&ethControllers, &readinessNotifier, portCount = ports.size()]() {
+        for (auto* ethController : ethControllers)
+        {
+            ethController->Activate();
+        }
+        readinessNotifier.NotifyReady("Switching between " + std::to_string(portCount) + " ports");
+    });
+
+    if (realtimeProfile)
+    {
+        realtimeProfile->Start(ioContext, logger);
+    }
+
+    auto finalStateFuture = lifecycleService->StartLifecycle();
+
+    if (realtimeProfile)
+    {
+        realtimeProfile->ApplyToCurrentThread(RealtimeProfile::ThreadRole::Io);
+    }
+    std::thread t([&]() -> void { ioContext.run(); });
+    if (realtimeProfile)
+    {
+        realtimeProfile->ApplyToCurrentThread(RealtimeProfile::ThreadRole::Background);
+    }
+
+    promptForExit();
+
+    readinessNotifier.NotifyStopping();
+    Stop(ioContext, t, *logger, runningStatePromise, lifecycleService, &finalStateFuture);
+
+    if (realtimeProfile)
+    {
+        realtimeProfile->LogSummary();
+    }
+
+    for (L2Switch::PortId portId = 0; portId < l2Switch.GetPortCount(); ++portId)
+    {
+        const auto statistics = l2Switch.GetPortStatistics(portId);
+        logger->Debug("Switch port " + l2Switch.GetPortOptions(portId).name + ": received "
+                      + std::to_string(statistics.receivedFrames) + " frames, sent "
+                      + std::to_string(statistics.sentFrames) + " frames");
+    }
+}
+
+} // namespace
+
 int main(int argc, char** argv)
 {
     if (findArg(argc, argv, versionArg, argv) != NULL)
@@ -74,22 +252,405 @@ int main(int argc, char** argv)
         }
     }
 
+    const bool multicastSnoopingEnabled = (findArg(argc, argv, multicastSnoopingArg, argv) != NULL);
+    const bool latencyHistogramsEnabled = (findArg(argc, argv, latencyHistogramsArg, argv) != NULL);
+
+    const std::string someIpPortsStr = getArgDefault(argc, argv, someIpStatisticsArg, "");
+    std::vector<std::uint16_t> someIpPorts;
+    if (!someIpPortsStr.empty())
+    {
+        try
+        {
+            someIpPorts = ParsePortList(someIpPortsStr);
+        }
+        catch (const std::exception&)
+        {
+            std::cerr << "Error: Invalid SOME/IP port list '" << someIpPortsStr
+                      << "', expected comma separated numbers in range 1..65535" << std::endl;
+            return CodeErrorCli;
+        }
+    }
+
+    const std::string flowHashStr = getArgDefault(argc, argv, flowHashArg, "");
+    std::optional<FlowClassifier::HashFunction> flowHashFunction;
+    if (!flowHashStr.empty())
+    {
+        flowHashFunction = FlowClassifier::ParseHashFunction(flowHashStr);
+        if (!flowHashFunction)
+        {
+            std::cerr << "Error: Invalid flow hash '" << flowHashStr << "', expected toeplitz or fast" << std::endl;
+            return CodeErrorCli;
+        }
+    }
+
+    const std::string mtuStr = getArgDefault(argc, argv, mtuArg, "");
+    std::optional<MtuAdaptation::Options> mtuAdaptationOptions;
+    if (!mtuStr.empty())
+    {
+        try
+        {
+            const unsigned long mtu = std::stoul(mtuStr);
+            if (mtu < MtuAdaptation::minMtu || mtu > 65535)
+            {
+                throw std::out_of_range{"mtu"};
+            }
+            mtuAdaptationOptions.emplace();
+            mtuAdaptationOptions->mtu = static_cast<std::uint16_t>(mtu);
+            mtuAdaptationOptions->clampMss = (findArg(argc, argv, clampMssArg, argv) != NULL);
+        }
+        catch (const std::exception&)
+        {
+            std::cerr << "Error: Invalid MTU '" << mtuStr << "', expected a number in range "
+                      << MtuAdaptation::minMtu << "..65535" << std::endl;
+            return CodeErrorCli;
+        }
+    }
+    else if (findArg(argc, argv, clampMssArg, argv) != NULL)
+    {
+        std::cerr << "Error: " << clampMssArg << " requires " << mtuArg << std::endl;
+        return CodeErrorCli;
+    }
+
+    const std::string neighborProxyStaticStr = getArgDefault(argc, argv, neighborProxyStaticArg, "");
+    const bool neighborProxyEnabled =
+        (findArg(argc, argv, neighborProxyArg, argv) != NULL) || !neighborProxyStaticStr.empty();
+    std::vector<NeighborProxy::Binding> neighborProxyStaticBindings;
+    if (!neighborProxyStaticStr.empty())
+    {
+        try
+        {
+            neighborProxyStaticBindings = NeighborProxy::ParseBindings(neighborProxyStaticStr);
+        }
+        catch (const std::exception& error)
+        {
+            std::cerr << "Error: Invalid static neighbor bindings '" << neighborProxyStaticStr << "': "
+                      << error.what() << std::endl;
+            return CodeErrorCli;
+        }
+    }
+
+    const std::string loopSuppressionWindowStr = getArgDefault(argc, argv, loopSuppressionWindowArg, "");
+    const bool loopSuppressionEnabled =
+        (findArg(argc, argv, loopSuppressionArg, argv) != NULL) || !loopSuppressionWindowStr.empty();
+    std::chrono::milliseconds loopSuppressionWindow = LoopSuppression::defaultWindow;
+    if (!loopSuppressionWindowStr.empty())
+    {
+        try
+        {
+            loopSuppressionWindow = std::chrono::milliseconds{std::stoul(loopSuppressionWindowStr)};
+        }
+        catch (const std::exception&)
+        {
+            loopSuppressionWindow = std::chrono::milliseconds{0};
+        }
+        if (loopSuppressionWindow.count() == 0 || loopSuppressionWindow > LoopSuppression::maxWindow)
+        {
+            std::cerr << "Error: Invalid loop suppression window '" << loopSuppressionWindowStr
+                      << "', expected a number of milliseconds in range 1.." << LoopSuppression::maxWindow.count()
+                      << std::endl;
+            return CodeErrorCli;
+        }
+    }
+
+    const std::string metricsEndpoint = getArgDefault(argc, argv, metricsEndpointArg, "");
+    if (!metricsEndpoint.empty() && metricsEndpoint.rfind("unix:", 0) != 0)
+    {
+        try
+        {
+            std::size_t parsedLength = 0;
+            const unsigned long port = std::stoul(metricsEndpoint, &parsedLength);
+            if (parsedLength != metricsEndpoint.size() || port == 0 || port > 65535)
+            {
+                throw std::invalid_argument{"invalid port"};
+            }
+        }
+        catch (const std::exception&)
+        {
+            std::cerr << "Error: Invalid metrics endpoint '" << metricsEndpoint
+                      << "', expected a port in range 1..65535 or unix:<socket path>" << std::endl;
+            return CodeErrorCli;
+        }
+    }
+
+    const std::string metricsLogIntervalStr = getArgDefault(argc, argv, metricsLogIntervalArg, "");
+    std::chrono::seconds metricsLogInterval{0};
+    if (!metricsLogIntervalStr.empty())
+    {
+        try
+        {
+            metricsLogInterval = std::chrono::seconds{std::stoul(metricsLogIntervalStr)};
+        }
+        catch (const std::exception&)
+        {
+        }
+        if (metricsLogInterval.count() == 0)
+        {
+            std::cerr << "Error: Invalid metrics log interval '" << metricsLogIntervalStr
+                      << "', expected a number of seconds greater than 0" << std::endl;
+            return CodeErrorCli;
+        }
+    }
+
+    FrameTracer::Options frameTracerOptions;
+    try
+    {
+        const std::string traceRateLimitStr = getArgDefault(argc, argv, traceRateLimitArg, "");
+        if (!traceRateLimitStr.empty())
+        {
+            frameTracerOptions.maxLinesPerSecond = static_cast<std::uint32_t>(
+                ParseUnsigned(traceRateLimitStr, 0, std::numeric_limits<std::uint32_t>::max()));
+        }
+        const std::string traceFlowSamplingStr = getArgDefault(argc, argv, traceFlowSamplingArg, "");
+        if (!traceFlowSamplingStr.empty())
+        {
+            frameTracerOptions.flowSampleRate = static_cast<std::uint32_t>(
+                ParseUnsigned(traceFlowSamplingStr, 1, std::numeric_limits<std::uint32_t>::max()));
+        }
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << "Error: Invalid frame trace option: " << error.what() << std::endl;
+        return CodeErrorCli;
+    }
+
+    PcapngCapture::Options captureOptions;
+    captureOptions.pathPrefix = getArgDefault(argc, argv, captureArg, "");
+    try
+    {
+        const std::string captureSnapLengthStr = getArgDefault(argc, argv, captureSnapLengthArg, "");
+        if (!captureSnapLengthStr.empty())
+        {
+            captureOptions.snapLength = static_cast<std::uint32_t>(ParseUnsigned(captureSnapLengthStr, 1, 262144));
+        }
+        const std::string captureRotateSizeStr = getArgDefault(argc, argv, captureRotateSizeArg, "");
+        if (!captureRotateSizeStr.empty())
+        {
+            // in MiB, at most 1 TiB
+            captureOptions.rotateSize = ParseUnsigned(captureRotateSizeStr, 0, 1024 * 1024) * 1024 * 1024;
+        }
+        const std::string captureRotateIntervalStr = getArgDefault(argc, argv, captureRotateIntervalArg, "");
+        if (!captureRotateIntervalStr.empty())
+        {
+            // at most a week
+            captureOptions.rotateInterval =
+                std::chrono::seconds{ParseUnsigned(captureRotateIntervalStr, 0, 7 * 24 * 60 * 60)};
+        }
+        const std::string captureMaxFilesStr = getArgDefault(argc, argv, captureMaxFilesArg, "");
+        if (!captureMaxFilesStr.empty())
+        {
+            captureOptions.maxFiles = static_cast<std::uint32_t>(
+                ParseUnsigned(captureMaxFilesStr, 0, std::numeric_limits<std::uint32_t>::max()));
+        }
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << "Error: Invalid capture option: " << error.what() << std::endl;
+        return CodeErrorCli;
+    }
+
+    const std::string captureFilterStr = getArgDefault(argc, argv, captureFilterArg, "");
+    if (!captureFilterStr.empty())
+    {
+        try
+        {
+            captureOptions.filter = CaptureFilter::Parse(captureFilterStr);
+        }
+        catch (const std::exception& error)
+        {
+            std::cerr << "Error: Invalid capture filter '" << captureFilterStr << "': " << error.what() << std::endl;
+            return CodeErrorCli;
+        }
+    }
+
+    FlightRecorder::Options flightRecorderOptions;
+    flightRecorderOptions.pathPrefix = getArgDefault(argc, argv, flightRecorderArg, "");
+    try
+    {
+        const std::string flightRecorderFramesStr = getArgDefault(argc, argv, flightRecorderFramesArg, "");
+        if (!flightRecorderFramesStr.empty())
+        {
+            flightRecorderOptions.slotCount = static_cast<std::size_t>(
+                ParseUnsigned(flightRecorderFramesStr, 1, FlightRecorder::maxSlotCount));
+        }
+        const std::string flightRecorderSnapLengthStr = getArgDefault(argc, argv, flightRecorderSnapLengthArg, "");
+        if (!flightRecorderSnapLengthStr.empty())
+        {
+            flightRecorderOptions.snapLength = static_cast<std::uint32_t>(
+                ParseUnsigned(flightRecorderSnapLengthStr, 1, FlightRecorder::maxSnapLength));
+        }
+        const std::string flightRecorderNackBurstStr = getArgDefault(argc, argv, flightRecorderNackBurstArg, "");
+        if (!flightRecorderNackBurstStr.empty())
+        {
+            flightRecorderOptions.nackBurstThreshold = static_cast<std::uint32_t>(
+                ParseUnsigned(flightRecorderNackBurstStr, 0, std::numeric_limits<std::uint32_t>::max()));
+        }
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << "Error: Invalid flight recorder option: " << error.what() << std::endl;
+        return CodeErrorCli;
+    }
+    if (flightRecorderOptions.slotCount > FlightRecorder::maxSlotDataSize / flightRecorderOptions.snapLength)
+    {
+        std::cerr << "Error: Invalid flight recorder option: " << flightRecorderOptions.slotCount << " frames of "
+                  << flightRecorderOptions.snapLength << " bytes exceed "
+                  << FlightRecorder::maxSlotDataSize / (1024 * 1024) << " MiB" << std::endl;
+        return CodeErrorCli;
+    }
+
+    const std::string switchPortsStr = getArgDefault(argc, argv, switchPortsArg, "");
+    std::vector<L2Switch::PortDescription> switchPorts;
+    if (!switchPortsStr.empty())
+    {
+        try
+        {
+            switchPorts = L2Switch::ParsePorts(switchPortsStr);
+        }
+        catch (const std::exception& error)
+        {
+            std::cerr << "Error: Invalid switch ports '" << switchPortsStr << "': " << error.what() << std::endl;
+            return CodeErrorCli;
+        }
+
+        // the features of the forwarding pipeline are not available between switch ports
+        for (const auto* arg :
+             {&tapNameArg, &networkArg, &vlanTagArg, &multicastSnoopingArg, &someIpStatisticsArg, &flowHashArg,
+              &mtuArg, &clampMssArg, &neighborProxyArg, &neighborProxyStaticArg, &metricsLogIntervalArg,
+              &latencyHistogramsArg, &captureArg, &flightRecorderArg, &startupQueueFramesArg, &startupQueueAgeArg,
+              &loopSuppressionArg, &loopSuppressionWindowArg})
+        {
+            if (findArg(argc, argv, *arg, argv) != NULL)
+            {
+                std::cerr << "Error: " << *arg << " cannot be combined with " << switchPortsArg << std::endl;
+                return CodeErrorCli;
+            }
+        }
+    }
+
+    const std::string cpuAffinityStr = getArgDefault(argc, argv, cpuAffinityArg, "");
+    const std::string schedFifoStr = getArgDefault(argc, argv, schedFifoArg, "");
+    RealtimeProfile::Options realtimeProfileOptions;
+    realtimeProfileOptions.lockMemory = (findArg(argc, argv, lockMemoryArg, argv) != NULL);
+    try
+    {
+        if (!cpuAffinityStr.empty())
+        {
+            RealtimeProfile::ParseCpuAffinity(cpuAffinityStr, realtimeProfileOptions);
+        }
+        if (!schedFifoStr.empty())
+        {
+            RealtimeProfile::ParseSchedFifo(schedFifoStr, realtimeProfileOptions);
+        }
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << "Error: Invalid real-time profile option: " << error.what() << std::endl;
+        return CodeErrorCli;
+    }
+
+    PreActivationQueue::Options startupQueueOptions;
+    try
+    {
+        const std::string startupQueueFramesStr = getArgDefault(argc, argv, startupQueueFramesArg, "");
+        if (!startupQueueFramesStr.empty())
+        {
+            startupQueueOptions.maxFrames = static_cast<std::size_t>(
+                ParseUnsigned(startupQueueFramesStr, 0, PreActivationQueue::maxFramesLimit));
+        }
+        const std::string startupQueueAgeStr = getArgDefault(argc, argv, startupQueueAgeArg, "");
+        if (!startupQueueAgeStr.empty())
+        {
+            startupQueueOptions.maxAge = std::chrono::milliseconds{
+                ParseUnsigned(startupQueueAgeStr, 1, PreActivationQueue::maxAgeLimit.count())};
+        }
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << "Error: Invalid startup queue option: " << error.what() << std::endl;
+        return CodeErrorCli;
+    }
+
+    const std::string readyFilePath = getArgDefault(argc, argv, readyFileArg, "");
+
     asio::io_context ioContext;
 
     try
     {
         throwInvalidCliIf(thereAreUnknownArguments(
             argc, argv,
-            {&tapNameArg, &networkArg, &vlanTagArg, &regUriArg, &logLevelArg, &participantNameArg, &configurationArg},
-            {&helpArg, &versionArg}));
+            {&tapNameArg, &networkArg, &vlanTagArg, &someIpStatisticsArg, &flowHashArg, &mtuArg,
+             &neighborProxyStaticArg, &metricsEndpointArg, &metricsLogIntervalArg, &traceRateLimitArg,
+             &traceFlowSamplingArg, &captureArg, &captureSnapLengthArg, &captureFilterArg, &captureRotateSizeArg,
+             &captureRotateIntervalArg, &captureMaxFilesArg, &flightRecorderArg, &flightRecorderFramesArg,
+             &flightRecorderSnapLengthArg, &flightRecorderNackBurstArg, &switchPortsArg, &cpuAffinityArg,
+             &schedFifoArg, &startupQueueFramesArg, &startupQueueAgeArg, &readyFileArg, &loopSuppressionWindowArg,
+             &regUriArg, &logLevelArg, &participantNameArg, &configurationArg},
+            {&helpArg, &versionArg, &multicastSnoopingArg, &latencyHistogramsArg, &clampMssArg, &neighborProxyArg,
+             &lockMemoryArg, &loopSuppressionArg}));
+
+        // threads inherit the profile of the thread creating them
+        std::unique_ptr<RealtimeProfile> realtimeProfile;
+        if (!cpuAffinityStr.empty() || !schedFifoStr.empty() || realtimeProfileOptions.lockMemory)
+        {
+            realtimeProfile = std::make_unique<RealtimeProfile>(realtimeProfileOptions);
+            realtimeProfile->ApplyToCurrentThread(RealtimeProfile::ThreadRole::Background);
+        }
+
+        StartupTimeline startupTimeline;
+        // logs until the participant and its logger are created
+        StartupLogger startupLogger;
 
         SilKit::Services::Logging::ILogger* logger;
         SilKit::Services::Orchestration::ILifecycleService* lifecycleService;
         std::promise<void> runningStatePromise;
-
         std::string participantName = "SilKitAdapterTap";
-        const auto participant =
-            CreateParticipant(argc, argv, logger, &participantName, &lifecycleService, &runningStatePromise);
+        // Outlives the TAP connection and the I/O thread, which log through the startup logger and thus through
+        // the logger of the participant once it is attached
+        std::unique_ptr<SilKit::IParticipant> participant;
+
+        // The participant is created, which waits for the registry, while the TAP device is opened and read, so
+        // that the frames the system under test sends meanwhile are queued instead of lost
+        auto participantFuture = std::async(std::launch::async, [&]() {
+            if (realtimeProfile)
+            {
+                realtimeProfile->ApplyToCurrentThread(RealtimeProfile::ThreadRole::SilKit);
+            }
+            auto createdParticipant =
+                CreateParticipant(argc, argv, logger, &participantName, &lifecycleService, &runningStatePromise);
+            startupTimeline.Record("participant created");
+            return createdParticipant;
+        });
+
+        if (!switchPorts.empty())
+        {
+            participant = participantFuture.get();
+            logger->Info("Switch mode: switching between " + std::to_string(switchPorts.size()) + " ports");
+            RunSwitch(participant.get(), logger, lifecycleService, &runningStatePromise, ioContext, switchPorts,
+                      metricsEndpoint, realtimeProfile.get(), readyFilePath);
+            return CodeSuccess;
+        }
+
+        startupLogger.Info("Creating TAP device ethernet connector for [" + tapDevName + "]");
+        TapConnection tapConnection{ioContext, tapDevName, &startupLogger};
+        startupTimeline.Record("TAP device opened");
+
+        PreActivationQueue startupQueue{startupQueueOptions};
+        tapConnection.StartReceiving(
+            [&startupQueue](std::vector<std::uint8_t> frame) { startupQueue.Push(std::move(frame)); });
+
+        if (realtimeProfile)
+        {
+            realtimeProfile->ApplyToCurrentThread(RealtimeProfile::ThreadRole::Io);
+        }
+        std::thread t([&]() -> void { ioContext.run(); });
+        IoThreadGuard ioThreadGuard{ioContext, t};
+        if (realtimeProfile)
+        {
+            realtimeProfile->ApplyToCurrentThread(RealtimeProfile::ThreadRole::Background);
+        }
+
+        participant = participantFuture.get();
+        startupLogger.Attach(logger);
 
         const bool debugActivated = logger->GetLogLevel() < SilKit::Services::Logging::Level::Info;
 
@@ -101,107 +662,221 @@ int main(int argc, char** argv)
             logger->Info("VLAN tagging enabled: injecting 802.1Q VLAN ID " + std::to_string(*vlanId));
         }
 
-        const auto onReceiveEthernetFrameFromTapDevice = [&logger, debugActivated, ethController,
-                                                          vlanId](std::vector<std::uint8_t> data) {
-            if (vlanId.has_value())
-            {
-                data = vlan::InjectVlanTag(std::move(data), *vlanId);
-            }
+        std::unique_ptr<MulticastSnooping> multicastSnooping;
+        if (multicastSnoopingEnabled)
+        {
+            logger->Info("Multicast snooping enabled: forwarding multicast from SIL Kit only for joined groups");
+            multicastSnooping = std::make_unique<MulticastSnooping>(logger);
+        }
 
-            if (data.size() < 60)
-            {
-                data.resize(60, 0);
-            }
-            const auto frameSize = data.size();
-            static intptr_t transmitId = 0;
-            ethController->SendFrame(EthernetFrame{std::move(data)}, reinterpret_cast<void*>(++transmitId));
+        std::unique_ptr<FlowClassifier> flowClassifier;
+        if (flowHashFunction)
+        {
+            logger->Info("Flow classification enabled with the " + flowHashStr + " hash");
+            FlowClassifier::Options flowClassifierOptions;
+            flowClassifierOptions.hashFunction = *flowHashFunction;
+            flowClassifier = std::make_unique<FlowClassifier>(flowClassifierOptions);
+        }
 
-            if (debugActivated)
+        std::unique_ptr<MtuAdaptation> mtuAdaptation;
+        if (mtuAdaptationOptions)
+        {
+            logger->Info("MTU adaptation enabled: fragmenting IPv4 packets larger than "
+                         + std::to_string(mtuAdaptationOptions->mtu) + " bytes towards SIL Kit"
+                         + (mtuAdaptationOptions->clampMss ? ", clamping the TCP MSS" : ""));
+            mtuAdaptation = std::make_unique<MtuAdaptation>(*mtuAdaptationOptions);
+        }
+
+        std::unique_ptr<NeighborProxy> neighborProxy;
+        if (neighborProxyEnabled)
+        {
+            logger->Info("Neighbor proxy enabled: answering ARP and neighbor discovery of the TAP device with "
+                         + std::to_string(neighborProxyStaticBindings.size()) + " static bindings");
+            neighborProxy = std::make_unique<NeighborProxy>(logger);
+            for (const auto& binding : neighborProxyStaticBindings)
             {
-                std::ostringstream SILKitDebugMessage;
-                SILKitDebugMessage << "TAP device >> SIL Kit: Ethernet frame (" << frameSize
-                                   << " bytes, txId=" << transmitId;
-                if (vlanId.has_value())
-                {
-                    SILKitDebugMessage << ", VLAN ID " << *vlanId;
-                }
-                SILKitDebugMessage << ")";
-                logger->Debug(SILKitDebugMessage.str());
+                neighborProxy->AddStaticBinding(binding);
             }
-        };
+        }
 
-        logger->Info("Creating TAP device ethernet connector for [" + tapDevName + "]");
-        TapConnection tapConnection{ioContext, tapDevName, onReceiveEthernetFrameFromTapDevice, logger};
+        std::unique_ptr<LoopSuppression> loopSuppression;
+        if (loopSuppressionEnabled)
+        {
+            logger->Info("Loop suppression enabled: dropping frames which come back within "
+                         + std::to_string(loopSuppressionWindow.count()) + " ms from the side they were sent to");
+            loopSuppression = std::make_unique<LoopSuppression>(logger, loopSuppressionWindow);
+        }
 
-        const auto onReceiveEthernetMessageFromSilKit = [&logger, debugActivated, &tapConnection, vlanId](
-                                                            IEthernetController* /*controller*/,
-                                                            const EthernetFrameEvent& msg) {
-            auto rawFrame = msg.frame.raw;
+        std::unique_ptr<SomeIpStatistics> someIpStatistics;
+        if (!someIpPorts.empty())
+        {
+            logger->Info("SOME/IP statistics enabled on ports " + someIpPortsStr);
+            someIpStatistics = std::make_unique<SomeIpStatistics>(someIpPorts);
+        }
 
-            if (vlanId.has_value())
-            {
-                const auto vid = vlan::ExtractVlanId(rawFrame);
-                if (!vid.has_value() || *vid != *vlanId)
-                    return; // No 802.1Q tag or VLAN ID mismatch, drop frame
+        std::unique_ptr<PipelineLatency> pipelineLatency;
+        if (latencyHistogramsEnabled)
+        {
+            logger->Info("Latency histograms enabled: timestamping every frame at each forwarding stage");
+            pipelineLatency = std::make_unique<PipelineLatency>();
+        }
 
-                auto strippedFrame = vlan::RemoveVlanTag(rawFrame);
-                tapConnection.SendEthernetFrameToTapDevice(strippedFrame);
+        // frames are traced on a background thread, so that debug logging does not slow down forwarding
+        std::unique_ptr<FrameTracer> frameTracer;
+        if (debugActivated)
+        {
+            frameTracer = std::make_unique<FrameTracer>(logger, "TAP device", frameTracerOptions);
+        }
 
-                if (debugActivated)
-                {
-                    std::ostringstream SILKitDebugMessage;
-                    SILKitDebugMessage << "SIL Kit >> TAP device: Ethernet frame (" << rawFrame.size()
-                                       << " bytes, removed VLAN ID " << *vid << ", sent " << strippedFrame.size()
-                                       << " bytes)";
-                    logger->Debug(SILKitDebugMessage.str());
-                }
-            }
-            else
-            {
-                tapConnection.SendEthernetFrameToTapDevice(rawFrame);
+        std::unique_ptr<PcapngCapture> capture;
+        if (!captureOptions.pathPrefix.empty())
+        {
+            logger->Info("Capturing the frames exchanged with SIL Kit to " + captureOptions.pathPrefix + "-*.pcapng");
+            capture = std::make_unique<PcapngCapture>(logger, captureOptions);
+        }
 
-                if (debugActivated)
-                {
-                    std::ostringstream SILKitDebugMessage;
-                    SILKitDebugMessage << "SIL Kit >> TAP device: Ethernet frame (" << rawFrame.size() << " bytes)";
-                    logger->Debug(SILKitDebugMessage.str());
-                }
-            }
-        };
+        std::unique_ptr<FlightRecorder> flightRecorder;
+        if (!flightRecorderOptions.pathPrefix.empty())
+        {
+            logger->Info("Flight recorder enabled: keeping the last " + std::to_string(flightRecorderOptions.slotCount)
+                         + " frames, dumped to " + flightRecorderOptions.pathPrefix + "-*.pcapng");
+            flightRecorder = std::make_unique<FlightRecorder>(ioContext, logger, flightRecorderOptions);
+        }
 
-        ethController->AddFrameHandler(onReceiveEthernetMessageFromSilKit);
+        if (flightRecorder)
+        {
+            // the TAP device is already read on the io_context
+            asio::post(ioContext, [&tapConnection, &flightRecorder]() {
+                tapConnection.SetFatalReadErrorHandler(
+                    [&flightRecorder]() { flightRecorder->RequestDump(FlightRecorder::DumpReason::TapReadError); });
+            });
+        }
 
-        if (debugActivated)
+        ForwardingPipeline::Features pipelineFeatures;
+        pipelineFeatures.vlanId = vlanId;
+        pipelineFeatures.flowClassifier = flowClassifier.get();
+        pipelineFeatures.mtuAdaptation = mtuAdaptation.get();
+        pipelineFeatures.neighborProxy = neighborProxy.get();
+        pipelineFeatures.loopSuppression = loopSuppression.get();
+        pipelineFeatures.multicastSnooping = multicastSnooping.get();
+        pipelineFeatures.someIpStatistics = someIpStatistics.get();
+        pipelineFeatures.pipelineLatency = pipelineLatency.get();
+        pipelineFeatures.frameTracer = frameTracer.get();
+        pipelineFeatures.capture = capture.get();
+        pipelineFeatures.flightRecorder = flightRecorder.get();
+
+        ForwardingPipeline pipeline{
+            pipelineFeatures, tapConnection,
+            [ethController](const std::vector<std::uint8_t>& frame, std::intptr_t transmitId) {
+            ethController->SendFrame(EthernetFrame{frame}, reinterpret_cast<void*>(transmitId));
+        }};
+
+        ethController->AddFrameHandler([&pipeline](IEthernetController* /*controller*/, const EthernetFrameEvent& msg) {
+            pipeline.ForwardToEndpoint(msg.frame.raw);
+        });
+
+        ethController->AddFrameTransmitHandler(
+            [&pipeline](IEthernetController* /*controller*/, const EthernetFrameTransmitEvent& ack) {
+            pipeline.OnTransmitAck(reinterpret_cast<intptr_t>(ack.userContext), ack.status);
+        });
+
+        std::unique_ptr<MetricsServer> metricsServer;
+        if (!metricsEndpoint.empty())
         {
-            const auto onEthAckCallback = [&logger](IEthernetController* /*controller*/,
-                                                    const EthernetFrameTransmitEvent& ack) {
-                std::ostringstream SILKitDebugMessage;
-                if (ack.status == EthernetTransmitStatus::Transmitted)
+            const auto renderMetrics = [&someIpStatistics, &pipelineLatency, &realtimeProfile]() {
+                metrics::OpenMetricsWriter writer;
+                metrics::WriteCounters(writer, metrics::Aggregate());
+                if (realtimeProfile)
                 {
-                    SILKitDebugMessage << "SIL Kit >> TAP device: ACK for ETH Message with transmitId="
-                                       << reinterpret_cast<intptr_t>(ack.userContext);
+                    realtimeProfile->WriteMetrics(writer);
                 }
-                else
+                if (someIpStatistics)
                 {
-                    SILKitDebugMessage << "SIL Kit >> TAP device: NACK for ETH Message with transmitId="
-                                       << reinterpret_cast<intptr_t>(ack.userContext) << ": " << ack.status;
+                    someIpStatistics->WriteMetrics(writer);
                 }
-                logger->Debug(SILKitDebugMessage.str());
+                if (pipelineLatency)
+                {
+                    pipelineLatency->WriteMetrics(writer);
+                }
+                return writer.Finish();
             };
+            metricsServer = std::make_unique<MetricsServer>(ioContext, metricsEndpoint, renderMetrics, logger);
+            if (flightRecorder)
+            {
+                metricsServer->AddCommand("/flight-recorder/dump", [&flightRecorder]() {
+                    flightRecorder->RequestDump(FlightRecorder::DumpReason::Command);
+                    return std::string{"Flight recorder dump requested\n"};
+                });
+            }
+        }
 
-            ethController->AddFrameTransmitHandler(onEthAckCallback);
+        std::unique_ptr<metrics::SummaryLogger> metricsSummaryLogger;
+        if (metricsLogInterval.count() > 0)
+        {
+            metricsSummaryLogger = std::make_unique<metrics::SummaryLogger>(ioContext, metricsLogInterval, logger);
         }
 
+        ReadinessNotifier readinessNotifier{readyFilePath, logger};
+
         // Called during startup
-        lifecycleService->SetCommunicationReadyHandler([&ethController]() { ethController->Activate(); });
+        lifecycleService->SetCommunicationReadyHandler([&]() {
+            ethController->Activate();
+            startupTimeline.Record("communication ready");
+
+            // the queued frames go first, the queue is only used on the io_context
+            asio::post(ioContext, [&]() {
+                startupQueue.Activate(
+                    [&pipeline](std::vector<std::uint8_t> frame) { pipeline.ForwardToSilKit(std::move(frame)); });
+                startupTimeline.Record("forwarding");
+
+                logger->Info("Startup: " + startupTimeline.Describe());
+                const auto queueStatistics = startupQueue.GetStatistics();
+                if (queueStatistics.queuedFrames > 0 || queueStatistics.droppedFull > 0)
+                {
+                    logger->Info("Startup queue: forwarded " + std::to_string(queueStatistics.flushedFrames)
+                                 + " frames from the TAP device which arrived before SIL Kit was ready, dropped "
+                                 + std::to_string(queueStatistics.droppedFull) + " when full and "
+                                 + std::to_string(queueStatistics.droppedExpired) + " expired");
+                }
+                readinessNotifier.NotifyReady("Forwarding between TAP device " + tapDevName
+                                              + " and SIL Kit network " + ethernetNetworkName);
+            });
+        });
 
-        auto finalStateFuture = lifecycleService->StartLifecycle();
+        // after all pools and rings are allocated, so that they are prefaulted
+        if (realtimeProfile)
+        {
+            realtimeProfile->Start(ioContext, logger);
+        }
 
-        std::thread t([&]() -> void { ioContext.run(); });
+        startupTimeline.Record("lifecycle started");
+        auto finalStateFuture = lifecycleService->StartLifecycle();
 
         promptForExit();
 
+        readinessNotifier.NotifyStopping();
         Stop(ioContext, t, *logger, &runningStatePromise, lifecycleService, &finalStateFuture);
+
+        if (realtimeProfile)
+        {
+            realtimeProfile->LogSummary();
+        }
+
+        if (someIpStatistics)
+        {
+            someIpStatistics->LogSummary(logger, 20);
+        }
+
+        if (pipelineLatency)
+        {
+            pipelineLatency->LogSummary(logger);
+        }
+
+        const auto tapStatistics = tapConnection.GetStatistics();
+        std::ostringstream SILKitDebugMessage;
+        SILKitDebugMessage << "TAP device: received " << tapStatistics.receivedFrames << " frames in "
+                           << tapStatistics.receiveBursts << " bursts, sent " << tapStatistics.sentFrames << " frames";
+        logger->Debug(SILKitDebugMessage.str());
     }
     catch (const SilKit::ConfigurationError& error)
     {
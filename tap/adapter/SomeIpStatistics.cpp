@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "SomeIpStatistics.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "Enums.hpp"
+#include "PacketView.hpp"
+
+using namespace adapters;
+
+namespace {
+
+// bit 40 marks a slot as used, so that service 0 / method 0 / request is distinguishable from an empty slot
+constexpr std::uint64_t usedKeyBit = std::uint64_t(1) << 40u;
+
+auto MakeKey(const demo::SomeIpView& someIp) -> std::uint64_t
+{
+    return usedKeyBit | (std::uint64_t(someIp.GetServiceId()) << 24u) | (std::uint64_t(someIp.GetMethodId()) << 8u)
+           | demo::ToUnderlying(someIp.GetMessageType());
+}
+
+// single writer increment, avoids the locked read-modify-write of fetch_add
+void Increment(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+} // namespace
+
+SomeIpStatistics::SomeIpStatistics(const std::vector<std::uint16_t>& ports)
+{
+    for (const auto port : ports)
+    {
+        _ports.set(port);
+    }
+
+    for (auto& table : _tables)
+    {
+        table = std::make_unique<Slot[]>(slotCount);
+    }
+}
+
+void SomeIpStatistics::CountFrame(Direction direction, asio::const_buffer frame)
+{
+    // the flow extraction never throws on truncated or malformed frames
+    if (const auto flow = demo::ExtractFlow(frame))
+    {
+        CountFrame(direction, frame, *flow);
+    }
+}
+
+void SomeIpStatistics::CountFrame(Direction direction, asio::const_buffer frame, const demo::Flow& flow)
+{
+    const bool isTransport = flow.key.protocol == demo::ToUnderlying(demo::Ip4Protocol::UDP)
+                             || flow.key.protocol == demo::ToUnderlying(demo::Ip4Protocol::TCP);
+    // later fragments have no ports
+    if (!isTransport || !flow.key.HasPorts()
+        || !(_ports.test(flow.key.sourcePort) || _ports.test(flow.key.destinationPort)))
+    {
+        return;
+    }
+
+    CountMessages(direction, flow.GetPayload(frame));
+}
+
+void SomeIpStatistics::CountMessages(Direction direction, asio::const_buffer transportPayload)
+{
+    // several SOME/IP messages may be packed into one datagram or segment. TCP segments which do not start
+    // with a SOME/IP header (continuations of a segmented message) fail the header validation and are skipped.
+    for (auto someIp = demo::SomeIpView::Parse(transportPayload); someIp;
+         someIp = demo::SomeIpView::Parse(transportPayload))
+    {
+        CountMessage(direction, someIp);
+
+        if (transportPayload.size() < someIp.GetMessageSize())
+        {
+            break;
+        }
+        transportPayload += someIp.GetMessageSize();
+    }
+}
+
+void SomeIpStatistics::CountMessage(Direction direction, const demo::SomeIpView& someIp)
+{
+    const auto key = MakeKey(someIp);
+    Slot* const table = _tables[ToIndex(direction)].get();
+
+    auto slotIndex = static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 52u) & (slotCount - 1);
+    for (std::size_t probe = 0; probe < slotCount; ++probe)
+    {
+        Slot& slot = table[slotIndex];
+        const auto slotKey = slot.key.load(std::memory_order_relaxed);
+        if (slotKey == key)
+        {
+            Increment(slot.messages, 1);
+            Increment(slot.bytes, someIp.GetMessageSize());
+            return;
+        }
+        if (slotKey == 0)
+        {
+            slot.messages.store(1, std::memory_order_relaxed);
+            slot.bytes.store(someIp.GetMessageSize(), std::memory_order_relaxed);
+            // publish the counters together with the key to readers
+            slot.key.store(key, std::memory_order_release);
+            return;
+        }
+        slotIndex = (slotIndex + 1) & (slotCount - 1);
+    }
+
+    Increment(_untrackedMessages[ToIndex(direction)], 1);
+}
+
+auto SomeIpStatistics::Snapshot() const -> std::vector<Entry>
+{
+    std::vector<Entry> entries;
+    for (std::size_t directionIndex = 0; directionIndex < directionCount; ++directionIndex)
+    {
+        const Slot* const table = _tables[directionIndex].get();
+        for (std::size_t slotIndex = 0; slotIndex < slotCount; ++slotIndex)
+        {
+            const auto key = table[slotIndex].key.load(std::memory_order_acquire);
+            if (key == 0)
+            {
+                continue;
+            }
+
+            entries.push_back(Entry{
+                static_cast<Direction>(directionIndex),
+                static_cast<std::uint16_t>(key >> 24u),
+                static_cast<std::uint16_t>(key >> 8u),
+                static_cast<demo::SomeIpMessageType>(key & 0xFF),
+                table[slotIndex].messages.load(std::memory_order_relaxed),
+                table[slotIndex].bytes.load(std::memory_order_relaxed),
+            });
+        }
+    }
+    return entries;
+}
+
+auto SomeIpStatistics::GetUntrackedMessageCount(Direction direction) const -> std::uint64_t
+{
+    return _untrackedMessages[ToIndex(direction)].load(std::memory_order_relaxed);
+}
+
+void SomeIpStatistics::LogSummary(SilKit::Services::Logging::ILogger* logger, std::size_t entryCount) const
+{
+    auto entries = Snapshot();
+    if (entries.empty())
+    {
+        logger->Info("SOME/IP statistics: no messages seen");
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.bytes > rhs.bytes; });
+    entries.resize(std::min(entries.size(), entryCount));
+
+    for (const auto& entry : entries)
+    {
+        std::ostringstream SILKitInfoMessage;
+        SILKitInfoMessage << "SOME/IP statistics (" << ToString(entry.direction) << "): service 0x" << std::hex
+                          << std::setw(4) << std::setfill('0') << entry.serviceId << " method 0x" << std::setw(4)
+                          << entry.methodId << std::dec << " " << entry.messageType << ": " << entry.messages
+                          << " messages, " << entry.bytes << " bytes";
+        logger->Info(SILKitInfoMessage.str());
+    }
+}
+
+void SomeIpStatistics::WriteMetrics(metrics::OpenMetricsWriter& writer) const
+{
+    const auto entries = Snapshot();
+
+    std::vector<std::string> labels;
+    labels.reserve(entries.size());
+    for (const auto& entry : entries)
+    {
+        std::ostringstream labelStream;
+        labelStream << "direction=\"" << ToString(entry.direction) << "\",service=\"0x" << std::hex << std::setfill('0')
+                    << std::setw(4) << entry.serviceId << "\",method=\"0x" << std::setw(4) << entry.methodId
+                    << "\",message_type=\"0x" << std::setw(2) << +demo::ToUnderlying(entry.messageType) << "\"";
+        labels.push_back(labelStream.str());
+    }
+
+    writer.Family("someip_messages", "counter", "SOME/IP messages per direction, service, method and message type.");
+    for (std::size_t entryIndex = 0; entryIndex < entries.size(); ++entryIndex)
+    {
+        writer.Sample("_total", labels[entryIndex], entries[entryIndex].messages);
+    }
+
+    writer.Family("someip_bytes", "counter", "SOME/IP message bytes per direction, service, method and message type.");
+    for (std::size_t entryIndex = 0; entryIndex < entries.size(); ++entryIndex)
+    {
+        writer.Sample("_total", labels[entryIndex], entries[entryIndex].bytes);
+    }
+
+    writer.Family("someip_untracked_messages", "counter", "SOME/IP messages not counted because the table is full.");
+    for (std::size_t directionIndex = 0; directionIndex < directionCount; ++directionIndex)
+    {
+        const auto direction = static_cast<Direction>(directionIndex);
+        writer.Sample("_total", std::string{"direction=\""} + ToString(direction) + "\"",
+                      GetUntrackedMessageCount(direction));
+    }
+}
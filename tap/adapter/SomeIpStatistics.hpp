@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Direction.hpp"
+#include "Metrics.hpp"
+#include "FlowKey.hpp"
+#include "PacketView.hpp"
+#include "SomeIpHeader.hpp"
+
+#include "asio/ts/buffer.hpp"
+
+#include "silkit/services/logging/all.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// Per-service, per-method and per-message-type SOME/IP traffic counters.
+///
+///   SOME/IP messages are decoded from UDP datagrams and TCP segments on the configured ports.
+///   The counters live in a fixed-size open addressing table per direction, which is only
+///   written by the thread forwarding that direction, so counting does not need any lock.
+/// </summary>
+class SomeIpStatistics
+{
+public:
+    struct Entry
+    {
+        Direction direction;
+        std::uint16_t serviceId;
+        std::uint16_t methodId;
+        demo::SomeIpMessageType messageType;
+        std::uint64_t messages;
+        std::uint64_t bytes;
+    };
+
+    explicit SomeIpStatistics(const std::vector<std::uint16_t>& ports);
+
+    /// <summary>
+    /// Counts the SOME/IP messages contained in the frame. Must always be called from the same thread
+    /// for a given direction.
+    /// </summary>
+    void CountFrame(Direction direction, asio::const_buffer frame);
+
+    /// <summary>
+    /// Counts the SOME/IP messages of a frame the FlowClassifier already classified, without parsing its
+    /// Ethernet, IP and transport headers again.
+    /// </summary>
+    void CountFrame(Direction direction, asio::const_buffer frame, const demo::Flow& flow);
+
+    /// <summary>
+    /// Returns the current counters of all (direction, service, method, message type) combinations seen.
+    /// </summary>
+    auto Snapshot() const -> std::vector<Entry>;
+
+    /// <summary>
+    /// Number of messages which could not be counted because the table of a direction is full.
+    /// </summary>
+    auto GetUntrackedMessageCount(Direction direction) const -> std::uint64_t;
+
+    /// <summary>
+    /// Logs the entries with the most bytes.
+    /// </summary>
+    void LogSummary(SilKit::Services::Logging::ILogger* logger, std::size_t entryCount) const;
+
+    /// <summary>
+    /// Writes the message and byte counters of all entries as OpenMetrics families.
+    /// </summary>
+    void WriteMetrics(metrics::OpenMetricsWriter& writer) const;
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> key{0};
+        std::atomic<std::uint64_t> messages{0};
+        std::atomic<std::uint64_t> bytes{0};
+    };
+
+    // must be a power of two
+    static constexpr std::size_t slotCount = 4096;
+
+    void CountMessages(Direction direction, asio::const_buffer transportPayload);
+    void CountMessage(Direction direction, const demo::SomeIpView& someIp);
+
+    std::bitset<65536> _ports;
+    std::array<std::unique_ptr<Slot[]>, directionCount> _tables;
+    std::array<std::atomic<std::uint64_t>, directionCount> _untrackedMessages{};
+};
+
+} // namespace adapters
@@ -0,0 +1,321 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "Startup.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+
+#include "Metrics.hpp"
+
+#if defined(__linux__)
+#include <cstddef>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace adapters;
+using namespace std::chrono;
+
+namespace {
+
+auto ToString(SilKit::Services::Logging::Level level) -> const char*
+{
+    using Level = SilKit::Services::Logging::Level;
+    switch (level)
+    {
+    case Level::Trace:
+        return "trace";
+    case Level::Debug:
+        return "debug";
+    case Level::Info:
+        return "info";
+    case Level::Warn:
+        return "warn";
+    case Level::Error:
+        return "error";
+    case Level::Critical:
+        return "critical";
+    default:
+        return "off";
+    }
+}
+
+// Sends a message of the sd_notify protocol to the service manager, nothing if the adapter was not started by one
+auto SendToServiceManager(const std::string& message) -> std::error_code
+{
+#if defined(__linux__)
+    const char* socketPath = std::getenv("NOTIFY_SOCKET");
+    if (socketPath == nullptr || socketPath[0] == '\0')
+    {
+        return {};
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    const auto pathLength = std::strlen(socketPath);
+    if ((socketPath[0] != '/' && socketPath[0] != '@') || pathLength >= sizeof(address.sun_path))
+    {
+        return std::make_error_code(std::errc::invalid_argument);
+    }
+    std::memcpy(address.sun_path, socketPath, pathLength);
+    if (address.sun_path[0] == '@')
+    {
+        // a socket in the abstract namespace
+        address.sun_path[0] = '\0';
+    }
+
+    const int socketDescriptor = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (socketDescriptor < 0)
+    {
+        return std::error_code{errno, std::generic_category()};
+    }
+    const auto addressLength = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + pathLength);
+    std::error_code error;
+    if (::sendto(socketDescriptor, message.data(), message.size(), MSG_NOSIGNAL,
+                 reinterpret_cast<const sockaddr*>(&address), addressLength)
+        < 0)
+    {
+        error = std::error_code{errno, std::generic_category()};
+    }
+    ::close(socketDescriptor);
+    return error;
+#else
+    (void)message;
+    return {};
+#endif
+}
+
+} // namespace
+
+StartupLogger::~StartupLogger()
+{
+    for (const auto& message : _messages)
+    {
+        std::cerr << "[" << ToString(message.first) << "] " << message.second << std::endl;
+    }
+}
+
+void StartupLogger::Attach(SilKit::Services::Logging::ILogger* logger)
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+    for (const auto& message : _messages)
+    {
+        logger->Log(message.first, message.second);
+    }
+    _messages.clear();
+    _messages.shrink_to_fit();
+    _logger.store(logger);
+}
+
+void StartupLogger::Log(Level level, const std::string& msg)
+{
+    if (auto* logger = _logger.load())
+    {
+        logger->Log(level, msg);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    // attached while waiting for the lock
+    if (auto* logger = _logger.load())
+    {
+        logger->Log(level, msg);
+        return;
+    }
+    _messages.emplace_back(level, msg);
+}
+
+void StartupLogger::Trace(const std::string& msg)
+{
+    Log(Level::Trace, msg);
+}
+
+void StartupLogger::Debug(const std::string& msg)
+{
+    Log(Level::Debug, msg);
+}
+
+void StartupLogger::Info(const std::string& msg)
+{
+    Log(Level::Info, msg);
+}
+
+void StartupLogger::Warn(const std::string& msg)
+{
+    Log(Level::Warn, msg);
+}
+
+void StartupLogger::Error(const std::string& msg)
+{
+    Log(Level::Error, msg);
+}
+
+void StartupLogger::Critical(const std::string& msg)
+{
+    Log(Level::Critical, msg);
+}
+
+auto StartupLogger::GetLogLevel() const -> Level
+{
+    const auto* logger = _logger.load();
+    return logger ? logger->GetLogLevel() : Level::Trace;
+}
+
+constexpr std::size_t PreActivationQueue::defaultMaxFrames;
+constexpr std::chrono::milliseconds PreActivationQueue::defaultMaxAge;
+constexpr std::size_t PreActivationQueue::maxFramesLimit;
+constexpr std::chrono::milliseconds PreActivationQueue::maxAgeLimit;
+
+PreActivationQueue::PreActivationQueue(Options options)
+    : _options{options}
+{
+}
+
+void PreActivationQueue::Push(std::vector<std::uint8_t> frame)
+{
+    if (_handler)
+    {
+        _handler(std::move(frame));
+        return;
+    }
+
+    const auto now = Clock::now();
+    DropExpired(now);
+    if (_options.maxFrames == 0)
+    {
+        ++_statistics.droppedFull;
+        metrics::Increment(metrics::Counter::DropsTapToSilKitStartupQueueFull);
+        return;
+    }
+    if (_frames.size() == _options.maxFrames)
+    {
+        _frames.pop_front();
+        ++_statistics.droppedFull;
+        metrics::Increment(metrics::Counter::DropsTapToSilKitStartupQueueFull);
+    }
+    _frames.push_back(QueuedFrame{now, std::move(frame)});
+    ++_statistics.queuedFrames;
+    metrics::Increment(metrics::Counter::StartupQueuedFrames);
+}
+
+void PreActivationQueue::Activate(FrameEndpoint::FrameHandler handler)
+{
+    DropExpired(Clock::now());
+    _handler = std::move(handler);
+    while (!_frames.empty())
+    {
+        auto frame = std::move(_frames.front().frame);
+        _frames.pop_front();
+        ++_statistics.flushedFrames;
+        _handler(std::move(frame));
+    }
+    _frames.shrink_to_fit();
+}
+
+void PreActivationQueue::DropExpired(Clock::time_point now)
+{
+    while (!_frames.empty() && now - _frames.front().arrival > _options.maxAge)
+    {
+        _frames.pop_front();
+        ++_statistics.droppedExpired;
+        metrics::Increment(metrics::Counter::DropsTapToSilKitStartupQueueExpired);
+    }
+}
+
+StartupTimeline::StartupTimeline()
+    : _start{Clock::now()}
+{
+}
+
+void StartupTimeline::Record(const std::string& step)
+{
+    const auto elapsed = Clock::now() - _start;
+    std::lock_guard<std::mutex> lock{_mutex};
+    _steps.emplace_back(step, elapsed);
+}
+
+auto StartupTimeline::Describe() const -> std::string
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+    std::string description;
+    for (const auto& step : _steps)
+    {
+        description += (description.empty() ? "" : ", ") + step.first + " after "
+                       + std::to_string(duration_cast<milliseconds>(step.second).count()) + " ms";
+    }
+    return description;
+}
+
+ReadinessNotifier::ReadinessNotifier(std::string readyFilePath, SilKit::Services::Logging::ILogger* logger)
+    : _readyFilePath{std::move(readyFilePath)}
+    , _logger{logger}
+{
+}
+
+ReadinessNotifier::~ReadinessNotifier()
+{
+    if (_readyFileWritten)
+    {
+        std::remove(_readyFilePath.c_str());
+    }
+}
+
+void ReadinessNotifier::NotifyReady(const std::string& status)
+{
+    Notify("READY=1\nSTATUS=" + status);
+
+    if (_readyFilePath.empty())
+    {
+        return;
+    }
+
+    // written next to the ready file and renamed, so that a watcher never sees a partial file
+    const auto temporaryPath = _readyFilePath + ".tmp";
+    {
+        std::ofstream file{temporaryPath, std::ios::trunc};
+        file << status << "\n";
+        if (!file)
+        {
+            _logger->Warn("Cannot write the ready file " + temporaryPath + ": " + std::strerror(errno));
+            return;
+        }
+    }
+#if WIN32
+    // rename does not replace an existing file on Windows
+    std::remove(_readyFilePath.c_str());
+#endif
+    if (std::rename(temporaryPath.c_str(), _readyFilePath.c_str()) != 0)
+    {
+        _logger->Warn("Cannot write the ready file " + _readyFilePath + ": " + std::strerror(errno));
+        std::remove(temporaryPath.c_str());
+        return;
+    }
+    _readyFileWritten = true;
+}
+
+void ReadinessNotifier::NotifyStopping()
+{
+    Notify("STOPPING=1");
+
+    if (_readyFileWritten)
+    {
+        std::remove(_readyFilePath.c_str());
+        _readyFileWritten = false;
+    }
+}
+
+void ReadinessNotifier::Notify(const std::string& message)
+{
+    const auto error = SendToServiceManager(message);
+    if (error)
+    {
+        _logger->Warn("Cannot notify the service manager: " + error.message());
+    }
+}
@@ -0,0 +1,179 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FrameEndpoint.hpp"
+
+#include "silkit/services/logging/all.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// Logger for the startup, while the participant, which owns the logger of the adapter, is created in
+/// parallel. Messages are kept until the logger of the participant is attached and forwarded to it afterwards.
+/// If it is never attached, the messages are written to stderr when the startup logger is destroyed.
+/// </summary>
+class StartupLogger : public SilKit::Services::Logging::ILogger
+{
+public:
+    using Level = SilKit::Services::Logging::Level;
+
+    ~StartupLogger() override;
+
+    /// <summary>
+    /// Forwards the kept messages and all later ones to logger. May be called from any thread.
+    /// </summary>
+    void Attach(SilKit::Services::Logging::ILogger* logger);
+
+    void Log(Level level, const std::string& msg) override;
+    void Trace(const std::string& msg) override;
+    void Debug(const std::string& msg) override;
+    void Info(const std::string& msg) override;
+    void Warn(const std::string& msg) override;
+    void Error(const std::string& msg) override;
+    void Critical(const std::string& msg) override;
+    // Trace until the logger is attached, so that no message is filtered before its level is known
+    auto GetLogLevel() const -> Level override;
+
+private:
+    std::atomic<SilKit::Services::Logging::ILogger*> _logger{nullptr};
+    std::mutex _mutex;
+    std::vector<std::pair<Level, std::string>> _messages;
+};
+
+/// <summary>
+/// Frames from the TAP device which arrive before the Ethernet controller of SIL Kit is active. SIL Kit would
+/// not transmit them, so they are queued and handed to the forwarding when the controller is activated.
+///
+///   The queue is bounded: when maxFrames are queued, the oldest frame is dropped for the new one, and frames
+///   older than maxAge are dropped, since the protocols of the system under test retransmit them by then
+///   anyway. After the activation frames pass straight through. Only used on the io_context.
+/// </summary>
+class PreActivationQueue
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t defaultMaxFrames = 1024;
+    static constexpr std::chrono::milliseconds defaultMaxAge{5000};
+    // bounds of the options, a queue of full-size frames holds up to 64 MiB
+    static constexpr std::size_t maxFramesLimit = 65536;
+    static constexpr std::chrono::milliseconds maxAgeLimit{60000};
+
+    struct Options
+    {
+        // 0 drops all frames before the activation
+        std::size_t maxFrames = defaultMaxFrames;
+        Clock::duration maxAge = defaultMaxAge;
+    };
+
+    struct Statistics
+    {
+        std::uint64_t queuedFrames;
+        std::uint64_t flushedFrames;
+        std::uint64_t droppedFull;
+        std::uint64_t droppedExpired;
+    };
+
+    explicit PreActivationQueue(Options options);
+
+    /// <summary>
+    /// Hands the frame to the handler once activated, queues it before.
+    /// </summary>
+    void Push(std::vector<std::uint8_t> frame);
+
+    /// <summary>
+    /// Hands the queued frames which are not older than maxAge to the handler, in the order they arrived,
+    /// and all following frames directly.
+    /// </summary>
+    void Activate(FrameEndpoint::FrameHandler handler);
+
+    auto GetStatistics() const -> Statistics
+    {
+        return _statistics;
+    }
+
+private:
+    struct QueuedFrame
+    {
+        Clock::time_point arrival;
+        std::vector<std::uint8_t> frame;
+    };
+
+    void DropExpired(Clock::time_point now);
+
+    Options _options;
+    FrameEndpoint::FrameHandler _handler;
+    std::deque<QueuedFrame> _frames;
+    Statistics _statistics{};
+};
+
+/// <summary>
+/// Timeline of the startup, the time after which each step was completed. Steps may run in parallel and are
+/// recorded from any thread.
+/// </summary>
+class StartupTimeline
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    StartupTimeline();
+
+    void Record(const std::string& step);
+
+    /// <summary>
+    /// Describes the steps in the order they were completed, e.g. "TAP device opened after 2 ms, participant
+    /// created after 812 ms".
+    /// </summary>
+    auto Describe() const -> std::string;
+
+private:
+    const Clock::time_point _start;
+    mutable std::mutex _mutex;
+    std::vector<std::pair<std::string, Clock::duration>> _steps;
+};
+
+/// <summary>
+/// Tells others that the adapter forwards frames: the service manager with the sd_notify protocol, if the
+/// adapter runs as a systemd service of Type=notify (NOTIFY_SOCKET is set), and a ready file, if a path is
+/// given. The ready file is written atomically and removed when the adapter stops. Failures are logged as
+/// warnings, forwarding does not depend on them.
+/// </summary>
+class ReadinessNotifier
+{
+public:
+    ReadinessNotifier(std::string readyFilePath, SilKit::Services::Logging::ILogger* logger);
+    ~ReadinessNotifier();
+
+    ReadinessNotifier(const ReadinessNotifier&) = delete;
+    ReadinessNotifier& operator=(const ReadinessNotifier&) = delete;
+
+    /// <summary>
+    /// Notifies the readiness, status is a human readable line for the service manager and the ready file.
+    /// </summary>
+    void NotifyReady(const std::string& status);
+
+    /// <summary>
+    /// Notifies the service manager that the adapter stops and removes the ready file.
+    /// </summary>
+    void NotifyStopping();
+
+private:
+    void Notify(const std::string& message);
+
+    const std::string _readyFilePath;
+    SilKit::Services::Logging::ILogger* _logger;
+    bool _readyFileWritten{false};
+};
+
+} // namespace adapters
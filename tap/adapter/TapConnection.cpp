@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "TapConnection.hpp"
+#include "Tracepoints.hpp"
 
 #if defined(__QNX__)
 #include <net/if.h>
@@ -39,10 +40,8 @@ bool IsFatalReadError(const std::error_code& ec)
 } // namespace
 
 TapConnection::TapConnection(asio::io_context& io_context, const std::string& tapDevName,
-                             std::function<void(std::vector<std::uint8_t>)> onNewFrameHandler,
                              SilKit::Services::Logging::ILogger* logger)
     : _tapDeviceStream{io_context}
-    , _onNewFrameHandler(std::move(onNewFrameHandler))
     , _logger(logger)
 {
     _fileDescriptor = GetTapDeviceFileDescriptor(tapDevName.c_str());
@@ -52,9 +51,56 @@ TapConnection::TapConnection(asio::io_context& io_context, const std::string& ta
     throwInvalidFileDescriptorIf(_fileDescriptor < 0);
 #endif
     _tapDeviceStream.assign(_fileDescriptor);
+#if !WIN32
+    // lets DrainReadyFrames read without blocking, the synchronous writes of asio still wait for the device
+    _tapDeviceStream.native_non_blocking(true);
+#endif
+}
+
+void TapConnection::StartReceiving(FrameHandler onNewFrameHandler)
+{
+    _onNewFrameHandler = std::move(onNewFrameHandler);
     ReceiveEthernetFrameFromTapDevice();
 }
 
+void TapConnection::SendSegments(const demo::FrameBuilder& frame)
+{
+#if WIN32
+    // a stream handle writes only the first buffer of a sequence, the frame is joined instead
+    thread_local std::vector<std::uint8_t> flattenedFrame;
+    frame.FlattenTo(flattenedFrame);
+    Send(flattenedFrame.data(), flattenedFrame.size());
+#else
+    // one writev, the TAP device takes the gather list as one frame
+    std::size_t sizeSent = 0;
+    try
+    {
+        sizeSent = _tapDeviceStream.write_some(frame);
+    }
+    catch (...)
+    {
+        CountTapWriteError();
+        throw;
+    }
+    if (frame.GetSize() != sizeSent)
+    {
+        CountTapWriteError();
+        throw adapters::InvalidFrameSizeError{};
+    }
+    _sentFrames.fetch_add(1, std::memory_order_relaxed);
+    _sentBytes.fetch_add(frame.GetSize(), std::memory_order_relaxed);
+#endif
+}
+
+auto TapConnection::GetStatistics() const -> Statistics
+{
+    return Statistics{
+        _receivedFrames.load(std::memory_order_relaxed), _receivedBytes.load(std::memory_order_relaxed),
+        _receiveBursts.load(std::memory_order_relaxed),  _sentFrames.load(std::memory_order_relaxed),
+        _sentBytes.load(std::memory_order_relaxed),
+    };
+}
+
 void TapConnection::ReceiveEthernetFrameFromTapDevice()
 {
     _tapDeviceStream.async_read_some(asio::buffer(_ethernetFrameBuffer.data(), _ethernetFrameBuffer.size()),
@@ -74,22 +120,24 @@ void TapConnection::ReceiveEthernetFrameFromTapDevice()
                                                  "Error category: " + ec.category().name();
                 // clang-format on
                 _logger->Error(SILKitErrorMessage);
+                metrics::Increment(metrics::Counter::TapReadErrors);
 
                 // do not read again, as this would busy-loop and flood the log with the same error
                 if (IsFatalReadError(ec))
                 {
                     _logger->Error("TAP device descriptor is no longer usable. Stopping reception from TAP device.");
+                    if (_onFatalReadErrorHandler)
+                    {
+                        _onFatalReadErrorHandler();
+                    }
                     return;
                 }
             }
             else
             {
-                auto frame_data = std::vector<std::uint8_t>(bytes_received);
-                asio::buffer_copy(asio::buffer(frame_data),
-                                  asio::buffer(_ethernetFrameBuffer.data(), _ethernetFrameBuffer.size()),
-                                  bytes_received);
-
-                _onNewFrameHandler(std::move(frame_data));
+                _receiveBursts.fetch_add(1, std::memory_order_relaxed);
+                DeliverFrame(bytes_received);
+                DrainReadyFrames();
             }
         }
         catch (const std::exception& ex)
@@ -97,6 +145,7 @@ void TapConnection::ReceiveEthernetFrameFromTapDevice()
             // Handle any exception that might occur
             std::string SILKitErrorMessage = "Exception occurred: " + std::string(ex.what());
             _logger->Error(SILKitErrorMessage);
+            metrics::Increment(metrics::Counter::DropsTapToSilKitProcessingError);
         }
         // Continue with the next read
 
@@ -104,6 +153,37 @@ void TapConnection::ReceiveEthernetFrameFromTapDevice()
     });
 }
 
+void TapConnection::DeliverFrame(std::size_t frameSize)
+{
+    TAP_ADAPTER_PROBE1(tap_read, frameSize);
+    _receivedFrames.fetch_add(1, std::memory_order_relaxed);
+    _receivedBytes.fetch_add(frameSize, std::memory_order_relaxed);
+
+    auto frame_data = std::vector<std::uint8_t>(frameSize);
+    asio::buffer_copy(asio::buffer(frame_data), asio::buffer(_ethernetFrameBuffer.data(), _ethernetFrameBuffer.size()),
+                      frameSize);
+
+    _onNewFrameHandler(std::move(frame_data));
+}
+
+void TapConnection::DrainReadyFrames()
+{
+#if !WIN32
+    // Under load several frames are queued when a read completes. Reading them right away saves a round
+    // trip through the reactor per frame.
+    for (std::size_t frameCount = 1; frameCount < maxReceiveBurst; ++frameCount)
+    {
+        const auto bytesReceived = ::read(_fileDescriptor, _ethernetFrameBuffer.data(), _ethernetFrameBuffer.size());
+        if (bytesReceived <= 0)
+        {
+            // nothing ready (EAGAIN), errors are reported by the next asynchronous read
+            return;
+        }
+        DeliverFrame(static_cast<std::size_t>(bytesReceived));
+    }
+#endif
+}
+
 #if WIN32
 TapConnection::~TapConnection()
 {
@@ -3,11 +3,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <cstdint>
 
 #include "Exceptions.hpp"
+#include "FrameEndpoint.hpp"
+#include "Metrics.hpp"
 
 #include "asio/ts/buffer.hpp"
 #include "asio/ts/io_context.hpp"
@@ -23,29 +26,66 @@
 #include "asio/posix/stream_descriptor.hpp"
 #endif
 
-class TapConnection
+class TapConnection : public adapters::FrameEndpoint
 {
 public:
     TapConnection(asio::io_context& io_context, const std::string& tapDevName,
-                  std::function<void(std::vector<std::uint8_t>)> onNewFrameHandler,
                   SilKit::Services::Logging::ILogger* logger);
 
-    template <class container>
-    auto SendEthernetFrameToTapDevice(const container& data)
+    void StartReceiving(FrameHandler onNewFrameHandler) override;
+
+    /// <summary>
+    /// Sets a handler which is called on the io_context when reading from the TAP device failed for good.
+    /// </summary>
+    void SetFatalReadErrorHandler(std::function<void()> handler) override
+    {
+        _onFatalReadErrorHandler = std::move(handler);
+    }
+
+    void Send(const std::uint8_t* frame, std::size_t frameSize) override
     {
-        auto sizeSent = _tapDeviceStream.write_some(asio::buffer(data.data(), data.size()));
-        if (data.size() != sizeSent)
+        std::size_t sizeSent = 0;
+        try
+        {
+            sizeSent = _tapDeviceStream.write_some(asio::buffer(frame, frameSize));
+        }
+        catch (...)
+        {
+            CountTapWriteError();
+            throw;
+        }
+        if (frameSize != sizeSent)
         {
+            CountTapWriteError();
             throw adapters::InvalidFrameSizeError{};
         }
+        _sentFrames.fetch_add(1, std::memory_order_relaxed);
+        _sentBytes.fetch_add(frameSize, std::memory_order_relaxed);
     }
 
+    void SendSegments(const demo::FrameBuilder& frame) override;
+
+    auto GetStatistics() const -> Statistics override;
+
 private:
+    // frames read without waiting after a completed read, before the reactor is asked again
+    static constexpr std::size_t maxReceiveBurst = 32;
+
     std::array<std::uint8_t, 70000> _ethernetFrameBuffer;
-    std::function<void(std::vector<std::uint8_t>)> _onNewFrameHandler;
+    FrameHandler _onNewFrameHandler;
+    std::function<void()> _onFatalReadErrorHandler;
     SilKit::Services::Logging::ILogger* _logger;
 
+    std::atomic<std::uint64_t> _receivedFrames{0};
+    std::atomic<std::uint64_t> _receivedBytes{0};
+    std::atomic<std::uint64_t> _receiveBursts{0};
+    std::atomic<std::uint64_t> _sentFrames{0};
+    std::atomic<std::uint64_t> _sentBytes{0};
+
     void ReceiveEthernetFrameFromTapDevice();
+    void DeliverFrame(std::size_t frameSize);
+    void DrainReadyFrames();
+    inline void CountTapWriteError();
     inline auto extractErrorMessage(const int errorCode) -> std::string;
 
 #if WIN32
@@ -92,6 +132,12 @@ private:
 ////////////////////////////
 // Inline implementations //
 ////////////////////////////
+void TapConnection::CountTapWriteError()
+{
+    adapters::metrics::Increment(adapters::metrics::Counter::TapWriteErrors);
+    adapters::metrics::Increment(adapters::metrics::Counter::DropsSilKitToTapTapWriteError);
+}
+
 auto TapConnection::extractErrorMessage(const int errorCode) -> std::string
 {
 #ifdef WIN32
@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// USDT (user statically defined tracing) probes of the forwarding pipeline, provider "sil_kit_adapter_tap".
+// With <sys/sdt.h> (systemtap-sdt-dev) available, every probe compiles to a single nop instruction which
+// bpftrace, perf or SystemTap can patch at runtime. Otherwise the probes compile to nothing.
+//
+//   probe name          arguments
+//   tap_read            frame size
+//   send_frame          transmit id, frame size
+//   transmit_ack        transmit id, transmit status
+//   silkit_frame        frame size
+//   tap_write           frame size
+//   frame_dropped       direction, reason (metrics::Counter)
+
+#if defined(__has_include) && !defined(SILKIT_ADAPTER_TAP_DISABLE_USDT)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define SILKIT_ADAPTER_TAP_HAS_USDT 1
+#endif
+#endif
+
+#if defined(SILKIT_ADAPTER_TAP_HAS_USDT)
+#define TAP_ADAPTER_PROBE1(name, arg1) DTRACE_PROBE1(sil_kit_adapter_tap, name, arg1)
+#define TAP_ADAPTER_PROBE2(name, arg1, arg2) DTRACE_PROBE2(sil_kit_adapter_tap, name, arg1, arg2)
+#else
+#define TAP_ADAPTER_PROBE1(name, arg1) ((void)0)
+#define TAP_ADAPTER_PROBE2(name, arg1, arg2) ((void)0)
+#endif
@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+// The replaced global allocation functions live in a translation unit of their own: where GCC sees a new
+// expression and the inlined free of the replaced operator delete together, it reports -Wmismatched-new-delete.
+
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+
+std::atomic<bool> countAllocations{false};
+std::atomic<std::uint64_t> allocationCount{0};
+std::atomic<std::uint64_t> allocatedBytes{0};
+
+void Count(std::size_t size)
+{
+    if (countAllocations.load(std::memory_order_relaxed))
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+}
+
+auto CountedAllocate(std::size_t size) -> void*
+{
+    Count(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+auto CountedAllocateAligned(std::size_t size, std::align_val_t alignment) -> void*
+{
+    Count(size);
+    const auto align = static_cast<std::size_t>(alignment);
+#if WIN32
+    // the CRT of MSVC has no aligned_alloc, its aligned blocks are freed with _aligned_free
+    return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    // aligned_alloc requires a size which is a multiple of the alignment
+    return std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+}
+
+void FreeAligned(void* memory)
+{
+#if WIN32
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+} // namespace
+
+namespace adapters {
+
+void StartCountingAllocations()
+{
+    allocationCount = 0;
+    allocatedBytes = 0;
+    countAllocations = true;
+}
+
+auto StopCountingAllocations() -> AllocationCount
+{
+    countAllocations = false;
+    return AllocationCount{allocationCount.load(), allocatedBytes.load()};
+}
+
+} // namespace adapters
+
+// The replaced global allocation functions, all forms end up in CountedAllocate or CountedAllocateAligned.
+void* operator new(std::size_t size)
+{
+    if (auto* memory = CountedAllocate(size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (auto* memory = CountedAllocateAligned(size, alignment))
+    {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    FreeAligned(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+    FreeAligned(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+    FreeAligned(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept
+{
+    FreeAligned(memory);
+}
@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+
+namespace adapters {
+
+struct AllocationCount
+{
+    std::uint64_t allocations;
+    std::uint64_t bytes;
+};
+
+/// <summary>
+/// Resets the count and counts the calls of the global allocation functions, which AllocationCounter.cpp
+/// replaces, until StopCountingAllocations.
+/// </summary>
+void StartCountingAllocations();
+
+/// <summary>
+/// Stops counting and returns the allocations since StartCountingAllocations.
+/// </summary>
+auto StopCountingAllocations() -> AllocationCount;
+
+} // namespace adapters
@@ -0,0 +1,405 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+// Counts the heap allocations of the forwarding path per frame in the steady state and compares them with the
+// budgets below. Exits with 1 if a scenario allocates more than its budget, so that new per-frame allocations
+// fail the test instead of going unnoticed. Lower a budget when an allocation is removed from the path.
+
+#include "AllocationCounter.hpp"
+#include "ForwardingPipeline.hpp"
+#include "LoopbackEndpoint.hpp"
+#include "L2Switch.hpp"
+#include "Startup.hpp"
+#include "Device.hpp"
+#include "Fleet.hpp"
+#include "Reflector.hpp"
+
+#include "BufferWriter.hpp"
+#include "EthernetHeader.hpp"
+#include "Icmp4Header.hpp"
+#include "Ip4Header.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "asio/ts/io_context.hpp"
+
+#include "silkit/services/logging/all.hpp"
+
+using namespace adapters;
+using namespace demo;
+
+namespace {
+
+constexpr std::uint16_t harnessVlanId = 42;
+// frames per poll of the io_context, as many as the TAP device delivers in a few bursts
+constexpr std::size_t framesPerBatch = 128;
+constexpr std::size_t warmUpFrames = 4096;
+constexpr std::size_t defaultMeasuredFrames = 65536;
+
+const EthernetAddress hostMac{{0x52, 0x54, 0x56, 0x53, 0x4B, 0x55}};
+const EthernetAddress deviceMac{{0x52, 0x54, 0x56, 0x53, 0x4B, 0x56}};
+const Ip4Address hostIp{{192, 168, 7, 2}};
+const Ip4Address deviceIp{{192, 168, 7, 35}};
+
+struct Scenario
+{
+    std::string name;
+    // allocations per frame allowed in the steady state, the known allocations of the path today
+    double allocationBudget;
+    // forwards frameCount frames
+    std::function<void(std::size_t frameCount)> run;
+};
+
+struct Result
+{
+    double allocationsPerFrame;
+    double bytesPerFrame;
+};
+
+// Discards the log, with a level which keeps the debug messages from being composed
+class NullLogger : public SilKit::Services::Logging::ILogger
+{
+public:
+    using Level = SilKit::Services::Logging::Level;
+
+    void Log(Level /*level*/, const std::string& /*msg*/) override {}
+    void Trace(const std::string& /*msg*/) override {}
+    void Debug(const std::string& /*msg*/) override {}
+    void Info(const std::string& /*msg*/) override {}
+    void Warn(const std::string& /*msg*/) override {}
+    void Error(const std::string& /*msg*/) override {}
+    void Critical(const std::string& /*msg*/) override {}
+    auto GetLogLevel() const -> Level override
+    {
+        return Level::Off;
+    }
+};
+
+// An Ethernet/IPv4/ICMP echo request of frameSize bytes from the host to the device, optionally 802.1Q tagged.
+auto MakeEchoRequest(std::size_t frameSize, bool vlanTagged) -> std::vector<std::uint8_t>
+{
+    std::vector<std::uint8_t> frame(frameSize, 0xA5);
+    auto dst = asio::buffer(frame);
+    dst += WriteEthernetHeader(dst, EthernetHeader{deviceMac, hostMac, {}, {}, EtherType::Ip4});
+    const auto ip4TotalLength = static_cast<std::uint16_t>(dst.size());
+    dst += WriteIp4Header(
+        dst, Ip4Header{ip4TotalLength, 1, true, false, 0, 64, Ip4Protocol::ICMP, 0, hostIp, deviceIp});
+    WriteIcmp4Header(dst, Icmp4Header{Icmp4Type::EchoRequest, 0, 0});
+
+    if (vlanTagged)
+    {
+        frame = vlan::InjectVlanTag(std::move(frame), harnessVlanId);
+    }
+    return frame;
+}
+
+auto MakeFeatures(bool vlan) -> ForwardingPipeline::Features
+{
+    ForwardingPipeline::Features features;
+    if (vlan)
+    {
+        features.vlanId = harnessVlanId;
+    }
+    return features;
+}
+
+// The forwarding pipeline behind a loopback endpoint, forwarding to a SIL Kit stub which drops the frames. The
+// scenarios wire the receive handler of the endpoint themselves.
+struct LoopbackPipeline
+{
+    std::shared_ptr<asio::io_context> ioContext;
+    std::shared_ptr<LoopbackEndpoint> endpoint;
+    std::shared_ptr<ForwardingPipeline> pipeline;
+};
+
+auto MakeLoopbackPipeline(bool vlan) -> LoopbackPipeline
+{
+    auto ioContext = std::make_shared<asio::io_context>();
+    auto endpoint = std::make_shared<LoopbackEndpoint>(*ioContext, LoopbackEndpoint::Options{});
+    auto pipeline = std::make_shared<ForwardingPipeline>(
+        MakeFeatures(vlan), *endpoint, [](const std::vector<std::uint8_t>& /*frame*/, std::intptr_t /*id*/) {});
+    return LoopbackPipeline{std::move(ioContext), std::move(endpoint), std::move(pipeline)};
+}
+
+// Injects frameCount copies of frame into the endpoint, standing in for the copies out of the read buffer of the
+// TAP device, and polls the io_context after each batch.
+void RunBatches(asio::io_context& ioContext, LoopbackEndpoint& endpoint, const std::vector<std::uint8_t>& frame,
+                std::size_t frameCount)
+{
+    for (std::size_t frameIndex = 0; frameIndex < frameCount; frameIndex += framesPerBatch)
+    {
+        for (std::size_t batchIndex = 0; batchIndex < framesPerBatch; ++batchIndex)
+        {
+            endpoint.Inject(std::vector<std::uint8_t>(frame.begin(), frame.end()));
+        }
+        while (ioContext.poll() > 0)
+        {
+        }
+        ioContext.restart();
+    }
+}
+
+// Hands frameCount frames to process, going round the frames
+template <typename Frame, typename Process>
+void RunRoundRobin(const std::vector<Frame>& frames, std::size_t frameCount, Process&& process)
+{
+    for (std::size_t frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+    {
+        process(frames[frameIndex % frames.size()]);
+    }
+}
+
+// TAP device -> SIL Kit
+auto MakeEndpointToSilKitScenario(bool vlan, double allocationBudget) -> Scenario
+{
+    const auto loopback = MakeLoopbackPipeline(vlan);
+    loopback.endpoint->StartReceiving([pipeline = loopback.pipeline](std::vector<std::uint8_t> frame) {
+        pipeline->ForwardToSilKit(std::move(frame));
+    });
+    const auto frame = MakeEchoRequest(98, false);
+
+    return Scenario{std::string{"tap_to_silkit"} + (vlan ? "_vlan" : ""), allocationBudget,
+                    [loopback, frame](std::size_t frameCount) {
+        RunBatches(*loopback.ioContext, *loopback.endpoint, frame, frameCount);
+    }};
+}
+
+// TAP device -> SIL Kit through the startup queue after the activation, which passes the frames straight through
+auto MakeStartupQueueScenario(double allocationBudget) -> Scenario
+{
+    const auto loopback = MakeLoopbackPipeline(false);
+    auto startupQueue = std::make_shared<PreActivationQueue>(PreActivationQueue::Options{});
+    loopback.endpoint->StartReceiving([startupQueue](std::vector<std::uint8_t> frame) {
+        startupQueue->Push(std::move(frame));
+    });
+    startupQueue->Activate([pipeline = loopback.pipeline](std::vector<std::uint8_t> frame) {
+        pipeline->ForwardToSilKit(std::move(frame));
+    });
+    const auto frame = MakeEchoRequest(98, false);
+
+    return Scenario{"startup_queue", allocationBudget, [loopback, startupQueue, frame](std::size_t frameCount) {
+        RunBatches(*loopback.ioContext, *loopback.endpoint, frame, frameCount);
+    }};
+}
+
+// SIL Kit -> TAP device. The frames are forwarded from a buffer owned by the stub of SIL Kit, as the
+// frame handler of the Ethernet controller gets them.
+auto MakeSilKitToEndpointScenario(bool vlan, double allocationBudget) -> Scenario
+{
+    const auto loopback = MakeLoopbackPipeline(vlan);
+    const auto frames = std::make_shared<std::vector<std::vector<std::uint8_t>>>(1, MakeEchoRequest(98, vlan));
+
+    return Scenario{std::string{"silkit_to_tap"} + (vlan ? "_vlan" : ""), allocationBudget,
+                    [loopback, frames](std::size_t frameCount) {
+        RunRoundRobin(*frames, frameCount, [&loopback](const std::vector<std::uint8_t>& frame) {
+            loopback.pipeline->ForwardToEndpoint(SilKit::Util::Span<const std::uint8_t>{frame.data(), frame.size()});
+        });
+    }};
+}
+
+// The ICMP echo device of the demo answering echo requests, the replies are dropped.
+auto MakeEchoDeviceScenario(double allocationBudget) -> Scenario
+{
+    auto device = std::make_shared<Device>(deviceMac, deviceIp, [](const FrameBuilder& /*reply*/) {});
+    const auto frames = std::make_shared<std::vector<std::vector<std::uint8_t>>>(1, MakeEchoRequest(98, false));
+
+    return Scenario{"echo_device", allocationBudget, [device, frames](std::size_t frameCount) {
+        RunRoundRobin(*frames, frameCount,
+                      [&device](const std::vector<std::uint8_t>& frame) { device->Process(asio::buffer(frame)); });
+    }};
+}
+
+// The reflector mode of the echo device, reflecting the echo requests into its reused buffer.
+auto MakeEchoReflectorScenario(double allocationBudget) -> Scenario
+{
+    auto reflector =
+        std::make_shared<Reflector>(deviceMac, deviceIp, [](const std::vector<std::uint8_t>& /*reply*/) {});
+    const auto frames = std::make_shared<std::vector<std::vector<std::uint8_t>>>(1, MakeEchoRequest(98, false));
+
+    return Scenario{"echo_reflector", allocationBudget, [reflector, frames](std::size_t frameCount) {
+        RunRoundRobin(*frames, frameCount, [&reflector](const std::vector<std::uint8_t>& frame) {
+            reflector->Process(asio::buffer(frame));
+        });
+    }};
+}
+
+// A fleet of endpoints of the echo device, the echo requests go round the endpoints through the hash tables.
+auto MakeEchoFleetScenario(double allocationBudget) -> Scenario
+{
+    constexpr std::uint32_t endpointCount = 4096;
+    constexpr std::uint32_t requestedEndpoints = 64;
+    auto fleet = std::make_shared<Fleet>(
+        Fleet::ParseEndpoints("10.0.0.1=02:00:00:00:00:01/" + std::to_string(endpointCount)),
+        [](const std::vector<std::uint8_t>& /*reply*/) {});
+    auto frames = std::make_shared<std::vector<std::vector<std::uint8_t>>>();
+    for (std::uint32_t index = 0; index < requestedEndpoints; ++index)
+    {
+        const auto& endpoint = fleet->GetEndpoints()[index * (endpointCount / requestedEndpoints)];
+        auto frame = MakeEchoRequest(98, false);
+        auto dst = asio::buffer(frame);
+        dst += WriteEthernetHeader(dst, EthernetHeader{endpoint.ethernetAddress, hostMac, {}, {}, EtherType::Ip4});
+        WriteIp4Header(dst, Ip4Header{static_cast<std::uint16_t>(dst.size()), 1, true, false, 0, 64,
+                                      Ip4Protocol::ICMP, 0, hostIp, endpoint.ip4Address});
+        frames->push_back(std::move(frame));
+    }
+
+    return Scenario{"echo_fleet", allocationBudget, [fleet, frames](std::size_t frameCount) {
+        RunRoundRobin(*frames, frameCount,
+                      [&fleet](const std::vector<std::uint8_t>& frame) { fleet->Process(asio::buffer(frame)); });
+    }};
+}
+
+// The switch between two untagged ports and a port tagged in the same VLAN, the frames are unicast to learned
+// ports, with the tag kept, added or removed, and broadcast. The ports drop the frames.
+auto MakeSwitchScenario(double allocationBudget) -> Scenario
+{
+    auto logger = std::make_shared<NullLogger>();
+    auto l2Switch = std::make_shared<L2Switch>(logger.get());
+    const auto dropFrame = [](const FrameBuilder& /*frame*/) {};
+    const auto hostPort = l2Switch->AddPort(L2Switch::PortOptions{"host", harnessVlanId, {}}, dropFrame);
+    const auto devicePort = l2Switch->AddPort(L2Switch::PortOptions{"device", harnessVlanId, {}}, dropFrame);
+    const auto trunkPort = l2Switch->AddPort(L2Switch::PortOptions{"trunk", std::nullopt, {harnessVlanId}}, dropFrame);
+
+    const auto echoRequest = MakeEchoRequest(98, false);
+    auto echoReply = echoRequest;
+    WriteEthernetHeader(asio::buffer(echoReply), EthernetHeader{hostMac, deviceMac, {}, {}, EtherType::Ip4});
+    auto broadcast = echoRequest;
+    WriteEthernetHeader(asio::buffer(broadcast),
+                        EthernetHeader{EthernetAddress{{0xff, 0xff, 0xff, 0xff, 0xff, 0xff}}, hostMac, {}, {},
+                                       EtherType::Ip4});
+
+    // the device moves between its untagged port and the trunk, the host stays
+    struct Frame
+    {
+        L2Switch::PortId ingressPort;
+        std::vector<std::uint8_t> data;
+    };
+    const auto frames = std::make_shared<std::vector<Frame>>(std::vector<Frame>{
+        {devicePort, echoReply},
+        {hostPort, echoRequest},
+        {trunkPort, vlan::InjectVlanTag(echoReply, harnessVlanId)},
+        {hostPort, echoRequest},
+        {hostPort, broadcast},
+    });
+
+    return Scenario{"switch", allocationBudget, [logger, l2Switch, frames](std::size_t frameCount) {
+        RunRoundRobin(*frames, frameCount, [&l2Switch](const Frame& frame) {
+            l2Switch->Receive(frame.ingressPort, asio::buffer(frame.data));
+        });
+    }};
+}
+
+auto Measure(const Scenario& scenario, std::size_t measuredFrames) -> Result
+{
+    scenario.run(warmUpFrames);
+
+    StartCountingAllocations();
+    scenario.run(measuredFrames);
+    const auto count = StopCountingAllocations();
+
+    return Result{static_cast<double>(count.allocations) / static_cast<double>(measuredFrames),
+                  static_cast<double>(count.bytes) / static_cast<double>(measuredFrames)};
+}
+
+void WriteJson(const std::string& path, const std::vector<Scenario>& scenarios, const std::vector<Result>& results)
+{
+    std::ofstream out{path};
+    out << "{\n  \"scenarios\": [\n";
+    for (std::size_t index = 0; index < scenarios.size(); ++index)
+    {
+        out << "    {\"name\": \"" << scenarios[index].name << "\", \"allocations_per_frame\": "
+            << results[index].allocationsPerFrame << ", \"bytes_per_frame\": " << results[index].bytesPerFrame
+            << ", \"allocation_budget\": " << scenarios[index].allocationBudget << "}"
+            << (index + 1 < scenarios.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+void PrintHelp()
+{
+    std::cout << "Usage: sil-kit-adapter-tap-allocation-harness [--frames=<count>] [--json=<path>]\n"
+                 "  --frames=<count>  frames forwarded per scenario after the warm-up, defaults to "
+              << defaultMeasuredFrames << "\n"
+                 "  --json=<path>     also writes the results as JSON to path\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::size_t measuredFrames = defaultMeasuredFrames;
+    std::string jsonPath;
+    for (int argIndex = 1; argIndex < argc; ++argIndex)
+    {
+        const std::string arg{argv[argIndex]};
+        if (arg.rfind("--frames=", 0) == 0)
+        {
+            measuredFrames = std::strtoull(arg.c_str() + std::strlen("--frames="), nullptr, 10);
+        }
+        else if (arg.rfind("--json=", 0) == 0)
+        {
+            jsonPath = arg.substr(std::strlen("--json="));
+        }
+        else
+        {
+            PrintHelp();
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+    if (measuredFrames == 0)
+    {
+        PrintHelp();
+        return 2;
+    }
+    // whole batches only, the TAP to SIL Kit scenarios forward frames in batches
+    measuredFrames = (measuredFrames + framesPerBatch - 1) / framesPerBatch * framesPerBatch;
+
+    // The budgets are the known per-frame allocations:
+    //   tap_to_silkit: the frame vector of the endpoint
+    //   startup_queue: the frame vector of the endpoint
+    //   silkit_to_tap: none
+    //   echo_device:   none
+    //   echo_reflector: none
+    //   echo_fleet:    none
+    //   switch:        none
+    const std::vector<Scenario> scenarios{
+        MakeEndpointToSilKitScenario(false, 1), MakeEndpointToSilKitScenario(true, 1), MakeStartupQueueScenario(1),
+        MakeSilKitToEndpointScenario(false, 0), MakeSilKitToEndpointScenario(true, 0),
+        MakeEchoDeviceScenario(0), MakeEchoReflectorScenario(0), MakeEchoFleetScenario(0),
+        MakeSwitchScenario(0),
+    };
+
+    std::vector<Result> results;
+    bool overBudget = false;
+    std::cout << std::left << std::setw(20) << "scenario" << std::right << std::setw(14) << "allocs/frame"
+              << std::setw(14) << "bytes/frame" << std::setw(10) << "budget" << "\n";
+    for (const auto& scenario : scenarios)
+    {
+        const auto result = Measure(scenario, measuredFrames);
+        results.push_back(result);
+
+        // amortized allocations of containers growing in steps (the queue of the loopback) stay below half an
+        // allocation per frame, every allocation per frame on the path counts as a whole one
+        const auto exceedsBudget = result.allocationsPerFrame >= scenario.allocationBudget + 0.5;
+        overBudget = overBudget || exceedsBudget;
+
+        std::cout << std::left << std::setw(20) << scenario.name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(14) << result.allocationsPerFrame << std::setw(14) << result.bytesPerFrame
+                  << std::setw(10) << std::setprecision(0) << scenario.allocationBudget
+                  << (exceedsBudget ? "  OVER BUDGET" : "") << "\n";
+    }
+
+    if (!jsonPath.empty())
+    {
+        WriteJson(jsonPath, scenarios, results);
+    }
+    return overBudget ? 1 : 0;
+}
@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+// Checks that the vectorized word sums behind InternetChecksum agree with the scalar one, and that
+// InternetChecksum agrees with a byte-wise sum after RFC 1071, over random lengths, unaligned starts and buffers
+// split at odd offsets. The benchmarks only time the implementations, this fails with 1 if one of them is wrong.
+
+#include "InternetChecksum.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace demo;
+
+namespace {
+
+constexpr std::uint32_t seed = 0x1A2B3C4D;
+constexpr int randomCases = 20000;
+constexpr std::size_t maxRandomLength = 9000;
+// longer than the 65536 vectors after which the 32-bit lanes of SSE2 and AVX2 are flushed
+constexpr std::size_t flushLength = 3 * 1024 * 1024;
+
+struct Implementation
+{
+    const char* name;
+    detail::SumWordsFunction sumWords;
+};
+
+auto GetImplementations() -> std::vector<Implementation>
+{
+    std::vector<Implementation> implementations;
+#if DEMO_INTERNET_CHECKSUM_X86
+    implementations.push_back(Implementation{"sse2", &detail::SumWordsSse2});
+    if (detail::IsAvx2Supported())
+    {
+        implementations.push_back(Implementation{"avx2", &detail::SumWordsAvx2});
+    }
+#endif
+    return implementations;
+}
+
+// The sums are not folded, only their value modulo 0xFFFF is defined
+auto Reduce(std::uint64_t sum) -> std::uint64_t
+{
+    return sum % 0xFFFF;
+}
+
+auto ReferenceChecksum(const std::uint8_t* data, std::size_t size) -> std::uint16_t
+{
+    std::uint64_t sum = 0;
+    for (std::size_t index = 0; index < size; ++index)
+    {
+        sum += (index % 2 == 0) ? std::uint64_t{data[index]} << 8u : data[index];
+    }
+    while ((sum >> 16u) != 0)
+    {
+        sum = (sum & 0xFFFFu) + (sum >> 16u);
+    }
+    return static_cast<std::uint16_t>(~sum);
+}
+
+class Checker
+{
+public:
+    void CheckSumWords(const std::vector<Implementation>& implementations, const std::uint8_t* data,
+                       std::size_t size, std::size_t offset)
+    {
+        const auto expected = Reduce(detail::SumWordsScalar(data, size));
+        for (const auto& implementation : implementations)
+        {
+            const auto actual = Reduce(implementation.sumWords(data, size));
+            if (actual != expected)
+            {
+                Fail(std::string{implementation.name} + " sums " + std::to_string(actual) + " instead of "
+                     + std::to_string(expected) + " over " + std::to_string(size) + " bytes at offset "
+                     + std::to_string(offset));
+            }
+        }
+    }
+
+    void CheckSplitChecksum(const std::uint8_t* data, std::size_t size, const std::vector<std::size_t>& splits)
+    {
+        InternetChecksum checksum;
+        std::size_t begin = 0;
+        for (const auto end : splits)
+        {
+            checksum.AddBuffer(asio::buffer(data + begin, end - begin));
+            begin = end;
+        }
+        checksum.AddBuffer(asio::buffer(data + begin, size - begin));
+
+        const auto actual = checksum.GetChecksum();
+        const auto expected = ReferenceChecksum(data, size);
+        if (actual != expected)
+        {
+            Fail("InternetChecksum is " + std::to_string(actual) + " instead of "
+                 + std::to_string(expected) + " over " + std::to_string(size) + " bytes in "
+                 + std::to_string(splits.size() + 1) + " buffers");
+        }
+    }
+
+    auto GetFailures() const -> int
+    {
+        return _failures;
+    }
+
+private:
+    void Fail(const std::string& message)
+    {
+        // the first failures are enough to find the bug
+        if (++_failures <= 10)
+        {
+            std::cout << "FAILED: " << message << "\n";
+        }
+    }
+
+    int _failures{0};
+};
+
+} // namespace
+
+int main()
+{
+    const auto implementations = GetImplementations();
+    std::cout << "checking the word sums of scalar";
+    for (const auto& implementation : implementations)
+    {
+        std::cout << ", " << implementation.name;
+    }
+    std::cout << " (selected: " << detail::GetSumWordsName() << ")\n";
+
+    std::mt19937 random{seed};
+    std::vector<std::uint8_t> data(flushLength + 64);
+    for (auto& byte : data)
+    {
+        byte = static_cast<std::uint8_t>(random());
+    }
+
+    Checker checker;
+    for (int caseIndex = 0; caseIndex < randomCases; ++caseIndex)
+    {
+        // odd start offsets leave the vector loads unaligned, even lengths as required by the word sums
+        const auto offset = random() % 64;
+        const auto size = random() % (maxRandomLength / 2) * 2;
+        checker.CheckSumWords(implementations, data.data() + offset, size, offset);
+
+        std::vector<std::size_t> splits;
+        for (auto split = random() % 40; split < size; split += 1 + random() % 200)
+        {
+            splits.push_back(split);
+        }
+        checker.CheckSplitChecksum(data.data() + offset, size + random() % 2, splits);
+    }
+
+    // all bytes 0xFF maximize the lane sums before the flush
+    std::vector<std::uint8_t> ones(flushLength + 64, 0xFF);
+    for (const std::size_t offset : {0, 1, 3})
+    {
+        checker.CheckSumWords(implementations, ones.data() + offset, flushLength, offset);
+        checker.CheckSumWords(implementations, data.data() + offset, flushLength, offset);
+    }
+
+    std::cout << (checker.GetFailures() == 0 ? "all implementations agree"
+                                              : std::to_string(checker.GetFailures()) + " mismatches")
+              << "\n";
+    return checker.GetFailures() == 0 ? 0 : 1;
+}
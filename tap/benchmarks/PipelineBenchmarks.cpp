@@ -0,0 +1,249 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "ForwardingPipeline.hpp"
+#include "FlowClassifier.hpp"
+#include "MtuAdaptation.hpp"
+#include "NeighborProxy.hpp"
+#include "LoopSuppression.hpp"
+#include "LoopbackEndpoint.hpp"
+#include "LatencyHistogram.hpp"
+#include "SomeIpStatistics.hpp"
+#include "FlightRecorder.hpp"
+
+#include "BufferWriter.hpp"
+#include "EthernetHeader.hpp"
+#include "Ip4Header.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "asio/ts/io_context.hpp"
+
+using namespace adapters;
+using namespace demo;
+
+namespace {
+
+// frames injected into the loopback per benchmark iteration
+constexpr std::size_t framesPerIteration = 256;
+constexpr std::uint16_t benchmarkVlanId = 42;
+
+enum struct PipelineVariant
+{
+    Plain,
+    Vlan,
+    SomeIpStatistics,
+    LatencyHistograms,
+    FlightRecorder,
+    FlowToeplitz,
+    FlowFast,
+    MtuAdaptation,
+    NeighborProxy,
+    LoopSuppression,
+};
+
+const EthernetAddress sourceMac{{0x52, 0x54, 0x56, 0x53, 0x4B, 0x55}};
+const EthernetAddress destinationMac{{0x52, 0x54, 0x56, 0x53, 0x4B, 0x56}};
+const Ip4Address sourceIp{{192, 168, 7, 2}};
+const Ip4Address destinationIp{{192, 168, 7, 35}};
+
+// An Ethernet/IPv4/UDP frame of frameSize bytes between the SOME/IP SD ports, optionally 802.1Q tagged. It may
+// be fragmented, so that the MTU adaptation fragments the larger frames.
+auto MakeUdpFrame(std::size_t frameSize, bool vlanTagged) -> std::vector<std::uint8_t>
+{
+    const auto ip4TotalLength = static_cast<std::uint16_t>(frameSize - 14);
+    const auto udpLength = static_cast<std::uint16_t>(ip4TotalLength - 20);
+
+    std::vector<std::uint8_t> frame(frameSize, 0xA5);
+    auto dst = asio::buffer(frame);
+    dst += WriteEthernetHeader(dst, EthernetHeader{destinationMac, sourceMac, {}, {}, EtherType::Ip4});
+    dst += WriteIp4Header(dst, Ip4Header{ip4TotalLength, 0x1234, false, false, 0, 64, Ip4Protocol::UDP, 0, sourceIp,
+                                         destinationIp});
+
+    BufferWriter udpWriter{dst};
+    udpWriter.WriteBe(std::uint16_t{30490});
+    udpWriter.WriteBe(std::uint16_t{30490});
+    udpWriter.WriteBe(udpLength);
+    udpWriter.WriteBe(std::uint16_t{0});
+
+    if (vlanTagged)
+    {
+        frame = vlan::InjectVlanTag(std::move(frame), benchmarkVlanId);
+    }
+    return frame;
+}
+
+// The pipeline with the features of a variant, between a loopback endpoint and a SIL Kit stub which only
+// counts the frames.
+struct PipelineFixture
+{
+    explicit PipelineFixture(PipelineVariant variant)
+        : endpoint{ioContext, LoopbackEndpoint::Options{}}
+    {
+        ForwardingPipeline::Features features;
+        switch (variant)
+        {
+        case PipelineVariant::Plain:
+            break;
+        case PipelineVariant::Vlan:
+            features.vlanId = benchmarkVlanId;
+            break;
+        case PipelineVariant::SomeIpStatistics:
+            someIpStatistics = std::make_unique<SomeIpStatistics>(std::vector<std::uint16_t>{30490});
+            features.someIpStatistics = someIpStatistics.get();
+            break;
+        case PipelineVariant::LatencyHistograms:
+            pipelineLatency = std::make_unique<PipelineLatency>();
+            features.pipelineLatency = pipelineLatency.get();
+            break;
+        case PipelineVariant::FlightRecorder:
+            flightRecorder = std::make_unique<FlightRecorder>(ioContext, nullptr, FlightRecorder::Options{});
+            features.flightRecorder = flightRecorder.get();
+            break;
+        case PipelineVariant::FlowToeplitz:
+        case PipelineVariant::FlowFast:
+        {
+            FlowClassifier::Options options;
+            options.hashFunction = variant == PipelineVariant::FlowToeplitz ? FlowClassifier::HashFunction::Toeplitz
+                                                                           : FlowClassifier::HashFunction::Fast;
+            flowClassifier = std::make_unique<FlowClassifier>(options);
+            features.flowClassifier = flowClassifier.get();
+            break;
+        }
+        case PipelineVariant::MtuAdaptation:
+        {
+            // the minimum MTU, so that the frames of 1514 bytes are fragmented as well
+            MtuAdaptation::Options options;
+            options.mtu = MtuAdaptation::minMtu;
+            options.clampMss = true;
+            mtuAdaptation = std::make_unique<MtuAdaptation>(options);
+            features.mtuAdaptation = mtuAdaptation.get();
+            break;
+        }
+        case PipelineVariant::NeighborProxy:
+            // the UDP frames are neither answered nor learned from, this is the cost for all other traffic
+            neighborProxy = std::make_unique<NeighborProxy>(nullptr);
+            features.neighborProxy = neighborProxy.get();
+            break;
+        case PipelineVariant::LoopSuppression:
+            // the frames repeat but never come back, this is the cost of remembering and looking up each frame
+            loopSuppression = std::make_unique<LoopSuppression>(nullptr);
+            features.loopSuppression = loopSuppression.get();
+            break;
+        }
+
+        pipeline = std::make_unique<ForwardingPipeline>(
+            features, endpoint, [this](const std::vector<std::uint8_t>& frame, std::intptr_t /*transmitId*/) {
+            ++silKitFrames;
+            silKitBytes += frame.size();
+        });
+        endpoint.StartReceiving(
+            [this](std::vector<std::uint8_t> frame) { pipeline->ForwardToSilKit(std::move(frame)); });
+    }
+
+    asio::io_context ioContext;
+    LoopbackEndpoint endpoint;
+    std::unique_ptr<SomeIpStatistics> someIpStatistics;
+    std::unique_ptr<PipelineLatency> pipelineLatency;
+    std::unique_ptr<FlightRecorder> flightRecorder;
+    std::unique_ptr<FlowClassifier> flowClassifier;
+    std::unique_ptr<MtuAdaptation> mtuAdaptation;
+    std::unique_ptr<NeighborProxy> neighborProxy;
+    std::unique_ptr<LoopSuppression> loopSuppression;
+    std::unique_ptr<ForwardingPipeline> pipeline;
+    std::uint64_t silKitFrames{0};
+    std::uint64_t silKitBytes{0};
+};
+
+void BM_EndpointToSilKit(benchmark::State& state, PipelineVariant variant)
+{
+    PipelineFixture fixture{variant};
+    const auto frame = MakeUdpFrame(static_cast<std::size_t>(state.range(0)), false);
+
+    for (auto _ : state)
+    {
+        // the copy stands in for the copy out of the read buffer of the TAP device
+        for (std::size_t frameIndex = 0; frameIndex < framesPerIteration; ++frameIndex)
+        {
+            fixture.endpoint.Inject(frame);
+        }
+        while (fixture.ioContext.poll() > 0)
+        {
+        }
+        fixture.ioContext.restart();
+    }
+
+    benchmark::DoNotOptimize(fixture.silKitFrames);
+    state.SetItemsProcessed(static_cast<std::int64_t>(fixture.silKitFrames));
+    state.SetBytesProcessed(static_cast<std::int64_t>(fixture.silKitBytes));
+    const auto statistics = fixture.endpoint.GetStatistics();
+    const auto receiveBursts = std::max<std::uint64_t>(statistics.receiveBursts, 1);
+    state.counters["frames_per_burst"] =
+        static_cast<double>(statistics.receivedFrames) / static_cast<double>(receiveBursts);
+}
+
+void BM_SilKitToEndpoint(benchmark::State& state, PipelineVariant variant)
+{
+    PipelineFixture fixture{variant};
+    const auto frame = MakeUdpFrame(static_cast<std::size_t>(state.range(0)), variant == PipelineVariant::Vlan);
+    const SilKit::Util::Span<const std::uint8_t> rawFrame{frame.data(), frame.size()};
+
+    for (auto _ : state)
+    {
+        fixture.pipeline->ForwardToEndpoint(rawFrame);
+    }
+
+    const auto statistics = fixture.endpoint.GetStatistics();
+    benchmark::DoNotOptimize(statistics);
+    state.SetItemsProcessed(static_cast<std::int64_t>(statistics.sentFrames));
+    state.SetBytesProcessed(static_cast<std::int64_t>(statistics.sentBytes));
+}
+
+void FrameSizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgName("frame_size")->Arg(60)->Arg(1514)->Arg(9014);
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_EndpointToSilKit, plain, PipelineVariant::Plain)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_EndpointToSilKit, vlan, PipelineVariant::Vlan)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_EndpointToSilKit, someip_statistics, PipelineVariant::SomeIpStatistics)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_EndpointToSilKit, latency_histograms, PipelineVariant::LatencyHistograms)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_EndpointToSilKit, flight_recorder, PipelineVariant::FlightRecorder)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_EndpointToSilKit, flow_toeplitz, PipelineVariant::FlowToeplitz)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_EndpointToSilKit, flow_fast, PipelineVariant::FlowFast)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_EndpointToSilKit, mtu_adaptation, PipelineVariant::MtuAdaptation)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_EndpointToSilKit, neighbor_proxy, PipelineVariant::NeighborProxy)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_EndpointToSilKit, loop_suppression, PipelineVariant::LoopSuppression)->Apply(FrameSizes);
+
+BENCHMARK_CAPTURE(BM_SilKitToEndpoint, plain, PipelineVariant::Plain)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_SilKitToEndpoint, vlan, PipelineVariant::Vlan)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_SilKitToEndpoint, someip_statistics, PipelineVariant::SomeIpStatistics)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_SilKitToEndpoint, latency_histograms, PipelineVariant::LatencyHistograms)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_SilKitToEndpoint, flight_recorder, PipelineVariant::FlightRecorder)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_SilKitToEndpoint, flow_toeplitz, PipelineVariant::FlowToeplitz)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_SilKitToEndpoint, flow_fast, PipelineVariant::FlowFast)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_SilKitToEndpoint, mtu_adaptation, PipelineVariant::MtuAdaptation)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_SilKitToEndpoint, neighbor_proxy, PipelineVariant::NeighborProxy)->Apply(FrameSizes);
+BENCHMARK_CAPTURE(BM_SilKitToEndpoint, loop_suppression, PipelineVariant::LoopSuppression)->Apply(FrameSizes);
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    // recorded in the JSON output, to tell apart the results of different builds
+    benchmark::AddCustomContext("silkit_adapter_version", SILKIT_ADAPTER_VERSION);
+    benchmark::AddCustomContext("build_type", PIPELINE_BENCHMARKS_BUILD_TYPE);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,460 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "ArpIp4Packet.hpp"
+#include "BufferReader.hpp"
+#include "BufferWriter.hpp"
+#include "EthernetHeader.hpp"
+#include "FlowHash.hpp"
+#include "FlowKey.hpp"
+#include "InternetChecksum.hpp"
+#include "Ip4Header.hpp"
+#include "PacketView.hpp"
+#include "UdpHeader.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace demo;
+
+namespace {
+
+// Frame sizes without the FCS, as they are exchanged with the TAP device and SIL Kit.
+constexpr std::size_t minimumFrameSize = 60;
+constexpr std::size_t standardFrameSize = 1514;
+constexpr std::size_t jumboFrameSize = 9014;
+
+constexpr std::size_t ethernetHeaderSize = 14;
+constexpr std::size_t ip4HeaderSize = 20;
+constexpr std::size_t udpHeaderSize = 8;
+
+enum struct FrameMix
+{
+    Minimum,
+    Imix,
+    Standard,
+    Jumbo,
+};
+
+auto GetFrameSizes(FrameMix mix) -> std::vector<std::size_t>
+{
+    switch (mix)
+    {
+    case FrameMix::Minimum:
+        return {minimumFrameSize};
+    case FrameMix::Imix:
+        // simple IMIX: 7 x 64, 4 x 570 and 1 x 1518 bytes on the wire, interleaved as on a real link
+        return {60, 566, 60, 60, 566, 60, 1514, 60, 566, 60, 60, 566};
+    case FrameMix::Standard:
+        return {standardFrameSize};
+    case FrameMix::Jumbo:
+        return {jumboFrameSize};
+    }
+    return {};
+}
+
+const EthernetAddress sourceMac{{0x52, 0x54, 0x56, 0x53, 0x4B, 0x55}};
+const EthernetAddress destinationMac{{0x52, 0x54, 0x56, 0x53, 0x4B, 0x56}};
+const Ip4Address sourceIp{{192, 168, 7, 2}};
+const Ip4Address destinationIp{{192, 168, 7, 35}};
+
+// Writes an Ethernet/IPv4/UDP frame of frameSize bytes into target, returns the bytes written.
+auto WriteUdpFrame(asio::mutable_buffer target, std::size_t frameSize) -> std::size_t
+{
+    const auto ip4TotalLength = static_cast<std::uint16_t>(frameSize - ethernetHeaderSize);
+    const auto udpLength = static_cast<std::uint16_t>(ip4TotalLength - ip4HeaderSize);
+
+    auto dst = target;
+    dst += WriteEthernetHeader(dst, EthernetHeader{destinationMac, sourceMac, {}, {}, EtherType::Ip4});
+    dst += WriteIp4Header(dst, Ip4Header{ip4TotalLength, 0x1234, true, false, 0, 64, Ip4Protocol::UDP, 0, sourceIp,
+                                         destinationIp});
+
+    BufferWriter udpWriter{dst};
+    udpWriter.WriteBe(std::uint16_t{30490});
+    udpWriter.WriteBe(std::uint16_t{30491});
+    udpWriter.WriteBe(udpLength);
+    udpWriter.WriteBe(std::uint16_t{0});
+    dst += udpWriter.GetOffset();
+
+    std::memset(dst.data(), 0xA5, udpLength - udpHeaderSize);
+    return frameSize;
+}
+
+auto MakeUdpFrames(FrameMix mix) -> std::vector<std::vector<std::uint8_t>>
+{
+    std::vector<std::vector<std::uint8_t>> frames;
+    for (const auto frameSize : GetFrameSizes(mix))
+    {
+        std::vector<std::uint8_t> frame(frameSize);
+        WriteUdpFrame(asio::buffer(frame), frameSize);
+        frames.push_back(std::move(frame));
+    }
+    return frames;
+}
+
+auto GetTotalSize(const std::vector<std::vector<std::uint8_t>>& frames) -> std::int64_t
+{
+    std::int64_t totalSize = 0;
+    for (const auto& frame : frames)
+    {
+        totalSize += static_cast<std::int64_t>(frame.size());
+    }
+    return totalSize;
+}
+
+void SetFramesProcessed(benchmark::State& state, const std::vector<std::vector<std::uint8_t>>& frames)
+{
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(frames.size()));
+    state.SetBytesProcessed(state.iterations() * GetTotalSize(frames));
+}
+
+// ================================================================================
+//  Parsing and writing
+// ================================================================================
+
+void BM_ParseUdpFrame(benchmark::State& state, FrameMix mix)
+{
+    const auto frames = MakeUdpFrames(mix);
+    for (auto _ : state)
+    {
+        for (const auto& frame : frames)
+        {
+            const auto ethernet = ParseEthernetHeader(asio::buffer(frame));
+            const auto ip4 = ParseIp4Header(ethernet.remaining);
+            const auto udp = ParseUdpHeader(ip4.remaining);
+            benchmark::DoNotOptimize(udp);
+        }
+    }
+    SetFramesProcessed(state, frames);
+}
+
+void BM_ViewUdpFrame(benchmark::State& state, FrameMix mix)
+{
+    const auto frames = MakeUdpFrames(mix);
+    for (auto _ : state)
+    {
+        for (const auto& frame : frames)
+        {
+            const auto ethernet = EthernetView::Parse(asio::buffer(frame));
+            const auto ip4 = Ip4View::Parse(ethernet.GetPayload());
+            const auto udp = UdpView::Parse(ip4.GetPayload());
+            benchmark::DoNotOptimize(udp.GetDestinationPort());
+        }
+    }
+    SetFramesProcessed(state, frames);
+}
+
+// Frames cut off in the IPv4 header, as a flood of malformed traffic would deliver them
+auto MakeTruncatedFrames() -> std::vector<std::vector<std::uint8_t>>
+{
+    auto frames = MakeUdpFrames(FrameMix::Minimum);
+    frames.front().resize(ethernetHeaderSize + ip4HeaderSize / 2);
+    return frames;
+}
+
+void BM_ParseTruncatedFrame(benchmark::State& state)
+{
+    const auto frames = MakeTruncatedFrames();
+    for (auto _ : state)
+    {
+        for (const auto& frame : frames)
+        {
+            try
+            {
+                const auto ethernet = ParseEthernetHeader(asio::buffer(frame));
+                benchmark::DoNotOptimize(ParseIp4Header(ethernet.remaining));
+            }
+            catch (const std::exception&)
+            {
+            }
+        }
+    }
+    SetFramesProcessed(state, frames);
+}
+
+void BM_ViewTruncatedFrame(benchmark::State& state)
+{
+    const auto frames = MakeTruncatedFrames();
+    for (auto _ : state)
+    {
+        for (const auto& frame : frames)
+        {
+            const auto ethernet = EthernetView::Parse(asio::buffer(frame));
+            benchmark::DoNotOptimize(Ip4View::Parse(ethernet.GetPayload()).GetStatus());
+        }
+    }
+    SetFramesProcessed(state, frames);
+}
+
+void BM_WriteUdpFrame(benchmark::State& state, FrameMix mix)
+{
+    const auto frames = MakeUdpFrames(mix);
+    std::vector<std::uint8_t> target(jumboFrameSize);
+    for (auto _ : state)
+    {
+        for (const auto& frame : frames)
+        {
+            benchmark::DoNotOptimize(WriteUdpFrame(asio::buffer(target), frame.size()));
+            benchmark::ClobberMemory();
+        }
+    }
+    SetFramesProcessed(state, frames);
+}
+
+void BM_ParseArpFrame(benchmark::State& state)
+{
+    std::vector<std::uint8_t> frame(minimumFrameSize);
+    auto dst = asio::buffer(frame);
+    dst += WriteEthernetHeader(dst, EthernetHeader{destinationMac, sourceMac, {}, {}, EtherType::Arp});
+    WriteArpIp4Packet(dst, ArpIp4Packet{ArpOperation::Request, sourceMac, sourceIp, {}, destinationIp});
+
+    for (auto _ : state)
+    {
+        const auto ethernet = ParseEthernetHeader(asio::buffer(frame));
+        benchmark::DoNotOptimize(ParseArpIp4Packet(ethernet.remaining));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(frame.size()));
+}
+
+void BM_BufferReaderReadBe(benchmark::State& state)
+{
+    const std::vector<std::uint8_t> data(static_cast<std::size_t>(state.range(0)), 0x5A);
+    for (auto _ : state)
+    {
+        BufferReader reader{asio::buffer(data)};
+        std::uint32_t sum = 0;
+        for (std::size_t wordIndex = 0; wordIndex < data.size() / 4; ++wordIndex)
+        {
+            sum += reader.ReadBe<std::uint32_t>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_BufferWriterWriteBe(benchmark::State& state)
+{
+    std::vector<std::uint8_t> data(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        BufferWriter writer{asio::buffer(data)};
+        for (std::size_t wordIndex = 0; wordIndex < data.size() / 4; ++wordIndex)
+        {
+            writer.WriteBe(static_cast<std::uint32_t>(wordIndex));
+        }
+        benchmark::DoNotOptimize(writer.GetOffset());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// ================================================================================
+//  VLAN tagging
+// ================================================================================
+
+void BM_InjectVlanTag(benchmark::State& state, FrameMix mix)
+{
+    const auto frames = MakeUdpFrames(mix);
+    for (auto _ : state)
+    {
+        for (const auto& frame : frames)
+        {
+            // the copy is part of the measurement, the adapter injects into a copy of the TAP frame as well
+            benchmark::DoNotOptimize(adapters::vlan::InjectVlanTag(frame, 42));
+        }
+    }
+    SetFramesProcessed(state, frames);
+}
+
+void BM_StripVlanTag(benchmark::State& state, FrameMix mix)
+{
+    auto frames = MakeUdpFrames(mix);
+    for (auto& frame : frames)
+    {
+        frame = adapters::vlan::InjectVlanTag(std::move(frame), 42);
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto& frame : frames)
+        {
+            if (adapters::vlan::ExtractVlanId(frame) == std::uint16_t{42})
+            {
+                benchmark::DoNotOptimize(adapters::vlan::RemoveVlanTag(frame));
+            }
+        }
+    }
+    SetFramesProcessed(state, frames);
+}
+
+// ================================================================================
+//  Flow classification
+// ================================================================================
+
+void BM_ExtractFlow(benchmark::State& state, FrameMix mix)
+{
+    const auto frames = MakeUdpFrames(mix);
+    for (auto _ : state)
+    {
+        for (const auto& frame : frames)
+        {
+            benchmark::DoNotOptimize(ExtractFlow(asio::buffer(frame)));
+        }
+    }
+    SetFramesProcessed(state, frames);
+}
+
+auto MakeFlowKey(std::uint8_t ipVersion) -> FlowKey
+{
+    FlowKey flowKey = {};
+    flowKey.ipVersion = ipVersion;
+    flowKey.protocol = ToUnderlying(Ip4Protocol::UDP);
+    for (std::size_t index = 0; index < flowKey.sourceAddress.size(); ++index)
+    {
+        flowKey.sourceAddress[index] = static_cast<std::uint8_t>(index);
+        flowKey.destinationAddress[index] = static_cast<std::uint8_t>(0x80 + index);
+    }
+    flowKey.sourcePort = 30490;
+    flowKey.destinationPort = 30491;
+    flowKey.vlanId = FlowKey::noVlanId;
+    return flowKey;
+}
+
+void BM_ToeplitzHash(benchmark::State& state, std::uint8_t ipVersion)
+{
+    const ToeplitzHash toeplitzHash;
+    auto flowKey = MakeFlowKey(ipVersion);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(toeplitzHash.Hash(flowKey, true));
+        // a new port per iteration, like a stream of new flows
+        ++flowKey.sourcePort;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_FastFlowHash(benchmark::State& state, std::uint8_t ipVersion)
+{
+    auto flowKey = MakeFlowKey(ipVersion);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(FastFlowHash(flowKey, true));
+        ++flowKey.sourcePort;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// ================================================================================
+//  Checksum
+// ================================================================================
+
+void BM_InternetChecksum(benchmark::State& state)
+{
+    std::vector<std::uint8_t> data(static_cast<std::size_t>(state.range(0)));
+    for (std::size_t index = 0; index < data.size(); ++index)
+    {
+        data[index] = static_cast<std::uint8_t>(index * 7);
+    }
+
+    for (auto _ : state)
+    {
+        InternetChecksum checksum;
+        checksum.AddBuffer(asio::buffer(data));
+        benchmark::DoNotOptimize(checksum.GetChecksum());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// The implementations of the word sum behind InternetChecksum, which one is used depends on the CPU
+void BM_SumWords(benchmark::State& state, detail::SumWordsFunction sumWords)
+{
+    std::vector<std::uint8_t> data(static_cast<std::size_t>(state.range(0)));
+    for (std::size_t index = 0; index < data.size(); ++index)
+    {
+        data[index] = static_cast<std::uint8_t>(index * 7);
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sumWords(data.data(), data.size() & ~std::size_t{1}));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void ChecksumLengths(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->Arg(20)->Arg(64)->Arg(576)->Arg(1500)->Arg(9000)->Arg(65535);
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_ParseUdpFrame, 64B, FrameMix::Minimum);
+BENCHMARK_CAPTURE(BM_ParseUdpFrame, imix, FrameMix::Imix);
+BENCHMARK_CAPTURE(BM_ParseUdpFrame, 1500B, FrameMix::Standard);
+BENCHMARK_CAPTURE(BM_ParseUdpFrame, jumbo, FrameMix::Jumbo);
+
+BENCHMARK_CAPTURE(BM_ViewUdpFrame, 64B, FrameMix::Minimum);
+BENCHMARK_CAPTURE(BM_ViewUdpFrame, imix, FrameMix::Imix);
+BENCHMARK_CAPTURE(BM_ViewUdpFrame, 1500B, FrameMix::Standard);
+BENCHMARK_CAPTURE(BM_ViewUdpFrame, jumbo, FrameMix::Jumbo);
+
+BENCHMARK(BM_ParseTruncatedFrame);
+BENCHMARK(BM_ViewTruncatedFrame);
+
+BENCHMARK_CAPTURE(BM_WriteUdpFrame, 64B, FrameMix::Minimum);
+BENCHMARK_CAPTURE(BM_WriteUdpFrame, imix, FrameMix::Imix);
+BENCHMARK_CAPTURE(BM_WriteUdpFrame, 1500B, FrameMix::Standard);
+BENCHMARK_CAPTURE(BM_WriteUdpFrame, jumbo, FrameMix::Jumbo);
+
+BENCHMARK(BM_ParseArpFrame);
+
+BENCHMARK_CAPTURE(BM_ExtractFlow, 64B, FrameMix::Minimum);
+BENCHMARK_CAPTURE(BM_ExtractFlow, imix, FrameMix::Imix);
+BENCHMARK_CAPTURE(BM_ToeplitzHash, ipv4, std::uint8_t{4});
+BENCHMARK_CAPTURE(BM_ToeplitzHash, ipv6, std::uint8_t{6});
+BENCHMARK_CAPTURE(BM_FastFlowHash, ipv4, std::uint8_t{4});
+BENCHMARK_CAPTURE(BM_FastFlowHash, ipv6, std::uint8_t{6});
+BENCHMARK(BM_BufferReaderReadBe)->Arg(64)->Arg(1500);
+BENCHMARK(BM_BufferWriterWriteBe)->Arg(64)->Arg(1500);
+
+BENCHMARK_CAPTURE(BM_InjectVlanTag, 64B, FrameMix::Minimum);
+BENCHMARK_CAPTURE(BM_InjectVlanTag, imix, FrameMix::Imix);
+BENCHMARK_CAPTURE(BM_InjectVlanTag, 1500B, FrameMix::Standard);
+BENCHMARK_CAPTURE(BM_InjectVlanTag, jumbo, FrameMix::Jumbo);
+
+BENCHMARK_CAPTURE(BM_StripVlanTag, 64B, FrameMix::Minimum);
+BENCHMARK_CAPTURE(BM_StripVlanTag, imix, FrameMix::Imix);
+BENCHMARK_CAPTURE(BM_StripVlanTag, 1500B, FrameMix::Standard);
+BENCHMARK_CAPTURE(BM_StripVlanTag, jumbo, FrameMix::Jumbo);
+
+BENCHMARK(BM_InternetChecksum)->Apply(ChecksumLengths);
+BENCHMARK_CAPTURE(BM_SumWords, scalar, &detail::SumWordsScalar)->Apply(ChecksumLengths);
+#if DEMO_INTERNET_CHECKSUM_X86
+BENCHMARK_CAPTURE(BM_SumWords, sse2, &detail::SumWordsSse2)->Apply(ChecksumLengths);
+#endif
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    // recorded in the JSON output, to tell apart the results of different builds
+    benchmark::AddCustomContext("silkit_adapter_version", SILKIT_ADAPTER_VERSION);
+    benchmark::AddCustomContext("build_type", UTILITY_BENCHMARKS_BUILD_TYPE);
+    benchmark::AddCustomContext("checksum_implementation", detail::GetSumWordsName());
+#if DEMO_INTERNET_CHECKSUM_X86
+    if (detail::IsAvx2Supported())
+    {
+        BENCHMARK_CAPTURE(BM_SumWords, avx2, &detail::SumWordsAvx2)->Apply(ChecksumLengths);
+    }
+#endif
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
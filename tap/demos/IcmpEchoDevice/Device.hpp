@@ -12,6 +12,7 @@
 #include "Ip4Address.hpp"
 
 #include "EthernetHeader.hpp"
+#include "FrameBuilder.hpp"
 
 #include "ArpIp4Packet.hpp"
 
@@ -26,18 +27,20 @@
 #include <asio/ts/buffer.hpp>
 #include <asio/ts/internet.hpp>
 #include <asio/ts/socket.hpp>
-#include "silkit/services/logging/all.hpp"
 
 namespace demo {
 
 class Device
 {
 public:
-    Device(EthernetAddress ethernetAddress, Ip4Address ip4Address, SilKit::Services::Logging::ILogger* logger,
-           std::function<void(std::vector<std::uint8_t>)> sendFrameCallback)
+    // The reply references the payload of the received frame and is only valid during the call, the callback
+    // sends it as a gather list or joins it once with FrameBuilder::FlattenTo.
+    using SendFrameCallback = std::function<void(const FrameBuilder& frame)>;
+
+    // Received and sent frames are not logged here, the callers trace them with adapters::FrameTracer
+    Device(EthernetAddress ethernetAddress, Ip4Address ip4Address, SendFrameCallback sendFrameCallback)
         : _ethernetAddress{ethernetAddress}
         , _ip4Address{ip4Address}
-        , _logger(logger)
         , _sendFrameCallback{std::move(sendFrameCallback)}
     {
     }
@@ -45,17 +48,11 @@ public:
 public:
     void Process(asio::const_buffer incomingData);
 
-public:
-    std::vector<std::uint8_t> AllocateBuffer(std::size_t size)
-    {
-        return std::vector<std::uint8_t>(size);
-    }
-
 private:
     EthernetAddress _ethernetAddress;
     Ip4Address _ip4Address;
-    std::function<void(std::vector<std::uint8_t>)> _sendFrameCallback;
-    SilKit::Services::Logging::ILogger* _logger;
+    SendFrameCallback _sendFrameCallback;
+    FrameBuilder _reply;
 };
 
 } // namespace demo
@@ -0,0 +1,232 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "Fleet.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "FrameRewrite.hpp"
+#include "Icmp4Header.hpp"
+#include "PacketView.hpp"
+#include "Split.hpp"
+
+#include <asio/ts/internet.hpp>
+
+namespace demo {
+
+namespace {
+
+constexpr std::uint64_t maxEthernetAddressKey = (std::uint64_t{1} << 48u) - 1;
+
+auto FromKey(std::uint64_t key) -> EthernetAddress
+{
+    EthernetAddress address{};
+    for (std::size_t index = 6; index-- > 0; key >>= 8u)
+    {
+        address.data[index] = static_cast<std::uint8_t>(key);
+    }
+    return address;
+}
+
+auto FromKey(std::uint32_t key) -> Ip4Address
+{
+    return Ip4Address{{static_cast<std::uint8_t>(key >> 24u), static_cast<std::uint8_t>(key >> 16u),
+                       static_cast<std::uint8_t>(key >> 8u), static_cast<std::uint8_t>(key)}};
+}
+
+template <typename Address>
+auto ToString(const Address& address) -> std::string
+{
+    std::ostringstream stream;
+    stream << address;
+    return stream.str();
+}
+
+auto ParseCount(const std::string& text) -> std::uint64_t
+{
+    const bool isNumber = !text.empty() && text.size() <= 9
+                          && std::all_of(text.begin(), text.end(),
+                                         [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; });
+    const auto count = isNumber ? std::stoull(text) : 0;
+    if (count == 0)
+    {
+        throw std::invalid_argument{"'" + text + "' is not a positive number of endpoints"};
+    }
+    return count;
+}
+
+} // namespace
+
+auto Fleet::ParseEndpoints(const std::string& list) -> std::vector<Endpoint>
+{
+    std::vector<Endpoint> endpoints;
+    for (const auto& term : demo::Split(list, ','))
+    {
+        const auto equalSign = term.find('=');
+        if (equalSign == std::string::npos)
+        {
+            throw std::invalid_argument{"'" + term + "' is not of the form <ip>=<mac>[/<count>]"};
+        }
+
+        const auto ipText = term.substr(0, equalSign);
+        std::error_code errorCode;
+        const auto ip4Address = asio::ip::make_address_v4(ipText, errorCode);
+        if (errorCode)
+        {
+            throw std::invalid_argument{"'" + ipText + "' is not an IPv4 address"};
+        }
+
+        const auto slash = term.find('/', equalSign);
+        const auto count = slash == std::string::npos ? 1 : ParseCount(term.substr(slash + 1));
+        const auto firstEthernetAddress = ParseEthernetAddress(term.substr(equalSign + 1, slash - equalSign - 1));
+
+        const std::uint64_t firstIp4Key = ip4Address.to_uint();
+        const auto firstEthernetKey = ToKey(firstEthernetAddress);
+        if (count - 1 > std::numeric_limits<std::uint32_t>::max() - firstIp4Key
+            || count - 1 > maxEthernetAddressKey - firstEthernetKey)
+        {
+            throw std::invalid_argument{"the range '" + term + "' runs past the last address"};
+        }
+        for (std::uint64_t index = 0; index < count; ++index)
+        {
+            endpoints.push_back(Endpoint{FromKey(firstEthernetKey + index),
+                                         FromKey(static_cast<std::uint32_t>(firstIp4Key + index))});
+        }
+    }
+    return endpoints;
+}
+
+Fleet::Fleet(std::vector<Endpoint> endpoints, SendFrame sendFrame)
+    : _endpoints{std::move(endpoints)}
+    , _counters(_endpoints.size())
+    , _sendFrame{std::move(sendFrame)}
+{
+    if (_endpoints.size() > std::numeric_limits<std::uint32_t>::max())
+    {
+        throw std::invalid_argument{"too many endpoints"};
+    }
+    _byEthernetAddress.reserve(_endpoints.size());
+    _byIp4Address.reserve(_endpoints.size());
+
+    for (std::uint32_t index = 0; index < _endpoints.size(); ++index)
+    {
+        const auto& endpoint = _endpoints[index];
+        const auto ip4Key = ToKey(endpoint.ip4Address);
+        const bool isUnicastEthernet = (endpoint.ethernetAddress.data[0] & 0x01) == 0
+                                       && !(endpoint.ethernetAddress == EthernetAddress{});
+        // not 0.0.0.0, multicast (224.0.0.0/4) or the limited broadcast address
+        const bool isUnicastIp4 = ip4Key != 0 && (ip4Key >> 28u) != 0xE && ip4Key != 0xFFFFFFFF;
+        if (!isUnicastEthernet || !isUnicastIp4)
+        {
+            throw std::invalid_argument{"the endpoint " + ToString(endpoint.ip4Address) + " "
+                                        + ToString(endpoint.ethernetAddress) + " has a non-unicast address"};
+        }
+        if (!_byEthernetAddress.emplace(ToKey(endpoint.ethernetAddress), index).second)
+        {
+            throw std::invalid_argument{ToString(endpoint.ethernetAddress) + " is used by two endpoints"};
+        }
+        if (!_byIp4Address.emplace(ip4Key, index).second)
+        {
+            throw std::invalid_argument{ToString(endpoint.ip4Address) + " is used by two endpoints"};
+        }
+    }
+}
+
+bool Fleet::Process(asio::const_buffer frame)
+{
+    const auto ethernet = EthernetView::Parse(frame);
+    if (!ethernet)
+    {
+        return Unanswered();
+    }
+
+    switch (ethernet.GetEtherType())
+    {
+    case EtherType::Arp:
+    {
+        const auto arp = ArpView::Parse(ethernet.GetPayload());
+        if (!arp || arp.GetOperation() != ArpOperation::Request)
+        {
+            return Unanswered();
+        }
+        const auto found = _byIp4Address.find(ToKey(arp.GetTargetProtocolAddress()));
+        if (found == _byIp4Address.end())
+        {
+            return Unanswered();
+        }
+        const auto& endpoint = _endpoints[found->second];
+        _frame.assign(static_cast<const std::uint8_t*>(frame.data()),
+                      static_cast<const std::uint8_t*>(frame.data()) + frame.size());
+        RewriteToArpReply(_frame.data(), ethernet.GetHeaderSize(), endpoint.ethernetAddress, endpoint.ip4Address);
+        Send(_counters[found->second].arpReplies);
+        return true;
+    }
+    case EtherType::Ip4:
+    {
+        // echo requests to a broadcast or multicast address are not answered, like by Linux by default
+        const auto found = _byEthernetAddress.find(ToKey(ethernet.GetDestination()));
+        if (found == _byEthernetAddress.end())
+        {
+            return Unanswered();
+        }
+        const auto& endpoint = _endpoints[found->second];
+        const auto ip4 = Ip4View::Parse(ethernet.GetPayload());
+        if (!ip4 || ip4.GetProtocol() != Ip4Protocol::ICMP || !(ip4.GetDestinationAddress() == endpoint.ip4Address))
+        {
+            return Unanswered();
+        }
+        // later fragments are reflected like the first one, which carries the echo request
+        const bool isFirstFragment = ip4.GetFragmentOffset() == 0;
+        if (isFirstFragment)
+        {
+            const auto icmp4 = Icmp4View::Parse(ip4.GetPayload());
+            if (!icmp4 || icmp4.GetType() != Icmp4Type::EchoRequest)
+            {
+                return Unanswered();
+            }
+        }
+        _frame.assign(static_cast<const std::uint8_t*>(frame.data()),
+                      static_cast<const std::uint8_t*>(frame.data()) + frame.size());
+        RewriteToIp4Reply(_frame.data(), ethernet.GetHeaderSize(), ip4.GetHeaderLength(), endpoint.ethernetAddress,
+                          isFirstFragment);
+        Send(_counters[found->second].echoReplies);
+        return true;
+    }
+    default:
+        return Unanswered();
+    }
+}
+
+auto Fleet::ToKey(const EthernetAddress& address) -> std::uint64_t
+{
+    std::uint64_t key = 0;
+    for (const auto byte : address.data)
+    {
+        key = (key << 8u) | byte;
+    }
+    return key;
+}
+
+auto Fleet::ToKey(const Ip4Address& address) -> std::uint32_t
+{
+    return (std::uint32_t{address.data[0]} << 24u) | (std::uint32_t{address.data[1]} << 16u)
+           | (std::uint32_t{address.data[2]} << 8u) | address.data[3];
+}
+
+bool Fleet::Unanswered()
+{
+    ++_unansweredFrames;
+    return false;
+}
+
+void Fleet::Send(std::uint64_t& counter)
+{
+    _sendFrame(_frame);
+    ++counter;
+}
+
+} // namespace demo
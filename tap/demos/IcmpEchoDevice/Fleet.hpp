@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "EthernetAddress.hpp"
+#include "Ip4Address.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <asio/ts/buffer.hpp>
+
+namespace demo {
+
+/// <summary>
+/// Emulates many endpoints, e.g. the ECUs of a vehicle network, in one participant: answers the ARP requests and
+/// ICMP echo requests for each of them.
+///
+///   ARP requests are dispatched by the target IPv4 address, IPv4 packets by the destination Ethernet address and
+///   then checked against the IPv4 address of the endpoint, both through hash tables. Replies are rewritten from a
+///   copy of the request in a reused buffer like in the Reflector, and counted per endpoint. Process must be
+///   called from one thread at a time.
+/// </summary>
+class Fleet
+{
+public:
+    // the frame is only valid during the call, the sender must copy it
+    using SendFrame = std::function<void(const std::vector<std::uint8_t>& frame)>;
+
+    struct Endpoint
+    {
+        EthernetAddress ethernetAddress;
+        Ip4Address ip4Address;
+    };
+
+    struct Counters
+    {
+        std::uint64_t arpReplies{0};
+        std::uint64_t echoReplies{0};
+    };
+
+    /// <summary>
+    /// Parses a comma separated list of address ranges of the form ip=mac[/count], e.g.
+    /// "192.168.7.100=52:54:56:00:01:00/500,10.0.0.1=02:00:00:00:00:01". A range of count endpoints starts at
+    /// the given addresses, both are incremented from one endpoint to the next.
+    /// </summary>
+    /// <exception cref="std::invalid_argument">Thrown if the list is malformed or a range overflows.</exception>
+    static auto ParseEndpoints(const std::string& list) -> std::vector<Endpoint>;
+
+    /// <exception cref="std::invalid_argument">Thrown if an address is not unicast or used twice.</exception>
+    Fleet(std::vector<Endpoint> endpoints, SendFrame sendFrame);
+
+    /// <summary>
+    /// Returns true if the frame was answered.
+    /// </summary>
+    bool Process(asio::const_buffer frame);
+
+    auto GetEndpoints() const -> const std::vector<Endpoint>&
+    {
+        return _endpoints;
+    }
+
+    // the counters of the endpoint at the same index
+    auto GetCounters() const -> const std::vector<Counters>&
+    {
+        return _counters;
+    }
+
+    auto GetUnansweredFrames() const -> std::uint64_t
+    {
+        return _unansweredFrames;
+    }
+
+private:
+    static auto ToKey(const EthernetAddress& address) -> std::uint64_t;
+    static auto ToKey(const Ip4Address& address) -> std::uint32_t;
+
+    bool Unanswered();
+    void Send(std::uint64_t& counter);
+
+    std::vector<Endpoint> _endpoints;
+    std::vector<Counters> _counters;
+    // indices into _endpoints
+    std::unordered_map<std::uint64_t, std::uint32_t> _byEthernetAddress;
+    std::unordered_map<std::uint32_t, std::uint32_t> _byIp4Address;
+
+    SendFrame _sendFrame;
+    std::vector<std::uint8_t> _frame;
+    std::uint64_t _unansweredFrames{0};
+};
+
+} // namespace demo
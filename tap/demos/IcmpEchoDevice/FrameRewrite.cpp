@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "FrameRewrite.hpp"
+
+#include <cstring>
+
+#include "ArpIp4Packet.hpp"
+#include "FieldLayout.hpp"
+#include "Icmp4Header.hpp"
+#include "InternetChecksum.hpp"
+#include "Ip4Header.hpp"
+#include "UdpHeader.hpp"
+
+namespace demo {
+
+namespace {
+
+using Arp = layout::ArpIp4;
+using Ip4 = layout::Ip4;
+using Icmp4 = layout::Icmp4;
+using Udp = layout::Udp;
+
+constexpr std::uint8_t replyTimeToLive = 64;
+
+// Ethernet: to the sender, from the endpoint
+void ReplyFrom(std::uint8_t* frame, const EthernetAddress& ethernetAddress)
+{
+    std::memcpy(frame, frame + 6, 6);
+    std::memcpy(frame + 6, ethernetAddress.data.data(), 6);
+}
+
+} // namespace
+
+void RewriteToArpReply(std::uint8_t* frame, std::size_t ethernetHeaderSize, const EthernetAddress& ethernetAddress,
+                       const Ip4Address& ip4Address)
+{
+    auto* arp = frame + ethernetHeaderSize;
+    ReplyFrom(frame, ethernetAddress);
+
+    Arp::Operation::Store(arp, ArpOperation::Reply);
+    Arp::TargetHardwareAddress::Store(arp, Arp::SenderHardwareAddress::Load(arp));
+    Arp::TargetProtocolAddress::Store(arp, Arp::SenderProtocolAddress::Load(arp));
+    Arp::SenderHardwareAddress::Store(arp, ethernetAddress);
+    Arp::SenderProtocolAddress::Store(arp, ip4Address);
+}
+
+void RewriteToIp4Reply(std::uint8_t* frame, std::size_t ethernetHeaderSize, std::size_t ip4HeaderLength,
+                       const EthernetAddress& ethernetAddress, bool isFirstFragment)
+{
+    auto* ip4 = frame + ethernetHeaderSize;
+    auto* transport = ip4 + ip4HeaderLength;
+    ReplyFrom(frame, ethernetAddress);
+
+    // Swapping the addresses changes neither the header checksum nor the pseudo header of the UDP checksum, the
+    // sum does not depend on the order of the words. Only the time to live needs an update.
+    const auto source = Ip4::SourceAddress::Load(ip4);
+    Ip4::SourceAddress::Store(ip4, Ip4::DestinationAddress::Load(ip4));
+    Ip4::DestinationAddress::Store(ip4, source);
+
+    const auto oldTimeToLiveWord = LoadBe<std::uint16_t>(ip4 + Ip4::TimeToLive::offset);
+    Ip4::TimeToLive::Store(ip4, replyTimeToLive);
+    Ip4::Checksum::Store(ip4, InternetChecksum::Update(Ip4::Checksum::Load(ip4), oldTimeToLiveWord,
+                                                       LoadBe<std::uint16_t>(ip4 + Ip4::TimeToLive::offset)));
+
+    if (!isFirstFragment)
+    {
+        return;
+    }
+    switch (Ip4::Protocol::Load(ip4))
+    {
+    case Ip4Protocol::ICMP:
+    {
+        // the checksum of a fragmented echo request covers the whole message, the update is still right
+        const auto oldTypeWord = LoadBe<std::uint16_t>(transport);
+        Icmp4::Type::Store(transport, Icmp4Type::EchoReply);
+        const auto oldChecksum = Icmp4::Checksum::Load(transport);
+        Icmp4::Checksum::Store(transport,
+                               InternetChecksum::Update(oldChecksum, oldTypeWord, LoadBe<std::uint16_t>(transport)));
+        break;
+    }
+    case Ip4Protocol::UDP:
+    {
+        // swapped like the addresses, the checksum stays valid, also if it is 0 for none
+        const auto sourcePort = Udp::SourcePort::Load(transport);
+        Udp::SourcePort::Store(transport, Udp::DestinationPort::Load(transport));
+        Udp::DestinationPort::Store(transport, sourcePort);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+} // namespace demo
@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "EthernetAddress.hpp"
+#include "Ip4Address.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace demo {
+
+// In-place rewrites of a copy of a received frame into the reply of an emulated endpoint. The headers must have
+// been validated by the caller, e.g. with the packet views.
+
+/// <summary>
+/// Turns an ARP request into the reply of the endpoint with the given addresses.
+/// </summary>
+void RewriteToArpReply(std::uint8_t* frame, std::size_t ethernetHeaderSize, const EthernetAddress& ethernetAddress,
+                       const Ip4Address& ip4Address);
+
+/// <summary>
+/// Sends an IPv4 packet back to its sender from the endpoint with the given Ethernet address: the addresses are
+/// swapped and the time to live is reset. In the first fragment, an ICMP echo request becomes an echo reply and
+/// the ports of a UDP datagram are swapped. The checksums are updated incrementally.
+/// </summary>
+void RewriteToIp4Reply(std::uint8_t* frame, std::size_t ethernetHeaderSize, std::size_t ip4HeaderLength,
+                       const EthernetAddress& ethernetAddress, bool isFirstFragment);
+
+} // namespace demo
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "Reflector.hpp"
+
+#include "ArpIp4Packet.hpp"
+#include "FrameRewrite.hpp"
+#include "Icmp4Header.hpp"
+#include "Ip4Header.hpp"
+#include "PacketView.hpp"
+#include "UdpHeader.hpp"
+
+namespace demo {
+
+namespace {
+
+using Icmp4 = layout::Icmp4;
+using Udp = layout::Udp;
+
+} // namespace
+
+bool Reflector::Process(asio::const_buffer frame)
+{
+    // only the headers of the received frame are looked at, the frame is copied once it will be answered
+    const auto ethernet = EthernetView::Parse(frame);
+    if (!ethernet)
+    {
+        return false;
+    }
+
+    switch (ethernet.GetEtherType())
+    {
+    case EtherType::Arp:
+    {
+        const auto arp = ArpView::Parse(ethernet.GetPayload());
+        if (!arp || arp.GetOperation() != ArpOperation::Request || !(arp.GetTargetProtocolAddress() == _ip4Address))
+        {
+            return false;
+        }
+        _frame.assign(static_cast<const std::uint8_t*>(frame.data()),
+                      static_cast<const std::uint8_t*>(frame.data()) + frame.size());
+        RewriteToArpReply(_frame.data(), ethernet.GetHeaderSize(), _ethernetAddress, _ip4Address);
+        Send();
+        return true;
+    }
+    case EtherType::Ip4:
+    {
+        const auto ip4 = Ip4View::Parse(ethernet.GetPayload());
+        if (!ip4 || !(ip4.GetDestinationAddress() == _ip4Address))
+        {
+            return false;
+        }
+        // later fragments are reflected like the first one, which carries the headers which change
+        const bool isFirstFragment = ip4.GetFragmentOffset() == 0;
+        const auto payload = ip4.GetPayload();
+        switch (ip4.GetProtocol())
+        {
+        case Ip4Protocol::ICMP:
+            if (isFirstFragment
+                && (payload.size() < Icmp4::size
+                    || Icmp4::Type::Load(static_cast<const std::uint8_t*>(payload.data())) != Icmp4Type::EchoRequest))
+            {
+                return false;
+            }
+            break;
+        case Ip4Protocol::UDP:
+            if (isFirstFragment && payload.size() < Udp::size)
+            {
+                return false;
+            }
+            break;
+        default:
+            return false;
+        }
+        // the Ethernet padding of short frames is sent back as well
+        _frame.assign(static_cast<const std::uint8_t*>(frame.data()),
+                      static_cast<const std::uint8_t*>(frame.data()) + frame.size());
+        RewriteToIp4Reply(_frame.data(), ethernet.GetHeaderSize(), ip4.GetHeaderLength(), _ethernetAddress,
+                          isFirstFragment);
+        Send();
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+void Reflector::Send()
+{
+    _sendFrame(_frame);
+    ++_reflectedFrames;
+}
+
+} // namespace demo
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "EthernetAddress.hpp"
+#include "Ip4Address.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <asio/ts/buffer.hpp>
+
+namespace demo {
+
+/// <summary>
+/// A fast peer for benchmarks of the adapter: answers ARP requests, ICMP echo requests and every UDP datagram
+/// addressed to the device by reflecting the received frame.
+///
+///   The frame is copied into a reused buffer and rewritten in place: the addresses and UDP ports are swapped,
+///   and the checksums are updated incrementally for the few changed fields instead of being recomputed. Nothing
+///   is parsed beyond the headers, nothing is allocated once the buffer fits the largest frame, and nothing is
+///   logged. Other frames are ignored. Process must be called from one thread at a time.
+/// </summary>
+class Reflector
+{
+public:
+    // the frame is only valid during the call, the sender must copy it
+    using SendFrame = std::function<void(const std::vector<std::uint8_t>& frame)>;
+
+    Reflector(EthernetAddress ethernetAddress, Ip4Address ip4Address, SendFrame sendFrame)
+        : _ethernetAddress{ethernetAddress}
+        , _ip4Address{ip4Address}
+        , _sendFrame{std::move(sendFrame)}
+    {
+    }
+
+    /// <summary>
+    /// Returns true if the frame was answered.
+    /// </summary>
+    bool Process(asio::const_buffer frame);
+
+    auto GetReflectedFrames() const -> std::uint64_t
+    {
+        return _reflectedFrames;
+    }
+
+private:
+    void Send();
+
+    EthernetAddress _ethernetAddress;
+    Ip4Address _ip4Address;
+    SendFrame _sendFrame;
+    std::vector<std::uint8_t> _frame;
+    std::uint64_t _reflectedFrames{0};
+};
+
+} // namespace demo
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: MIT
 
 #include "Device.hpp"
+#include "Fleet.hpp"
+#include "Reflector.hpp"
 
 #include <iostream>
 #include <string>
@@ -14,6 +16,7 @@
 #include "silkit/services/ethernet/all.hpp"
 #include "silkit/services/ethernet/string_utils.hpp"
 #include "../adapter/Parsing.hpp"
+#include "../adapter/FrameTrace.hpp"
 
 #include "common/Parsing.hpp"
 #include "common/Cli.hpp"
@@ -24,6 +27,9 @@ using namespace util;
 using namespace adapters;
 using namespace std::chrono_literals;
 
+const std::string reflectorArg = "--reflector";
+const std::string endpointsArg = "--endpoints";
+
 void print_demo_help(bool userRequested)
 {
     // clang-format off
@@ -32,10 +38,14 @@ void print_demo_help(bool userRequested)
         "  [" << regUriArg << " silkit://<host{localhost}>:<port{8501}>]\n"
         "  [" << networkArg << " <SIL Kit Ethernet network name{tap_demo}>]\n"
         "  [" << logLevelArg << " <Trace|Debug|Warn|{Info}|Error|Critical|Off>]\n"
-        "  [" << vlanTagArg << " (log VLAN tag information from received frames)]\n";
+        "  [" << vlanTagArg << " (log VLAN tag information from received frames)]\n"
+        "  [" << reflectorArg << " (reflect ARP, ICMP echo and UDP frames without logging, for benchmarks)]\n"
+        "  [" << endpointsArg << " <ip>=<mac>[/<count>][,<ip>=<mac>[/<count>],...] (emulate these endpoints instead\n"
+        "     of the single device, a range of count endpoints increments both addresses)]\n";
         std::cout << "\n"
         "Example:\n"
-        "sil-kit-demo-ethernet-icmp-echo-device " << participantNameArg << " EchoDevice " << networkArg << " tap_network " << logLevelArg << " Off\n ";
+        "sil-kit-demo-ethernet-icmp-echo-device " << participantNameArg << " EchoDevice " << networkArg << " tap_network " << logLevelArg << " Off\n"
+        "sil-kit-demo-ethernet-icmp-echo-device " << endpointsArg << " 192.168.7.100=52:54:56:00:01:00/2000\n ";
 
     if (!userRequested)
         std::cout << "\n"
@@ -43,6 +53,31 @@ void print_demo_help(bool userRequested)
     // clang-format on
 }
 
+// The totals at Info level, the counters of each endpoint at Debug level
+void LogFleetCounters(SilKit::Services::Logging::ILogger& logger, const demo::Fleet& fleet)
+{
+    const auto& endpoints = fleet.GetEndpoints();
+    const auto& counters = fleet.GetCounters();
+    demo::Fleet::Counters total;
+    for (std::size_t index = 0; index < endpoints.size(); ++index)
+    {
+        total.arpReplies += counters[index].arpReplies;
+        total.echoReplies += counters[index].echoReplies;
+        if (logger.GetLogLevel() <= SilKit::Services::Logging::Level::Debug)
+        {
+            std::ostringstream SILKitDebugMessage;
+            SILKitDebugMessage << "Endpoint " << endpoints[index].ip4Address << " " << endpoints[index].ethernetAddress
+                               << ": " << counters[index].arpReplies << " ARP replies, " << counters[index].echoReplies
+                               << " echo replies";
+            logger.Debug(SILKitDebugMessage.str());
+        }
+    }
+    std::ostringstream SILKitInfoMessage;
+    SILKitInfoMessage << "Endpoints answered " << total.arpReplies << " ARP requests and " << total.echoReplies
+                      << " echo requests, " << fleet.GetUnansweredFrames() << " frames were left unanswered";
+    logger.Info(SILKitInfoMessage.str());
+}
+
 /**************************************************************************************************
  * Main Function
  **************************************************************************************************/
@@ -60,6 +95,27 @@ int main(int argc, char** argv)
     const std::string registryURI = getArgDefault(argc, argv, regUriArg, "silkit://localhost:8501");
     const std::string ethernetNetworkName = getArgDefault(argc, argv, networkArg, "tap_demo");
     const bool useVlanTag = (findArg(argc, argv, vlanTagArg, argv) != nullptr);
+    const bool reflectorMode = (findArg(argc, argv, reflectorArg, argv) != nullptr);
+    const std::string endpointsStr = getArgDefault(argc, argv, endpointsArg, "");
+    const bool fleetMode = !endpointsStr.empty();
+    if (reflectorMode && fleetMode)
+    {
+        std::cerr << "Error: " << reflectorArg << " and " << endpointsArg << " cannot be combined" << std::endl;
+        return CodeErrorCli;
+    }
+    std::vector<demo::Fleet::Endpoint> fleetEndpoints;
+    if (fleetMode)
+    {
+        try
+        {
+            fleetEndpoints = demo::Fleet::ParseEndpoints(endpointsStr);
+        }
+        catch (const std::exception& error)
+        {
+            std::cerr << "Error: Invalid endpoints '" << endpointsStr << "': " << error.what() << std::endl;
+            return CodeErrorCli;
+        }
+    }
 
     const std::string ethernetControllerName = participantName + "_Eth1";
     const std::string participantConfigurationString =
@@ -68,7 +124,8 @@ int main(int argc, char** argv)
     try
     {
         throwInvalidCliIf(thereAreUnknownArguments(
-            argc, argv, {&networkArg, &regUriArg, &logLevelArg, &participantNameArg}, {&helpArg, &vlanTagArg}));
+            argc, argv, {&networkArg, &regUriArg, &logLevelArg, &participantNameArg, &endpointsArg},
+            {&helpArg, &vlanTagArg, &reflectorArg}));
 
         auto participantConfiguration =
             SilKit::Config::ParticipantConfigurationFromString(participantConfigurationString);
@@ -79,60 +136,104 @@ int main(int argc, char** argv)
         logger->Info("Creating ethernet controller '" + ethernetControllerName + "'");
         auto* ethController = participant->CreateEthernetController(ethernetControllerName, ethernetNetworkName);
 
+        // frames are parsed and logged on a background thread, and only at Debug/Trace log level
+        std::unique_ptr<adapters::FrameTracer> frameTracer;
+        if (logger->GetLogLevel() < SilKit::Services::Logging::Level::Info && !reflectorMode)
+        {
+            frameTracer = std::make_unique<adapters::FrameTracer>(logger, "Demo", adapters::FrameTracer::Options{});
+        }
+
         static constexpr auto ethernetAddress = demo::EthernetAddress{0x52, 0x54, 0x56, 0x53, 0x4B, 0x55};
         static constexpr auto ip4Address = demo::Ip4Address{192, 168, 7, 35};
-        auto demoDevice = demo::Device{ethernetAddress, ip4Address, logger,
-                                       [&logger, ethController, useVlanTag](std::vector<std::uint8_t> data) {
-            const auto frameSize = data.size();
-            std::optional<std::uint16_t> vid;
-            if (useVlanTag)
+        // SendFrame takes one contiguous frame and copies it, the reply is joined into a reused buffer
+        std::vector<std::uint8_t> replyFrame;
+        auto demoDevice = demo::Device{
+            ethernetAddress, ip4Address,
+            [&frameTracer, &replyFrame, ethController, useVlanTag](const demo::FrameBuilder& reply) {
+            static intptr_t transmitId = 0;
+            ++transmitId;
+            reply.FlattenTo(replyFrame);
+            if (frameTracer)
             {
-                vid = adapters::vlan::ExtractVlanId(data);
+                std::optional<std::uint16_t> vid;
+                if (useVlanTag)
+                {
+                    vid = adapters::vlan::ExtractVlanId(replyFrame);
+                }
+                frameTracer->TraceFrame(Direction::TapToSilKit, replyFrame.data(), replyFrame.size(), transmitId, vid);
             }
-            static intptr_t transmitId = 0;
-            ethController->SendFrame(EthernetFrame{std::move(data)}, reinterpret_cast<void*>(++transmitId));
+            ethController->SendFrame(EthernetFrame{replyFrame}, reinterpret_cast<void*>(transmitId));
+        }};
 
-            std::ostringstream SILKitDebugMessage;
-            SILKitDebugMessage << "Demo >> SIL Kit: Ethernet frame (" << frameSize << " bytes, txId=" << transmitId;
-            if (vid.has_value())
+        // SendFrame copies the frame, so the reflector can reuse its buffer for the next one
+        auto reflector =
+            demo::Reflector{ethernetAddress, ip4Address, [ethController](const std::vector<std::uint8_t>& frame) {
+            ethController->SendFrame(EthernetFrame{frame});
+        }};
+        if (reflectorMode)
+        {
+            std::ostringstream SILKitInfoMessage;
+            SILKitInfoMessage << "Reflector mode: answering ARP, ICMP echo and UDP to " << ip4Address
+                              << " without logging the frames";
+            logger->Info(SILKitInfoMessage.str());
+        }
+
+        // like the device, but the reply is only valid during the call
+        auto fleet = demo::Fleet{std::move(fleetEndpoints),
+                                 [&frameTracer, ethController, useVlanTag](const std::vector<std::uint8_t>& frame) {
+            static intptr_t transmitId = 0;
+            ++transmitId;
+            if (frameTracer)
             {
-                SILKitDebugMessage << ", VLAN ID " << *vid;
+                std::optional<std::uint16_t> vid;
+                if (useVlanTag)
+                {
+                    vid = adapters::vlan::ExtractVlanId(frame);
+                }
+                frameTracer->TraceFrame(Direction::TapToSilKit, frame.data(), frame.size(), transmitId, vid);
             }
-            SILKitDebugMessage << ")";
-            logger->Debug(SILKitDebugMessage.str());
+            ethController->SendFrame(EthernetFrame{frame}, reinterpret_cast<void*>(transmitId));
         }};
+        if (fleetMode)
+        {
+            const auto& endpoints = fleet.GetEndpoints();
+            std::ostringstream SILKitInfoMessage;
+            SILKitInfoMessage << "Emulating " << endpoints.size() << " endpoints from " << endpoints.front().ip4Address
+                              << " to " << endpoints.back().ip4Address;
+            logger->Info(SILKitInfoMessage.str());
+        }
 
-        auto onReceivedEthernetMessageFromSILKit =
-            [&logger, &demoDevice, useVlanTag](IEthernetController* /*controller*/, const EthernetFrameEvent& msg) {
+        auto onReceivedEthernetMessageFromSILKit = [&frameTracer, &demoDevice, &reflector, &fleet, useVlanTag,
+                                                    reflectorMode, fleetMode](IEthernetController* /*controller*/,
+                                                                              const EthernetFrameEvent& msg) {
             auto rawFrame = msg.frame.raw;
-            std::ostringstream SILKitDebugMessage;
-            SILKitDebugMessage << "SIL Kit >> Demo: Ethernet frame (" << rawFrame.size() << " bytes";
-            if (useVlanTag)
+            if (reflectorMode)
             {
-                const auto vid = adapters::vlan::ExtractVlanId(rawFrame);
-                if (vid.has_value())
+                reflector.Process(asio::buffer(rawFrame.data(), rawFrame.size()));
+                return;
+            }
+            if (frameTracer)
+            {
+                std::optional<std::uint16_t> vid;
+                if (useVlanTag)
                 {
-                    SILKitDebugMessage << ", VLAN ID " << *vid;
+                    vid = adapters::vlan::ExtractVlanId(rawFrame);
                 }
+                frameTracer->TraceFrame(Direction::SilKitToTap, rawFrame.data(), rawFrame.size(), 0, vid);
+            }
+            if (fleetMode)
+            {
+                fleet.Process(asio::buffer(rawFrame.data(), rawFrame.size()));
+                return;
             }
-            SILKitDebugMessage << ")";
-            logger->Debug(SILKitDebugMessage.str());
             demoDevice.Process(asio::buffer(rawFrame.data(), rawFrame.size()));
         };
 
-        auto onEthernetAckCallback = [&logger](IEthernetController*, const EthernetFrameTransmitEvent& ack) {
-            std::ostringstream SILKitDebugMessage;
-            if (ack.status == EthernetTransmitStatus::Transmitted)
-            {
-                SILKitDebugMessage << "SIL Kit >> Demo: ACK for ETH Message with transmitId="
-                                   << reinterpret_cast<intptr_t>(ack.userContext);
-            }
-            else
+        auto onEthernetAckCallback = [&frameTracer](IEthernetController*, const EthernetFrameTransmitEvent& ack) {
+            if (frameTracer)
             {
-                SILKitDebugMessage << "SIL Kit >> Demo: NACK for ETH Message with transmitId="
-                                   << reinterpret_cast<intptr_t>(ack.userContext) << ": " << ack.status;
+                frameTracer->TraceTransmitStatus(reinterpret_cast<intptr_t>(ack.userContext), ack.status);
             }
-            logger->Debug(SILKitDebugMessage.str());
         };
 
         ethController->AddFrameHandler(onReceivedEthernetMessageFromSILKit);
@@ -171,6 +272,14 @@ int main(int argc, char** argv)
             logger->Debug(SILKitDebugMessage.str());
         }
         lifecycleService->Stop("Adapter stopped by the user.");
+        if (reflectorMode)
+        {
+            logger->Info("Reflector mode: reflected " + std::to_string(reflector.GetReflectedFrames()) + " frames");
+        }
+        if (fleetMode)
+        {
+            LogFleetCounters(*logger, fleet);
+        }
 
         auto finalState = finalStateFuture.wait_for(15s);
         if (finalState != std::future_status::ready)
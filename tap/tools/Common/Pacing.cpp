@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "Pacing.hpp"
+
+#include <algorithm>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// waits shorter than this are spun instead of slept
+constexpr auto spinThreshold = 200us;
+// longer sleeps are split, so that a stop request is noticed during a long gap between frames
+constexpr auto maxSleepSlice = 50ms;
+
+} // namespace
+
+namespace adapters {
+
+void WaitUntil(std::chrono::steady_clock::time_point deadline, const std::atomic<bool>& stopRequested)
+{
+    const auto sleepEnd = deadline - spinThreshold;
+    for (auto now = std::chrono::steady_clock::now(); now < sleepEnd && !stopRequested;
+         now = std::chrono::steady_clock::now())
+    {
+        std::this_thread::sleep_until(std::min(sleepEnd, now + maxSleepSlice));
+    }
+    while (std::chrono::steady_clock::now() < deadline && !stopRequested)
+    {
+    }
+}
+
+void WaitForPendingFrames(const std::atomic<std::uint64_t>& pendingFrames, const std::atomic<bool>& stopRequested)
+{
+    while (pendingFrames >= maxPendingFrames && !stopRequested)
+    {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace adapters
@@ -0,0 +1,28 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace adapters {
+
+/// <summary>
+/// Frames handed to SIL Kit without a transmit acknowledgment yet, bounds the memory SIL Kit buffers at max rate.
+/// </summary>
+constexpr std::uint64_t maxPendingFrames = 4096;
+
+/// <summary>
+/// Sleeps until shortly before the deadline and spins for the rest of the wait, as a sleep usually overshoots by
+/// tens of microseconds. Returns early once stopRequested is set.
+/// </summary>
+void WaitUntil(std::chrono::steady_clock::time_point deadline, const std::atomic<bool>& stopRequested);
+
+/// <summary>
+/// Yields until fewer than maxPendingFrames frames wait for their transmit acknowledgment, or stopRequested is set.
+/// </summary>
+void WaitForPendingFrames(const std::atomic<std::uint64_t>& pendingFrames, const std::atomic<bool>& stopRequested);
+
+} // namespace adapters
@@ -0,0 +1,199 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "Probe.hpp"
+
+#include "ArpIp4Packet.hpp"
+#include "EthernetHeader.hpp"
+#include "Icmp4Header.hpp"
+#include "InternetChecksum.hpp"
+#include "Ip4Header.hpp"
+#include "ReadUintBe.hpp"
+#include "UdpHeader.hpp"
+#include "WriteUintBe.hpp"
+
+#include <cstring>
+#include <exception>
+
+using namespace adapters;
+using namespace demo;
+
+namespace {
+
+constexpr std::uint32_t probeMagic = 0x534B5450; // "SKTP"
+constexpr std::size_t probePayloadSize = 24;
+// source port of UDP probes, the echo service sends its replies there
+constexpr std::uint16_t localUdpPort = 50007;
+
+const EthernetAddress broadcastEthernetAddress{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+void WriteProbePayload(asio::mutable_buffer target, const ProbeEndpoints& endpoints, std::uint64_t sequence,
+                       std::uint64_t sendTimestampNs)
+{
+    target += WriteUintBe(target, probeMagic);
+    target += WriteUintBe(target, endpoints.runId);
+    target += WriteUintBe(target, sequence);
+    target += WriteUintBe(target, sendTimestampNs);
+    // recognizable filler, e.g. in a capture
+    std::memset(target.data(), 0xA5, target.size());
+}
+
+auto ReadProbePayload(asio::const_buffer payload, const ProbeEndpoints& endpoints) -> std::optional<ProbeReply>
+{
+    if (payload.size() < probePayloadSize || ReadUintBe<std::uint32_t>(payload) != probeMagic
+        || ReadUintBe<std::uint32_t>(payload + 4) != endpoints.runId)
+    {
+        return std::nullopt;
+    }
+    return ProbeReply{ReadUintBe<std::uint64_t>(payload + 8), ReadUintBe<std::uint64_t>(payload + 16)};
+}
+
+} // namespace
+
+namespace adapters {
+
+void WriteProbe(asio::mutable_buffer target, const ProbeEndpoints& endpoints, std::size_t frameSize,
+                std::uint64_t sequence, std::uint64_t sendTimestampNs)
+{
+    auto dst = asio::buffer(target, frameSize);
+    const auto ip4TotalLength = static_cast<std::uint16_t>(frameSize - 14);
+    const auto protocol = endpoints.udpPort ? Ip4Protocol::UDP : Ip4Protocol::ICMP;
+
+    dst += WriteEthernetHeader(dst, EthernetHeader{endpoints.peerEthernetAddress, endpoints.localEthernetAddress,
+                                                   {}, {}, EtherType::Ip4});
+    dst += WriteIp4Header(dst, Ip4Header{ip4TotalLength, static_cast<std::uint16_t>(sequence), true, false, 0, 64,
+                                         protocol, 0, endpoints.localIp4Address, endpoints.peerIp4Address});
+
+    const auto transport = dst;
+    if (endpoints.udpPort)
+    {
+        dst += WriteUintBe(dst, localUdpPort);
+        dst += WriteUintBe(dst, *endpoints.udpPort);
+        dst += WriteUintBe(dst, static_cast<std::uint16_t>(transport.size()));
+        dst += WriteUintBe(dst, std::uint16_t{0}); // no checksum, optional for UDP over IPv4
+        WriteProbePayload(dst, endpoints, sequence, sendTimestampNs);
+    }
+    else
+    {
+        dst += WriteIcmp4Header(dst, Icmp4Header{Icmp4Type::EchoRequest, 0, 0});
+        dst += WriteUintBe(dst, static_cast<std::uint16_t>(endpoints.runId)); // identifier
+        dst += WriteUintBe(dst, static_cast<std::uint16_t>(sequence));
+        WriteProbePayload(dst, endpoints, sequence, sendTimestampNs);
+
+        InternetChecksum checksum;
+        checksum.AddBuffer(transport);
+        WriteUintBe(transport + 2, checksum.GetChecksum());
+    }
+}
+
+auto ParseProbeReply(asio::const_buffer frame, const ProbeEndpoints& endpoints) -> std::optional<ProbeReply>
+{
+    try
+    {
+        const auto [ethernetHeader, ethernetPayload] = ParseEthernetHeader(frame);
+        if (ethernetHeader.etherType != EtherType::Ip4)
+        {
+            return std::nullopt;
+        }
+
+        const auto [ip4Header, ip4Payload] = ParseIp4Header(ethernetPayload);
+        if (!(ip4Header.destinationAddress == endpoints.localIp4Address))
+        {
+            return std::nullopt;
+        }
+
+        if (endpoints.udpPort && ip4Header.protocol == Ip4Protocol::UDP)
+        {
+            const auto [udpHeader, udpPayload] = ParseUdpHeader(ip4Payload);
+            if (udpHeader.destinationPort != localUdpPort)
+            {
+                return std::nullopt;
+            }
+            return ReadProbePayload(udpPayload, endpoints);
+        }
+        if (!endpoints.udpPort && ip4Header.protocol == Ip4Protocol::ICMP)
+        {
+            const auto [icmp4Header, icmp4Payload] = ParseIcmp4Header(ip4Payload);
+            if (icmp4Header.type != Icmp4Type::EchoReply || icmp4Payload.size() < 4)
+            {
+                return std::nullopt;
+            }
+            return ReadProbePayload(icmp4Payload + 4, endpoints); // skip identifier and sequence number
+        }
+    }
+    catch (const std::exception&)
+    {
+        // malformed frames are no probes
+    }
+    return std::nullopt;
+}
+
+auto MakeArpRequest(const ProbeEndpoints& endpoints) -> std::vector<std::uint8_t>
+{
+    std::vector<std::uint8_t> frame(60);
+    auto dst = asio::buffer(frame);
+    dst += WriteEthernetHeader(dst, EthernetHeader{broadcastEthernetAddress, endpoints.localEthernetAddress, {}, {},
+                                                   EtherType::Arp});
+    WriteArpIp4Packet(dst, ArpIp4Packet{ArpOperation::Request, endpoints.localEthernetAddress,
+                                        endpoints.localIp4Address, EthernetAddress{}, endpoints.peerIp4Address});
+    return frame;
+}
+
+auto MakeArpReply(asio::const_buffer frame, const ProbeEndpoints& endpoints)
+    -> std::optional<std::vector<std::uint8_t>>
+{
+    try
+    {
+        const auto [ethernetHeader, ethernetPayload] = ParseEthernetHeader(frame);
+        if (ethernetHeader.etherType != EtherType::Arp)
+        {
+            return std::nullopt;
+        }
+
+        const auto arpPacket = ParseArpIp4Packet(ethernetPayload);
+        if (arpPacket.operation != ArpOperation::Request
+            || !(arpPacket.targetProtocolAddress == endpoints.localIp4Address))
+        {
+            return std::nullopt;
+        }
+
+        std::vector<std::uint8_t> reply(60);
+        auto dst = asio::buffer(reply);
+        dst += WriteEthernetHeader(dst, EthernetHeader{arpPacket.senderHardwareAddress,
+                                                       endpoints.localEthernetAddress, {}, {}, EtherType::Arp});
+        WriteArpIp4Packet(dst, ArpIp4Packet{ArpOperation::Reply, endpoints.localEthernetAddress,
+                                            endpoints.localIp4Address, arpPacket.senderHardwareAddress,
+                                            arpPacket.senderProtocolAddress});
+        return reply;
+    }
+    catch (const std::exception&)
+    {
+        return std::nullopt;
+    }
+}
+
+auto ParseArpReply(asio::const_buffer frame, const ProbeEndpoints& endpoints) -> std::optional<EthernetAddress>
+{
+    try
+    {
+        const auto [ethernetHeader, ethernetPayload] = ParseEthernetHeader(frame);
+        if (ethernetHeader.etherType != EtherType::Arp)
+        {
+            return std::nullopt;
+        }
+
+        const auto arpPacket = ParseArpIp4Packet(ethernetPayload);
+        if (arpPacket.operation != ArpOperation::Reply
+            || !(arpPacket.senderProtocolAddress == endpoints.peerIp4Address))
+        {
+            return std::nullopt;
+        }
+        return arpPacket.senderHardwareAddress;
+    }
+    catch (const std::exception&)
+    {
+        return std::nullopt;
+    }
+}
+
+} // namespace adapters
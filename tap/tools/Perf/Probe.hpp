@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "EthernetAddress.hpp"
+#include "Ip4Address.hpp"
+
+#include "asio/ts/buffer.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// Frames sent by the perf participant and reflected by the peer on the TAP side.
+///
+///   A probe is an ICMP echo request, which the network stack of the peer answers by itself, or a UDP
+///   datagram for a UDP echo service. Its payload starts with a magic number, the id of the run, a
+///   sequence number and the send timestamp; the reflected frame carries them back unchanged.
+/// </summary>
+struct ProbeEndpoints
+{
+    demo::EthernetAddress localEthernetAddress;
+    demo::Ip4Address localIp4Address;
+    demo::EthernetAddress peerEthernetAddress;
+    demo::Ip4Address peerIp4Address;
+    // probes are ICMP echo requests if not set
+    std::optional<std::uint16_t> udpPort;
+    // tells apart the replies of this run from late replies of a previous one
+    std::uint32_t runId;
+};
+
+struct ProbeReply
+{
+    std::uint64_t sequence;
+    std::uint64_t sendTimestampNs;
+};
+
+/// <summary>
+/// Smallest probe frame: Ethernet, IPv4 and ICMP/UDP headers plus the probe payload.
+/// </summary>
+constexpr std::size_t minimumProbeFrameSize = 14 + 20 + 8 + 24;
+
+/// <summary>
+/// Writes a probe of frameSize bytes (at least minimumProbeFrameSize) into the beginning of target.
+/// </summary>
+void WriteProbe(asio::mutable_buffer target, const ProbeEndpoints& endpoints, std::size_t frameSize,
+                std::uint64_t sequence, std::uint64_t sendTimestampNs);
+
+/// <summary>
+/// Returns the sequence number and send timestamp if the frame is a reflected probe of this run.
+/// </summary>
+auto ParseProbeReply(asio::const_buffer frame, const ProbeEndpoints& endpoints) -> std::optional<ProbeReply>;
+
+/// <summary>
+/// ARP request for the address of the peer.
+/// </summary>
+auto MakeArpRequest(const ProbeEndpoints& endpoints) -> std::vector<std::uint8_t>;
+
+/// <summary>
+/// ARP reply if the frame is an ARP request for the local address, the peer resolves it before answering.
+/// </summary>
+auto MakeArpReply(asio::const_buffer frame, const ProbeEndpoints& endpoints)
+    -> std::optional<std::vector<std::uint8_t>>;
+
+/// <summary>
+/// Ethernet address of the peer if the frame is an ARP reply of the peer.
+/// </summary>
+auto ParseArpReply(asio::const_buffer frame, const ProbeEndpoints& endpoints) -> std::optional<demo::EthernetAddress>;
+
+} // namespace adapters
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "ProbeStatistics.hpp"
+
+#include <algorithm>
+
+using namespace adapters;
+
+ProbeStatistics::ProbeStatistics()
+    : _receivedSequences(duplicateWindow, 0)
+{
+}
+
+void ProbeStatistics::RecordReceived(std::uint64_t sequence, std::uint64_t roundTripNs, std::size_t frameSize)
+{
+    _receivedFrames.fetch_add(1, std::memory_order_relaxed);
+    _receivedBytes.fetch_add(frameSize, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto& receivedSequence = _receivedSequences[sequence % duplicateWindow];
+    if (receivedSequence == sequence + 1)
+    {
+        ++_duplicateFrames;
+        return;
+    }
+    receivedSequence = sequence + 1;
+
+    ++_uniqueFrames;
+    if (sequence < _highestSequence)
+    {
+        ++_reorderedFrames;
+    }
+    _highestSequence = std::max(_highestSequence, sequence);
+    _roundTrip.Record(roundTripNs);
+}
+
+auto ProbeStatistics::GetCounters() const -> Counters
+{
+    return Counters{
+        _sentFrames.load(std::memory_order_relaxed),
+        _sentBytes.load(std::memory_order_relaxed),
+        _receivedFrames.load(std::memory_order_relaxed),
+        _receivedBytes.load(std::memory_order_relaxed),
+    };
+}
+
+auto ProbeStatistics::Summarize() const -> Summary
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+    Summary summary{};
+    summary.counters = GetCounters();
+    summary.lostFrames =
+        summary.counters.sentFrames > _uniqueFrames ? summary.counters.sentFrames - _uniqueFrames : 0;
+    summary.reorderedFrames = _reorderedFrames;
+    summary.duplicateFrames = _duplicateFrames;
+    summary.roundTrip = _roundTrip.Summarize();
+    return summary;
+}
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "LatencyHistogram.hpp"
+
+namespace adapters {
+
+/// <summary>
+/// Statistics of the probes of a run: throughput of both directions, loss, reordering, duplicates and
+/// the round-trip time percentiles.
+///
+///   Replies are matched to probes by their sequence number. Duplicates are detected within the last
+///   duplicateWindow sequence numbers, older duplicates are counted as reordered replies.
+/// </summary>
+class ProbeStatistics
+{
+public:
+    struct Counters
+    {
+        std::uint64_t sentFrames;
+        std::uint64_t sentBytes;
+        std::uint64_t receivedFrames;
+        std::uint64_t receivedBytes;
+    };
+
+    struct Summary
+    {
+        Counters counters;
+        std::uint64_t lostFrames;
+        std::uint64_t reorderedFrames;
+        std::uint64_t duplicateFrames;
+        LatencyHistogram::Summary roundTrip;
+    };
+
+    ProbeStatistics();
+
+    void RecordSent(std::size_t frameSize)
+    {
+        _sentFrames.fetch_add(1, std::memory_order_relaxed);
+        _sentBytes.fetch_add(frameSize, std::memory_order_relaxed);
+    }
+
+    void RecordReceived(std::uint64_t sequence, std::uint64_t roundTripNs, std::size_t frameSize);
+
+    /// <summary>
+    /// Sent and received frames and bytes so far, for the periodic progress report.
+    /// </summary>
+    auto GetCounters() const -> Counters;
+
+    /// <summary>
+    /// Summary of the run. Probes whose replies are missing are counted as lost, so this should be called
+    /// once the replies had time to arrive.
+    /// </summary>
+    auto Summarize() const -> Summary;
+
+private:
+    static constexpr std::size_t duplicateWindow = 65536;
+
+    std::atomic<std::uint64_t> _sentFrames{0};
+    std::atomic<std::uint64_t> _sentBytes{0};
+    std::atomic<std::uint64_t> _receivedFrames{0};
+    std::atomic<std::uint64_t> _receivedBytes{0};
+
+    mutable std::mutex _mutex;
+    std::vector<std::uint64_t> _receivedSequences; // indexed by sequence % duplicateWindow, sequence + 1 once received
+    std::uint64_t _highestSequence{0};
+    std::uint64_t _uniqueFrames{0};
+    std::uint64_t _reorderedFrames{0};
+    std::uint64_t _duplicateFrames{0};
+    LatencyHistogram _roundTrip;
+};
+
+} // namespace adapters
@@ -0,0 +1,448 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "Probe.hpp"
+#include "ProbeStatistics.hpp"
+#include "../../adapter/Parsing.hpp"
+#include "Pacing.hpp"
+#include "EthernetHeader.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "asio/ip/address.hpp"
+
+#include "common/Parsing.hpp"
+#include "common/Cli.hpp"
+#include "common/ParticipantCreation.hpp"
+#include "common/Exceptions.hpp"
+
+#include "silkit/SilKit.hpp"
+#include "silkit/config/all.hpp"
+#include "silkit/services/ethernet/all.hpp"
+#include "silkit/services/logging/all.hpp"
+
+using namespace SilKit::Services::Ethernet;
+using namespace SilKit::Services::Orchestration;
+using namespace std::chrono_literals;
+using namespace util;
+using namespace adapters;
+
+namespace {
+
+const std::string peerArg = "--peer";
+const std::string ipArg = "--ip";
+const std::string udpPortArg = "--udp-port";
+const std::string frameSizeArg = "--frame-size";
+const std::string rateArg = "--rate";
+const std::string burstArg = "--burst";
+const std::string durationArg = "--duration";
+
+const demo::EthernetAddress localEthernetAddress{0x52, 0x54, 0x56, 0x53, 0x4B, 0x57};
+
+// time given to the last replies after the last probe was sent
+constexpr auto drainTimeout = 1s;
+constexpr int arpAttempts = 5;
+
+std::atomic<bool> stopRequested{false};
+
+void OnStopSignal(int /*signalNumber*/)
+{
+    stopRequested = true;
+}
+
+void print_perf_help(bool userRequested)
+{
+    // clang-format off
+    std::cout << "Usage (defaults in curly braces if you omit the switch):" << std::endl;
+    std::cout << "sil-kit-adapter-tap-perf [" << participantNameArg << " <participant's name{SilKitAdapterTapPerf}>]\n"
+        "  [" << configurationArg << " <path to .silkit.yaml or .json configuration file>]\n"
+        "  [" << regUriArg << " silkit://<host{localhost}>:<port{8501}>]\n"
+        "  [" << logLevelArg << " <Trace|Debug|Warn|{Info}|Error|Critical|Off>]\n"
+        "  [" << networkArg << " <SIL Kit ethernet network{tap_demo}>]\n"
+        "  [" << peerArg << " <IPv4 address of the reflecting peer{192.168.7.2}>]\n"
+        "  [" << ipArg << " <IPv4 address of this participant{192.168.7.36}>]\n"
+        "  [" << udpPortArg << " <UDP echo port of the peer, ICMP echo requests are sent if omitted>]\n"
+        "  [" << frameSizeArg << " <frame size in bytes without FCS{100}, at least 66, or imix>]\n"
+        "  [" << rateArg << " <frames per second{1000}, or max to send as fast as SIL Kit acknowledges>]\n"
+        "  [" << burstArg << " <frames sent back to back, at the given average rate{1}>]\n"
+        "  [" << durationArg << " <seconds of traffic{10}>]\n"
+        "  [" << vlanTagArg << " <VLAN ID of the sent frames>]\n";
+    std::cout << "\n"
+        "Example:\n"
+        "sil-kit-adapter-tap-perf " << networkArg << " tap_demo " << peerArg << " 192.168.7.2 "
+        << frameSizeArg << " imix " << rateArg << " 20000 " << durationArg << " 30\n";
+
+    if (!userRequested)
+        std::cout << "\n"
+            "Pass " << helpArg << " to get this message.\n";
+    // clang-format on
+}
+
+auto ParseIp4Address(const std::string& address, const std::string& arg) -> demo::Ip4Address
+{
+    std::error_code ec;
+    const auto parsed = asio::ip::make_address_v4(address, ec);
+    if (ec)
+    {
+        throw std::invalid_argument{"Invalid IPv4 address '" + address + "' for " + arg};
+    }
+    return demo::Ip4Address{parsed.to_bytes()};
+}
+
+auto GetFrameSizes(const std::string& frameSize) -> std::vector<std::size_t>
+{
+    if (frameSize == "imix")
+    {
+        // simple IMIX: 7 x 64, 4 x 570 and 1 x 1518 bytes on the wire, the smallest frames grown to hold a probe
+        return {minimumProbeFrameSize, 566, minimumProbeFrameSize, minimumProbeFrameSize, 566, minimumProbeFrameSize,
+                1514, minimumProbeFrameSize, 566, minimumProbeFrameSize, minimumProbeFrameSize, 566};
+    }
+
+    const auto size = std::stoul(frameSize);
+    if (size < minimumProbeFrameSize || size > 65535)
+    {
+        throw std::out_of_range{"frame size"};
+    }
+    return {size};
+}
+
+void LogRate(SilKit::Services::Logging::ILogger* logger, const char* prefix, const ProbeStatistics::Counters& counters,
+             std::chrono::nanoseconds duration)
+{
+    const auto seconds = std::max(std::chrono::duration<double>(duration).count(), 1e-9);
+    std::ostringstream SILKitInfoMessage;
+    SILKitInfoMessage << std::fixed << std::setprecision(1) << prefix << "sent " << counters.sentFrames / seconds
+                      << " frames/s, " << counters.sentBytes * 8 / seconds / 1e6 << " Mbit/s, received "
+                      << counters.receivedFrames / seconds << " frames/s, "
+                      << counters.receivedBytes * 8 / seconds / 1e6 << " Mbit/s";
+    logger->Info(SILKitInfoMessage.str());
+}
+
+auto Subtract(const ProbeStatistics::Counters& lhs, const ProbeStatistics::Counters& rhs) -> ProbeStatistics::Counters
+{
+    return ProbeStatistics::Counters{lhs.sentFrames - rhs.sentFrames, lhs.sentBytes - rhs.sentBytes,
+                                     lhs.receivedFrames - rhs.receivedFrames, lhs.receivedBytes - rhs.receivedBytes};
+}
+
+void LogSummary(SilKit::Services::Logging::ILogger* logger, const ProbeStatistics::Summary& summary,
+                std::uint64_t nacks)
+{
+    const auto& counters = summary.counters;
+    const auto lossPercent =
+        counters.sentFrames > 0 ? 100.0 * static_cast<double>(summary.lostFrames) / counters.sentFrames : 0.0;
+
+    std::ostringstream SILKitInfoMessage;
+    SILKitInfoMessage << std::fixed << std::setprecision(3) << "Perf: sent " << counters.sentFrames << " frames ("
+                      << counters.sentBytes << " bytes), received " << counters.receivedFrames << " frames ("
+                      << counters.receivedBytes << " bytes), lost " << summary.lostFrames << " (" << lossPercent
+                      << "%), reordered " << summary.reorderedFrames << ", duplicates " << summary.duplicateFrames
+                      << ", NACKs " << nacks;
+    logger->Info(SILKitInfoMessage.str());
+
+    const auto& roundTrip = summary.roundTrip;
+    if (roundTrip.count == 0)
+    {
+        return;
+    }
+    const auto toMicroseconds = [](std::uint64_t valueNs) { return static_cast<double>(valueNs) / 1e3; };
+    std::ostringstream SILKitRoundTripMessage;
+    SILKitRoundTripMessage << std::fixed << std::setprecision(1) << "Perf: round-trip time p50="
+                           << toMicroseconds(roundTrip.p50Ns) << "us p90=" << toMicroseconds(roundTrip.p90Ns)
+                           << "us p99=" << toMicroseconds(roundTrip.p99Ns) << "us p99.9="
+                           << toMicroseconds(roundTrip.p999Ns) << "us max=" << toMicroseconds(roundTrip.maxNs)
+                           << "us mean=" << toMicroseconds(roundTrip.sumNs / roundTrip.count) << "us ("
+                           << roundTrip.count << " replies)";
+    logger->Info(SILKitRoundTripMessage.str());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (findArg(argc, argv, versionArg, argv) != NULL)
+    {
+        print_version();
+        return CodeSuccess;
+    }
+
+    if (findArg(argc, argv, helpArg, argv) != NULL)
+    {
+        print_perf_help(true);
+        return CodeSuccess;
+    }
+
+    const std::string ethernetNetworkName = getArgDefault(argc, argv, networkArg, "tap_demo");
+    const std::string ethernetControllerName = "SilKit_ETH_CTRL_1";
+    const std::string frameSizeStr = getArgDefault(argc, argv, frameSizeArg, "100");
+    const std::string rateStr = getArgDefault(argc, argv, rateArg, "1000");
+    const bool maxRate = (rateStr == "max");
+
+    ProbeEndpoints endpoints{};
+    std::vector<std::size_t> frameSizes;
+    double rate = 0.0;
+    unsigned long burst = 1;
+    std::chrono::seconds duration{10};
+    std::optional<std::uint16_t> vlanId;
+    try
+    {
+        endpoints.localEthernetAddress = localEthernetAddress;
+        endpoints.localIp4Address = ParseIp4Address(getArgDefault(argc, argv, ipArg, "192.168.7.36"), ipArg);
+        endpoints.peerIp4Address = ParseIp4Address(getArgDefault(argc, argv, peerArg, "192.168.7.2"), peerArg);
+        endpoints.runId = std::random_device{}();
+
+        const std::string udpPortStr = getArgDefault(argc, argv, udpPortArg, "");
+        if (!udpPortStr.empty())
+        {
+            const auto udpPort = std::stoul(udpPortStr);
+            if (udpPort == 0 || udpPort > 65535)
+            {
+                throw std::out_of_range{"UDP port"};
+            }
+            endpoints.udpPort = static_cast<std::uint16_t>(udpPort);
+        }
+
+        frameSizes = GetFrameSizes(frameSizeStr);
+        if (!maxRate)
+        {
+            rate = std::stod(rateStr);
+            if (!(rate > 0.0))
+            {
+                throw std::out_of_range{"rate"};
+            }
+        }
+        burst = std::stoul(getArgDefault(argc, argv, burstArg, "1"));
+        if (burst == 0)
+        {
+            throw std::out_of_range{"burst"};
+        }
+        duration = std::chrono::seconds{std::stoul(getArgDefault(argc, argv, durationArg, "10"))};
+
+        const std::string vlanTagStr = getArgDefault(argc, argv, vlanTagArg, "");
+        if (!vlanTagStr.empty())
+        {
+            const auto parsedId = std::stoul(vlanTagStr);
+            if (parsedId > 4094)
+            {
+                throw std::out_of_range{"VLAN ID"};
+            }
+            vlanId = static_cast<std::uint16_t>(parsedId);
+        }
+    }
+    catch (const std::invalid_argument& error)
+    {
+        std::cerr << "Error: " << error.what() << std::endl;
+        return CodeErrorCli;
+    }
+    catch (const std::exception&)
+    {
+        std::cerr << "Error: Invalid number in " << udpPortArg << ", " << frameSizeArg << " (66..65535 or imix), "
+                  << rateArg << " (greater than 0 or max), " << burstArg << " (at least 1), " << durationArg
+                  << " or " << vlanTagArg << " (VLAN ID in range 0..4094)" << std::endl;
+        return CodeErrorCli;
+    }
+
+    try
+    {
+        throwInvalidCliIf(thereAreUnknownArguments(argc, argv,
+                                                   {&peerArg, &ipArg, &udpPortArg, &frameSizeArg, &rateArg, &burstArg,
+                                                    &durationArg, &vlanTagArg, &networkArg, &regUriArg, &logLevelArg,
+                                                    &participantNameArg, &configurationArg},
+                                                   {&helpArg, &versionArg}));
+
+        SilKit::Services::Logging::ILogger* logger;
+        SilKit::Services::Orchestration::ILifecycleService* lifecycleService;
+        std::promise<void> runningStatePromise;
+
+        std::string participantName = "SilKitAdapterTapPerf";
+        const auto participant =
+            CreateParticipant(argc, argv, logger, &participantName, &lifecycleService, &runningStatePromise);
+
+        logger->Info("Creating ethernet controller '" + ethernetControllerName + "'");
+        auto* ethController = participant->CreateEthernetController(ethernetControllerName, ethernetNetworkName);
+
+        std::atomic<std::uint64_t> pendingFrames{0};
+        std::atomic<std::uint64_t> nacks{0};
+        auto sendFrame = [ethController, &pendingFrames, vlanId](std::vector<std::uint8_t> data) {
+            if (vlanId.has_value())
+            {
+                data = vlan::InjectVlanTag(std::move(data), *vlanId);
+            }
+            ++pendingFrames;
+            ethController->SendFrame(EthernetFrame{std::move(data)});
+        };
+
+        ProbeStatistics statistics;
+        std::promise<demo::EthernetAddress> peerResolvedPromise;
+        std::atomic<bool> peerResolved{false};
+
+        ethController->AddFrameHandler([&](IEthernetController* /*controller*/, const EthernetFrameEvent& event) {
+            const auto receiveNs = PipelineLatency::Now();
+            const auto frame = asio::buffer(event.frame.raw.data(), event.frame.raw.size());
+
+            if (const auto reply = ParseProbeReply(frame, endpoints))
+            {
+                statistics.RecordReceived(reply->sequence, receiveNs - reply->sendTimestampNs, frame.size());
+            }
+            else if (auto arpReply = MakeArpReply(frame, endpoints))
+            {
+                sendFrame(std::move(*arpReply));
+            }
+            else if (const auto peerEthernetAddress = ParseArpReply(frame, endpoints))
+            {
+                if (!peerResolved.exchange(true))
+                {
+                    peerResolvedPromise.set_value(*peerEthernetAddress);
+                }
+            }
+        });
+        ethController->AddFrameTransmitHandler(
+            [&pendingFrames, &nacks](IEthernetController* /*controller*/, const EthernetFrameTransmitEvent& ack) {
+            --pendingFrames;
+            if (ack.status != EthernetTransmitStatus::Transmitted)
+            {
+                ++nacks;
+            }
+        });
+
+        lifecycleService->SetCommunicationReadyHandler([&ethController]() { ethController->Activate(); });
+        auto finalStateFuture = lifecycleService->StartLifecycle();
+
+        std::signal(SIGINT, OnStopSignal);
+        std::signal(SIGTERM, OnStopSignal);
+
+        if (runningStatePromise.get_future().wait_for(15s) != std::future_status::ready)
+        {
+            logger->Error("Perf: the participant did not reach the running state, nothing was sent");
+            stopRequested = true;
+        }
+
+        // the peer is addressed by its Ethernet address, resolve it the way its network stack expects
+        auto peerResolvedFuture = peerResolvedPromise.get_future();
+        for (int attempt = 0; attempt < arpAttempts && !stopRequested; ++attempt)
+        {
+            sendFrame(MakeArpRequest(endpoints));
+            if (peerResolvedFuture.wait_for(1s) == std::future_status::ready)
+            {
+                endpoints.peerEthernetAddress = peerResolvedFuture.get();
+                break;
+            }
+        }
+        if (!peerResolved && !stopRequested)
+        {
+            std::ostringstream SILKitErrorMessage;
+            SILKitErrorMessage << "Perf: no ARP reply from " << getArgDefault(argc, argv, peerArg, "192.168.7.2")
+                               << " on network '" << ethernetNetworkName << "', nothing was sent";
+            logger->Error(SILKitErrorMessage.str());
+            stopRequested = true;
+        }
+
+        if (!stopRequested)
+        {
+            std::ostringstream SILKitInfoMessage;
+            SILKitInfoMessage << "Perf: sending " << (endpoints.udpPort ? "UDP" : "ICMP echo") << " probes of "
+                              << frameSizeStr << " bytes to " << getArgDefault(argc, argv, peerArg, "192.168.7.2")
+                              << (maxRate ? std::string{" at maximum rate"} : " at " + rateStr + " frames/s")
+                              << " in bursts of " << burst << " for " << duration.count() << " s";
+            logger->Info(SILKitInfoMessage.str());
+        }
+
+        const auto burstInterval = maxRate ? std::chrono::nanoseconds{0}
+                                           : std::chrono::nanoseconds{static_cast<std::int64_t>(burst * 1e9 / rate)};
+        const auto start = std::chrono::steady_clock::now();
+        auto reportStart = start;
+        ProbeStatistics::Counters countersAtReport{};
+        std::uint64_t sequence = 0;
+
+        for (std::uint64_t burstIndex = 0; !stopRequested; ++burstIndex)
+        {
+            const auto burstStart = start + static_cast<std::int64_t>(burstIndex) * burstInterval;
+            if (burstStart - start >= duration)
+            {
+                break;
+            }
+            if (!maxRate)
+            {
+                WaitUntil(burstStart, stopRequested);
+            }
+            else if (std::chrono::steady_clock::now() - start >= duration)
+            {
+                break;
+            }
+
+            for (unsigned long frameIndex = 0; frameIndex < burst && !stopRequested; ++frameIndex, ++sequence)
+            {
+                WaitForPendingFrames(pendingFrames, stopRequested);
+
+                const auto frameSize = frameSizes[sequence % frameSizes.size()];
+                std::vector<std::uint8_t> data(frameSize);
+                WriteProbe(asio::buffer(data), endpoints, frameSize, sequence, PipelineLatency::Now());
+                statistics.RecordSent(frameSize);
+                sendFrame(std::move(data));
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (now - reportStart >= 1s)
+            {
+                const auto counters = statistics.GetCounters();
+                LogRate(logger, "Perf: ", Subtract(counters, countersAtReport), now - reportStart);
+                countersAtReport = counters;
+                reportStart = now;
+            }
+        }
+        const auto sendDuration = std::chrono::steady_clock::now() - start;
+
+        const auto drainDeadline = std::chrono::steady_clock::now() + drainTimeout;
+        while (std::chrono::steady_clock::now() < drainDeadline && !stopRequested)
+        {
+            const auto counters = statistics.GetCounters();
+            if (counters.receivedFrames >= counters.sentFrames)
+            {
+                break;
+            }
+            std::this_thread::sleep_for(10ms);
+        }
+
+        const auto summary = statistics.Summarize();
+        if (summary.counters.sentFrames > 0)
+        {
+            LogRate(logger, "Perf average: ", summary.counters, sendDuration);
+            LogSummary(logger, summary, nacks);
+        }
+
+        lifecycleService->Stop("Perf run finished.");
+        if (finalStateFuture.wait_for(15s) != std::future_status::ready)
+        {
+            logger->Debug("Lifecycle service stopping: timed out");
+        }
+    }
+    catch (const SilKit::ConfigurationError& error)
+    {
+        std::cerr << "Invalid configuration: " << error.what() << std::endl;
+        return CodeErrorConfiguration;
+    }
+    catch (const InvalidCli&)
+    {
+        print_perf_help(false);
+        std::cerr << std::endl << "Invalid command line arguments." << std::endl;
+        return CodeErrorCli;
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << "Something went wrong: " << error.what() << std::endl;
+        return CodeErrorOther;
+    }
+
+    return CodeSuccess;
+}
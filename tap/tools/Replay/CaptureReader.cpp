@@ -0,0 +1,385 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "CaptureReader.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace adapters;
+
+namespace {
+
+constexpr std::uint32_t pcapMagicMicroseconds = 0xA1B2C3D4;
+constexpr std::uint32_t pcapMagicNanoseconds = 0xA1B23C4D;
+constexpr std::uint32_t pcapngByteOrderMagic = 0x1A2B3C4D;
+
+constexpr std::uint32_t sectionHeaderBlock = 0x0A0D0D0A;
+constexpr std::uint32_t interfaceDescriptionBlock = 0x00000001;
+constexpr std::uint32_t obsoletePacketBlock = 0x00000002;
+constexpr std::uint32_t simplePacketBlock = 0x00000003;
+constexpr std::uint32_t enhancedPacketBlock = 0x00000006;
+
+constexpr std::uint16_t optionEndOfOptions = 0;
+constexpr std::uint16_t optionIfTimestampResolution = 9;
+constexpr std::uint16_t optionIfTimestampOffset = 14;
+
+constexpr std::uint32_t linkTypeEthernet = 1;
+
+constexpr std::size_t pcapFileHeaderSize = 24;
+constexpr std::size_t pcapRecordHeaderSize = 16;
+
+// block type, block length, the fixed fields of the block and the trailing block length
+constexpr std::size_t minBlockLength = 12;
+constexpr std::size_t minInterfaceDescriptionBlockLength = 20;
+constexpr std::size_t minSimplePacketBlockLength = 16;
+constexpr std::size_t minPacketBlockLength = 32;
+
+auto Swap32(std::uint32_t value) -> std::uint32_t
+{
+    return ((value & 0xFF) << 24u) | ((value & 0xFF00) << 8u) | ((value >> 8u) & 0xFF00) | (value >> 24u);
+}
+
+auto MalformedFile(const std::string& detail) -> std::runtime_error
+{
+    return std::runtime_error{"malformed capture file: " + detail};
+}
+
+auto MinBlockLength(std::uint32_t blockType) -> std::size_t
+{
+    switch (blockType)
+    {
+    case interfaceDescriptionBlock:
+        return minInterfaceDescriptionBlockLength;
+    case simplePacketBlock:
+        return minSimplePacketBlockLength;
+    case enhancedPacketBlock:
+    case obsoletePacketBlock:
+        return minPacketBlockLength;
+    default:
+        return minBlockLength;
+    }
+}
+
+} // namespace
+
+CaptureReader::CaptureReader(const std::string& path)
+{
+#if WIN32
+    std::ifstream file{path, std::ios::binary};
+    if (!file)
+    {
+        throw std::runtime_error{"cannot open " + path};
+    }
+    _contents.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    _data = _contents.data();
+    _size = _contents.size();
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error{"cannot open " + path + ": " + std::strerror(errno)};
+    }
+    struct stat fileStatus = {};
+    if (::fstat(fd, &fileStatus) != 0 || fileStatus.st_size == 0)
+    {
+        ::close(fd);
+        throw std::runtime_error{"cannot read " + path};
+    }
+    _size = static_cast<std::size_t>(fileStatus.st_size);
+    void* mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error{"cannot map " + path + ": " + std::strerror(errno)};
+    }
+    ::madvise(mapping, _size, MADV_SEQUENTIAL);
+    _data = static_cast<const std::uint8_t*>(mapping);
+#endif
+
+    try
+    {
+        Require(0, 4);
+        std::uint32_t magic;
+        std::memcpy(&magic, _data, sizeof(magic));
+        if (magic == sectionHeaderBlock)
+        {
+            _isPcapng = true;
+            _firstRecordOffset = 0;
+        }
+        else
+        {
+            _swapped = (magic == Swap32(pcapMagicMicroseconds) || magic == Swap32(pcapMagicNanoseconds));
+            const auto pcapMagic = Read32(0);
+            if (pcapMagic != pcapMagicMicroseconds && pcapMagic != pcapMagicNanoseconds)
+            {
+                throw std::runtime_error{path + " is neither a pcap nor a pcapng file"};
+            }
+            Require(0, pcapFileHeaderSize);
+            const auto linkType = Read32(20) & 0x0FFFFFFF; // the upper bits carry FCS information
+            _interfaces.push_back(Interface{linkType == linkTypeEthernet,
+                                            static_cast<std::uint8_t>(pcapMagic == pcapMagicNanoseconds ? 9 : 6),
+                                            false, 0});
+            if (!_interfaces.back().isEthernet)
+            {
+                throw std::runtime_error{path + " does not contain Ethernet frames (link type "
+                                         + std::to_string(linkType) + ")"};
+            }
+            _firstRecordOffset = pcapFileHeaderSize;
+        }
+    }
+    catch (...)
+    {
+#if !WIN32
+        ::munmap(const_cast<std::uint8_t*>(_data), _size);
+#endif
+        throw;
+    }
+    _offset = _firstRecordOffset;
+}
+
+CaptureReader::~CaptureReader()
+{
+#if !WIN32
+    ::munmap(const_cast<std::uint8_t*>(_data), _size);
+#endif
+}
+
+void CaptureReader::Rewind()
+{
+    _offset = _firstRecordOffset;
+    _lastTimestampNs = 0;
+    if (_isPcapng)
+    {
+        _interfaces.clear();
+    }
+}
+
+auto CaptureReader::Next(CapturedFrame& frame) -> bool
+{
+    return _isPcapng ? NextPcapng(frame) : NextPcap(frame);
+}
+
+void CaptureReader::Require(std::size_t offset, std::size_t size) const
+{
+    if (offset > _size || size > _size - offset)
+    {
+        throw MalformedFile("truncated at offset " + std::to_string(offset));
+    }
+}
+
+auto CaptureReader::Read16(std::size_t offset) const -> std::uint16_t
+{
+    Require(offset, 2);
+    std::uint16_t value;
+    std::memcpy(&value, _data + offset, sizeof(value));
+    return _swapped ? static_cast<std::uint16_t>((value << 8u) | (value >> 8u)) : value;
+}
+
+auto CaptureReader::Read32(std::size_t offset) const -> std::uint32_t
+{
+    Require(offset, 4);
+    std::uint32_t value;
+    std::memcpy(&value, _data + offset, sizeof(value));
+    return _swapped ? Swap32(value) : value;
+}
+
+auto CaptureReader::Read64(std::size_t offset) const -> std::uint64_t
+{
+    const std::uint64_t first = Read32(offset);
+    const std::uint64_t second = Read32(offset + 4);
+    return _swapped ? (first << 32u) | second : (second << 32u) | first;
+}
+
+auto CaptureReader::ToNanoseconds(const Interface& captureInterface, std::uint64_t timestamp) const -> std::uint64_t
+{
+    std::uint64_t nanoseconds;
+    if (captureInterface.binaryResolution)
+    {
+        nanoseconds = static_cast<std::uint64_t>(static_cast<long double>(timestamp) * 1e9L
+                                                 / std::ldexp(1.0L, captureInterface.resolutionExponent));
+    }
+    else if (captureInterface.resolutionExponent <= 9)
+    {
+        nanoseconds = timestamp;
+        for (auto exponent = captureInterface.resolutionExponent; exponent < 9; ++exponent)
+        {
+            nanoseconds *= 10;
+        }
+    }
+    else
+    {
+        nanoseconds = timestamp;
+        for (auto exponent = captureInterface.resolutionExponent; exponent > 9; --exponent)
+        {
+            nanoseconds /= 10;
+        }
+    }
+    return nanoseconds + static_cast<std::uint64_t>(captureInterface.offsetSeconds * 1'000'000'000);
+}
+
+auto CaptureReader::NextPcap(CapturedFrame& frame) -> bool
+{
+    if (_offset >= _size)
+    {
+        return false;
+    }
+
+    const auto seconds = Read32(_offset);
+    const auto fraction = Read32(_offset + 4);
+    const auto capturedSize = Read32(_offset + 8);
+    const auto originalSize = Read32(_offset + 12);
+    Require(_offset + pcapRecordHeaderSize, capturedSize);
+
+    const auto& captureInterface = _interfaces.front();
+    frame.timestampNs = std::uint64_t{seconds} * 1'000'000'000
+                        + ToNanoseconds(captureInterface, fraction);
+    frame.interfaceId = 0;
+    frame.data = _data + _offset + pcapRecordHeaderSize;
+    frame.capturedSize = capturedSize;
+    frame.originalSize = originalSize;
+    _offset += pcapRecordHeaderSize + capturedSize;
+    return true;
+}
+
+auto CaptureReader::NextPcapng(CapturedFrame& frame) -> bool
+{
+    while (_offset < _size)
+    {
+        const auto blockOffset = _offset;
+        Require(blockOffset, minBlockLength);
+
+        std::uint32_t blockType;
+        std::memcpy(&blockType, _data + blockOffset, sizeof(blockType));
+        if (blockType == sectionHeaderBlock)
+        {
+            ReadSectionHeader(blockOffset);
+        }
+        else
+        {
+            blockType = Read32(blockOffset);
+        }
+
+        const std::size_t blockLength = Read32(blockOffset + 4);
+        if (blockLength < MinBlockLength(blockType) || blockLength % 4 != 0)
+        {
+            throw MalformedFile("invalid block length at offset " + std::to_string(blockOffset));
+        }
+        Require(blockOffset, blockLength);
+        _offset += blockLength;
+
+        if (blockType == interfaceDescriptionBlock)
+        {
+            ReadInterfaceDescription(blockOffset, blockLength);
+            continue;
+        }
+
+        std::uint32_t interfaceId = 0;
+        std::uint64_t timestamp = 0;
+        std::size_t dataOffset = 0;
+        std::uint32_t capturedSize = 0;
+        std::uint32_t originalSize = 0;
+        if (blockType == enhancedPacketBlock || blockType == obsoletePacketBlock)
+        {
+            interfaceId = blockType == enhancedPacketBlock ? Read32(blockOffset + 8) : Read16(blockOffset + 8);
+            timestamp = (std::uint64_t{Read32(blockOffset + 12)} << 32u) | Read32(blockOffset + 16);
+            capturedSize = Read32(blockOffset + 20);
+            originalSize = Read32(blockOffset + 24);
+            dataOffset = blockOffset + 28;
+            if (dataOffset + capturedSize > blockOffset + blockLength - 4)
+            {
+                throw MalformedFile("packet exceeds its block at offset " + std::to_string(blockOffset));
+            }
+        }
+        else if (blockType == simplePacketBlock)
+        {
+            originalSize = Read32(blockOffset + 8);
+            capturedSize = static_cast<std::uint32_t>(std::min<std::size_t>(originalSize, blockLength - 16));
+            dataOffset = blockOffset + 12;
+        }
+        else
+        {
+            continue; // statistics, name resolution and custom blocks
+        }
+
+        if (interfaceId >= _interfaces.size())
+        {
+            throw MalformedFile("packet of unknown interface " + std::to_string(interfaceId));
+        }
+        const auto& captureInterface = _interfaces[interfaceId];
+        if (!captureInterface.isEthernet)
+        {
+            continue;
+        }
+
+        if (blockType != simplePacketBlock)
+        {
+            _lastTimestampNs = ToNanoseconds(captureInterface, timestamp);
+        }
+        frame.timestampNs = _lastTimestampNs;
+        frame.interfaceId = interfaceId;
+        frame.data = _data + dataOffset;
+        frame.capturedSize = capturedSize;
+        frame.originalSize = originalSize;
+        return true;
+    }
+    return false;
+}
+
+void CaptureReader::ReadSectionHeader(std::size_t blockOffset)
+{
+    Require(blockOffset, 12);
+    std::uint32_t byteOrderMagic;
+    std::memcpy(&byteOrderMagic, _data + blockOffset + 8, sizeof(byteOrderMagic));
+    if (byteOrderMagic != pcapngByteOrderMagic && byteOrderMagic != Swap32(pcapngByteOrderMagic))
+    {
+        throw MalformedFile("invalid byte order magic at offset " + std::to_string(blockOffset));
+    }
+    _swapped = byteOrderMagic != pcapngByteOrderMagic;
+    _interfaces.clear(); // interface ids are local to a section
+}
+
+void CaptureReader::ReadInterfaceDescription(std::size_t blockOffset, std::size_t blockLength)
+{
+    Interface captureInterface{Read16(blockOffset + 8) == linkTypeEthernet, 6, false, 0};
+
+    const auto optionsEnd = blockOffset + blockLength - 4;
+    for (auto optionOffset = blockOffset + 16; optionOffset + 4 <= optionsEnd;)
+    {
+        const auto code = Read16(optionOffset);
+        const std::size_t length = Read16(optionOffset + 2);
+        if (code == optionEndOfOptions)
+        {
+            break;
+        }
+        if (length > optionsEnd - (optionOffset + 4))
+        {
+            throw MalformedFile("option exceeds its block at offset " + std::to_string(optionOffset));
+        }
+        if (code == optionIfTimestampResolution && length == 1)
+        {
+            const auto resolution = _data[optionOffset + 4];
+            captureInterface.binaryResolution = (resolution & 0x80u) != 0;
+            captureInterface.resolutionExponent = static_cast<std::uint8_t>(resolution & 0x7Fu);
+        }
+        else if (code == optionIfTimestampOffset && length == 8)
+        {
+            captureInterface.offsetSeconds = static_cast<std::int64_t>(Read64(optionOffset + 4));
+        }
+        optionOffset += 4 + ((length + 3) & ~std::size_t{3});
+    }
+
+    _interfaces.push_back(captureInterface);
+}
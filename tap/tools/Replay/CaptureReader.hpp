@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace adapters {
+
+/// <summary>
+/// Ethernet frame read from a capture file. data points into the mapped file.
+/// </summary>
+struct CapturedFrame
+{
+    std::uint64_t timestampNs;
+    std::uint32_t interfaceId;
+    const std::uint8_t* data;
+    std::uint32_t capturedSize;
+    std::uint32_t originalSize;
+};
+
+/// <summary>
+/// Reads the Ethernet frames of a pcap or pcapng file, which is mapped into memory as a whole.
+///
+///   Both byte orders and the microsecond and nanosecond pcap variants are supported. In pcapng files
+///   every section is read, frames of interfaces with a link type other than Ethernet are skipped.
+/// </summary>
+class CaptureReader
+{
+public:
+    /// <exception cref="std::runtime_error">Thrown if the file cannot be read or is no pcap/pcapng file.</exception>
+    explicit CaptureReader(const std::string& path);
+    ~CaptureReader();
+
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    /// <summary>
+    /// Reads the next frame, returns false at the end of the file.
+    /// </summary>
+    /// <exception cref="std::runtime_error">Thrown if the file is malformed.</exception>
+    auto Next(CapturedFrame& frame) -> bool;
+
+    /// <summary>
+    /// Starts reading from the first frame again.
+    /// </summary>
+    void Rewind();
+
+private:
+    struct Interface
+    {
+        bool isEthernet;
+        // timestamp units per second are 10^exponent, or 2^exponent if binaryResolution is set
+        std::uint8_t resolutionExponent;
+        bool binaryResolution;
+        std::int64_t offsetSeconds;
+    };
+
+    auto Read16(std::size_t offset) const -> std::uint16_t;
+    auto Read32(std::size_t offset) const -> std::uint32_t;
+    auto Read64(std::size_t offset) const -> std::uint64_t;
+    void Require(std::size_t offset, std::size_t size) const;
+    auto ToNanoseconds(const Interface& captureInterface, std::uint64_t timestamp) const -> std::uint64_t;
+
+    auto NextPcap(CapturedFrame& frame) -> bool;
+    auto NextPcapng(CapturedFrame& frame) -> bool;
+    void ReadSectionHeader(std::size_t blockOffset);
+    void ReadInterfaceDescription(std::size_t blockOffset, std::size_t blockLength);
+
+    const std::uint8_t* _data{nullptr};
+    std::size_t _size{0};
+#if WIN32
+    std::vector<std::uint8_t> _contents;
+#endif
+
+    bool _isPcapng{false};
+    bool _swapped{false};
+    std::size_t _firstRecordOffset{0};
+    std::size_t _offset{0};
+    // simple packet blocks carry no timestamp, they get the one of the previous frame
+    std::uint64_t _lastTimestampNs{0};
+
+    // pcap: the only interface, pcapng: the interfaces of the current section
+    std::vector<Interface> _interfaces;
+};
+
+} // namespace adapters
@@ -0,0 +1,344 @@
+// SPDX-FileCopyrightText: Copyright 2025 Vector Informatik GmbH
+// SPDX-License-Identifier: MIT
+
+#include "CaptureReader.hpp"
+#include "../../adapter/Parsing.hpp"
+#include "Pacing.hpp"
+#include "EthernetHeader.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "common/Parsing.hpp"
+#include "common/Cli.hpp"
+#include "common/ParticipantCreation.hpp"
+#include "common/Exceptions.hpp"
+
+#include "silkit/SilKit.hpp"
+#include "silkit/config/all.hpp"
+#include "silkit/services/ethernet/all.hpp"
+#include "silkit/services/logging/all.hpp"
+
+using namespace SilKit::Services::Ethernet;
+using namespace SilKit::Services::Orchestration;
+using namespace std::chrono_literals;
+using namespace util;
+using namespace adapters;
+
+namespace {
+
+const std::string fileArg = "--file";
+const std::string speedArg = "--speed";
+const std::string loopsArg = "--loops";
+const std::string interfaceArg = "--interface";
+
+
+std::atomic<bool> stopRequested{false};
+
+void OnStopSignal(int /*signalNumber*/)
+{
+    stopRequested = true;
+}
+
+void print_replay_help(bool userRequested)
+{
+    // clang-format off
+    std::cout << "Usage (defaults in curly braces if you omit the switch):" << std::endl;
+    std::cout << "sil-kit-adapter-tap-replay " << fileArg << " <pcap or pcapng file>\n"
+        "  [" << participantNameArg << " <participant's name{SilKitAdapterTapReplay}>]\n"
+        "  [" << configurationArg << " <path to .silkit.yaml or .json configuration file>]\n"
+        "  [" << regUriArg << " silkit://<host{localhost}>:<port{8501}>]\n"
+        "  [" << logLevelArg << " <Trace|Debug|Warn|{Info}|Error|Critical|Off>]\n"
+        "  [" << networkArg << " <SIL Kit ethernet network{Ethernet1}>]\n"
+        "  [" << speedArg << " <factor applied to the recorded timing{1}, or max to send as fast as possible>]\n"
+        "  [" << loopsArg << " <number of times the file is replayed{1}, 0 for endless>]\n"
+        "  [" << interfaceArg << " <pcapng interface id to replay, e.g. 0 for tap_to_silkit of an adapter capture>]\n"
+        "  [" << vlanTagArg << " <VLAN ID to set on all frames, replacing their 802.1Q tag>]\n";
+    std::cout << "\n"
+        "Example:\n"
+        "sil-kit-adapter-tap-replay " << fileArg << " vehicle.pcapng " << networkArg << " tap_demo "
+        << speedArg << " 2 " << loopsArg << " 10\n";
+
+    if (!userRequested)
+        std::cout << "\n"
+            "Pass " << helpArg << " to get this message.\n";
+    // clang-format on
+}
+
+struct ReplayCounters
+{
+    std::uint64_t frames{0};
+    std::uint64_t bytes{0};
+    std::uint64_t truncatedFrames{0};
+    std::chrono::nanoseconds maxLag{0};
+};
+
+void LogRate(SilKit::Services::Logging::ILogger* logger, const char* prefix, std::uint64_t frames,
+             std::uint64_t bytes, std::chrono::nanoseconds duration)
+{
+    const auto seconds = std::max(std::chrono::duration<double>(duration).count(), 1e-9);
+    std::ostringstream SILKitInfoMessage;
+    SILKitInfoMessage << std::fixed << std::setprecision(1) << prefix << frames / seconds << " frames/s, "
+                      << bytes * 8 / seconds / 1e6 << " Mbit/s";
+    logger->Info(SILKitInfoMessage.str());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (findArg(argc, argv, versionArg, argv) != NULL)
+    {
+        print_version();
+        return CodeSuccess;
+    }
+
+    if (findArg(argc, argv, helpArg, argv) != NULL)
+    {
+        print_replay_help(true);
+        return CodeSuccess;
+    }
+
+    const std::string capturePath = getArgDefault(argc, argv, fileArg, "");
+    const std::string ethernetNetworkName = getArgDefault(argc, argv, networkArg, "Ethernet1");
+    const std::string ethernetControllerName = "SilKit_ETH_CTRL_1";
+
+    if (capturePath.empty())
+    {
+        print_replay_help(false);
+        std::cerr << std::endl << "Error: " << fileArg << " is required" << std::endl;
+        return CodeErrorCli;
+    }
+
+    const std::string speedStr = getArgDefault(argc, argv, speedArg, "1");
+    const bool maxRate = (speedStr == "max");
+    double speed = 1.0;
+    if (!maxRate)
+    {
+        try
+        {
+            speed = std::stod(speedStr);
+        }
+        catch (const std::exception&)
+        {
+            speed = 0.0;
+        }
+        if (!(speed > 0.0))
+        {
+            std::cerr << "Error: Invalid speed '" << speedStr << "', expected a factor greater than 0 or max"
+                      << std::endl;
+            return CodeErrorCli;
+        }
+    }
+
+    unsigned long loops = 1;
+    std::optional<std::uint32_t> interfaceId;
+    std::optional<std::uint16_t> vlanId;
+    try
+    {
+        loops = ParseUnsigned(getArgDefault(argc, argv, loopsArg, "1"), 0, std::numeric_limits<unsigned long>::max());
+        const std::string interfaceStr = getArgDefault(argc, argv, interfaceArg, "");
+        if (!interfaceStr.empty())
+        {
+            interfaceId = static_cast<std::uint32_t>(
+                ParseUnsigned(interfaceStr, 0, std::numeric_limits<std::uint32_t>::max()));
+        }
+        const std::string vlanTagStr = getArgDefault(argc, argv, vlanTagArg, "");
+        if (!vlanTagStr.empty())
+        {
+            vlanId = static_cast<std::uint16_t>(ParseUnsigned(vlanTagStr, 0, 4094));
+        }
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << "Error: Invalid number in " << loopsArg << ", " << interfaceArg << " or " << vlanTagArg << ": "
+                  << error.what() << std::endl;
+        return CodeErrorCli;
+    }
+
+    try
+    {
+        throwInvalidCliIf(thereAreUnknownArguments(argc, argv,
+                                                   {&fileArg, &speedArg, &loopsArg, &interfaceArg, &vlanTagArg,
+                                                    &networkArg, &regUriArg, &logLevelArg, &participantNameArg,
+                                                    &configurationArg},
+                                                   {&helpArg, &versionArg}));
+
+        CaptureReader captureReader{capturePath};
+
+        SilKit::Services::Logging::ILogger* logger;
+        SilKit::Services::Orchestration::ILifecycleService* lifecycleService;
+        std::promise<void> runningStatePromise;
+
+        std::string participantName = "SilKitAdapterTapReplay";
+        const auto participant =
+            CreateParticipant(argc, argv, logger, &participantName, &lifecycleService, &runningStatePromise);
+
+        logger->Info("Creating ethernet controller '" + ethernetControllerName + "'");
+        auto* ethController = participant->CreateEthernetController(ethernetControllerName, ethernetNetworkName);
+
+        std::atomic<std::uint64_t> pendingFrames{0};
+        std::atomic<std::uint64_t> nacks{0};
+        ethController->AddFrameTransmitHandler(
+            [&pendingFrames, &nacks](IEthernetController* /*controller*/, const EthernetFrameTransmitEvent& ack) {
+            --pendingFrames;
+            if (ack.status != EthernetTransmitStatus::Transmitted)
+            {
+                ++nacks;
+            }
+        });
+
+        lifecycleService->SetCommunicationReadyHandler([&ethController]() { ethController->Activate(); });
+        auto finalStateFuture = lifecycleService->StartLifecycle();
+
+        std::signal(SIGINT, OnStopSignal);
+        std::signal(SIGTERM, OnStopSignal);
+
+        if (runningStatePromise.get_future().wait_for(15s) != std::future_status::ready)
+        {
+            logger->Error("Replay: the participant did not reach the running state, nothing was sent");
+            stopRequested = true;
+        }
+
+        {
+            std::ostringstream SILKitInfoMessage;
+            SILKitInfoMessage << "Replaying " << capturePath << " on network '" << ethernetNetworkName << "' "
+                              << (maxRate ? std::string{"at maximum rate"} : "at " + speedStr + "x the recorded timing")
+                              << ", " << (loops == 0 ? std::string{"endlessly"} : std::to_string(loops) + " time(s)");
+            logger->Info(SILKitInfoMessage.str());
+        }
+
+        ReplayCounters counters;
+        ReplayCounters countersAtReport;
+        const auto replayStart = std::chrono::steady_clock::now();
+        auto reportStart = replayStart;
+
+        for (unsigned long loop = 0; (loops == 0 || loop < loops) && !stopRequested; ++loop)
+        {
+            captureReader.Rewind();
+            const auto loopStart = std::chrono::steady_clock::now();
+            std::optional<std::uint64_t> firstTimestampNs;
+            const auto framesBeforeLoop = counters.frames;
+
+            CapturedFrame frame{};
+            while (!stopRequested && captureReader.Next(frame))
+            {
+                if (interfaceId.has_value() && frame.interfaceId != *interfaceId)
+                {
+                    continue;
+                }
+
+                if (!maxRate)
+                {
+                    if (!firstTimestampNs.has_value())
+                    {
+                        firstTimestampNs = frame.timestampNs;
+                    }
+                    const auto offsetNs =
+                        frame.timestampNs > *firstTimestampNs ? frame.timestampNs - *firstTimestampNs : 0;
+                    const auto deadline =
+                        loopStart + std::chrono::nanoseconds{static_cast<std::int64_t>(offsetNs / speed)};
+                    WaitUntil(deadline, stopRequested);
+                    counters.maxLag = std::max(counters.maxLag, std::chrono::steady_clock::now() - deadline);
+                }
+
+                WaitForPendingFrames(pendingFrames, stopRequested);
+
+                std::vector<std::uint8_t> data(frame.data, frame.data + frame.capturedSize);
+                if (frame.capturedSize < frame.originalSize)
+                {
+                    ++counters.truncatedFrames;
+                }
+                if (vlanId.has_value())
+                {
+                    if (vlan::ExtractVlanId(data).has_value())
+                    {
+                        data = vlan::RemoveVlanTag(data);
+                    }
+                    data = vlan::InjectVlanTag(std::move(data), *vlanId);
+                }
+                if (data.size() < 60)
+                {
+                    data.resize(60, 0);
+                }
+
+                counters.bytes += data.size();
+                ++counters.frames;
+                ++pendingFrames;
+                ethController->SendFrame(EthernetFrame{std::move(data)});
+
+                const auto now = std::chrono::steady_clock::now();
+                if (now - reportStart >= 1s)
+                {
+                    LogRate(logger, "Replay: ", counters.frames - countersAtReport.frames,
+                            counters.bytes - countersAtReport.bytes, now - reportStart);
+                    countersAtReport = counters;
+                    reportStart = now;
+                }
+            }
+
+            // a further pass would forward nothing either, with --loops 0 it would spin forever
+            if (counters.frames == framesBeforeLoop && !stopRequested)
+            {
+                std::ostringstream SILKitErrorMessage;
+                SILKitErrorMessage << "Replay: " << capturePath << " contains no frames";
+                if (interfaceId.has_value())
+                {
+                    SILKitErrorMessage << " of interface " << *interfaceId;
+                }
+                SILKitErrorMessage << ", stopping the replay";
+                logger->Error(SILKitErrorMessage.str());
+                break;
+            }
+        }
+
+        const auto replayDuration = std::chrono::steady_clock::now() - replayStart;
+        std::ostringstream SILKitInfoMessage;
+        SILKitInfoMessage << "Replay finished: " << counters.frames << " frames, " << counters.bytes << " bytes in "
+                          << std::fixed << std::setprecision(3)
+                          << std::chrono::duration<double>(replayDuration).count() << " s, " << counters.truncatedFrames
+                          << " frames truncated by the capture snaplen, " << nacks << " NACKs";
+        if (!maxRate)
+        {
+            SILKitInfoMessage << ", max. lag behind the recorded timing "
+                              << std::chrono::duration<double, std::micro>(counters.maxLag).count() << " us";
+        }
+        logger->Info(SILKitInfoMessage.str());
+        LogRate(logger, "Replay average: ", counters.frames, counters.bytes, replayDuration);
+
+        lifecycleService->Stop("Replay finished.");
+        if (finalStateFuture.wait_for(15s) != std::future_status::ready)
+        {
+            logger->Debug("Lifecycle service stopping: timed out");
+        }
+    }
+    catch (const SilKit::ConfigurationError& error)
+    {
+        std::cerr << "Invalid configuration: " << error.what() << std::endl;
+        return CodeErrorConfiguration;
+    }
+    catch (const InvalidCli&)
+    {
+        print_replay_help(false);
+        std::cerr << std::endl << "Invalid command line arguments." << std::endl;
+        return CodeErrorCli;
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << "Something went wrong: " << error.what() << std::endl;
+        return CodeErrorOther;
+    }
+
+    return CodeSuccess;
+}